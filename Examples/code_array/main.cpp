@@ -76,7 +76,7 @@ int main( int argc, char **argv )
       printf("\t  linear_solver : solver method [jacobi | sor | sor2sma | pbicgstab | bicgstab]\n" );
       printf("\t  Iteration     : number of iteration\n" );
       printf("\t  vector_num    : number of RHS\n" );
-      printf("\t  padding_flag  : padding flag [0:off, 1:on]\n" );
+      printf("\t  padding_flag  : padding flag [0:off, 1:on(odd), 2:odd, 3:cache, 4:auto]\n" );
     }
     return 9;
   }
@@ -84,7 +84,12 @@ int main( int argc, char **argv )
   char* method  = argv[2];
   int   ItrMax  = atoi(argv[3]);
   int   nrhs    = atoi(argv[4]);
-  bool  padding = (atoi(argv[5])==0 ? false : true);
+  int   padflag = atoi(argv[5]);
+  bool  padding = (padflag==0 ? false : true);
+  if( padflag >= 2 )
+  {
+    paraMngr->SetPaddingPolicy( (CPM_PADDING)padflag );
+  }
   if( myrank == 0 )
   {
     printf("\tarray size             : %d^3\n", dim);
@@ -92,7 +97,7 @@ int main( int argc, char **argv )
     printf("\tLinear solver          : %s\n"  , method);
     printf("\tmax iteration          : %d\n"  , ItrMax);
     if( padding )
-      printf("\tpadding                : on\n");
+      printf("\tpadding                : on (policy=%d)\n", paraMngr->GetPaddingPolicy());
     else
       printf("\tpadding                : off\n");
   }
@@ -56,6 +56,8 @@ private:
 
   std::vector<Node*> leafNodeArray;  ///< リーフノードリスト
 
+  std::vector<Node*> nodeTable;  ///< 全ノードのハッシュテーブル(Pedigreeをキーとする開番地法)
+
   static const int HilbertOrdering[24][8];    ///< ヒルベルトオーダリング 子ノード選択順テーブル
   static const int HilbertOrientation[24][8]; ///< ヒルベルトオーダリング 回転テーブル
 
@@ -139,6 +141,26 @@ public:
   ///
   NeighborInfo* makeNeighborInfo(const Node* node, const Partition* partition) const;
 
+  /// 指定されたノードの隣接情報を計算(非周期境界、周期境界を同時に計算).
+  ///
+  ///  @param[in] node ノード
+  ///  @param[in] partition 領域分割情報
+  ///  @param[out] neighborInfo 周期境界条件なしの隣接情報(NUM_FACE個の配列)
+  ///  @param[out] periodicInfo 全方向周期境界条件での隣接情報(NUM_FACE個の配列)
+  ///
+  ///  @note ルートグリッドの周期境界フラグは参照、変更しないので，
+  ///        複数スレッドから同時に呼び出してよい.
+  ///
+  void makeNeighborInfo(const Node* node, const Partition* partition,
+                        NeighborInfo* neighborInfo, NeighborInfo* periodicInfo) const;
+
+  /// Pedigreeからノードを検索.
+  ///
+  ///  @param[in] pedigree Pedigree
+  ///  @return ノードへのポインタ(存在しない場合は0)
+  ///
+  Node* findNode(const Pedigree& pedigree) const;
+
 private:
   /// コンストラクタ(リーフノードのPedigreeリストから).
   ///
@@ -202,6 +224,56 @@ private:
   ///
   Node* findNeighborNode(const Node* node, Face face) const;
 
+  /// 隣接ノード探索(隣接ルートを指定).
+  ///
+  ///  @param[in] node 基準ノード
+  ///  @param[in] face 面
+  ///  @param[in] neighborRootID 面の方向に隣接するルートのルートID(存在しない場合は-1)
+  ///  @return 隣接ノードへのポインタ
+  ///
+  ///  @note ハッシュテーブルにより，隣接位置を含む最も深いノードを求める.
+  ///
+  Node* findNeighborNode(const Node* node, Face face, int neighborRootID) const;
+
+  /// 隣接ノードから1面分の隣接情報をセット.
+  ///
+  ///  @param[in] node 基準ノード
+  ///  @param[in] face 面
+  ///  @param[in] neighbor 隣接ノード(0のときは何もしない)
+  ///  @param[in] partition 領域分割情報
+  ///  @param[out] neighborInfo 隣接情報
+  ///
+  void setNeighborInfo(const Node* node, Face face, const Node* neighbor,
+                       const Partition* partition, NeighborInfo& neighborInfo) const;
+
+  /// ノード検索用ハッシュテーブルの作成.
+  void buildNodeTable();
+
+  /// 再帰呼び出しによるノード数のカウント.
+  ///
+  ///  @param[in] node ノード
+  ///  @return ノード数(自身と子孫)
+  ///
+  size_t countNode(const Node* node) const;
+
+  /// 再帰呼び出しによるハッシュテーブルへのノード登録.
+  ///
+  ///  @param[in] node ノード
+  ///
+  void insertNode(Node* node);
+
+  /// Pedigree値のハッシュ.
+  ///
+  ///  @param[in] key Pedigree値
+  ///  @return ハッシュ値
+  ///
+  static uint64_t hashKey(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    return key;
+  }
+
   /// Pedigree情報を通信用バッファにパック.
   ///
   ///  @param[in] node 対象ノード
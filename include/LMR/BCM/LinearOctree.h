@@ -0,0 +1,249 @@
+/*
+ * BCMTools
+ *
+ * Copyright (C) 2011-2014 Institute of Industrial Science, The University of Tokyo.
+ * All rights reserved.
+ *
+ * Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+ * All rights reserved.
+ *
+ */
+
+/**
+ *  @file LinearOctree.h
+ *  @brief Pedigree配列によるリニアOctreeクラス
+ */
+
+#ifndef LINEAR_OCTREE_H
+#define LINEAR_OCTREE_H
+
+#include "BCMTools.h"
+
+#include <vector>
+#include "Vec3.h"
+#include "RootGrid.h"
+#include "Pedigree.h"
+#include "NeighborInfo.h"
+#include "Partition.h"
+
+using namespace Vec3class;
+
+/** Pedigree配列によるリニアOctreeクラス.
+ *
+ *  リーフノードのみを，ルートIDとZ(Morton)順位置から作ったキーのソート済み配列で保持する.
+ *  ノードオブジェクトを生成しないので，読み込み専用のツリーに対して省メモリで，
+ *  親子関係はキーの演算，ノード探索はキー配列の2分探索で行う.
+ *
+ *  @note リーフID(ブロックID)は，コンストラクタに与えたPedigreeリストの順番.
+ *        Pedigreeリストに無い領域は，BCMOctreeの非アクティブノードと同様に扱う.
+ */
+class LinearOctree {
+
+  /// キーのレベル部分のビット数(キー = rootID:Morton位置:レベル).
+  static const int LevelBits = 4;
+
+  /// キーのMorton位置部分のビット数(最大レベルでの3方向分).
+  static const int MortonBits = 3 * Pedigree::MaxLevel;
+
+  RootGrid* rootGrid;  ///< ルートノード配置情報
+
+  std::vector<uint64_t> keys;  ///< ソート済みリーフキー配列
+
+  std::vector<int> sortedID;   ///< ソート順の位置 → リーフID
+
+  std::vector<int> position;   ///< リーフID → ソート順の位置
+
+  std::vector<int> rootHead;   ///< ルート毎の先頭位置(ルート数+1個)
+
+public:
+
+  /// コンストラクタ.
+  ///
+  ///  @param[in] rootGrid ルートノード配置情報
+  ///  @param[in] pedigrees リーフノードのPedigreeリスト
+  ///
+  ///  @note rootGridは，デストラクタにより解放される.
+  ///
+  LinearOctree(RootGrid* rootGrid, const std::vector<Pedigree>& pedigrees);
+
+  /// デストラクタ.
+  ~LinearOctree();
+
+  /// ルートグリッドを取得.
+  /// @return ルートグリッド
+  const RootGrid* getRootGrid() const { return rootGrid; }
+
+  /// リーフノード総数を取得.
+  /// @return リーフノード総数
+  int getNumLeafNode() const { return keys.size(); }
+
+  /// リーフノードのPedigreeを取得.
+  ///
+  ///  @param[in] id リーフID
+  ///  @return Pedigree
+  ///
+  Pedigree getPedigree(int id) const { return keyToPedigree(keys[position[id]]); }
+
+  /// リーフノードのレベルを取得.
+  ///
+  ///  @param[in] id リーフID
+  ///  @return レベル
+  ///
+  int getLevel(int id) const { return keyLevel(keys[position[id]]); }
+
+  /// 指定したリーフノードの面が外部境界(周期境界も含む)かどうかチェック.
+  ///
+  ///  @param[in] id リーフID
+  ///  @param[in] face 面
+  ///  @return 外部境界ならtrue
+  ///
+  bool checkOnOuterBoundary(int id, Face face) const;
+
+  /// 指定されたリーフノードの原点位置を取得.
+  ///
+  ///  @param[in] id リーフID
+  ///  @return 原点位置
+  ///
+  Vec3d getOrigin(int id) const;
+
+  /// 指定したノードの領域を含むリーフノードを検索.
+  ///
+  ///  @param[in] pedigree ノードのPedigree
+  ///  @return リーフID(自身または祖先がリーフでない場合は-1)
+  ///
+  int findLeaf(const Pedigree& pedigree) const;
+
+  /// 指定されたリーフノードの隣接情報を計算.
+  ///
+  ///  @param[in] id リーフID
+  ///  @param[in] partition 領域分割情報
+  ///  @return 隣接情報クラス(NUM_FACE個の配列，呼び出し側で解放する)
+  ///
+  ///  @note ルートグリッドの周期境界フラグに従う.
+  ///
+  NeighborInfo* makeNeighborInfo(int id, const Partition* partition) const;
+
+  /// 指定されたリーフノードの隣接情報を計算(非周期境界、周期境界を同時に計算).
+  ///
+  ///  @param[in] id リーフID
+  ///  @param[in] partition 領域分割情報
+  ///  @param[out] neighborInfo 周期境界条件なしの隣接情報(NUM_FACE個の配列)
+  ///  @param[out] periodicInfo 全方向周期境界条件での隣接情報(NUM_FACE個の配列)
+  ///
+  ///  @note 読み込みのみなので，複数スレッドから同時に呼び出してよい.
+  ///
+  void makeNeighborInfo(int id, const Partition* partition,
+                        NeighborInfo* neighborInfo, NeighborInfo* periodicInfo) const;
+
+  /// 辺，頂点方向の隣接リーフを検索.
+  ///
+  ///  基準リーフと同レベルの斜め方向の隣接領域について，基準リーフの辺または頂点に
+  ///  接するリーフを集める(同レベルまたは粗いリーフは1個，細かいリーフは辺で複数).
+  ///
+  ///  @param[in] id リーフID
+  ///  @param[in] dir 方向(各軸-1,0,1，2軸以上が0以外)
+  ///  @param[out] leafIDs 隣接リーフIDリスト
+  ///  @param[out] offsets 隣接リーフ毎の原点位置(基準リーフ原点から，細かい方のリーフの大きさ単位，3個ずつ)
+  ///  @param[out] crossMask 周期境界を越えた軸のビットフラグ(bit0:X，bit1:Y，bit2:Z)
+  ///  @return 隣接領域が無ければ(外部境界)false
+  ///
+  ///  @note 外部境界は，ルートグリッドの周期境界フラグによらず周期境界として探索し，crossMaskで区別する.
+  ///
+  bool findEdgeNeighbor(int id, const int dir[3], std::vector<int>& leafIDs,
+                        std::vector<int>& offsets, int& crossMask) const;
+
+private:
+
+  /// コピーコンストラクタ(禁止).
+  LinearOctree(const LinearOctree&);
+
+  /// 代入演算子(禁止).
+  LinearOctree& operator=(const LinearOctree&);
+
+  /// ビットを3ビット間隔に展開(Morton位置の作成用).
+  static uint64_t spreadBits(uint64_t v);
+
+  /// 3ビット間隔のビットを詰める(spreadBitsの逆変換).
+  static unsigned compactBits(uint64_t v);
+
+  /// Pedigreeからキーを作成.
+  ///
+  ///  @param[in] pedigree Pedigree
+  ///  @return キー
+  ///
+  static uint64_t pedigreeToKey(const Pedigree& pedigree);
+
+  /// キーからPedigreeを作成.
+  ///
+  ///  @param[in] key キー
+  ///  @return Pedigree
+  ///
+  static Pedigree keyToPedigree(uint64_t key);
+
+  /// キーのレベルを取得.
+  static int keyLevel(uint64_t key) { return int(key & ((1 << LevelBits) - 1)); }
+
+  /// キーのルートIDを取得.
+  static int keyRootID(uint64_t key) { return int(key >> (MortonBits + LevelBits)); }
+
+  /// キーの領域先頭(レベル部分を0にしたキー)を取得.
+  static uint64_t keyBegin(uint64_t key) { return key & ~uint64_t((1 << LevelBits) - 1); }
+
+  /// キーの領域末尾(次の領域の先頭)を取得.
+  static uint64_t keyEnd(uint64_t key) {
+    return keyBegin(key) + (uint64_t(1) << (3 * (Pedigree::MaxLevel - keyLevel(key)) + LevelBits));
+  }
+
+  /// 指定したキー位置を含むリーフノードを検索.
+  ///
+  ///  @param[in] begin 領域先頭のキー
+  ///  @param[in] rootID ルートID
+  ///  @return ソート順の位置(含むリーフが無い場合は-1)
+  ///
+  int findContaining(uint64_t begin, int rootID) const;
+
+  /// 指定したキー範囲にリーフノードがあるかどうか.
+  ///
+  ///  @param[in] begin 領域先頭のキー
+  ///  @param[in] end 領域末尾のキー
+  ///  @param[in] rootID ルートID
+  ///  @return リーフノードがあればtrue
+  ///
+  bool hasLeaf(uint64_t begin, uint64_t end, int rootID) const;
+
+  /// 隣接ノードのPedigreeを計算.
+  ///
+  ///  @param[in] pedigree 基準ノードのPedigree
+  ///  @param[in] face 面
+  ///  @param[in] neighborRootID 面の方向に隣接するルートのルートID(存在しない場合は-1)
+  ///  @param[out] neighbor 隣接ノードのPedigree(基準ノードと同レベル)
+  ///  @return 隣接ノードがなければ(周期境界以外の外部境界)false
+  ///
+  static bool neighborPedigree(const Pedigree& pedigree, Face face, int neighborRootID,
+                               Pedigree& neighbor);
+
+  /// 1面分の隣接情報をセット.
+  ///
+  ///  @param[in] pedigree 基準ノードのPedigree
+  ///  @param[in] face 面
+  ///  @param[in] neighborRootID 面の方向に隣接するルートのルートID(存在しない場合は-1)
+  ///  @param[in] partition 領域分割情報
+  ///  @param[out] neighborInfo 隣接情報
+  ///
+  void setNeighborInfo(const Pedigree& pedigree, Face face, int neighborRootID,
+                       const Partition* partition, NeighborInfo& neighborInfo) const;
+
+  /// 辺，頂点に接するリーフを再帰的に収集.
+  ///
+  ///  @param[in] node 探索するノード(基準ノードと同レベルの隣接ノードまたはその子孫)
+  ///  @param[in] dir 基準ノードから見た方向
+  ///  @param[out] nodes 見つかったリーフのPedigreeリスト
+  ///  @param[out] leafIDs 見つかったリーフのIDリスト
+  ///
+  void collectEdgeLeaf(const Pedigree& node, const int dir[3],
+                       std::vector<Pedigree>& nodes, std::vector<int>& leafIDs) const;
+
+};
+
+
+#endif // LINEAR_OCTREE_H
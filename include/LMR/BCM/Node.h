@@ -139,6 +139,17 @@ public:
     return childList[i];
   }
 
+  /// 子ノードを所得.
+  ///
+  ///  @param[in] i  子ノード番号(0〜7)
+  ///  @return 子ノードへのポインタ
+  ///
+  const Node* getChild(int i) const {
+    assert(childList);
+    assert(0 <= i && i < 8);
+    return childList[i];
+  }
+
 
 };
 
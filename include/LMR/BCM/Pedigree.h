@@ -191,6 +191,12 @@ public:
     return getX(level) + getY(level) * 2 + getZ(level) * 4;
   }
 
+  /// 内部64ビットデータを取得.
+  ///
+  ///   @return Pedigree値(ノード検索のキーとして使用)
+  ///
+  uint64_t getKey() const { return p; }
+
   /// シリアライズに必要なバイト数を取得.
   ///
   ///   @return バイト数
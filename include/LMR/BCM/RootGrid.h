@@ -145,6 +145,22 @@ public:
   ///  @note 隣接ルートが存在しない場合は-1を返す.
   ///
   int getNeighborRoot(int rootID, Face face) const {
+    bool periodic = (face == X_M || face == X_P) ? periodicX
+                  : (face == Y_M || face == Y_P) ? periodicY
+                  : periodicZ;
+    return getNeighborRoot(rootID, face, periodic);
+  }
+
+  /// 隣接ルートのルートIDを取得(周期境界条件を指定).
+  ///
+  ///  @param[in] rootID ルートID
+  ///  @param[in] face 隣接面
+  ///  @param[in] periodic 周期境界条件とするかどうか(周期境界フラグは参照しない)
+  ///  @return 隣接するルートのルートID
+  ///
+  ///  @note 隣接ルートが存在しない場合は-1を返す.
+  ///
+  int getNeighborRoot(int rootID, Face face, bool periodic) const {
     assert(0 <= rootID && rootID < nx*ny*nz);
     int ix = rootID2indexX(rootID);
     int iy = rootID2indexY(rootID);
@@ -154,28 +170,28 @@ public:
       case X_M:
         ix--;
         if (ix < 0) {
-          if (periodicX) ix += nx;
+          if (periodic) ix += nx;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
       case X_P:
         ix++;
         if (ix >= nx) {
-          if (periodicX) ix -= nx;
+          if (periodic) ix -= nx;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
       case Y_M:
         iy--;
         if (iy < 0) {
-          if (periodicY) iy += ny;
+          if (periodic) iy += ny;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
       case Y_P:
         iy++;
         if (iy >= ny) {
-          if (periodicY) iy -= ny;
+          if (periodic) iy -= ny;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
@@ -183,14 +199,14 @@ public:
       case Z_M:
         iz--;
         if (iz < 0) {
-          if (periodicZ) iz += nz;
+          if (periodic) iz += nz;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
       case Z_P:
         iz++;
         if (iz >= nz) {
-          if (periodicZ) iz -= nz;
+          if (periodic) iz -= nz;
           else return -1;
         }
         return index2rootID(ix, iy, iz);
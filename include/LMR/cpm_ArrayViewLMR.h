@@ -0,0 +1,96 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ArrayViewLMR.h
+ * LMR用多次元配列ビュークラスのヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_ARRAYVIEW_LMR_H_
+#define _CPM_ARRAYVIEW_LMR_H_
+
+#include "cpm_ArrayView.h"
+
+/** LMR用多次元配列ビュークラス
+ *  - _IDX_*_LMRマクロと同じ、リーフを最外とした配列を参照する
+ *  - Leaf()で取得したリーフ毎のcpm_ArrayViewを最内ループで使用する
+ */
+template<class T, CPM_ARRAY_SHAPE Layout, int VC=-1>
+class cpm_ArrayViewLMR
+{
+public:
+  /** リーフ毎のビューの型 */
+  typedef cpm_ArrayView<T, Layout, VC> LeafView;
+
+  /** デフォルトコンストラクタ */
+  cpm_ArrayViewLMR()
+  {
+    m_sl = 0;
+  }
+
+  /** コンストラクタ
+   *  @param[in] ptr      配列ポインタ
+   *  @param[in] imax     リーフのi方向の実セル数
+   *  @param[in] jmax     リーフのj方向の実セル数
+   *  @param[in] kmax     リーフのk方向の実セル数
+   *  @param[in] nmax     成分数(S3Dのとき1、V3D,V3DExのときは3固定で無視される)
+   *  @param[in] vc       仮想セル数(VCが0以上のときは無視される)
+   *  @param[in] pad_size リーフ毎のパディングサイズ(NULLのときパディングなし)
+   */
+  cpm_ArrayViewLMR( T *ptr, int imax, int jmax, int kmax, int nmax, int vc, const int *pad_size=NULL )
+    : m_leaf0( ptr, imax, jmax, kmax, nmax, vc, pad_size )
+  {
+    m_sl = ptrdiff_t(m_leaf0.Size());
+  }
+
+  /** リーフのビューの取得
+   *  @param[in] leafIdx ローカルリーフ順番号(0～)
+   *  @return リーフのビュー
+   */
+  LeafView Leaf( int leafIdx ) const
+  {
+    return m_leaf0.Shift( ptrdiff_t(leafIdx) * m_sl );
+  }
+
+  /** 要素の参照(S3D、Ex形式のときは成分0)
+   *  @return 要素の参照
+   */
+  T& operator()( int i, int j, int k, int leafIdx ) const
+  {
+    return *(m_leaf0.Cell(i, j, k) + ptrdiff_t(leafIdx) * m_sl);
+  }
+
+  /** 要素の参照(S4D,V3Dは(i,j,k,n,leaf)、S4DEx,V3DExは(n,i,j,k,leaf)の順)
+   *  @return 要素の参照
+   */
+  T& operator()( int a0, int a1, int a2, int a3, int leafIdx ) const
+  {
+    return *(&m_leaf0(a0, a1, a2, a3) + ptrdiff_t(leafIdx) * m_sl);
+  }
+
+  /** リーフ間のストライドの取得
+   *  @return リーフ1個分の要素数
+   */
+  ptrdiff_t StrideLeaf() const { return m_sl; }
+
+protected:
+  LeafView  m_leaf0; ///< 先頭リーフのビュー
+  ptrdiff_t m_sl;    ///< リーフ間のストライド
+};
+
+#endif /* _CPM_ARRAYVIEW_LMR_H_ */
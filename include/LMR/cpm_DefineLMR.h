@@ -104,6 +104,15 @@
  */
 #define _IDX_V3DEX_LMR(_N,_I,_J,_K,_IL,_NI,_NJ,_NK,_VC) (_IDX_S4DEX_LMR(_N,_I,_J,_K,_IL,3,_NI,_NJ,_NK,_VC))
 
+/** 隣接方向(dx,dy,dz) -> 方向番号変換マクロ
+ *  - 3x3x3の近傍の通し番号(0～26、13は自身)で、面、辺、頂点方向を表す
+ *  @param[in] _DX x方向(-1,0,1)
+ *  @param[in] _DY y方向(-1,0,1)
+ *  @param[in] _DZ z方向(-1,0,1)
+ *  @return 方向番号
+ */
+#define _LMR_DIR_IDX(_DX,_DY,_DZ) ( ((_DX)+1) + 3*((_DY)+1) + 9*((_DZ)+1) )
+
 
 
 
@@ -184,6 +184,45 @@ public:
    */
   stCommInfo* SearchDistCommInfo(stCommInfo *commInfo);
 
+  /** 通信情報毎のバッファオフセットの計算
+   *  - 成分数1、通信層数1～maxVCについて、周期境界フラグ毎に各通信情報の
+   *    送受信バッファ内の先頭位置を計算しておく
+   *  - SetBndCommBufferからコールされる
+   *  @param[in] sz_face   1リーフの格子数(平面内２軸)
+   *  @param[in] maxVC     送受信バッファの最大袖数
+   */
+  void SetCommOffset( size_t sz_face[2], size_t maxVC );
+
+  /** 通信情報毎の送信バッファオフセットの取得
+   *  - 戻り値offに対し、j番目の通信情報のデータは送信バッファのnmax*off[j]から
+   *    nmax*(off[j+1]-off[j])ワードとなる(bPeriodicが一致しない通信情報はサイズ0)
+   *  - 面内格子数、通信層数が計算済みの条件と異なる場合はworkに計算して返す
+   *  @param[in]    sz_face   1リーフの格子数(平面内２軸)
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    bPeriodic 周期境界フラグ
+   *  @param[inout] work      作業領域
+   *  @return オフセット配列(通信情報数+1)
+   */
+  const size_t* GetSendOffset( size_t sz_face[2], size_t vc_comm, bool bPeriodic, std::vector<size_t> &work )
+  {
+    return GetCommOffset( true, sz_face, vc_comm, bPeriodic, work );
+  }
+
+  /** 通信情報毎の受信バッファオフセットの取得
+   *  - 戻り値offに対し、j番目の通信情報のデータは受信バッファのnmax*off[j]から
+   *    nmax*(off[j+1]-off[j])ワードとなる(bPeriodicが一致しない通信情報はサイズ0)
+   *  - 面内格子数、通信層数が計算済みの条件と異なる場合はworkに計算して返す
+   *  @param[in]    sz_face   1リーフの格子数(平面内２軸)
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    bPeriodic 周期境界フラグ
+   *  @param[inout] work      作業領域
+   *  @return オフセット配列(通信情報数+1)
+   */
+  const size_t* GetRecvOffset( size_t sz_face[2], size_t vc_comm, bool bPeriodic, std::vector<size_t> &work )
+  {
+    return GetCommOffset( false, sz_face, vc_comm, bPeriodic, work );
+  }
+
 
 
 protected:
@@ -197,6 +236,26 @@ protected:
    */
   void Qsort( int type, std::vector<stCommInfo*> &vecCommInfo, int startIndex, int endIndex );
 
+  /** 通信情報毎のバッファオフセットの取得
+   *  @param[in]    bSend     送信バッファ(true)か受信バッファ(false)か
+   *  @param[in]    sz_face   1リーフの格子数(平面内２軸)
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    bPeriodic 周期境界フラグ
+   *  @param[inout] work      作業領域
+   *  @return オフセット配列(通信情報数+1)
+   */
+  const size_t* GetCommOffset( bool bSend, size_t sz_face[2], size_t vc_comm, bool bPeriodic
+                             , std::vector<size_t> &work );
+
+  /** 通信情報毎のバッファオフセットを計算
+   *  @param[in]  bSend     送信バッファ(true)か受信バッファ(false)か
+   *  @param[in]  sz_face   1リーフの格子数(平面内２軸)
+   *  @param[in]  vc_comm   通信する仮想セル数
+   *  @param[in]  bPeriodic 周期境界フラグ
+   *  @param[out] off       オフセット配列(通信情報数+1)
+   */
+  void CalcCommOffset( bool bSend, size_t sz_face[2], size_t vc_comm, bool bPeriodic, size_t *off );
+
 
 
 
@@ -231,6 +290,18 @@ protected:
   /// 受信バッファサイズ(WORD数)
   size_t m_CommRecvBufSize;
 
+  /// オフセット計算済みの面内格子数
+  size_t m_offsetFace[2];
+
+  /// オフセット計算済みの最大袖数
+  size_t m_offsetVC;
+
+  /// 送信バッファオフセット(成分数1、[周期境界フラグ][(通信層数-1)*(通信情報数+1)+通信情報番号])
+  std::vector<size_t> m_sendOffset[2];
+
+  /// 受信バッファオフセット(成分数1、[周期境界フラグ][(通信層数-1)*(通信情報数+1)+通信情報番号])
+  std::vector<size_t> m_recvOffset[2];
+
 
 };
 
@@ -28,6 +28,7 @@
 #include "cpm_BaseParaManager.h"
 #include "cpm_VoxelInfoLMR.h"
 #include "cpm_LeafCommInfo.h"
+#include "cpm_ArrayViewLMR.h"
 
 /** プロセスグループ毎のVOXEL空間情報管理マップ */
 //typedef std::map<int, cpm_VoxelInfoLMR*> LeafMap; //map<leafID,VoxelInfo*> -> cpm_VoxelInfoLMR.h
@@ -39,6 +40,81 @@ typedef std::map<int, cpm_LeafCommInfo*> LeafCommInfoMap; //map<distRankNo,cpm_L
 /** 全プロセスグループの袖通信情報マップ */
 typedef std::map<int, LeafCommInfoMap> BndCommInfoMap;  //map<procGrpID,LeafCommInfoMap>
 
+/** 集約袖通信の通信相手ランク毎の情報 */
+struct stAggCommInfo
+{
+  /// 送信バッファ
+  std::vector<REAL_BUF_TYPE> sendbuf;
+
+  /// 受信バッファ
+  std::vector<REAL_BUF_TYPE> recvbuf;
+
+  /// 送信リクエストID
+  MPI_Request reqSend;
+
+  /// 受信リクエストID
+  MPI_Request reqRecv;
+
+  /// コンストラクタ
+  stAggCommInfo()
+  {
+    reqSend = MPI_REQUEST_NULL;
+    reqRecv = MPI_REQUEST_NULL;
+  }
+};
+
+/** プロセスグループ内の集約袖通信情報マップ */
+typedef std::map<int, stAggCommInfo> AggCommInfoMap; //map<distRankNo,stAggCommInfo>
+
+/** 全プロセスグループの集約袖通信情報マップ */
+typedef std::map<int, AggCommInfoMap> BndAggCommInfoMap; //map<procGrpID,AggCommInfoMap>
+
+/** 辺、頂点方向の袖通信の1リーフペア分の情報 */
+struct stEdgeCommPath
+{
+  int iRecvLeafID; ///< 受信側リーフ番号
+  int iSendLeafID; ///< 送信側リーフ番号
+  int iDir;        ///< 受信側から見た方向番号(_LMR_DIR_IDX)
+  int iLevelDiff;  ///< 受信側から見たレベル差(送信側のレベル-受信側のレベル)
+  int iOffset[3];  ///< 受信側リーフ原点から見た送信側リーフの原点位置(細かい方のリーフの大きさ単位)
+  int iPeriodic;   ///< 周期境界を越える軸のビットフラグ(0のとき内部の隣接)
+};
+
+/** 辺、頂点方向の袖通信の通信相手ランク毎の情報 */
+struct stEdgeCommInfo
+{
+  /// 送信パス(相手ランクの受信パスと同じ並び)
+  std::vector<stEdgeCommPath> sendPath;
+
+  /// 受信パス(自ランクのリーフ順、方向番号順)
+  std::vector<stEdgeCommPath> recvPath;
+
+  /// 送信バッファ
+  std::vector<REAL_BUF_TYPE> sendbuf;
+
+  /// 受信バッファ
+  std::vector<REAL_BUF_TYPE> recvbuf;
+
+  /// 送信リクエストID
+  MPI_Request reqSend;
+
+  /// 受信リクエストID
+  MPI_Request reqRecv;
+
+  /// コンストラクタ
+  stEdgeCommInfo()
+  {
+    reqSend = MPI_REQUEST_NULL;
+    reqRecv = MPI_REQUEST_NULL;
+  }
+};
+
+/** プロセスグループ内の辺、頂点方向の袖通信情報マップ(自ランク宛はランク内コピー) */
+typedef std::map<int, stEdgeCommInfo> EdgeCommInfoMap; //map<distRankNo,stEdgeCommInfo>
+
+/** 全プロセスグループの辺、頂点方向の袖通信情報マップ */
+typedef std::map<int, EdgeCommInfoMap> BndEdgeCommInfoMap; //map<procGrpID,EdgeCommInfoMap>
+
 
 /** LMR用の並列管理クラス
  *  - 現時点ではユーザがインスタンスすることを許していない
@@ -67,16 +143,26 @@ public:
 
   /** LMR用の領域分割
    *  - FXgen出力の領域情報ファイル、木情報ファイルを渡して領域分割情報を生成する
+   *  - リーフは木情報ファイルのリーフ順(空間充填曲線順)に、連続した範囲で各ランクに割り当てる
+   *  - leafWeightを指定した場合は、重みの累積和が均等になるように分割する
+   *    (固体率、レベル毎のサブサイクル数、境界処理量などを重みとして与える)
+   *  - cutTolが正のとき、各ランクの重みが平均の(1+cutTol)倍を超えない範囲で
+   *    分割位置をずらし、ランク間の隣接リーフ面の数を減らす
    *
-   *  @param[in] treeFile  木情報ファイル
-   *  @param[in] maxVC     最大の袖数(袖通信用)
-   *  @param[in] maxN      最大の成分数(袖通信用)
-   *  @param[in] procGrpNo 領域分割を行うプロセスグループ番号
+   *  @param[in]  treeFile   木情報ファイル
+   *  @param[in]  maxVC      最大の袖数(袖通信用)
+   *  @param[in]  maxN       最大の成分数(袖通信用)
+   *  @param[in]  procGrpNo  領域分割を行うプロセスグループ番号
+   *  @param[in]  leafWeight リーフ毎の重み(全リーフ数分、全ランクで同じ値、NULLのとき均等)
+   *  @param[in]  cutTol     分割位置調整時の負荷不均衡の許容率(0以下のとき調整しない)
+   *  @param[out] partInfo   分割の統計情報(負荷不均衡率、ランク間の隣接リーフ面数、NULLのとき出力しない)
    *  @return 終了コード(CPM_SUCCESS=正常終了)
    */
   virtual
   cpm_ErrorCode VoxelInit_LMR( std::string treeFile
-                             , size_t maxVC=1, size_t maxN=3, int procGrpNo=0 );
+                             , size_t maxVC=1, size_t maxN=3, int procGrpNo=0
+                             , const double *leafWeight=NULL, double cutTol=0.0
+                             , S_LMR_PARTITION_INFO *partInfo=NULL );
 
   /** 木情報ファイルからリーフ数を取得する
    *  @param[in] treeFile  木情報ファイル
@@ -85,6 +171,154 @@ public:
   static
   int GetNumLeaf( std::string treeFile );
 
+  /** 木情報ファイルからリーフ数を取得する
+   *  - ランク0のみが読み込み、全ランクにブロードキャストする(commの全ランクでコール)
+   *  @param[in] comm      MPIコミュニケータ
+   *  @param[in] treeFile  木情報ファイル
+   *  @return    リーフ数
+   */
+  static
+  int GetNumLeaf( MPI_Comm comm, std::string treeFile );
+
+  /** LMR用のリーフ再分割
+   *  - 新しいリーフ毎の重みでVoxelInit_LMRと同じ方法でリーフ分割をやり直し、
+   *    リーフ毎のVOXEL空間情報と袖通信情報を再生成する(プロセスグループ内の全ランクでコール)
+   *  - 分割が変わらない場合は何もしない
+   *  - 再分割後、VoxelInit_LMRの分割で確保した配列はMigrateLeafArray_LMRで
+   *    新しい担当リーフの配列に移動する(次の再分割までに移動すること)
+   *  - 袖通信中(BndComm*_nowait後、wait前)にコールしてはいけない
+   *
+   *  @param[in]  leafWeight リーフ毎の重み(全リーフ数分、全ランクで同じ値、NULLのとき均等)
+   *  @param[in]  cutTol     分割位置調整時の負荷不均衡の許容率(0以下のとき調整しない)
+   *  @param[out] partInfo   分割の統計情報(NULLのとき出力しない)
+   *  @param[in]  procGrpNo  プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Rebalance_LMR( const double *leafWeight, double cutTol=0.0
+                             , S_LMR_PARTITION_INFO *partInfo=NULL, int procGrpNo=0 );
+
+  /** 直前のRebalance_LMRでリーフの担当ランクが変わったかどうか
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @retval    true      担当ランクが変わったリーフがある
+   *  @retval    false     変わっていない、またはRebalance_LMR未実行
+   */
+  bool IsLeafMigrated( int procGrpNo=0 );
+
+  /** リーフ毎の配列サイズ(要素数)の取得
+   *  - Alloc*で確保した配列の1リーフ分の要素数
+   *  @param[in] nmax      成分数
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 1リーフ分の要素数
+   */
+  size_t GetLeafArrayLength( int nmax, int vc, int procGrpNo=0 );
+
+  /** リーフデータの移動(MPI_Datatype指定)
+   *  - 直前のRebalance_LMRの前後の担当リーフ範囲から、リーフ単位でAlltoallvを行う
+   *  - sendArrayは再分割前、recvArrayは再分割後の担当リーフ数分の領域とする
+   *  - リーフ毎のデータが連続していれば配列形状(S4D,S4DEx等)は問わない
+   *
+   *  @param[in]  dtype     データのMPI_Datatype
+   *  @param[in]  sendArray 再分割前の配列
+   *  @param[out] recvArray 再分割後の配列
+   *  @param[in]  nwLeaf    1リーフ分の要素数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode MigrateLeafData( MPI_Datatype dtype, const void *sendArray, void *recvArray
+                               , size_t nwLeaf, int procGrpNo=0 );
+
+  /** リーフ毎の配列の移動
+   *  - Alloc*で確保した配列を、直前のRebalance_LMR後の担当リーフの配列に置き換える
+   *  - 担当ランクが変わっていない場合は何もしない
+   *  - 元の配列は解放し、arrayに新しく確保した配列をセットする
+   *  - arrayがRegisterFieldで登録されているときは登録を新しい配列に移す(仮想セルは最新でないとする)
+   *
+   *  @param[inout] array     Alloc*で確保した配列
+   *  @param[in]    nmax      成分数
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode MigrateLeafArray_LMR( T *&array, int nmax, int vc, int procGrpNo=0 )
+  {
+    if( !IsLeafMigrated(procGrpNo) )
+    {
+      return CPM_SUCCESS;
+    }
+
+    size_t nwLeaf = GetLeafArrayLength(nmax, vc, procGrpNo);
+    size_t nw = nwLeaf * size_t(GetLocalNumLeaf(procGrpNo));
+    T *newArray = (nw > 0) ? new T[nw] : NULL;
+    cpm_ErrorCode ret = MigrateLeafData(GetMPI_Datatype(array), array, newArray, nwLeaf, procGrpNo);
+    if( ret != CPM_SUCCESS )
+    {
+      delete [] newArray;
+      return ret;
+    }
+
+    moveField( array, newArray );
+    delete [] array;
+    array = newArray;
+    return CPM_SUCCESS;
+  }
+
+  /** LMR用のリーフの細分化、粗大化
+   *  - 自ランクのリーフ毎のフラグ(1:細分化、-1:粗大化、0:そのまま)から木情報を更新し、
+   *    リーフ毎のVOXEL空間情報と袖通信情報を再生成する(プロセスグループ内の全ランクでコール)
+   *  - 細分化したリーフは8つの子リーフ(子番号順)に、粗大化は兄弟の8リーフを親リーフに置き換える
+   *  - 兄弟の8リーフがランクをまたぐとき、隣接リーフとのレベル差が2以上になるときは
+   *    粗大化しない。レベル差が2以上になる隣接リーフは細分化する
+   *  - 新しいリーフは元のリーフの担当ランクが担当するため、データの移動はランク内で完結する
+   *    (負荷の偏りはRebalance_LMRで調整する)
+   *  - 更新後、VoxelInit_LMRの分割で確保した配列はAdaptLeafArray_LMR,AdaptLeafArrayEx_LMRで
+   *    新しいリーフの配列に置き換える(次の更新までに置き換えること)
+   *  - リーフの格子数は偶数とする(奇数のときは通信、状態の変更をせずCPM_ERROR_LMR_ADAPTを返す)
+   *
+   *  @param[inout] leafFlag  自ランクのリーフ毎のフラグ(GetLocalNumLeaf個)、
+   *                          2:1制約等で調整した、実際に行った操作に更新される
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Adapt_LMR( int *leafFlag, int procGrpNo=0 );
+
+  /** 直前のAdapt_LMRで自ランクのリーフが変わったかどうか
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @retval    true      自ランクに細分化、粗大化したリーフがある
+   *  @retval    false     変わっていない、またはAdapt_LMR未実行
+   */
+  bool IsLeafAdapted( int procGrpNo=0 );
+
+  /** リーフ毎の配列の細分化、粗大化(S3D,S4D,V3D版)
+   *  - Alloc*で確保した(imax,jmax,kmax,nmax,nLeaf)の形式の配列を、
+   *    直前のAdapt_LMR後のリーフの配列に置き換える
+   *  - 細分化は親セルの値を子セルにコピー、粗大化は子セル8個の平均とする
+   *  - 細分化、粗大化したリーフの仮想セルは0とする(BndComm等で更新すること)
+   *  - 元の配列は解放し、arrayに新しく確保した配列をセットする
+   *  - arrayがRegisterFieldで登録されているときは登録を新しい配列に移す(仮想セルは最新でないとする)
+   *
+   *  @param[inout] array     Alloc*で確保した配列
+   *  @param[in]    nmax      成分数
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode AdaptLeafArray_LMR( T *&array, int nmax, int vc, int procGrpNo=0 );
+
+  /** リーフ毎の配列の細分化、粗大化(S4DEx,V3DEx版)
+   *  - (nmax,imax,jmax,kmax,nLeaf)の形式の配列を対象とする以外はAdaptLeafArray_LMRと同じ
+   *
+   *  @param[inout] array     Alloc*で確保した配列
+   *  @param[in]    nmax      成分数
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode AdaptLeafArrayEx_LMR( T *&array, int nmax, int vc, int procGrpNo=0 );
+
 
 
 
@@ -142,6 +376,20 @@ public:
    */
   int GetLocalLeafIndex_byID( int leafID, int procGrpNo=0 );
 
+  /** 座標の担当ランク、リーフ、ローカルインデクスの一括検索
+   *  - 最大レベルのぺディグリーから座標を含むリーフを木探索し、担当ランクとリーフ内のインデクスを求める
+   *  - 通信は行わない(全ランクの座標を検索できる)
+   *  - 全体領域の上端の座標は端のセルに含める
+   *
+   *  @param[in]  num       点の数
+   *  @param[in]  pos       座標(3word/点)
+   *  @param[out] loc       検索結果(num個、leafは担当ランク内のリーフ順番号、計算領域外のときrank,leaf,indexは-1)
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode LocatePoints( int num, const double *pos, S_POINT_LOCATION *loc, int procGrpNo=0 );
+
   /** 領域分割数を取得(指定リーフのレベルにおける値)
    *  @param[in] leafIndex リーフ順番号(0~)
    *  @param[in] procGrpNo プロセスグループ番号(省略時=0)
@@ -295,6 +543,18 @@ public:
    */
   bool IsInnerBoundary( int leafIndex, cpm_FaceFlag face, int procGrpNo=0 );
 
+  /** 指定リーフの辺、頂点方向の隣接リーフ情報を取得
+   *  - 周期境界を越える隣接も含む(S_LMR_EDGE_NEIGHBOR::periodicで区別する)
+   *  @param[in]  leafIndex リーフ順番号(0~)
+   *  @param[in]  dx        x方向(-1,0,1)
+   *  @param[in]  dy        y方向(-1,0,1)
+   *  @param[in]  dz        z方向(-1,0,1)
+   *  @param[out] num       隣接リーフ数(辺は1 or 2、頂点は0 or 1)
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 隣接リーフ情報配列のポインタ
+   */
+  const S_LMR_EDGE_NEIGHBOR* GetEdgeNeighborList( int leafIndex, int dx, int dy, int dz, int &num, int procGrpNo=0 );
+
 
 
 
@@ -320,6 +580,56 @@ public:
   cpm_ErrorCode
   SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo=0 );
 
+  /** 集約袖通信モードのセット
+   *  - trueのとき、BndCommS3D,V3D,S4D,V3DEx,S4DEx(_nowait,wait_を含む)は
+   *    通信相手ランク毎に6面分のデータを1つのバッファにまとめ、1回の送受信で袖通信を行う
+   *  - 通常モードはX,Y,Zの順に方向毎に通信を完了させるため、後の方向の送信データに
+   *    前の方向で受信した袖が含まれ、辺、頂点の袖も隣接リーフ経由で更新される
+   *  - 集約モードでは全方向を同時に送信するため、面の袖は面内方向の実セル範囲のみを
+   *    更新し、辺、頂点の袖はSetBndCommEdgeの設定によらず辺、頂点方向のデータを
+   *    同じバッファに連結して更新する(通信相手ランク毎の送受信は1回のみ。
+   *    辺、頂点袖通信の制約はSetBndCommEdgeを参照)
+   *  - 周期境界袖通信(PeriodicComm*)は対象外
+   *  @param[in] bAggregate 集約袖通信モード(true:集約、false:方向毎(既定))
+   */
+  void SetBndCommAggregate( bool bAggregate )
+  {
+    m_bBndCommAggregate = bAggregate;
+  }
+
+  /** 集約袖通信モードの取得
+   *  @retval true  集約袖通信モード
+   *  @retval false 方向毎の袖通信モード
+   */
+  bool IsBndCommAggregate() const
+  {
+    return m_bBndCommAggregate;
+  }
+
+  /** 辺、頂点袖通信モードのセット
+   *  - trueのとき、BndCommS3D,V3D,S4D,V3DEx,S4DEx(_nowait,wait_を含む)で
+   *    辺、頂点方向の隣接リーフと直接袖通信を行い、辺、頂点の袖を更新する
+   *  - 送信データは送信側リーフの内部セルのみから作成するため、面の袖通信と同時に行い、
+   *    集約袖通信モードと組み合わせて1回の通信で27点ステンシルの袖をそろえられる
+   *  - レベル差がある場合、細→粗はセル平均、粗→細は粗いセル値のコピーとする
+   *  - vc_comm*2^|レベル差|がリーフの格子数以下である必要がある
+   *  - 周期境界を越える辺、頂点はPeriodicCommEdgeS4D,S4DExで通信する
+   *  @param[in] bEdge 辺、頂点袖通信モード(true:行う、false:行わない(既定))
+   */
+  void SetBndCommEdge( bool bEdge )
+  {
+    m_bBndCommEdge = bEdge;
+  }
+
+  /** 辺、頂点袖通信モードの取得
+   *  @retval true  辺、頂点袖通信を行う
+   *  @retval false 辺、頂点袖通信を行わない
+   */
+  bool IsBndCommEdge() const
+  {
+    return m_bBndCommEdge;
+  }
+
   /** 袖通信(Scalar3D版)
    *  - (imax,jmax,kmax,nLeaf)の形式の配列の袖通信を行う
    *
@@ -974,6 +1284,146 @@ public:
   cpm_ErrorCode PeriodicCommS4DEx( MPI_Datatype dtype, void *array, int nmax, int imax, int jmax, int kmax
                                  , int vc, int vc_comm, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo=0 );
 
+  /** 辺、頂点方向の周期境界袖通信(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax,nLeaf)の形式の配列の、周期境界を越える辺、頂点方向の袖通信を行う
+   *  - 越える軸がすべてperiodicMaskに含まれる隣接のみ通信する
+   *  - 面方向の周期境界袖通信(PeriodicCommS4D)の後に呼び出す
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    periodicMask 周期境界の軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode PeriodicCommEdgeS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , int periodicMask, int procGrpNo=0 );
+
+  /** 辺、頂点方向の周期境界袖通信(Scalar4DEx版)
+   *  - (nmax,imax,jmax,kmax,nLeaf)の形式の配列の、周期境界を越える辺、頂点方向の袖通信を行う
+   *  - 越える軸がすべてperiodicMaskに含まれる隣接のみ通信する
+   *  - 面方向の周期境界袖通信(PeriodicCommS4DEx)の後に呼び出す
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    periodicMask 周期境界の軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode PeriodicCommEdgeS4DEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+                                     , int periodicMask, int procGrpNo=0 );
+
+  /** 逆方向袖通信(Scalar3D版)
+   *  - (imax,jmax,kmax,nLeaf)の形式の配列の仮想セルの値を隣接リーフの内部セルへ送り、op で集約する
+   *  - 順方向の袖通信(BndCommS3D,PeriodicCommS3D)の逆操作で、Z,Y,X方向の順に集約する
+   *  - レベル差のある面では、順方向の平均(fine->coarse)の逆操作として1/8ずつ配分し、
+   *    複写(coarse->fine)の逆操作として8cellを集約する(CPM_SUMのとき総和は保存される)
+   *  - CPM_SUMのときは送信した仮想セルを0にする(CPM_MIN,CPM_MAXのときは変更しない)
+   *  - 辺、頂点方向の袖通信、集約袖通信の設定によらず面方向の通信で処理する
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、周期境界の通信情報でも集約する)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0 );
+
+  /** 逆方向袖通信(Vector3D版)
+   *  - (imax,jmax,kmax,3,nLeaf)の形式の配列の逆方向袖通信を行う
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、周期境界の通信情報でも集約する)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommV3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0 );
+
+  /** 逆方向袖通信(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax,nLeaf)の形式の配列の逆方向袖通信を行う
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、周期境界の通信情報でも集約する)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0 );
+
+  /** 非同期版逆方向袖通信(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax,nLeaf)の形式の配列の逆方向袖通信を開始する
+   *  - 方向毎の集約に依存関係があるため、ここではZ方向の送受信のみ開始し、
+   *    以降の方向はwait_BndCommS4D_Reverseで順に処理する
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、周期境界の通信情報でも集約する)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                         , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0 );
+
+  /** 非同期版逆方向袖通信のwait、集約(Scalar4D版)
+   *  - BndCommS4D_Reverse_nowaitと同じ引数で呼び出す
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、周期境界の通信情報でも集約する)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                       , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0 );
+
 
 
 
@@ -985,6 +1435,22 @@ protected:
   /** デストラクタ */
   virtual ~cpm_ParaManagerLMR();
 
+  /** 袖通信情報の削除
+   *  @param[in] procGrpNo プロセスグループ番号
+   */
+  void ClearBndCommInfo( int procGrpNo );
+
+  /** リーフ毎の配列の細分化、粗大化
+   *  @param[inout] array     Alloc*で確保した配列
+   *  @param[in]    nmax      成分数
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode adaptLeafArray( T *&array, int nmax, int vc, bool bEx, int procGrpNo );
+
   /** 配列確保(double)
    *  @param[in] nmax 成分数
    *  @param[in] sz   配列サイズ
@@ -1015,6 +1481,31 @@ protected:
   virtual
   int* AllocInt( int nmax, int sz[3], int vc, int procGrpNo );
 
+  /** 粒子の移動先ランクの判定
+   *  - 周期境界を補正した位置をLocatePointsで検索し、担当ランク番号を求める
+   *  - 周期境界を越える位置は全体領域内[始点,終点)に補正する(丸め誤差で端面に一致するときは始点とする)
+   *
+   *  @param[in]    num          位置の数
+   *  @param[inout] pos          位置(3word/個)
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[out]   rank         移動先のランク番号(計算領域外のとき-1)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode FindParticleRank( int num, double *pos, int periodicFlag, int *rank, int procGrpNo );
+
+  /** 粒子を送受信する隣接ランクリストの取得
+   *  - 自ランクの各リーフの面、辺、頂点方向の隣接リーフのランク番号(自ランクを除く)
+   *
+   *  @param[out] rankList     隣接ランク番号のリスト
+   *  @param[in]  periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[in]  procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode GetParticleNeighborRank( std::vector<int> &rankList, int periodicFlag, int procGrpNo );
+
   /** １方向の非同期受信処理
    *  @param[in]  commInfoMap 通信情報マップ
    *  @param[in]  sz_face     面内の格子数
@@ -1066,6 +1557,48 @@ protected:
                         , LeafCommInfoMap &commInfoMapM, LeafCommInfoMap &commInfoMapP
                         , bool bPeriodic, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo=0 );
 
+  /** 袖通信のランク内コピー処理(リーフ間の直接コピー)
+   *  - 送信側リーフから受信側リーフの袖へ、中間バッファを介さずにコピーする
+   *  - レベル差がある場合は、fine->coarseの平均化(8cell->1cell)、
+   *    coarse->fineの展開(1cell->8cell)を同時に行う
+   *  - リーフペア単位でOpenMP並列に処理する
+   *  @param[inout] array          袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax           配列サイズ(I方向)
+   *  @param[in]    jmax           配列サイズ(J方向)
+   *  @param[in]    kmax           配列サイズ(K方向)
+   *  @param[in]    nmax           配列サイズ(成分数)
+   *  @param[in]    vc             仮想セル数
+   *  @param[in]    vc_comm        通信する仮想セル数
+   *  @param[in]    pLeafCommInfoM ランク内の通信情報(マイナス側)
+   *  @param[in]    pLeafCommInfoP ランク内の通信情報(プラス側)
+   *  @param[in]    bPeriodic      周期境界フラグ(true:周期境界通信、false:内部袖通信のみ)
+   *  @param[in]    dir            通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]    pm             通信する正負方向(PLUS2MINUS or MINUS2PLUS or BOTH)
+   *  @param[in]    procGrpNo      プロセスグループ番号
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  cpm_ErrorCode copyDirect_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                              , cpm_LeafCommInfo* pLeafCommInfoM, cpm_LeafCommInfo* pLeafCommInfoP
+                              , bool bPeriodic, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo=0 );
+
+  /** 袖通信の１リーフペア分のランク内直接コピー
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    dstInfo   受信側リーフの通信情報
+   *  @param[in]    srcInfo   送信側リーフの通信情報(dstInfoの対)
+   *  @param[in]    face      受信側リーフの袖の面方向
+   *  @param[in]    procGrpNo プロセスグループ番号
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  cpm_ErrorCode copyLeaf_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                            , cpm_LeafCommInfo::stCommInfo* dstInfo, cpm_LeafCommInfo::stCommInfo* srcInfo
+                            , cpm_FaceFlag face, int procGrpNo=0 );
+
   /** 袖通信(Scalar3D,4D,Vector3D版)の１面の受信待機とデータの展開
    *  @param[in]  array       袖通信をする配列の先頭ポインタ
    *  @param[in]  imax        配列サイズ(I方向)
@@ -1090,13 +1623,408 @@ protected:
   template<class T>
   cpm_ErrorCode send_LMR_wait( LeafCommInfoMap &commInfoMap );
 
+  /** 逆方向袖通信の１方向の受信の開始、仮想セルのパックと送信、ランク内の集約
+   *  - 順方向の送信バッファで受信し、順方向の受信バッファから送信する
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    dir       通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]    bPeriodic 周期境界フラグ(true:周期境界通信、false:内部袖通信のみ)
+   *  @param[in]    op        集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode sendrecvReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , cpm_DirFlag dir, bool bPeriodic, CPM_Op op, int procGrpNo=0 );
+
+  /** 逆方向袖通信の１方向の受信待機と内部セルへの集約、送信待機
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    dir       通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]    bPeriodic 周期境界フラグ(true:周期境界通信、false:内部袖通信のみ)
+   *  @param[in]    op        集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode waitReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                               , cpm_DirFlag dir, bool bPeriodic, CPM_Op op, int procGrpNo=0 );
+
+  /** 逆方向袖通信の１通信面分の仮想セルのパック(順方向の展開の逆操作)
+   *  - 順方向の受信データと同じ並びのバッファへ集約し、和のときは仮想セルを0にする
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    commInfo  仮想セル側リーフの通信情報
+   *  @param[in]    face      仮想セル側リーフの面方向
+   *  @param[in]    op        集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[out]   buf       バッファ
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode packReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                               , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face, CPM_Op op
+                               , T* buf, int procGrpNo=0 );
+
+  /** 逆方向袖通信の１通信面分の内部セルへの集約(順方向のパックの逆操作)
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    commInfo  内部セル側リーフの通信情報
+   *  @param[in]    face      内部セル側リーフの面方向
+   *  @param[in]    op        集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    buf       バッファ(順方向の送信データと同じ並び)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode unpackReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                 , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face, CPM_Op op
+                                 , const T* buf, int procGrpNo=0 );
+
+  /** 指定面の袖通信情報マップの取得
+   *  @param[in]  face      面方向
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 袖通信情報マップのポインタ(未生成のときNULL)
+   */
+  LeafCommInfoMap* FindLeafCommInfoMap( cpm_FaceFlag face, int procGrpNo=0 );
+
+  /** 集約袖通信の通信相手情報マップの取得
+   *  - 初回呼出し時に6面と辺、頂点方向の袖通信情報マップから自ランク以外の通信相手を集めて生成する
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 集約袖通信情報マップのポインタ(袖通信情報が未生成のときNULL)
+   */
+  AggCommInfoMap* GetAggCommInfoMap( int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信情報の生成
+   *  - 自ランクのリーフの受信パスを通信相手ランクに送り、相手ランクの送信パスとする
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode SetBndEdgeCommInfo( int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信情報マップの取得
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 袖通信情報マップのポインタ(未生成のときNULL)
+   */
+  EdgeCommInfoMap* FindEdgeCommInfoMap( int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信パスの通信範囲を取得
+   *  - 受信側リーフの袖のうち、送信側リーフが覆う範囲を受信側のインデクスで返す
+   *  - 送信側のインデクスは、レベル差<=0のとき(i+so)/r、レベル差>0のときi*r+so～i*r+so+r-1
+   *    (rは2^|レベル差|)
+   *  @param[in]  path    通信パス
+   *  @param[in]  sz      リーフの格子数
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  vc_comm 通信する仮想セル数
+   *  @param[out] rs      受信側の始点インデクス
+   *  @param[out] re      受信側の終点インデクス+1
+   *  @param[out] so      送信側インデクスへのオフセット
+   *  @return 通信範囲があればtrue
+   */
+  static bool GetEdgeCommRange( const stEdgeCommPath &path, const int sz[3], int vc, int vc_comm
+                              , int rs[3], int re[3], int so[3] );
+
+  /** 辺、頂点方向の袖通信パスを通信するかどうか
+   *  @param[in]  path         通信パス
+   *  @param[in]  periodicMask 周期境界の軸のビットフラグ(0のとき内部の隣接のみ)
+   *  @return 通信するときtrue
+   */
+  static bool IsEdgeCommTarget( const stEdgeCommPath &path, int periodicMask )
+  {
+    if( periodicMask == 0 )
+    {
+      return path.iPeriodic == 0;
+    }
+    return path.iPeriodic != 0 && (path.iPeriodic & ~periodicMask) == 0;
+  }
+
+  /** 辺、頂点方向の袖通信の1パス分のパック
+   *  - 受信側の袖の範囲を[n][k][j][i]の順に並べる(細→粗はセル平均を送る)
+   *  @param[in]  array     袖通信をする配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  vc_comm   通信する仮想セル数
+   *  @param[in]  path      通信パス
+   *  @param[out] buf       送信バッファ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  cpm_ErrorCode packEdge_LMR( const T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                            , const stEdgeCommPath &path, T *buf, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信の1パス分の展開
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    path      通信パス
+   *  @param[in]    buf       受信バッファ
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  cpm_ErrorCode unpackEdge_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                              , const stEdgeCommPath &path, const T *buf, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信パス毎のデータ数と先頭位置を取得
+   *  @param[in]  paths        通信パスリスト
+   *  @param[in]  sz           リーフの格子数
+   *  @param[in]  nmax         配列サイズ(成分数)
+   *  @param[in]  vc           仮想セル数
+   *  @param[in]  vc_comm      通信する仮想セル数
+   *  @param[in]  periodicMask 周期境界の軸のビットフラグ(0のとき内部の隣接のみ)
+   *  @param[out] offset       パス毎の先頭位置(パス数+1個、通信しないパスはデータ数0)
+   *  @return 総データ数
+   */
+  static size_t GetEdgeCommOffset( const std::vector<stEdgeCommPath> &paths, const int sz[3], int nmax
+                                 , int vc, int vc_comm, int periodicMask, std::vector<size_t> &offset );
+
+  /** 辺、頂点方向の袖通信の通信相手1ランク分のパック
+   *  @param[in]  array     袖通信をする配列の先頭ポインタ
+   *  @param[in]  bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  vc_comm   通信する仮想セル数
+   *  @param[in]  paths     送信パスリスト
+   *  @param[in]  offset    パス毎の先頭位置(GetEdgeCommOffsetで取得)
+   *  @param[out] buf       送信バッファ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode packEdgeComm_LMR( const T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , const std::vector<stEdgeCommPath> &paths, const std::vector<size_t> &offset
+                                , T *buf, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信の通信相手1ランク分の展開
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    paths     受信パスリスト
+   *  @param[in]    offset    パス毎の先頭位置(GetEdgeCommOffsetで取得)
+   *  @param[in]    buf       受信バッファ
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode unpackEdgeComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , const std::vector<stEdgeCommPath> &paths, const std::vector<size_t> &offset
+                                  , const T *buf, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信のランク内コピー
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx          配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    periodicMask 周期境界の軸のビットフラグ(0のとき内部の隣接のみ)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode copy_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                             , int periodicMask, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信の受信、パックと送信
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx          配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    periodicMask 周期境界の軸のビットフラグ(0のとき内部の隣接のみ)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode sendrecv_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                 , int periodicMask, int procGrpNo=0 );
+
+  /** 辺、頂点方向の袖通信の受信待機と展開、ランク内コピー、送信待機
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx          配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    periodicMask 周期境界の軸のビットフラグ(0のとき内部の隣接のみ)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode wait_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                             , int periodicMask, int procGrpNo=0 );
+
+  /** 袖通信の１通信面分のパック(面方向、配列形状で振り分け)
+   *  @param[in]  av        袖通信をする配列のLMR配列ビュー(bEx=falseのとき使用)
+   *  @param[in]  avEx      袖通信をする配列のLMR配列ビュー(bEx=trueのとき使用)
+   *  @param[in]  bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc_comm   通信する仮想セル数
+   *  @param[in]  commInfo  通信情報
+   *  @param[in]  face      送信方向
+   *  @param[out] sendbuf   送信バッファ
+   *  @param[in]  nw        送信バッファのサイズ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode pack_LMR( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &avEx
+                        , bool bEx, int imax, int jmax, int kmax, int nmax, int vc_comm
+                        , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face
+                        , T* sendbuf, size_t nw, int procGrpNo=0 );
+
+  /** 袖通信の１通信面分の展開(面方向、配列形状で振り分け)
+   *  @param[in]    av        袖通信をする配列のLMR配列ビュー(bEx=falseのとき使用)
+   *  @param[in]    avEx      袖通信をする配列のLMR配列ビュー(bEx=trueのとき使用)
+   *  @param[in]    bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    commInfo  通信情報
+   *  @param[in]    face      受信方向
+   *  @param[in]    recvbuf   受信バッファ
+   *  @param[in]    procGrpNo プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode unpack_LMR( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &avEx
+                          , bool bEx, int imax, int jmax, int kmax, int nmax, int vc_comm
+                          , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face
+                          , T* recvbuf, int procGrpNo=0 );
+
+  /** ランク間通信情報の全通信面のパック(スレッド並列)
+   *  - SetBndCommBufferで計算済みのオフセットを用いて、通信面毎に独立にパックする
+   *  @param[in]  array         袖通信をする配列の先頭ポインタ
+   *  @param[in]  bEx           配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]  imax          配列サイズ(I方向)
+   *  @param[in]  jmax          配列サイズ(J方向)
+   *  @param[in]  kmax          配列サイズ(K方向)
+   *  @param[in]  nmax          配列サイズ(成分数)
+   *  @param[in]  vc            仮想セル数
+   *  @param[in]  vc_comm       通信する仮想セル数
+   *  @param[in]  pLeafCommInfo ランク間通信情報
+   *  @param[in]  sz_face       1リーフの格子数(平面内２軸)
+   *  @param[in]  bPeriodic     周期境界フラグ
+   *  @param[in]  face          送信方向
+   *  @param[out] sendbuf       送信バッファ
+   *  @param[out] commsize      送信サイズ
+   *  @param[in]  procGrpNo     プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode packLeafComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , cpm_LeafCommInfo *pLeafCommInfo, size_t sz_face[2], bool bPeriodic
+                                , cpm_FaceFlag face, T* sendbuf, int &commsize, int procGrpNo=0 );
+
+  /** ランク間通信情報の全通信面の展開(スレッド並列)
+   *  - SetBndCommBufferで計算済みのオフセットを用いて、通信面毎に独立に展開する
+   *    (細→粗の8セル平均も含む)
+   *  @param[inout] array         袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx           配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax          配列サイズ(I方向)
+   *  @param[in]    jmax          配列サイズ(J方向)
+   *  @param[in]    kmax          配列サイズ(K方向)
+   *  @param[in]    nmax          配列サイズ(成分数)
+   *  @param[in]    vc            仮想セル数
+   *  @param[in]    vc_comm       通信する仮想セル数
+   *  @param[in]    pLeafCommInfo ランク間通信情報
+   *  @param[in]    sz_face       1リーフの格子数(平面内２軸)
+   *  @param[in]    bPeriodic     周期境界フラグ
+   *  @param[in]    face          受信方向
+   *  @param[in]    recvbuf       受信バッファ
+   *  @param[in]    procGrpNo     プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode unpackLeafComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , cpm_LeafCommInfo *pLeafCommInfo, size_t sz_face[2], bool bPeriodic
+                                  , cpm_FaceFlag face, T* recvbuf, int procGrpNo=0 );
+
+  /** 集約袖通信の受信、パックと送信、ランク内コピー
+   *  - 通信相手ランク毎に、送信は+X,-X,+Y,-Y,+Z,-Z面の順、
+   *    受信は-X,+X,-Y,+Y,-Z,+Z面の順にデータを連結し、その後ろに辺、頂点方向の
+   *    データを連結する(相手の+X面の送信データは自身の-X面の受信データとなる)
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    procGrpNo プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode sendrecv_LMR_Agg( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , int procGrpNo=0 );
+
+  /** 集約袖通信の受信待機と展開、辺、頂点方向のランク内コピー、送信待機
+   *  - 辺、頂点方向のデータは全ランクの面の展開後に展開する
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    bEx       配列形状(true:S4DEx,V3DEx、false:S3D,S4D,V3D)
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   通信する仮想セル数
+   *  @param[in]    procGrpNo プロセスグループ番号
+   */
+  template<class T>
+  cpm_ErrorCode wait_LMR_Agg( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                            , int procGrpNo=0 );
+
   /** 袖通信(Scalar3D,4D,Vector3D版)の-X面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1104,17 +2032,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packMX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+X面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1122,17 +2049,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packPX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の-Y面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1140,17 +2066,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packMY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+Y面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1158,17 +2083,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packPY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の-Z面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1176,17 +2100,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packMZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+Z面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
    *  @param[in]  nmax        配列サイズ(成分数)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1194,104 +2117,98 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode packPZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                        , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                        , int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の-X面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+X面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の-Y面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+Y面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の-Z面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar3D,4D,Vector3D版)の+Z面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
    *  @param[in]    nmax        配列サイズ(成分数)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の１面の送信データのパックと送信
@@ -1351,12 +2268,11 @@ protected:
                                 , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-X面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1364,17 +2280,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packMXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+X面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1382,17 +2297,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packPXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-Y面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1400,17 +2314,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packMYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+Y面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1418,17 +2331,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packPYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-Z面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1436,17 +2348,16 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packMZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packMZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+Z面への送信データのパック(通信面毎)
-   *  @param[in]  array       袖通信をする配列の先頭ポインタ
+   *  @param[in]  av          袖通信をする配列のLMR配列ビュー
    *  @param[in]  nmax        配列サイズ(成分数)
    *  @param[in]  imax        配列サイズ(I方向)
    *  @param[in]  jmax        配列サイズ(J方向)
    *  @param[in]  kmax        配列サイズ(K方向)
-   *  @param[in]  vc          仮想セル数
    *  @param[in]  vc_comm     通信する仮想セル数
    *  @param[in]  commInfo    リーフ間の通信情報
    *  @param[out] sendbuf     送信バッファ
@@ -1454,104 +2365,98 @@ protected:
    *  @param[in]  procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode packPZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode packPZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                         , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw
                         , int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-X面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+X面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-Y面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+Y面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の-Z面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackMZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
   /** 袖通信(Scalar4DEx,Vector3DEx版)の+Z面からの受信データの展開(通信面毎)
-   *  @param[inout] array       袖通信をする配列の先頭ポインタ
+   *  @param[inout] av          袖通信をする配列のLMR配列ビュー
    *  @param[in]    nmax        配列サイズ(成分数)
    *  @param[in]    imax        配列サイズ(I方向)
    *  @param[in]    jmax        配列サイズ(J方向)
    *  @param[in]    kmax        配列サイズ(K方向)
-   *  @param[in]    vc          仮想セル数
    *  @param[in]    vc_comm     通信する仮想セル数
    *  @param[in]    commInfo    リーフ間の通信情報
    *  @param[in]    recvbuf     受信バッファ
    *  @param[in]    procGrpNo   プロセスグループ番号
    */
   template<class T>
-  cpm_ErrorCode unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+  cpm_ErrorCode unpackPZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo=0 );
 
 
@@ -1589,10 +2494,41 @@ protected:
   /** +Z方向袖通信情報 */
   BndCommInfoMap m_bndCommInfoMapPZ;
 
+  /** 集約袖通信モード */
+  bool m_bBndCommAggregate;
+
+  /** 集約袖通信の通信相手ランク毎の情報 */
+  BndAggCommInfoMap m_bndAggCommInfoMap;
+
+  /** 辺、頂点袖通信モード */
+  bool m_bBndCommEdge;
+
+  /** 辺、頂点方向の袖通信の通信相手ランク毎の情報 */
+  BndEdgeCommInfoMap m_bndEdgeCommInfoMap;
+
+  /** LMRの領域分割情報(再分割用) */
+  struct stLMRDomainInfo
+  {
+    S_LMR_TREE_INFO  treeInfo; ///< 木情報と現在の分割
+    std::vector<int> prevHead; ///< 直前の再分割前の各ランクの先頭リーフID(未実行のとき空)
+    size_t           maxVC;    ///< 袖通信バッファの最大袖数
+    size_t           maxN;     ///< 袖通信バッファの最大成分数
+
+    /**** 直前の細分化、粗大化(未実行のとき空) ****/
+    std::vector<int> adaptSrc;     ///< 自ランクの新しいリーフ毎の元のローカルリーフ順番号
+    std::vector<int> adaptOp;      ///< 自ランクの新しいリーフ毎の操作(0:そのまま、1～8:細分化(子番号+1)、-1:粗大化)
+    std::vector<int> prevChildId;  ///< 自ランクの元のリーフ毎の子番号
+  };
+
+  /** プロセスグループ毎のLMRの領域分割情報 */
+  std::map<int, stLMRDomainInfo> m_lmrDomainInfoMap;
+
 };
 
 //インライン関数
 #include "inline/cpm_ParaManagerLMR_BndComm.h"
 #include "inline/cpm_ParaManagerLMR_BndCommEx.h"
+#include "inline/cpm_ParaManagerLMR_Adapt.h"
+#include "inline/cpm_ParaManagerLMR_BndCommEdge.h"
 
 #endif /* _CPM_PARAMANAGER_LMR_H_ */
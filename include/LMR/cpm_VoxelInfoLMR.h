@@ -28,6 +28,7 @@
 //#include "BCM/BCMOctree.h"
 //#include "BCM/BCMFileCommon.h"
 #include "BCMOctree.h"
+#include "LinearOctree.h"
 #include "BCMFileCommon.h"
 #include "cpm_TextParserDomainLMR.h"
 #include "cpm_DefineLMR.h"
@@ -36,6 +37,58 @@
 class cpm_VoxelInfoLMR;
 typedef std::map<int, cpm_VoxelInfoLMR*> LeafMap; //map<leafID,VoxelInfo*>
 
+/** LMRのリーフ分割の統計情報 */
+struct S_LMR_PARTITION_INFO
+{
+  int    nRank;          ///< 並列数
+  int    numLeaf;        ///< 全リーフ数
+  double totalWeight;    ///< 全リーフの重みの合計
+  double maxWeight;      ///< ランク毎の重みの最大値
+  double minWeight;      ///< ランク毎の重みの最小値
+  double imbalance;      ///< 負荷不均衡率(最大値/平均値)
+  int    numCutFace;     ///< ランク間の隣接リーフ面の数(周期境界は含まない)
+  int    maxRankCutFace; ///< ランク毎のランク間の隣接リーフ面の数の最大値
+
+  /** コンストラクタ */
+  S_LMR_PARTITION_INFO()
+  {
+    nRank = numLeaf = 0;
+    totalWeight = maxWeight = minWeight = 0.0;
+    imbalance = 1.0;
+    numCutFace = maxRankCutFace = 0;
+  }
+
+  void print()
+  {
+    std::cout << "*** leaf partition info" << std::endl;
+    std::cout << "nRank     : " << nRank << std::endl;
+    std::cout << "numLeaf   : " << numLeaf << std::endl;
+    std::cout << "weight    : total=" << totalWeight << " max=" << maxWeight << " min=" << minWeight << std::endl;
+    std::cout << "imbalance : " << imbalance << std::endl;
+    std::cout << "cut face  : total=" << numCutFace << " max/rank=" << maxRankCutFace << std::endl;
+  }
+};
+
+/** LMRの木情報とリーフ分割(各ランクの担当リーフ範囲) */
+struct S_LMR_TREE_INFO
+{
+  S_OCT_DOMAIN_INFO      domainInfo; ///< 領域情報
+  BCMFileIO::OctHeader   octHeader;  ///< 木情報ファイルのヘッダー情報
+  std::vector<Pedigree>  pedigrees;  ///< 全リーフのぺディグリー
+  std::vector<int>       head;       ///< 各ランクの先頭リーフID(nRank+1個、末尾は全リーフ数)
+};
+
+/** LMRの辺、頂点方向の隣接リーフ情報 */
+struct S_LMR_EDGE_NEIGHBOR
+{
+  int dir;        ///< 方向番号(_LMR_DIR_IDX)
+  int leafID;     ///< 隣接リーフ番号
+  int rankNo;     ///< 隣接リーフのランク番号
+  int levelDiff;  ///< 隣接リーフとのレベル差(隣接リーフのレベル-自リーフのレベル)
+  int offset[3];  ///< 自リーフの原点から見た隣接リーフの原点位置(細かい方のリーフの大きさ単位)
+  int periodic;   ///< 周期境界を越える軸のビットフラグ(bit0:X、bit1:Y、bit2:Z、0のとき内部の隣接)
+};
+
 /** LMR用のVOXEL空間情報管理クラス
  */
 class cpm_VoxelInfoLMR : public cpm_VoxelInfo
@@ -56,7 +109,7 @@ public:
     const int *tl = m_voxelTailIndex;
     std::cout << "*** leaf  = " << m_leafID << std::endl;
     std::cout << "    rank  = " << m_rankNo << std::endl;
-    std::cout << "    level = " << m_node->getLevel() << std::endl;
+    std::cout << "    level = " << m_octree->getLevel(m_leafID) << std::endl;
     std::cout << "    gvox  = " << gv[0] << "," << gv[1] << "," << gv[2] << std::endl;
     std::cout << "    div   = " << dv[0] << "," << dv[1] << "," << dv[2] << std::endl;
     std::cout << "    pos   = " << ps[0] << "," << ps[1] << "," << ps[2] << std::endl;
@@ -110,12 +163,73 @@ protected:
   /** CPM領域分割情報の生成
    *  - MPI_COMM_WORLDを使用した領域を生成する。
    *
-   *  @param[in]  comm    MPIコミュニケータ
-   *  @param[in]  treeFile  領域情報ファイル
-   *  @param[out] leafMap リーフごとのVoxel空間情報マップ
+   *  - leafWeightを指定した場合は、リーフ順(空間充填曲線順)の重みの累積和が
+   *    均等になるように、各ランクに連続したリーフを割り当てる
+   *  - cutTolが正のとき、各ランクの重みが平均の(1+cutTol)倍を超えない範囲で
+   *    分割位置をずらし、ランク間の隣接リーフ面の数を減らす
+   *
+   *  @param[in]  comm       MPIコミュニケータ
+   *  @param[in]  treeFile   領域情報ファイル
+   *  @param[out] leafMap    リーフごとのVoxel空間情報マップ
+   *  @param[in]  leafWeight リーフ毎の重み(全リーフ数分、全ランクで同じ値、NULLのとき均等)
+   *  @param[in]  cutTol     分割位置調整時の負荷不均衡の許容率(0以下のとき調整しない)
+   *  @param[out] partInfo   分割の統計情報(NULLのとき出力しない)
+   *  @param[out] treeInfo   木情報と分割結果(NULLのとき出力しない、再分割時に使用する)
    *  @return 終了コード(CPM_SUCCESS=正常終了)
    */
-  static cpm_ErrorCode Init( MPI_Comm comm, std::string treeFile, LeafMap &leafMap );
+  static cpm_ErrorCode Init( MPI_Comm comm, std::string treeFile, LeafMap &leafMap
+                           , const double *leafWeight=NULL, double cutTol=0.0
+                           , S_LMR_PARTITION_INFO *partInfo=NULL
+                           , S_LMR_TREE_INFO *treeInfo=NULL );
+
+  /** 重みのチェック
+   *  @param[in] numLeaf    全リーフ数
+   *  @param[in] leafWeight リーフ毎の重み(NULLのときチェックしない)
+   *  @return 終了コード(CPM_SUCCESS=正常終了、負または非数のときCPM_ERROR_LMR_INVALID_WEIGHT)
+   */
+  static cpm_ErrorCode CheckLeafWeight( int numLeaf, const double *leafWeight );
+
+  /** リーフ分割
+   *  - Initと同じ方法で、treeInfo.headに各ランクの先頭リーフIDをセットする
+   *  @param[in]    nRank      並列数
+   *  @param[inout] treeInfo   木情報(headを更新する)
+   *  @param[in]    leafWeight リーフ毎の重み(NULLのとき均等)
+   *  @param[in]    cutTol     分割位置調整時の負荷不均衡の許容率(0以下のとき調整しない)
+   *  @param[out]   partInfo   分割の統計情報(NULLのとき出力しない)
+   */
+  static void PartitionLeaf( int nRank, S_LMR_TREE_INFO &treeInfo, const double *leafWeight
+                           , double cutTol, S_LMR_PARTITION_INFO *partInfo );
+
+  /** リーフ分割結果から自ランクのリーフ毎のVOXEL空間情報を生成
+   *  @param[in]  comm     MPIコミュニケータ
+   *  @param[in]  treeInfo 木情報と分割結果
+   *  @param[out] leafMap  リーフごとのVoxel空間情報マップ
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  static cpm_ErrorCode CreateLeafMap( MPI_Comm comm, const S_LMR_TREE_INFO &treeInfo, LeafMap &leafMap );
+
+  /** 領域情報と木情報の読み込み
+   *  - ランク0のみが領域情報ファイルと木情報ファイルを読み込み、
+   *    領域情報、ヘッダー、ぺディグリーを全ランクにブロードキャストする
+   *  - commの全ランクでコールすること
+   *  @param[in]  comm       MPIコミュニケータ
+   *  @param[in]  treeFile   領域情報ファイル
+   *  @param[out] domainInfo 領域情報
+   *  @param[out] header     ヘッダー情報
+   *  @param[out] pedigrees  ぺディグリー情報
+   *  @return 終了コード(CPM_SUCCESS=正常終了、ランク0の読み込みエラーは全ランクで返す)
+   */
+  static
+  cpm_ErrorCode LoadTreeInfo( MPI_Comm comm, std::string treeFile, S_OCT_DOMAIN_INFO &domainInfo
+                            , BCMFileIO::OctHeader &header, std::vector<Pedigree> &pedigrees );
+
+  /** 領域情報のブロードキャスト
+   *  @param[in]    comm       MPIコミュニケータ
+   *  @param[inout] domainInfo 領域情報(ランク0の値を送る)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  static
+  cpm_ErrorCode BcastDomainInfo( MPI_Comm comm, S_OCT_DOMAIN_INFO &domainInfo );
 
   /** 木情報ファイルの読み込み
    *  @param[in]  octFile   木情報ファイル
@@ -153,6 +267,74 @@ protected:
   static
   std::map<int,int> GetLeafIDMap(int nRank, int numLeaf);
 
+  /** 重み付きで各ランクの担当リーフマップを取得
+   *  - リーフ順の重みの累積和を並列数で均等に分割する
+   *  - 全リーフ数が並列数以上のとき、各ランクは1リーフ以上を担当する
+   *  @param[in] nRank   並列数
+   *  @param[in] numLeaf 全リーフ数
+   *  @param[in] weight  リーフ毎の重み(NULL、または合計が0以下のときGetLeafIDMap(nRank,numLeaf)と同じ)
+   *  @param[out] head   各ランクの先頭リーフID(nRank+1個、末尾はnumLeaf)
+   */
+  static
+  void GetLeafHead(int nRank, int numLeaf, const double *weight, std::vector<int> &head);
+
+  /** 各ランクの先頭リーフIDからリーフマップを生成
+   *  @param[in] head 各ランクの先頭リーフID(nRank+1個)
+   *  @return リーフマップ(map<leafID,rankNo>)
+   */
+  static
+  std::map<int,int> GetLeafIDMap(const std::vector<int> &head);
+
+  /** 全リーフの隣接リーフリストを取得
+   *  @param[in]  octree    木情報
+   *  @param[out] neighbor  リーフ毎の隣接リーフIDリスト
+   *  @param[in]  bPeriodic 周期境界の隣接を含めるかどうか(既定値は含めない)
+   */
+  static
+  void GetLeafNeighborList(const LinearOctree *octree, std::vector< std::vector<int> > &neighbor
+                          , bool bPeriodic=false);
+
+  /** リーフの細分化、粗大化による木情報の更新
+   *  - leafFlagが1のリーフは8つの子リーフに分割し(子番号順)、
+   *    -1のリーフは兄弟の8リーフがすべて-1のとき親リーフに統合する
+   *  - 兄弟の8リーフがリーフ順に連続していない、またはランクをまたぐときは統合しない
+   *  - 隣接リーフ(周期境界を含む)とのレベル差が1以下になるように、
+   *    細分化を追加、または粗大化を取り消す
+   *  - 新しいリーフは元のリーフの位置に並べ、元のリーフの担当ランクが担当する
+   *
+   *  @param[in]    treeInfo    更新前の木情報と分割
+   *  @param[inout] leafFlag    リーフ毎のフラグ(全リーフ数分、1:細分化、-1:粗大化、0:そのまま)、
+   *                            実際に行う操作に更新される
+   *  @param[out]   newTreeInfo 更新後の木情報と分割
+   *  @param[out]   srcLeaf     更新後のリーフ毎の元のリーフID(粗大化のときは兄弟の先頭)
+   *  @param[out]   srcOp       更新後のリーフ毎の操作(0:そのまま、1～8:細分化(子番号+1)、-1:粗大化)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  static
+  cpm_ErrorCode AdaptTree(const S_LMR_TREE_INFO &treeInfo, std::vector<int> &leafFlag
+                         , S_LMR_TREE_INFO &newTreeInfo, std::vector<int> &srcLeaf, std::vector<int> &srcOp);
+
+  /** ランク間の隣接リーフ面が減るように分割位置を調整
+   *  - 各分割位置について、隣り合う２ランクの重みが許容値を超えない範囲で位置をずらす
+   *  @param[in]    neighbor リーフ毎の隣接リーフIDリスト
+   *  @param[in]    weight   リーフ毎の重み(NULLのとき均等)
+   *  @param[in]    tol      負荷不均衡の許容率
+   *  @param[inout] head     各ランクの先頭リーフID(nRank+1個)
+   */
+  static
+  void RefineLeafHead(const std::vector< std::vector<int> > &neighbor, const double *weight, double tol
+                     , std::vector<int> &head);
+
+  /** 分割の統計情報を取得
+   *  @param[in]  neighbor リーフ毎の隣接リーフIDリスト
+   *  @param[in]  weight   リーフ毎の重み(NULLのとき均等)
+   *  @param[in]  head     各ランクの先頭リーフID(nRank+1個)
+   *  @param[out] info     統計情報
+   */
+  static
+  void GetPartitionInfo(const std::vector< std::vector<int> > &neighbor, const double *weight
+                       , const std::vector<int> &head, S_LMR_PARTITION_INFO &info);
+
   /** グローバルの領域情報をセット
    *  @param[in] dInfo 領域情報
    */
@@ -167,6 +349,11 @@ protected:
    */
   void SetNeighborInfo(const std::map<int,int> &leafIDmap);
 
+  /** 辺、頂点方向の隣接情報の取得
+   *  @param[in] leafIDmap リーフマップ(map<leafID,rankNo>)
+   */
+  void SetEdgeNeighborInfo(const std::map<int,int> &leafIDmap);
+
   /** 木情報ファイルからリーフ数を取得する
    *  @param[in] treefile  木情報ファイル
    *  @return    リーフ数
@@ -174,6 +361,15 @@ protected:
   static
   int GetNumLeaf( std::string treeFile );
 
+  /** 木情報ファイルからリーフ数を取得する
+   *  - ランク0のみが読み込み、全ランクにブロードキャストする(commの全ランクでコール)
+   *  @param[in] comm      MPIコミュニケータ
+   *  @param[in] treefile  木情報ファイル
+   *  @return    リーフ数
+   */
+  static
+  int GetNumLeaf( MPI_Comm comm, std::string treeFile );
+
 
 ////// 領域取得関係 //////
 
@@ -216,6 +412,17 @@ protected:
   virtual
   int GetNeighborLevelDiff( cpm_FaceFlag face ) const;
 
+  /** 辺、頂点方向の隣接リーフ情報を取得
+   *  - 自リーフの辺、頂点に接するリーフ(同レベルまたは粗いリーフは1個、細かいリーフは辺で2個)
+   *  - 周期境界を越える隣接も含み、periodicで区別する
+   *  @param[in]  dx  x方向(-1,0,1)
+   *  @param[in]  dy  y方向(-1,0,1)
+   *  @param[in]  dz  z方向(-1,0,1)
+   *  @param[out] num 隣接リーフ数(面方向、自身を指定したときは0)
+   *  @return 隣接リーフ情報配列のポインタ
+   */
+  const S_LMR_EDGE_NEIGHBOR* GetEdgeNeighborList( int dx, int dy, int dz, int &num ) const;
+
   /** 自リーフの境界が外部境界かどうかを判定
    *  @param[in] face  面方向
    *  @retval    true  外部境界
@@ -243,8 +450,8 @@ public:
 protected:
   /**** 木情報 ****/
   BCMFileIO::OctHeader m_octHeader;  ///< 木情報ファイルのヘッダー情報
-  BCMOctree *m_octree;               ///< 生成された木情報
-  Node      *m_node;                 ///< 自ランクが担当するリーフノード
+  LinearOctree *m_octree;            ///< 生成された木情報(自ランクのリーフで共有)
+  int       *m_octreeRef;            ///< 木情報の参照カウンタ
   int        m_leafID;               ///< リーフID
 
   /**** 隣接情報 ****/
@@ -255,6 +462,9 @@ protected:
   int m_periodicRankID_LMR[6][4]; ///< 周期境界の隣接ランク番号
   int m_neighborLevelDiff[6]; ///< 隣接リーフとのレベル差(-1/0/1)
 
+  std::vector<S_LMR_EDGE_NEIGHBOR> m_edgeNeighbor; ///< 辺、頂点方向の隣接リーフ情報(方向番号順)
+  int m_edgeHead[28]; ///< 方向番号毎のm_edgeNeighborの先頭位置(末尾は総数)
+
 };
 
 #endif /* _CPM_VOXELINFO_LMR_H_ */
@@ -0,0 +1,149 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManagerLMR_Adapt.h
+ * LMR用パラレルマネージャクラスのリーフ細分化、粗大化のインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_ADAPT_LMR_H_
+#define _CPM_PARAMANAGER_ADAPT_LMR_H_
+
+// リーフ内の1次元インデクス(S4D/S4DEx)
+#define _IDXAD(_I,_J,_K,_N) \
+( bEx ? _IDX_S4DEX(_N,_I,_J,_K,nmax,sz[0],sz[1],sz[2],vc) \
+      : _IDX_S4D(_I,_J,_K,_N,sz[0],sz[1],sz[2],vc) )
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ毎の配列の細分化、粗大化(S3D,S4D,V3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::AdaptLeafArray_LMR( T *&array, int nmax, int vc, int procGrpNo )
+{
+  return adaptLeafArray( array, nmax, vc, false, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ毎の配列の細分化、粗大化(S4DEx,V3DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::AdaptLeafArrayEx_LMR( T *&array, int nmax, int vc, int procGrpNo )
+{
+  return adaptLeafArray( array, nmax, vc, true, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ毎の配列の細分化、粗大化
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::adaptLeafArray( T *&array, int nmax, int vc, bool bEx, int procGrpNo )
+{
+  if( !IsLeafAdapted(procGrpNo) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  const stLMRDomainInfo &lmrInfo = m_lmrDomainInfoMap[procGrpNo];
+  const std::vector<int> &src     = lmrInfo.adaptSrc;
+  const std::vector<int> &op      = lmrInfo.adaptOp;
+  const std::vector<int> &childId = lmrInfo.prevChildId;
+  const int *sz = lmrInfo.treeInfo.domainInfo.size;
+  if( sz[0]%2 != 0 || sz[1]%2 != 0 || sz[2]%2 != 0 )
+  {
+    return CPM_ERROR_LMR_ADAPT;
+  }
+  const int hx = sz[0]/2;
+  const int hy = sz[1]/2;
+  const int hz = sz[2]/2;
+
+  // 新しい配列
+  size_t nwLeaf = GetLeafArrayLength(nmax, vc, procGrpNo);
+  int nLeaf = int(src.size());
+  T *newArray = (nwLeaf*nLeaf > 0) ? new T[nwLeaf*nLeaf] : NULL;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int l=0;l<nLeaf;l++ )
+  {
+    T *dst = newArray + nwLeaf * size_t(l);
+    const T *org = array + nwLeaf * size_t(src[l]);
+
+    // そのまま(仮想セルを含めてコピー)
+    if( op[l] == 0 )
+    {
+      memcpy( dst, org, sizeof(T)*nwLeaf );
+      continue;
+    }
+
+    // 仮想セルは0
+    for( size_t i=0;i<nwLeaf;i++ )
+    {
+      dst[i] = T(0);
+    }
+
+    if( op[l] > 0 )
+    {
+      // 細分化:親リーフの子番号に対応する1/8領域のセル値を2x2x2の子セルにコピー
+      int c  = op[l] - 1;
+      int ox = ( c     & 1) * hx;
+      int oy = ((c>>1) & 1) * hy;
+      int oz = ((c>>2) & 1) * hz;
+      for( int n=0;n<nmax;n++ ){
+      for( int k=0;k<sz[2];k++ ){
+      for( int j=0;j<sz[1];j++ ){
+      for( int i=0;i<sz[0];i++ ){
+        dst[_IDXAD(i,j,k,n)] = org[_IDXAD(ox+i/2,oy+j/2,oz+k/2,n)];
+      }}}}
+    }
+    else
+    {
+      // 粗大化:兄弟の8リーフの2x2x2セルの平均を親セルにセット
+      for( int m=0;m<8;m++ )
+      {
+        const T *child = org + nwLeaf * size_t(m);
+        int c  = childId[src[l]+m];
+        int ox = ( c     & 1) * hx;
+        int oy = ((c>>1) & 1) * hy;
+        int oz = ((c>>2) & 1) * hz;
+        for( int n=0;n<nmax;n++ ){
+        for( int k=0;k<hz;k++ ){
+        for( int j=0;j<hy;j++ ){
+        for( int i=0;i<hx;i++ ){
+          double sum = 0.0;
+          for( int kk=0;kk<2;kk++ ){
+          for( int jj=0;jj<2;jj++ ){
+          for( int ii=0;ii<2;ii++ ){
+            sum += double(child[_IDXAD(2*i+ii,2*j+jj,2*k+kk,n)]);
+          }}}
+          dst[_IDXAD(ox+i,oy+j,oz+k,n)] = T(sum * 0.125);
+        }}}}
+      }
+    }
+  }
+
+  // 登録フィールドは新しい配列に移す
+  moveField( array, newArray );
+  delete [] array;
+  array = newArray;
+  return CPM_SUCCESS;
+}
+
+#undef _IDXAD
+
+#endif /* _CPM_PARAMANAGER_ADAPT_LMR_H_ */
@@ -141,6 +141,37 @@ cpm_ParaManagerLMR::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    if( (ret = sendrecv_LMR_Agg(array, false, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    if( (ret = wait_LMR_Agg(array, false, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    // 登録フィールドの通信済みを記録
+    commitFieldComm( array );
+    return CPM_SUCCESS;
+  }
+
+  // 辺、頂点方向の袖通信(送信側の内部セルのみを送るため、面の袖通信より先に開始する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = sendrecv_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -362,6 +393,18 @@ cpm_ParaManagerLMR::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax
   } // ZDIR
 
 
+  // 辺、頂点方向の袖通信(面の袖通信の展開後に展開する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = wait_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   // 正常終了
   return CPM_SUCCESS;
 }
@@ -379,6 +422,27 @@ cpm_ParaManagerLMR::BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, i
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    return sendrecv_LMR_Agg(array, false, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo);
+  }
+
+  // 辺、頂点方向の袖通信(送信側の内部セルのみを送るため、面の袖通信より先に開始する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = sendrecv_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -550,6 +614,24 @@ cpm_ParaManagerLMR::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 非同期袖通信を省略したときは展開も省略
+  if( endFieldComm( array ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    if( (ret = wait_LMR_Agg(array, false, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    // 登録フィールドの通信済みを記録
+    commitFieldComm( array );
+    return CPM_SUCCESS;
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -681,6 +763,18 @@ cpm_ParaManagerLMR::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int
   } // ZDIR
 
 
+  // 辺、頂点方向の袖通信(面の袖通信の展開後に展開する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = wait_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   // 正常終了
   return CPM_SUCCESS;
 }
@@ -829,6 +923,114 @@ cpm_ParaManagerLMR::PeriodicCommS4D( T *array, int imax, int jmax, int kmax, int
   return CPM_SUCCESS;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::BndCommS3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                      , CPM_Op op, int periodicFlag, int procGrpNo )
+{
+  return BndCommS4D_Reverse( array, imax, jmax, kmax, 1, vc, vc_comm, op, periodicFlag, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Vector3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::BndCommV3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                      , CPM_Op op, int periodicFlag, int procGrpNo )
+{
+  return BndCommS4D_Reverse( array, imax, jmax, kmax, 3, vc, vc_comm, op, periodicFlag, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                      , CPM_Op op, int periodicFlag, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( (ret = BndCommS4D_Reverse_nowait( array, imax, jmax, kmax, nmax, vc, vc_comm, op, periodicFlag, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  return wait_BndCommS4D_Reverse( array, imax, jmax, kmax, nmax, vc, vc_comm, op, periodicFlag, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版、waitなし)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                             , CPM_Op op, int periodicFlag, int procGrpNo )
+{
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( !IsReverseOp(op) )
+  {
+    return CPM_ERROR_MPI_INVALID_OPERATOR;
+  }
+
+  // Z方向(周期境界以外)の送受信を開始(以降の方向はwait_BndCommS4D_Reverseで順に処理する)
+  return sendrecvReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, Z_DIR, false, op, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信のwait、集約(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                           , CPM_Op op, int periodicFlag, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( !IsReverseOp(op) )
+  {
+    return CPM_ERROR_MPI_INVALID_OPERATOR;
+  }
+
+  // Z,Y,X方向の順に、周期境界以外、周期境界の通信を行う(Z方向の周期境界以外はnowaitで開始済み)
+  cpm_DirFlag dirs[3] = {Z_DIR, Y_DIR, X_DIR};
+  for( int i=0;i<3;i++ )
+  {
+    cpm_DirFlag dir = dirs[i];
+    for( int p=0;p<2;p++ )
+    {
+      bool bPeriodic = (p==1);
+      if( bPeriodic && !(periodicFlag & (1<<int(dir))) )
+      {
+        continue;
+      }
+      if( i>0 || p>0 )
+      {
+        if( (ret = sendrecvReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, dir, bPeriodic, op, procGrpNo )) != CPM_SUCCESS )
+        {
+          return ret;
+        }
+      }
+      if( (ret = waitReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, dir, bPeriodic, op, procGrpNo )) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+    }
+  }
+
+  // 実セルを更新したので登録フィールドのバージョンを進める(登録されていないときは何もしない)
+  MarkFieldDirty( array );
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // １方向の非同期受信処理
 template<class T> CPM_INLINE
@@ -853,16 +1055,9 @@ cpm_ParaManagerLMR::recv_LMR( LeafCommInfoMap &commInfoMap, size_t sz_face[2], i
     }
 
     // 受信サイズの計算
-    int commsize = 0;
-    for( int j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
-    {
-      cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
-      if( commInfo->bPeriodic == bPeriodic )
-      {
-        size_t csz = commInfo->CalcRecvBufferSize(sz_face, vc_comm, nmax);
-        commsize += (int)csz;
-      }
-    }
+    std::vector<size_t> work;
+    const size_t *off = pLeafCommInfo->GetRecvOffset( sz_face, vc_comm, bPeriodic, work );
+    int commsize = int(nmax * off[pLeafCommInfo->m_vecCommInfo.size()]);
 
     // 受信
     if( commsize > 0 )
@@ -929,65 +1124,10 @@ cpm_ParaManagerLMR::send_LMR( T *array, int imax, int jmax, int kmax, int nmax,
 
     // 送信サイズの計算とパック
     int commsize = 0;
-    T *ptr = sendbuf;
-    for( int j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
+    if( (ret = packLeafComm_LMR(array, false, imax, jmax, kmax, nmax, vc, vc_comm, pLeafCommInfo, sz_face, bPeriodic
+                              , face, sendbuf, commsize, procGrpNo)) != CPM_SUCCESS )
     {
-      cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
-      if( commInfo->bPeriodic == bPeriodic )
-      {
-        // リーフ間の送信サイズ
-        size_t csz = commInfo->CalcSendBufferSize(sz_face, vc_comm, nmax);
-
-        // パック
-        if( face == X_MINUS )
-        {
-          if( (ret = packMX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == X_PLUS )
-        {
-          if( (ret = packPX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_MINUS )
-        {
-          if( (ret = packMY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_PLUS )
-        {
-          if( (ret = packPY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_MINUS )
-        {
-          if( (ret = packMZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_PLUS )
-        {
-          if( (ret = packPZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // 送信サイズを加算
-        commsize += (int)csz;
-
-        // バッファのポインタも変更
-        ptr += csz;
-      }
+      return ret;
     }
 
     // 送信
@@ -1013,25 +1153,6 @@ cpm_ParaManagerLMR::copy_LMR( T *array, int imax, int jmax, int kmax, int nmax,
                             , LeafCommInfoMap &commInfoMapM, LeafCommInfoMap &commInfoMapP
                             , bool bPeriodic, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo )
 {
-  cpm_ErrorCode ret;
-
-  size_t sz_face[2];
-  if( dir==X_DIR )
-  {
-    sz_face[0] = jmax;
-    sz_face[1] = kmax;
-  }
-  else if( dir==Y_DIR )
-  {
-    sz_face[0] = imax;
-    sz_face[1] = kmax;
-  }
-  else if( dir==Z_DIR )
-  {
-    sz_face[0] = imax;
-    sz_face[1] = jmax;
-  }
-
   // ランク内の通信情報を取得
   LeafCommInfoMap::iterator itM = commInfoMapM.find(m_rankNo);
   if( itM == commInfoMapM.end() )
@@ -1048,126 +1169,214 @@ cpm_ParaManagerLMR::copy_LMR( T *array, int imax, int jmax, int kmax, int nmax,
   cpm_LeafCommInfo* pLeafCommInfoM = itM->second;
   cpm_LeafCommInfo* pLeafCommInfoP = itP->second;
 
-  // バッファ
-  T* copybuf = (T*)pLeafCommInfoM->GetBndCommSendBufferPtr();
+  // リーフ間の直接コピー
+  return copyDirect_LMR<T, CPM_ARRAY_S4D>(array, imax, jmax, kmax, nmax, vc, vc_comm
+                                        , pLeafCommInfoM, pLeafCommInfoP, bPeriodic, dir, pm, procGrpNo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信のランク内コピー処理(リーフ間の直接コピー)
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::copyDirect_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , cpm_LeafCommInfo* pLeafCommInfoM, cpm_LeafCommInfo* pLeafCommInfoP
+                                  , bool bPeriodic, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo )
+{
+  // 面方向
+  cpm_FaceFlag faceM, faceP;
+  if( dir==X_DIR )
+  {
+    faceM = X_MINUS;
+    faceP = X_PLUS;
+  }
+  else if( dir==Y_DIR )
+  {
+    faceM = Y_MINUS;
+    faceP = Y_PLUS;
+  }
+  else if( dir==Z_DIR )
+  {
+    faceM = Z_MINUS;
+    faceP = Z_PLUS;
+  }
+  else
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
 
-  // マイナス側の通信情報を検索
-  for( int j=0;j<pLeafCommInfoM->m_vecCommInfo.size();j++ )
+  // リーフペア毎のコピー
+  //  - 書き込みは受信側リーフの法線方向の袖、読み込みは送信側リーフの法線方向の内部のみのため、
+  //    リーフペア間で競合しない
+  int nInfo = int(pLeafCommInfoM->m_vecCommInfo.size());
+  int err = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int j=0;j<nInfo;j++ )
   {
     cpm_LeafCommInfo::stCommInfo* commInfoM = pLeafCommInfoM->m_vecCommInfo[j];
-    if( commInfoM->bPeriodic == bPeriodic )
+    if( commInfoM->bPeriodic != bPeriodic )
     {
-      // マイナス側のリーフ間の送信サイズ
-      size_t cszM = commInfoM->CalcSendBufferSize(sz_face, vc_comm, nmax);
+      continue;
+    }
 
-      // 対応するプラス側の通信情報を検索
-      cpm_LeafCommInfo::stCommInfo* commInfoP = pLeafCommInfoP->SearchDistCommInfo(commInfoM);
-      if( !commInfoP )
-      {
-        return CPM_ERROR;
-      }
+    // 対応するプラス側の通信情報を検索
+    cpm_LeafCommInfo::stCommInfo* commInfoP = pLeafCommInfoP->SearchDistCommInfo(commInfoM);
+    cpm_ErrorCode ret = commInfoP ? CPM_SUCCESS : CPM_ERROR;
 
-      // プラス側のリーフ間の送信サイズ
-      size_t cszP = commInfoP->CalcSendBufferSize(sz_face, vc_comm, nmax);
+    // マイナス側からプラス側へのコピー
+    if( ret==CPM_SUCCESS && (pm==MINUS2PLUS || pm==BOTH) )
+    {
+      ret = copyLeaf_LMR<T, Layout>(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, commInfoM, faceP, procGrpNo);
+    }
 
-      // パックと展開
-      if( dir == X_DIR )
-      {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, cszM, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
+    // プラス側からマイナス側へのコピー
+    if( ret==CPM_SUCCESS && (pm==PLUS2MINUS || pm==BOTH) )
+    {
+      ret = copyLeaf_LMR<T, Layout>(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, commInfoP, faceM, procGrpNo);
+    }
 
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, cszP, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
+    if( ret != CPM_SUCCESS )
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      err = ret;
+    }
+  }
+
+  return cpm_ErrorCode(err);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信の１リーフペア分のランク内直接コピー
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::copyLeaf_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , cpm_LeafCommInfo::stCommInfo* dstInfo, cpm_LeafCommInfo::stCommInfo* srcInfo
+                                , cpm_FaceFlag face, int procGrpNo )
+{
+  // 法線方向の軸と正負
+  int  na    = (face==X_MINUS || face==X_PLUS) ? 0 : ((face==Y_MINUS || face==Y_PLUS) ? 1 : 2);
+  bool bPlus = (face==X_PLUS || face==Y_PLUS || face==Z_PLUS);
+
+  // リーフインデクス
+  int dstIdx = GetLocalLeafIndex_byID(dstInfo->iOwnLeafID, procGrpNo);
+  int srcIdx = GetLocalLeafIndex_byID(srcInfo->iOwnLeafID, procGrpNo);
+  if( dstIdx < 0 || srcIdx < 0 )
+  {
+    return CPM_ERROR;
+  }
+
+  // リーフの配列ビュー
+  cpm_ArrayViewLMR<T, Layout> av( array, imax, jmax, kmax, nmax, vc );
+  cpm_ArrayView<T, Layout> d = av.Leaf( dstIdx );
+  cpm_ArrayView<T, Layout> s = av.Leaf( srcIdx );
+  ptrdiff_t st = d.StrideI();
+  ptrdiff_t sn = d.StrideN();
+
+  // 受信側から見たレベル差
+  int levelDiff = dstInfo->iLevelDiff;
+  int gc = vc_comm;
+
+  // 軸毎の受信範囲[ds,de)と送信側インデクスへのオフセット
+  //  - levelDiff== 0 : 送信側 d+off
+  //  - levelDiff== 1 : 送信側 2*d+off、+1の8cellの平均(fine->coarse)
+  //  - levelDiff==-1 : 送信側 (d+2)/2-1+off (coarse->fine)
+  //  pack,unpackを連続して行った場合と同じインデクスとなる
+  //  qbitは1/4面の位置を表すfaceIdxのビット位置(qbit[法線軸][軸])
+  static const int qbit[3][3] = { {-1, 0, 1}, { 1,-1, 0}, { 0, 1,-1} };
+  int sz[3] = {imax, jmax, kmax};
+  int ds[3], de[3], off[3];
+  for( int a=0;a<3;a++ )
+  {
+    int m = sz[a];
+    if( a == na )
+    {
+      // 法線方向
+      int gn = (levelDiff==-1) ? 2*gc : gc;
+      ds[a] = bPlus ? m    : -gn;
+      de[a] = bPlus ? m+gn : 0;
+      if( levelDiff==0 )
+      {
+        off[a] = bPlus ? -m : m;
       }
-      else if( dir == Y_DIR )
+      else if( levelDiff==1 )
       {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, cszM, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, cszP, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
+        off[a] = bPlus ? -2*m : m;
       }
-      else if( dir == Z_DIR )
+      else
       {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, cszM, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, copybuf, cszP, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
+        off[a] = bPlus ? -m/2 : m;
       }
     }
+    else if( levelDiff==0 )
+    {
+      ds[a]  = -gc;
+      de[a]  = m+gc;
+      off[a] = 0;
+    }
+    else if( levelDiff==1 )
+    {
+      // 受信側(coarse)の1/4面
+      int q  = (dstInfo->iFaceIdx >> qbit[na][a]) & 1;
+      int ts = q * (m/2);
+      ds[a]  = q ? ts   : -gc;
+      de[a]  = q ? m+gc : ts+m/2;
+      off[a] = -2*ts;
+    }
+    else
+    {
+      // 送信側(coarse)の1/4面
+      int q  = (srcInfo->iFaceIdx >> qbit[na][a]) & 1;
+      ds[a]  = -2*gc;
+      de[a]  = m+2*gc;
+      off[a] = q * (m/2);
+    }
+  }
+
+  if( levelDiff==1 )
+  {
+    // fine  -> coarse
+    // 8cell -> 1cell
+    for( int n=0;n<nmax;n++){
+    for( int k=ds[2];k<de[2];k++ ){
+    for( int j=ds[1];j<de[1];j++ ){
+      int sj = 2*j + off[1];
+      int sk = 2*k + off[2];
+      T* pd  = d.Cell(0, j,   k  ) + n*sn;
+      T* p00 = s.Cell(0, sj,  sk  ) + n*sn;
+      T* p10 = s.Cell(0, sj+1,sk  ) + n*sn;
+      T* p01 = s.Cell(0, sj,  sk+1) + n*sn;
+      T* p11 = s.Cell(0, sj+1,sk+1) + n*sn;
+      for( int i=ds[0];i<de[0];i++ ){
+        ptrdiff_t s0 = ptrdiff_t(2*i + off[0]) * st;
+        ptrdiff_t s1 = s0 + st;
+        T val = p00[s0] + p00[s1]
+              + p10[s0] + p10[s1]
+              + p01[s0] + p01[s1]
+              + p11[s0] + p11[s1];
+        val *= 0.125;
+        pd[i*st] = val;
+      }
+    }}}
+  }
+  else
+  {
+    // 同じレベル、またはcoarse -> fine(1cell -> 8cell)
+    bool bFine = (levelDiff==-1);
+    for( int n=0;n<nmax;n++){
+    for( int k=ds[2];k<de[2];k++ ){
+    for( int j=ds[1];j<de[1];j++ ){
+      int sj = (bFine ? (j+2)/2-1 : j) + off[1];
+      int sk = (bFine ? (k+2)/2-1 : k) + off[2];
+      T* pd = d.Cell(0, j,  k ) + n*sn;
+      T* ps = s.Cell(0, sj, sk) + n*sn;
+      for( int i=ds[0];i<de[0];i++ ){
+        int si = (bFine ? (i+2)/2-1 : i) + off[0];
+        pd[i*st] = ps[si*st];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -1229,62 +1438,10 @@ cpm_ParaManagerLMR::recv_LMR_wait( T *array, int imax, int jmax, int kmax, int n
     T* recvbuf = (T*)pLeafCommInfo->GetBndCommRecvBufferPtr();
 
     // 受信データの展開
-    T *ptr = recvbuf;
-    for( int j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
+    if( (ret = unpackLeafComm_LMR(array, false, imax, jmax, kmax, nmax, vc, vc_comm, pLeafCommInfo, sz_face, bPeriodic
+                                , face, recvbuf, procGrpNo)) != CPM_SUCCESS )
     {
-      cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
-      if( commInfo->bPeriodic == bPeriodic )
-      {
-        // リーフ間の受信サイズ
-        size_t csz = commInfo->CalcRecvBufferSize(sz_face, vc_comm, nmax);
-
-        // 展開
-        if( face == X_MINUS )
-        {
-          if( (ret = unpackMX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == X_PLUS )
-        {
-          if( (ret = unpackPX(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_MINUS )
-        {
-          if( (ret = unpackMY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_PLUS )
-        {
-          if( (ret = unpackPY(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        if( face == Z_MINUS )
-        {
-          if( (ret = unpackMZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_PLUS )
-        {
-          if( (ret = unpackPZ(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // バッファのポインタも変更
-        ptr += csz;
-      }
+      return ret;
     }
   }
 
@@ -1327,7 +1484,7 @@ cpm_ParaManagerLMR::send_LMR_wait( LeafCommInfoMap &commInfoMap )
 // 袖通信(Scalar3D,4D,Vector3D版)の-X面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1338,6 +1495,8 @@ cpm_ParaManagerLMR::packMX( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int js=0, je=jmax; //j方向範囲
@@ -1394,8 +1553,9 @@ cpm_ParaManagerLMR::packMX( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=0;i<gc;i++ ){
-    sendbuf[_IDXFX(i,jj,kk,n,0,jmaxb,kmaxb,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFX(i,jj,kk,n,0,jmaxb,kmaxb,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1405,7 +1565,7 @@ cpm_ParaManagerLMR::packMX( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の+X面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1416,6 +1576,8 @@ cpm_ParaManagerLMR::packPX( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int js=0, je=jmax; //j方向範囲
@@ -1476,8 +1638,9 @@ cpm_ParaManagerLMR::packPX( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=imax-gc;i<imax;i++ ){
-    sendbuf[_IDXFX(i,jj,kk,n,imax-gc,jmaxb,kmaxb,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFX(i,jj,kk,n,imax-gc,jmaxb,kmaxb,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1487,7 +1650,7 @@ cpm_ParaManagerLMR::packPX( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の-Y面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1498,6 +1661,8 @@ cpm_ParaManagerLMR::packMY( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1554,8 +1719,9 @@ cpm_ParaManagerLMR::packMY( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=0;j<gc;j++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
-    sendbuf[_IDXFY(ii,j,kk,n,imaxb,0,kmaxb,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFY(ii,j,kk,n,imaxb,0,kmaxb,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1565,7 +1731,7 @@ cpm_ParaManagerLMR::packMY( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の+Y面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1576,6 +1742,8 @@ cpm_ParaManagerLMR::packPY( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1632,8 +1800,9 @@ cpm_ParaManagerLMR::packPY( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=jmax-gc;j<jmax;j++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
-    sendbuf[_IDXFY(ii,j,kk,n,imaxb,jmax-gc,kmaxb,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFY(ii,j,kk,n,imaxb,jmax-gc,kmaxb,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1643,7 +1812,7 @@ cpm_ParaManagerLMR::packPY( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の-Z面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1654,6 +1823,8 @@ cpm_ParaManagerLMR::packMZ( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1710,8 +1881,9 @@ cpm_ParaManagerLMR::packMZ( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=0;k<gc;k++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
-    sendbuf[_IDXFZ(ii,jj,k,n,imaxb,jmaxb,0,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFZ(ii,jj,k,n,imaxb,jmaxb,0,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1722,7 +1894,7 @@ cpm_ParaManagerLMR::packMZ( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の+Z面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                           , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1733,6 +1905,8 @@ cpm_ParaManagerLMR::packPZ( T *array, int imax, int jmax, int kmax, int nmax, in
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1789,8 +1963,9 @@ cpm_ParaManagerLMR::packPZ( T *array, int imax, int jmax, int kmax, int nmax, in
   for( int n=0;n<nmax;n++){
   for( int k=kmax-gc;k<kmax;k++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k,n);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
-    sendbuf[_IDXFZ(ii,jj,k,n,imaxb,jmaxb,kmax-gc,gc)] = array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)];
+    sendbuf[_IDXFZ(ii,jj,k,n,imaxb,jmaxb,kmax-gc,gc)] = pa[i];
   }}}}
 
   return CPM_SUCCESS;
@@ -1800,7 +1975,7 @@ cpm_ParaManagerLMR::packPZ( T *array, int imax, int jmax, int kmax, int nmax, in
 // 袖通信(Scalar3D,4D,Vector3D版)の-X面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -1811,6 +1986,8 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -1819,8 +1996,9 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<0;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFX(i,j,k,n,0-vc_comm,jmax,kmax,vc_comm)];
+      pa[i] = recvbuf[_IDXFX(i,j,k,n,0-vc_comm,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -1867,6 +2045,7 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<0;i++ ){
       int ii=(i   )*2;
       int jj=(j-js)*2;
@@ -1880,7 +2059,7 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFX(ii  ,jj+1,kk+1,n,0-gc,jmax,kmax,gc)]
             + recvbuf[_IDXFX(ii+1,jj+1,kk+1,n,0-gc,jmax,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -1898,11 +2077,12 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-gc;i<0;i++ ){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFX(ii,jj,kk,n,0-vc_comm,jmaxb,kmaxb,vc_comm)];
+      pa[i] = recvbuf[_IDXFX(ii,jj,kk,n,0-vc_comm,jmaxb,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -1913,7 +2093,7 @@ cpm_ParaManagerLMR::unpackMX( T *array, int imax, int jmax, int kmax, int nmax,
 // 袖通信(Scalar3D,4D,Vector3D版)の+X面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPX( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -1924,6 +2104,8 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -1932,8 +2114,9 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=imax;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFX(i,j,k,n,imax,jmax,kmax,vc_comm)];
+      pa[i] = recvbuf[_IDXFX(i,j,k,n,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -1981,6 +2164,7 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=imax;i<imax+vc_comm;i++ ){
       int ii=(i   )*2;
       int jj=(j-js)*2;
@@ -1994,7 +2178,7 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFX(ii  ,jj+1,kk+1,n,imax2,jmax,kmax,gc)]
             + recvbuf[_IDXFX(ii+1,jj+1,kk+1,n,imax2,jmax,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2013,11 +2197,12 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=imax;i<imax+gc;i++ ){
       int ii=i/2;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFX(ii,jj,kk,n,imax2,jmaxb,kmaxb,vc_comm)];
+      pa[i] = recvbuf[_IDXFX(ii,jj,kk,n,imax2,jmaxb,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -2028,7 +2213,7 @@ cpm_ParaManagerLMR::unpackPX( T *array, int imax, int jmax, int kmax, int nmax,
 // 袖通信(Scalar3D,4D,Vector3D版)の-Y面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2039,6 +2224,8 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -2047,8 +2234,9 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFY(i,j,k,n,imax,0-vc_comm,kmax,vc_comm)];
+      pa[i] = recvbuf[_IDXFY(i,j,k,n,imax,0-vc_comm,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2095,6 +2283,7 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
       int ii=(i-is)*2;
       int jj=(j   )*2;
@@ -2108,7 +2297,7 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFY(ii  ,jj+1,kk+1,n,imax,0-gc,kmax,gc)]
             + recvbuf[_IDXFY(ii+1,jj+1,kk+1,n,imax,0-gc,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2126,11 +2315,12 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<0;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-gc;i<imax+gc;i++ ){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFY(ii,jj,kk,n,imaxb,0-vc_comm,kmaxb,vc_comm)];
+      pa[i] = recvbuf[_IDXFY(ii,jj,kk,n,imaxb,0-vc_comm,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -2142,7 +2332,7 @@ cpm_ParaManagerLMR::unpackMY( T *array, int imax, int jmax, int kmax, int nmax,
 // 袖通信(Scalar3D,4D,Vector3D版)の+Y面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPY( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2153,6 +2343,8 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -2161,8 +2353,9 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFY(i,j,k,n,imax,jmax,kmax,vc_comm)];
+      pa[i] = recvbuf[_IDXFY(i,j,k,n,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2210,6 +2403,7 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
       int ii=(i-is)*2;
       int jj=(j   )*2;
@@ -2223,7 +2417,7 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFY(ii  ,jj+1,kk+1,n,imax,jmax2,kmax,gc)]
             + recvbuf[_IDXFY(ii+1,jj+1,kk+1,n,imax,jmax2,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2242,11 +2436,12 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=jmax;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-gc;i<imax+gc;i++ ){
       int ii=(i+2)/2-1;
       int jj=j/2;
       int kk=(k+2)/2-1;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFY(ii,jj,kk,n,imaxb,jmax2,kmaxb,vc_comm)];
+      pa[i] = recvbuf[_IDXFY(ii,jj,kk,n,imaxb,jmax2,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -2257,7 +2452,7 @@ cpm_ParaManagerLMR::unpackPY( T *array, int imax, int jmax, int kmax, int nmax,
 // 袖通信(Scalar3D,4D,Vector3D版)の-Z面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2268,6 +2463,8 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -2276,8 +2473,9 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFZ(i,j,k,n,imax,jmax,0-vc_comm,vc_comm)];
+      pa[i] = recvbuf[_IDXFZ(i,j,k,n,imax,jmax,0-vc_comm,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2324,6 +2522,7 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
       int ii=(i-is)*2;
       int jj=(j-js)*2;
@@ -2337,7 +2536,7 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFZ(ii  ,jj+1,kk+1,n,imax,jmax,0-gc,gc)]
             + recvbuf[_IDXFZ(ii+1,jj+1,kk+1,n,imax,jmax,0-gc,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2355,11 +2554,12 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=0-gc;k<0;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-gc;i<imax+gc;i++ ){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFZ(ii,jj,kk,n,imaxb,jmaxb,0-vc_comm,vc_comm)];
+      pa[i] = recvbuf[_IDXFZ(ii,jj,kk,n,imaxb,jmaxb,0-vc_comm,vc_comm)];
     }}}}
   }
 
@@ -2370,7 +2570,7 @@ cpm_ParaManagerLMR::unpackMZ( T *array, int imax, int jmax, int kmax, int nmax,
 // 袖通信(Scalar3D,4D,Vector3D版)の+Z面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPZ( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, int imax, int jmax, int kmax, int nmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2381,6 +2581,8 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = av.Leaf( leafIdx );
 
   // 展開
   if( levelDiff==0 )
@@ -2389,8 +2591,9 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFZ(i,j,k,n,imax,jmax,kmax,vc_comm)];
+      pa[i] = recvbuf[_IDXFZ(i,j,k,n,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2438,6 +2641,7 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
       int ii=(i-is)*2;
       int jj=(j-js)*2;
@@ -2451,7 +2655,7 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
             + recvbuf[_IDXFZ(ii  ,jj+1,kk+1,n,imax,jmax,kmax2,gc)]
             + recvbuf[_IDXFZ(ii+1,jj+1,kk+1,n,imax,jmax,kmax2,gc)];
       val *= 0.125;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = val;
+      pa[i] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2470,11 +2674,12 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
     for( int n=0;n<nmax;n++){
     for( int k=kmax;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k,n);
     for( int i=0-gc;i<imax+gc;i++ ){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=k/2;
-      array[_IDX_S4D_LMR(i,j,k,n,leafIdx,imax,jmax,kmax,nmax,vc)] = recvbuf[_IDXFZ(ii,jj,kk,n,imaxb,jmaxb,kmax2,vc_comm)];
+      pa[i] = recvbuf[_IDXFZ(ii,jj,kk,n,imaxb,jmaxb,kmax2,vc_comm)];
     }}}}
   }
 
@@ -2482,6 +2687,946 @@ cpm_ParaManagerLMR::unpackPZ( T *array, int imax, int jmax, int kmax, int nmax,
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信の１通信面分のパック(面方向、配列形状で振り分け)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::pack_LMR( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &avEx
+                            , bool bEx, int imax, int jmax, int kmax, int nmax, int vc_comm
+                            , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face
+                            , T* sendbuf, size_t nw, int procGrpNo )
+{
+  if( bEx )
+  {
+    switch( face )
+    {
+    case X_MINUS: return packMXEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case X_PLUS : return packPXEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Y_MINUS: return packMYEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Y_PLUS : return packPYEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Z_MINUS: return packMZEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Z_PLUS : return packPZEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    default     : break;
+    }
+  }
+  else
+  {
+    switch( face )
+    {
+    case X_MINUS: return packMX(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case X_PLUS : return packPX(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Y_MINUS: return packMY(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Y_PLUS : return packPY(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Z_MINUS: return packMZ(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    case Z_PLUS : return packPZ(av, imax, jmax, kmax, nmax, vc_comm, commInfo, sendbuf, nw, procGrpNo);
+    default     : break;
+    }
+  }
+
+  return CPM_ERROR_BNDCOMM;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信の１通信面分の展開(面方向、配列形状で振り分け)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::unpack_LMR( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4D> &av, const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &avEx
+                              , bool bEx, int imax, int jmax, int kmax, int nmax, int vc_comm
+                              , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face
+                              , T* recvbuf, int procGrpNo )
+{
+  if( bEx )
+  {
+    switch( face )
+    {
+    case X_MINUS: return unpackMXEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case X_PLUS : return unpackPXEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Y_MINUS: return unpackMYEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Y_PLUS : return unpackPYEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Z_MINUS: return unpackMZEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Z_PLUS : return unpackPZEx(avEx, nmax, imax, jmax, kmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    default     : break;
+    }
+  }
+  else
+  {
+    switch( face )
+    {
+    case X_MINUS: return unpackMX(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case X_PLUS : return unpackPX(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Y_MINUS: return unpackMY(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Y_PLUS : return unpackPY(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Z_MINUS: return unpackMZ(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    case Z_PLUS : return unpackPZ(av, imax, jmax, kmax, nmax, vc_comm, commInfo, recvbuf, procGrpNo);
+    default     : break;
+    }
+  }
+
+  return CPM_ERROR_BNDCOMM;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ランク間通信情報の全通信面のパック(スレッド並列)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::packLeafComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                    , cpm_LeafCommInfo *pLeafCommInfo, size_t sz_face[2], bool bPeriodic
+                                    , cpm_FaceFlag face, T* sendbuf, int &commsize, int procGrpNo )
+{
+  // 通信面毎のオフセット(成分数1)
+  std::vector<size_t> work;
+  const size_t *off = pLeafCommInfo->GetSendOffset( sz_face, vc_comm, bPeriodic, work );
+
+  // 配列ビュー(通信面毎のパック、展開で共有する)
+  cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>   av;
+  cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> avEx;
+  if( bEx )
+  {
+    avEx = cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX>( array, imax, jmax, kmax, nmax, vc );
+  }
+  else
+  {
+    av = cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>( array, imax, jmax, kmax, nmax, vc );
+  }
+
+  int nInfo = int(pLeafCommInfo->m_vecCommInfo.size());
+  commsize = int(nmax * off[nInfo]);
+
+  cpm_ErrorCode ret = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int j=0;j<nInfo;j++ )
+  {
+    cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
+    if( commInfo->bPeriodic != bPeriodic )
+    {
+      continue;
+    }
+
+    // パック
+    size_t csz = nmax * (off[j+1] - off[j]);
+    cpm_ErrorCode r = pack_LMR(av, avEx, bEx, imax, jmax, kmax, nmax, vc_comm, commInfo, face
+                             , sendbuf + nmax * off[j], csz, procGrpNo);
+    if( r != CPM_SUCCESS )
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      ret = r;
+    }
+  }
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ランク間通信情報の全通信面の展開(スレッド並列)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::unpackLeafComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                      , cpm_LeafCommInfo *pLeafCommInfo, size_t sz_face[2], bool bPeriodic
+                                      , cpm_FaceFlag face, T* recvbuf, int procGrpNo )
+{
+  // 通信面毎のオフセット(成分数1)
+  std::vector<size_t> work;
+  const size_t *off = pLeafCommInfo->GetRecvOffset( sz_face, vc_comm, bPeriodic, work );
+
+  // 通信面毎に展開先の袖領域は重ならないので、独立に展開できる
+  // 配列ビュー(通信面毎のパック、展開で共有する)
+  cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>   av;
+  cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> avEx;
+  if( bEx )
+  {
+    avEx = cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX>( array, imax, jmax, kmax, nmax, vc );
+  }
+  else
+  {
+    av = cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>( array, imax, jmax, kmax, nmax, vc );
+  }
+
+  int nInfo = int(pLeafCommInfo->m_vecCommInfo.size());
+  cpm_ErrorCode ret = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int j=0;j<nInfo;j++ )
+  {
+    cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
+    if( commInfo->bPeriodic != bPeriodic )
+    {
+      continue;
+    }
+
+    // 展開
+    cpm_ErrorCode r = unpack_LMR(av, avEx, bEx, imax, jmax, kmax, nmax, vc_comm, commInfo, face
+                               , recvbuf + nmax * off[j], procGrpNo);
+    if( r != CPM_SUCCESS )
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      ret = r;
+    }
+  }
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約袖通信の受信、パックと送信、ランク内コピー
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::sendrecv_LMR_Agg( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                    , int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 周期境界フラグ
+  bool bPeriodic = false;
+
+  // 面の並び(相手の送信面sface[i]が自身の受信面rface[i]に対応)
+  const cpm_FaceFlag sface[6] = {X_PLUS , X_MINUS, Y_PLUS , Y_MINUS, Z_PLUS , Z_MINUS};
+  const cpm_FaceFlag rface[6] = {X_MINUS, X_PLUS , Y_MINUS, Y_PLUS , Z_MINUS, Z_PLUS };
+
+  // 面内格子数
+  size_t sz_face[6][2] = { {size_t(jmax), size_t(kmax)}, {size_t(jmax), size_t(kmax)}
+                         , {size_t(imax), size_t(kmax)}, {size_t(imax), size_t(kmax)}
+                         , {size_t(imax), size_t(jmax)}, {size_t(imax), size_t(jmax)} };
+
+  // 通信マップの取得
+  LeafCommInfoMap *pSendMap[6], *pRecvMap[6];
+  for( int f=0;f<6;f++ )
+  {
+    pSendMap[f] = FindLeafCommInfoMap(sface[f], procGrpNo);
+    pRecvMap[f] = FindLeafCommInfoMap(rface[f], procGrpNo);
+    if( !pSendMap[f] || !pRecvMap[f] )
+    {
+      return CPM_ERROR_BNDCOMM_BUFFER;
+    }
+  }
+  AggCommInfoMap *pAggMap = GetAggCommInfoMap(procGrpNo);
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pAggMap || !pEdgeMap )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+  int sz[3] = {imax, jmax, kmax};
+
+  // 受信処理
+  for( AggCommInfoMap::iterator it=pAggMap->begin();it!=pAggMap->end();it++ )
+  {
+    int distRank = it->first;
+    stAggCommInfo &aggInfo = it->second;
+    aggInfo.reqRecv = MPI_REQUEST_NULL;
+
+    // 受信サイズの計算
+    size_t commsize = 0;
+    for( int f=0;f<6;f++ )
+    {
+      LeafCommInfoMap::iterator itL = pRecvMap[f]->find(distRank);
+      if( itL == pRecvMap[f]->end() ) continue;
+      std::vector<cpm_LeafCommInfo::stCommInfo*> &vecCommInfo = itL->second->m_vecCommInfo;
+      for( int j=0;j<vecCommInfo.size();j++ )
+      {
+        if( vecCommInfo[j]->bPeriodic == bPeriodic )
+        {
+          commsize += vecCommInfo[j]->CalcRecvBufferSize(sz_face[f], vc_comm, nmax);
+        }
+      }
+    }
+    EdgeCommInfoMap::iterator itE = pEdgeMap->find(distRank);
+    if( itE != pEdgeMap->end() )
+    {
+      std::vector<size_t> offset;
+      commsize += GetEdgeCommOffset(itE->second.recvPath, sz, nmax, vc, vc_comm, 0, offset);
+    }
+    if( commsize == 0 )
+    {
+      continue;
+    }
+
+    // 受信バッファ(不足時のみ拡張)
+    size_t nword = (commsize * sizeof(T) + sizeof(REAL_BUF_TYPE) - 1) / sizeof(REAL_BUF_TYPE);
+    if( aggInfo.recvbuf.size() < nword )
+    {
+      aggInfo.recvbuf.resize(nword);
+    }
+
+    // 受信
+    T* recvbuf = (T*)&aggInfo.recvbuf[0];
+    if( (ret = Irecv( recvbuf, (int)commsize, distRank, &aggInfo.reqRecv, procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // パックと送信処理
+  for( AggCommInfoMap::iterator it=pAggMap->begin();it!=pAggMap->end();it++ )
+  {
+    int distRank = it->first;
+    stAggCommInfo &aggInfo = it->second;
+    aggInfo.reqSend = MPI_REQUEST_NULL;
+
+    // 送信サイズの計算
+    size_t commsize = 0;
+    for( int f=0;f<6;f++ )
+    {
+      LeafCommInfoMap::iterator itL = pSendMap[f]->find(distRank);
+      if( itL == pSendMap[f]->end() ) continue;
+      std::vector<cpm_LeafCommInfo::stCommInfo*> &vecCommInfo = itL->second->m_vecCommInfo;
+      for( int j=0;j<vecCommInfo.size();j++ )
+      {
+        if( vecCommInfo[j]->bPeriodic == bPeriodic )
+        {
+          commsize += vecCommInfo[j]->CalcSendBufferSize(sz_face[f], vc_comm, nmax);
+        }
+      }
+    }
+    EdgeCommInfoMap::iterator itE = pEdgeMap->find(distRank);
+    std::vector<size_t> edgeOffset;
+    if( itE != pEdgeMap->end() )
+    {
+      commsize += GetEdgeCommOffset(itE->second.sendPath, sz, nmax, vc, vc_comm, 0, edgeOffset);
+    }
+    if( commsize == 0 )
+    {
+      continue;
+    }
+
+    // 送信バッファ(不足時のみ拡張)
+    size_t nword = (commsize * sizeof(T) + sizeof(REAL_BUF_TYPE) - 1) / sizeof(REAL_BUF_TYPE);
+    if( aggInfo.sendbuf.size() < nword )
+    {
+      aggInfo.sendbuf.resize(nword);
+    }
+    T* sendbuf = (T*)&aggInfo.sendbuf[0];
+
+    // 6面分のパック
+    T *ptr = sendbuf;
+    for( int f=0;f<6;f++ )
+    {
+      LeafCommInfoMap::iterator itL = pSendMap[f]->find(distRank);
+      if( itL == pSendMap[f]->end() ) continue;
+      int csz = 0;
+      if( (ret = packLeafComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, itL->second, sz_face[f], bPeriodic
+                                , sface[f], ptr, csz, procGrpNo)) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+      ptr += csz;
+    }
+
+    // 辺、頂点方向のパック(6面分の後ろに連結)
+    if( itE != pEdgeMap->end() )
+    {
+      if( (ret = packEdgeComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, itE->second.sendPath, edgeOffset
+                                , ptr, procGrpNo)) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+    }
+
+    // 送信
+    if( (ret = Isend( sendbuf, (int)commsize, distRank, &aggInfo.reqSend, procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // ランク内コピー処理
+  const cpm_DirFlag dir[3] = {X_DIR, Y_DIR, Z_DIR};
+  for( int d=0;d<3;d++ )
+  {
+    LeafCommInfoMap &commInfoMapM = *pRecvMap[2*d];
+    LeafCommInfoMap &commInfoMapP = *pRecvMap[2*d+1];
+    if( bEx )
+    {
+      ret = copy_LMR_Ex(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoMapM, commInfoMapP, bPeriodic, dir[d], BOTH, procGrpNo);
+    }
+    else
+    {
+      ret = copy_LMR(array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoMapM, commInfoMapP, bPeriodic, dir[d], BOTH, procGrpNo);
+    }
+    if( ret != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約袖通信の受信待機と展開、辺、頂点方向のランク内コピー、送信待機
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::wait_LMR_Agg( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 周期境界フラグ
+  bool bPeriodic = false;
+
+  // 受信面の並び
+  const cpm_FaceFlag rface[6] = {X_MINUS, X_PLUS , Y_MINUS, Y_PLUS , Z_MINUS, Z_PLUS };
+
+  // 面内格子数
+  size_t sz_face[6][2] = { {size_t(jmax), size_t(kmax)}, {size_t(jmax), size_t(kmax)}
+                         , {size_t(imax), size_t(kmax)}, {size_t(imax), size_t(kmax)}
+                         , {size_t(imax), size_t(jmax)}, {size_t(imax), size_t(jmax)} };
+
+  // 通信マップの取得
+  LeafCommInfoMap *pRecvMap[6];
+  for( int f=0;f<6;f++ )
+  {
+    pRecvMap[f] = FindLeafCommInfoMap(rface[f], procGrpNo);
+    if( !pRecvMap[f] )
+    {
+      return CPM_ERROR_BNDCOMM_BUFFER;
+    }
+  }
+  AggCommInfoMap *pAggMap = GetAggCommInfoMap(procGrpNo);
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pAggMap || !pEdgeMap )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+  int sz[3] = {imax, jmax, kmax};
+
+  // 受信バッファ内の辺、頂点方向のデータの先頭位置
+  std::map<int, size_t> edgeStart;
+
+  // 受信待機と6面分の展開
+  for( AggCommInfoMap::iterator it=pAggMap->begin();it!=pAggMap->end();it++ )
+  {
+    int distRank = it->first;
+    stAggCommInfo &aggInfo = it->second;
+
+    // リクエストNULLのとき何もしない
+    if( aggInfo.reqRecv == MPI_REQUEST_NULL )
+    {
+      continue;
+    }
+
+    // Wait
+    if( (ret = Wait( &aggInfo.reqRecv )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    aggInfo.reqRecv = MPI_REQUEST_NULL;
+
+    // 6面分の展開
+    T *ptr = (T*)&aggInfo.recvbuf[0];
+    for( int f=0;f<6;f++ )
+    {
+      LeafCommInfoMap::iterator itL = pRecvMap[f]->find(distRank);
+      if( itL == pRecvMap[f]->end() ) continue;
+      if( (ret = unpackLeafComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, itL->second, sz_face[f], bPeriodic
+                                  , rface[f], ptr, procGrpNo)) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+      std::vector<size_t> work;
+      const size_t *off = itL->second->GetRecvOffset(sz_face[f], vc_comm, bPeriodic, work);
+      ptr += nmax * off[itL->second->m_vecCommInfo.size()];
+    }
+    edgeStart[distRank] = size_t(ptr - (T*)&aggInfo.recvbuf[0]);
+  }
+
+  // 辺、頂点方向の展開
+  //  - 全ランクの面の展開後に行い、面の袖通信で書かれた辺、頂点の袖を上書きする
+  for( std::map<int, size_t>::iterator it=edgeStart.begin();it!=edgeStart.end();it++ )
+  {
+    EdgeCommInfoMap::iterator itE = pEdgeMap->find(it->first);
+    if( itE == pEdgeMap->end() )
+    {
+      continue;
+    }
+    std::vector<size_t> offset;
+    if( GetEdgeCommOffset(itE->second.recvPath, sz, nmax, vc, vc_comm, 0, offset) == 0 )
+    {
+      continue;
+    }
+    const T *ptr = (const T*)&(*pAggMap)[it->first].recvbuf[0] + it->second;
+    if( (ret = unpackEdgeComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, itE->second.recvPath, offset
+                                , ptr, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 辺、頂点方向のランク内コピー
+  if( (ret = copy_LMR_Edge(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 送信待機
+  for( AggCommInfoMap::iterator it=pAggMap->begin();it!=pAggMap->end();it++ )
+  {
+    stAggCommInfo &aggInfo = it->second;
+    if( aggInfo.reqSend == MPI_REQUEST_NULL )
+    {
+      continue;
+    }
+    if( (ret = Wait( &aggInfo.reqSend )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    aggInfo.reqSend = MPI_REQUEST_NULL;
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１方向の受信の開始、仮想セルのパックと送信、ランク内の集約
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::sendrecvReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                       , cpm_DirFlag dir, bool bPeriodic, CPM_Op op, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  // 面方向と面内格子数
+  cpm_FaceFlag face[2] = {cpm_FaceFlag(2*int(dir)), cpm_FaceFlag(2*int(dir)+1)};
+  size_t sz_face[2];
+  if( dir==X_DIR )
+  {
+    sz_face[0] = jmax;
+    sz_face[1] = kmax;
+  }
+  else if( dir==Y_DIR )
+  {
+    sz_face[0] = imax;
+    sz_face[1] = kmax;
+  }
+  else
+  {
+    sz_face[0] = imax;
+    sz_face[1] = jmax;
+  }
+
+  // 通信マップの取得
+  LeafCommInfoMap *commInfoMap[2];
+  for( int pm=0;pm<2;pm++ )
+  {
+    if( !(commInfoMap[pm] = FindLeafCommInfoMap(face[pm], procGrpNo)) )
+    {
+      return CPM_ERROR_BNDCOMM_BUFFER;
+    }
+  }
+
+  // 受信(順方向の送信バッファで受信する、マイナス方向、プラス方向の順)
+  for( int pm=0;pm<2;pm++ )
+  {
+    for( LeafCommInfoMap::iterator it=commInfoMap[pm]->begin();it!=commInfoMap[pm]->end();it++ )
+    {
+      int distRank = it->first;
+      cpm_LeafCommInfo* pLeafCommInfo = it->second;
+      pLeafCommInfo->m_reqRecv = MPI_REQUEST_NULL;
+      if( m_rankNo == distRank )
+      {
+        continue;
+      }
+
+      std::vector<size_t> work;
+      const size_t *off = pLeafCommInfo->GetSendOffset( sz_face, vc_comm, bPeriodic, work );
+      int commsize = int(nmax * off[pLeafCommInfo->m_vecCommInfo.size()]);
+      if( commsize > 0 )
+      {
+        T* recvbuf = (T*)pLeafCommInfo->GetBndCommSendBufferPtr();
+        if( (ret = Irecv( recvbuf, commsize, distRank, &pLeafCommInfo->m_reqRecv, procGrpNo )) != CPM_SUCCESS )
+        {
+          return ret;
+        }
+      }
+    }
+  }
+
+  // 仮想セルのパックと送信(順方向の受信バッファから送信する、プラス方向、マイナス方向の順)
+  for( int pm=1;pm>=0;pm-- )
+  {
+    for( LeafCommInfoMap::iterator it=commInfoMap[pm]->begin();it!=commInfoMap[pm]->end();it++ )
+    {
+      int distRank = it->first;
+      cpm_LeafCommInfo* pLeafCommInfo = it->second;
+      pLeafCommInfo->m_reqSend = MPI_REQUEST_NULL;
+      if( m_rankNo == distRank )
+      {
+        continue;
+      }
+
+      std::vector<size_t> work;
+      const size_t *off = pLeafCommInfo->GetRecvOffset( sz_face, vc_comm, bPeriodic, work );
+      int nInfo = int(pLeafCommInfo->m_vecCommInfo.size());
+      int commsize = int(nmax * off[nInfo]);
+      T* sendbuf = (T*)pLeafCommInfo->GetBndCommRecvBufferPtr();
+      for( int j=0;j<nInfo;j++ )
+      {
+        cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
+        if( commInfo->bPeriodic != bPeriodic )
+        {
+          continue;
+        }
+        if( (ret = packReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, face[pm], op
+                                  , sendbuf + nmax * off[j], procGrpNo )) != CPM_SUCCESS )
+        {
+          return ret;
+        }
+      }
+      if( commsize > 0 )
+      {
+        if( (ret = Isend( sendbuf, commsize, distRank, &pLeafCommInfo->m_reqSend, procGrpNo )) != CPM_SUCCESS )
+        {
+          return ret;
+        }
+      }
+    }
+  }
+
+  // ランク内の集約(リーフペアの集約先の領域が重なることがあるため逐次処理)
+  LeafCommInfoMap::iterator itM = commInfoMap[0]->find(m_rankNo);
+  LeafCommInfoMap::iterator itP = commInfoMap[1]->find(m_rankNo);
+  if( itM == commInfoMap[0]->end() || itP == commInfoMap[1]->end() )
+  {
+    return CPM_SUCCESS;
+  }
+  cpm_LeafCommInfo* pLeafCommInfoM = itM->second;
+  cpm_LeafCommInfo* pLeafCommInfoP = itP->second;
+  std::vector<T> work;
+  for( size_t j=0;j<pLeafCommInfoM->m_vecCommInfo.size();j++ )
+  {
+    cpm_LeafCommInfo::stCommInfo* commInfoM = pLeafCommInfoM->m_vecCommInfo[j];
+    if( commInfoM->bPeriodic != bPeriodic )
+    {
+      continue;
+    }
+    cpm_LeafCommInfo::stCommInfo* commInfoP = pLeafCommInfoP->SearchDistCommInfo(commInfoM);
+    if( !commInfoP )
+    {
+      return CPM_ERROR;
+    }
+
+    // プラス側リーフの袖 -> マイナス側リーフの内部
+    work.resize( commInfoP->CalcRecvBufferSize( sz_face, vc_comm, nmax ) );
+    if( (ret = packReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, face[1], op, &work[0], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    if( (ret = unpackReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, face[0], op, &work[0], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+
+    // マイナス側リーフの袖 -> プラス側リーフの内部
+    work.resize( commInfoM->CalcRecvBufferSize( sz_face, vc_comm, nmax ) );
+    if( (ret = packReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoM, face[0], op, &work[0], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    if( (ret = unpackReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfoP, face[1], op, &work[0], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１方向の受信待機と内部セルへの集約、送信待機
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::waitReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , cpm_DirFlag dir, bool bPeriodic, CPM_Op op, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  // 面方向と面内格子数
+  cpm_FaceFlag face[2] = {cpm_FaceFlag(2*int(dir)), cpm_FaceFlag(2*int(dir)+1)};
+  size_t sz_face[2];
+  if( dir==X_DIR )
+  {
+    sz_face[0] = jmax;
+    sz_face[1] = kmax;
+  }
+  else if( dir==Y_DIR )
+  {
+    sz_face[0] = imax;
+    sz_face[1] = kmax;
+  }
+  else
+  {
+    sz_face[0] = imax;
+    sz_face[1] = jmax;
+  }
+
+  // 受信待機と集約(リーフペアの集約先の領域が重なることがあるため逐次処理)
+  for( int pm=0;pm<2;pm++ )
+  {
+    LeafCommInfoMap *commInfoMap = FindLeafCommInfoMap(face[pm], procGrpNo);
+    if( !commInfoMap )
+    {
+      return CPM_ERROR_BNDCOMM_BUFFER;
+    }
+    for( LeafCommInfoMap::iterator it=commInfoMap->begin();it!=commInfoMap->end();it++ )
+    {
+      cpm_LeafCommInfo* pLeafCommInfo = it->second;
+      if( m_rankNo == it->first || pLeafCommInfo->m_reqRecv == MPI_REQUEST_NULL )
+      {
+        continue;
+      }
+      if( (ret = Wait( &pLeafCommInfo->m_reqRecv )) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+      pLeafCommInfo->m_reqRecv = MPI_REQUEST_NULL;
+
+      std::vector<size_t> work;
+      const size_t *off = pLeafCommInfo->GetSendOffset( sz_face, vc_comm, bPeriodic, work );
+      T* recvbuf = (T*)pLeafCommInfo->GetBndCommSendBufferPtr();
+      for( size_t j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
+      {
+        cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
+        if( commInfo->bPeriodic != bPeriodic )
+        {
+          continue;
+        }
+        if( (ret = unpackReverse_LMR( array, imax, jmax, kmax, nmax, vc, vc_comm, commInfo, face[pm], op
+                                    , recvbuf + nmax * off[j], procGrpNo )) != CPM_SUCCESS )
+        {
+          return ret;
+        }
+      }
+    }
+  }
+
+  // 送信待機
+  for( int pm=0;pm<2;pm++ )
+  {
+    LeafCommInfoMap *commInfoMap = FindLeafCommInfoMap(face[pm], procGrpNo);
+    for( LeafCommInfoMap::iterator it=commInfoMap->begin();it!=commInfoMap->end();it++ )
+    {
+      cpm_LeafCommInfo* pLeafCommInfo = it->second;
+      if( pLeafCommInfo->m_reqSend == MPI_REQUEST_NULL )
+      {
+        continue;
+      }
+      if( (ret = Wait( &pLeafCommInfo->m_reqSend )) != CPM_SUCCESS )
+      {
+        return ret;
+      }
+      pLeafCommInfo->m_reqSend = MPI_REQUEST_NULL;
+    }
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１通信面分の仮想セルのパック(順方向の展開の逆操作)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::packReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face, CPM_Op op
+                                   , T* buf, int procGrpNo )
+{
+  // 法線方向の軸と正負
+  int  na    = int(face) / 2;
+  bool bPlus = (int(face) % 2 == 1);
+
+  // リーフの配列ビュー
+  int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  if( leafIdx < 0 )
+  {
+    return CPM_ERROR;
+  }
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>( array, imax, jmax, kmax, nmax, vc ).Leaf( leafIdx );
+
+  // 軸毎の袖の範囲[ds,de)と、順方向の受信バッファの始点bs、サイズnb
+  //  - levelDiff== 0 : バッファ位置 x-bs
+  //  - levelDiff== 1 : バッファ位置 2*(x-bs)、+1の8点(自身がcoarse、1/4面の袖)
+  //  - levelDiff==-1 : バッファ位置 (x+2)/2-1-bs(自身がfine、2倍の袖)
+  //  順方向の展開(unpackMX等)と同じインデクスとなる
+  static const int qbit[3][3] = { {-1, 0, 1}, { 1,-1, 0}, { 0, 1,-1} };
+  int levelDiff = commInfo->iLevelDiff;
+  int gc = vc_comm;
+  int sz[3] = {imax, jmax, kmax};
+  int ds[3], de[3], bs[3], nb[3];
+  for( int d=0;d<3;d++ )
+  {
+    int m = sz[d];
+    if( d == na )
+    {
+      int gn = (levelDiff==-1) ? 2*gc : gc;
+      ds[d] = bPlus ? m : -gn;
+      de[d] = ds[d] + gn;
+      bs[d] = (levelDiff==-1) ? (bPlus ? m/2 : -gc) : ds[d];
+      nb[d] = (levelDiff==1) ? 2*gc : gc;
+    }
+    else if( levelDiff==0 )
+    {
+      ds[d] = -gc;
+      de[d] = m+gc;
+      bs[d] = -gc;
+      nb[d] = m+2*gc;
+    }
+    else if( levelDiff==1 )
+    {
+      int q  = (commInfo->iFaceIdx >> qbit[na][d]) & 1;
+      int ts = q * (m/2);
+      ds[d] = q ? ts   : -gc;
+      de[d] = q ? m+gc : ts+m/2;
+      bs[d] = ts-gc;
+      nb[d] = m+4*gc;
+    }
+    else
+    {
+      ds[d] = -2*gc;
+      de[d] = m+2*gc;
+      bs[d] = -gc;
+      nb[d] = m/2+2*gc;
+    }
+  }
+
+  // バッファを演算の単位元で初期化
+  size_t nw = size_t(nb[0]) * size_t(nb[1]) * size_t(nb[2]) * size_t(nmax);
+  T ident = ReduceIdentity<T>(op);
+  for( size_t i=0;i<nw;i++ )
+  {
+    buf[i] = ident;
+  }
+
+  // 袖の値をバッファへ集約
+  //  - fine -> coarseの平均の逆操作は1/8ずつ配分、coarse -> fineの複写の逆操作は8cellを集約
+  T w = (op==CPM_SUM && levelDiff==1) ? T(0.125) : T(1);
+  for( int n=0;n<nmax;n++ ){
+  for( int k=ds[2];k<de[2];k++ ){
+  for( int j=ds[1];j<de[1];j++ ){
+    T *pa = a.Row(j,k,n);
+    for( int i=ds[0];i<de[0];i++ ){
+      T val = pa[i] * w;
+      if( levelDiff==1 )
+      {
+        int t0 = 2*(i-bs[0]);
+        int t1 = 2*(j-bs[1]);
+        int t2 = 2*(k-bs[2]);
+        for( int dk=0;dk<2;dk++ ){
+        for( int dj=0;dj<2;dj++ ){
+        for( int di=0;di<2;di++ ){
+          buf[((size_t(n)*nb[2] + (t2+dk))*nb[1] + (t1+dj))*nb[0] + (t0+di)] = val;
+        }}}
+        continue;
+      }
+      int t0 = i-bs[0];
+      int t1 = j-bs[1];
+      int t2 = k-bs[2];
+      if( levelDiff==-1 )
+      {
+        t0 = (i+2)/2-1-bs[0];
+        t1 = (j+2)/2-1-bs[1];
+        t2 = (k+2)/2-1-bs[2];
+      }
+      T &b = buf[((size_t(n)*nb[2] + t2)*nb[1] + t1)*nb[0] + t0];
+      if( op==CPM_SUM )
+      {
+        b += val;
+      }
+      else if( op==CPM_MIN )
+      {
+        if( val < b ) b = val;
+      }
+      else
+      {
+        if( val > b ) b = val;
+      }
+    }
+  }}}
+
+  // 和のときは送信した袖を0にする
+  if( op==CPM_SUM )
+  {
+    int gbox[6] = {ds[0], ds[1], ds[2], de[0]-ds[0], de[1]-ds[1], de[2]-ds[2]};
+    FillBox( a, gbox, T(0) );
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１通信面分の内部セルへの集約(順方向のパックの逆操作)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::unpackReverse_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                     , cpm_LeafCommInfo::stCommInfo* commInfo, cpm_FaceFlag face, CPM_Op op
+                                     , const T* buf, int procGrpNo )
+{
+  // 法線方向の軸と正負
+  int  na    = int(face) / 2;
+  bool bPlus = (int(face) % 2 == 1);
+
+  // リーフの配列ビュー
+  int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  if( leafIdx < 0 )
+  {
+    return CPM_ERROR;
+  }
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a = cpm_ArrayViewLMR<T, CPM_ARRAY_S4D>( array, imax, jmax, kmax, nmax, vc ).Leaf( leafIdx );
+
+  // 順方向の送信範囲(packMX等と同じ)
+  //  - levelDiff== 1 : 1/4面(自身がcoarse)
+  //  - levelDiff==-1 : 層数を2倍(自身がfine)
+  static const int qbit[3][3] = { {-1, 0, 1}, { 1,-1, 0}, { 0, 1,-1} };
+  int levelDiff = commInfo->iLevelDiff;
+  int gc = vc_comm;
+  int sz[3] = {imax, jmax, kmax};
+  int box[6];
+  for( int d=0;d<3;d++ )
+  {
+    int m = sz[d];
+    int g = (levelDiff==-1) ? 2*gc : gc;
+    if( d == na )
+    {
+      box[d]   = bPlus ? m-g : 0;
+      box[d+3] = g;
+    }
+    else if( levelDiff==1 )
+    {
+      int q  = (commInfo->iFaceIdx >> qbit[na][d]) & 1;
+      box[d]   = q * (m/2) - gc;
+      box[d+3] = m/2 + 2*gc;
+    }
+    else
+    {
+      box[d]   = -g;
+      box[d+3] = m + 2*g;
+    }
+  }
+
+  ReduceBox( a, box, buf, op );
+
+  return CPM_SUCCESS;
+}
+
+
 
 #undef _IDXFX
 #undef _IDXFY
@@ -0,0 +1,486 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManagerLMR_BndCommEdge.h
+ * LMR用パラレルマネージャクラスの辺、頂点方向の袖通信のインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_BNDCOMM_EDGE_LMR_H_
+#define _CPM_PARAMANAGER_BNDCOMM_EDGE_LMR_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の周期境界袖通信(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::PeriodicCommEdgeS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                       , int periodicMask, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( periodicMask <= 0 || periodicMask > 7 )
+  {
+    return CPM_ERROR_PERIODIC_INVALID_DIR;
+  }
+
+  if( (ret = sendrecv_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, periodicMask, procGrpNo)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  return wait_LMR_Edge(array, false, imax, jmax, kmax, nmax, vc, vc_comm, periodicMask, procGrpNo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の周期境界袖通信(Scalar4DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::PeriodicCommEdgeS4DEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+                                         , int periodicMask, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( periodicMask <= 0 || periodicMask > 7 )
+  {
+    return CPM_ERROR_PERIODIC_INVALID_DIR;
+  }
+
+  if( (ret = sendrecv_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, periodicMask, procGrpNo)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  return wait_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, periodicMask, procGrpNo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の1パス分のパック
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::packEdge_LMR( const T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                , const stEdgeCommPath &path, T *buf, int procGrpNo )
+{
+  // 受信側の袖の範囲
+  int sz[3] = {imax, jmax, kmax};
+  int rs[3], re[3], so[3];
+  if( !GetEdgeCommRange(path, sz, vc, vc_comm, rs, re, so) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 送信側リーフの配列ビュー
+  int srcIdx = GetLocalLeafIndex_byID(path.iSendLeafID, procGrpNo);
+  if( srcIdx < 0 )
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
+  cpm_ArrayViewLMR<T, Layout> av( const_cast<T*>(array), imax, jmax, kmax, nmax, vc );
+  cpm_ArrayView<T, Layout> s = av.Leaf( srcIdx );
+  ptrdiff_t st = s.StrideI();
+  ptrdiff_t sn = s.StrideN();
+
+  int ld = path.iLevelDiff;
+  int r  = 1 << (ld < 0 ? -ld : ld);
+  T *p = buf;
+  if( ld <= 0 )
+  {
+    // 同じレベル、またはcoarse -> fine(粗いセルの値)
+    for( int n=0;n<nmax;n++ ){
+    for( int k=rs[2];k<re[2];k++ ){
+    for( int j=rs[1];j<re[1];j++ ){
+      const T* ps = s.Cell(0, (j+so[1])/r, (k+so[2])/r) + n*sn;
+      for( int i=rs[0];i<re[0];i++ ){
+        *p++ = ps[((i+so[0])/r)*st];
+      }
+    }}}
+  }
+  else
+  {
+    // fine -> coarse(r^3セルの平均)
+    double w = 1.0 / double(r*r*r);
+    for( int n=0;n<nmax;n++ ){
+    for( int k=rs[2];k<re[2];k++ ){
+    for( int j=rs[1];j<re[1];j++ ){
+    for( int i=rs[0];i<re[0];i++ ){
+      double sum = 0.0;
+      for( int kk=0;kk<r;kk++ ){
+      for( int jj=0;jj<r;jj++ ){
+        const T* ps = s.Cell(0, j*r+so[1]+jj, k*r+so[2]+kk) + n*sn;
+        for( int ii=0;ii<r;ii++ ){
+          sum += double(ps[(i*r+so[0]+ii)*st]);
+        }
+      }}
+      *p++ = T(sum * w);
+    }}}}
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の1パス分の展開
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::unpackEdge_LMR( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , const stEdgeCommPath &path, const T *buf, int procGrpNo )
+{
+  // 受信側の袖の範囲
+  int sz[3] = {imax, jmax, kmax};
+  int rs[3], re[3], so[3];
+  if( !GetEdgeCommRange(path, sz, vc, vc_comm, rs, re, so) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 受信側リーフの配列ビュー
+  int dstIdx = GetLocalLeafIndex_byID(path.iRecvLeafID, procGrpNo);
+  if( dstIdx < 0 )
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
+  cpm_ArrayViewLMR<T, Layout> av( array, imax, jmax, kmax, nmax, vc );
+  cpm_ArrayView<T, Layout> d = av.Leaf( dstIdx );
+  ptrdiff_t st = d.StrideI();
+  ptrdiff_t sn = d.StrideN();
+
+  const T *p = buf;
+  for( int n=0;n<nmax;n++ ){
+  for( int k=rs[2];k<re[2];k++ ){
+  for( int j=rs[1];j<re[1];j++ ){
+    T* pd = d.Cell(0, j, k) + n*sn;
+    for( int i=rs[0];i<re[0];i++ ){
+      pd[i*st] = *p++;
+    }
+  }}}
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の通信相手1ランク分のパック
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::packEdgeComm_LMR( const T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                    , const std::vector<stEdgeCommPath> &paths, const std::vector<size_t> &offset
+                                    , T *buf, int procGrpNo )
+{
+  // パス毎のパック
+  int nPath = int(paths.size());
+  int err = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int n=0;n<nPath;n++ )
+  {
+    if( offset[n+1] == offset[n] ) continue;
+    const stEdgeCommPath &path = paths[n];
+    cpm_ErrorCode iret = bEx
+      ? packEdge_LMR<T, CPM_ARRAY_S4DEX>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, buf+offset[n], procGrpNo)
+      : packEdge_LMR<T, CPM_ARRAY_S4D  >(array, imax, jmax, kmax, nmax, vc, vc_comm, path, buf+offset[n], procGrpNo);
+    if( iret != CPM_SUCCESS )
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      err = iret;
+    }
+  }
+
+  return cpm_ErrorCode(err);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の通信相手1ランク分の展開
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::unpackEdgeComm_LMR( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                      , const std::vector<stEdgeCommPath> &paths, const std::vector<size_t> &offset
+                                      , const T *buf, int procGrpNo )
+{
+  // パス毎の展開
+  int nPath = int(paths.size());
+  int err = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int n=0;n<nPath;n++ )
+  {
+    if( offset[n+1] == offset[n] ) continue;
+    const stEdgeCommPath &path = paths[n];
+    cpm_ErrorCode iret = bEx
+      ? unpackEdge_LMR<T, CPM_ARRAY_S4DEX>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, buf+offset[n], procGrpNo)
+      : unpackEdge_LMR<T, CPM_ARRAY_S4D  >(array, imax, jmax, kmax, nmax, vc, vc_comm, path, buf+offset[n], procGrpNo);
+    if( iret != CPM_SUCCESS )
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      err = iret;
+    }
+  }
+
+  return cpm_ErrorCode(err);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信のランク内コピー
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::copy_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                 , int periodicMask, int procGrpNo )
+{
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pEdgeMap )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+  EdgeCommInfoMap::iterator itS = pEdgeMap->find(m_rankNo);
+  if( itS == pEdgeMap->end() )
+  {
+    return CPM_SUCCESS;
+  }
+  int sz[3] = {imax, jmax, kmax};
+
+  // 書き込みは受信側リーフの辺、頂点の袖、読み込みは送信側リーフの内部のみのため、
+  // パス間で競合しない
+  const std::vector<stEdgeCommPath> &paths = itS->second.recvPath;
+  std::vector<size_t> offset;
+  GetEdgeCommOffset(paths, sz, nmax, vc, vc_comm, periodicMask, offset);
+  int nPath = int(paths.size());
+  int err = CPM_SUCCESS;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    std::vector<T> work;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for( int n=0;n<nPath;n++ )
+    {
+      size_t cnt = offset[n+1] - offset[n];
+      if( cnt == 0 ) continue;
+      if( work.size() < cnt )
+      {
+        work.resize(cnt);
+      }
+      const stEdgeCommPath &path = paths[n];
+      cpm_ErrorCode iret;
+      if( bEx )
+      {
+        iret = packEdge_LMR<T, CPM_ARRAY_S4DEX>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, &work[0], procGrpNo);
+        if( iret == CPM_SUCCESS )
+        {
+          iret = unpackEdge_LMR<T, CPM_ARRAY_S4DEX>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, &work[0], procGrpNo);
+        }
+      }
+      else
+      {
+        iret = packEdge_LMR<T, CPM_ARRAY_S4D>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, &work[0], procGrpNo);
+        if( iret == CPM_SUCCESS )
+        {
+          iret = unpackEdge_LMR<T, CPM_ARRAY_S4D>(array, imax, jmax, kmax, nmax, vc, vc_comm, path, &work[0], procGrpNo);
+        }
+      }
+      if( iret != CPM_SUCCESS )
+      {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        err = iret;
+      }
+    }
+  }
+
+  return cpm_ErrorCode(err);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の受信、パックと送信
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::sendrecv_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                     , int periodicMask, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pEdgeMap )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+  int sz[3] = {imax, jmax, kmax};
+
+  // 受信処理
+  for( EdgeCommInfoMap::iterator it=pEdgeMap->begin();it!=pEdgeMap->end();it++ )
+  {
+    int distRank = it->first;
+    stEdgeCommInfo &edgeInfo = it->second;
+    edgeInfo.reqRecv = MPI_REQUEST_NULL;
+    if( distRank == m_rankNo )
+    {
+      continue;
+    }
+
+    // 受信サイズ
+    std::vector<size_t> offset;
+    size_t commsize = GetEdgeCommOffset(edgeInfo.recvPath, sz, nmax, vc, vc_comm, periodicMask, offset);
+    if( commsize == 0 )
+    {
+      continue;
+    }
+
+    // 受信バッファ(不足時のみ拡張)
+    size_t nword = (commsize * sizeof(T) + sizeof(REAL_BUF_TYPE) - 1) / sizeof(REAL_BUF_TYPE);
+    if( edgeInfo.recvbuf.size() < nword )
+    {
+      edgeInfo.recvbuf.resize(nword);
+    }
+
+    // 受信
+    T* recvbuf = (T*)&edgeInfo.recvbuf[0];
+    if( (ret = Irecv( recvbuf, (int)commsize, distRank, &edgeInfo.reqRecv, procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // パックと送信処理
+  for( EdgeCommInfoMap::iterator it=pEdgeMap->begin();it!=pEdgeMap->end();it++ )
+  {
+    int distRank = it->first;
+    stEdgeCommInfo &edgeInfo = it->second;
+    edgeInfo.reqSend = MPI_REQUEST_NULL;
+    if( distRank == m_rankNo )
+    {
+      continue;
+    }
+
+    // 送信サイズとパス毎の先頭位置
+    std::vector<size_t> offset;
+    size_t commsize = GetEdgeCommOffset(edgeInfo.sendPath, sz, nmax, vc, vc_comm, periodicMask, offset);
+    if( commsize == 0 )
+    {
+      continue;
+    }
+
+    // 送信バッファ(不足時のみ拡張)
+    size_t nword = (commsize * sizeof(T) + sizeof(REAL_BUF_TYPE) - 1) / sizeof(REAL_BUF_TYPE);
+    if( edgeInfo.sendbuf.size() < nword )
+    {
+      edgeInfo.sendbuf.resize(nword);
+    }
+    T* sendbuf = (T*)&edgeInfo.sendbuf[0];
+
+    // パック
+    if( (ret = packEdgeComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, edgeInfo.sendPath, offset
+                              , sendbuf, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+
+    // 送信
+    if( (ret = Isend( sendbuf, (int)commsize, distRank, &edgeInfo.reqSend, procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信の受信待機と展開、ランク内コピー、送信待機
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManagerLMR::wait_LMR_Edge( T *array, bool bEx, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                 , int periodicMask, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pEdgeMap )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+  int sz[3] = {imax, jmax, kmax};
+
+  // 受信待機と展開
+  //  - 面の袖通信の展開後に行い、面の袖通信で書かれた辺、頂点の袖を上書きする
+  for( EdgeCommInfoMap::iterator it=pEdgeMap->begin();it!=pEdgeMap->end();it++ )
+  {
+    stEdgeCommInfo &edgeInfo = it->second;
+
+    // リクエストNULLのとき何もしない
+    if( edgeInfo.reqRecv == MPI_REQUEST_NULL )
+    {
+      continue;
+    }
+
+    // Wait
+    if( (ret = Wait( &edgeInfo.reqRecv )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    edgeInfo.reqRecv = MPI_REQUEST_NULL;
+
+    // 展開
+    std::vector<size_t> offset;
+    GetEdgeCommOffset(edgeInfo.recvPath, sz, nmax, vc, vc_comm, periodicMask, offset);
+    if( (ret = unpackEdgeComm_LMR(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, edgeInfo.recvPath, offset
+                                , (const T*)&edgeInfo.recvbuf[0], procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // ランク内コピー処理
+  if( (ret = copy_LMR_Edge(array, bEx, imax, jmax, kmax, nmax, vc, vc_comm, periodicMask, procGrpNo)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 送信待機
+  for( EdgeCommInfoMap::iterator it=pEdgeMap->begin();it!=pEdgeMap->end();it++ )
+  {
+    stEdgeCommInfo &edgeInfo = it->second;
+    if( edgeInfo.reqSend == MPI_REQUEST_NULL )
+    {
+      continue;
+    }
+    if( (ret = Wait( &edgeInfo.reqSend )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    edgeInfo.reqSend = MPI_REQUEST_NULL;
+  }
+
+  // 正常終了
+  return CPM_SUCCESS;
+}
+
+#endif /* _CPM_PARAMANAGER_BNDCOMM_EDGE_LMR_H_ */
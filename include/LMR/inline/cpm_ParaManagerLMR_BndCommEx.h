@@ -103,6 +103,37 @@ cpm_ParaManagerLMR::BndCommS4DEx( T *array, int nmax, int imax, int jmax, int km
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    if( (ret = sendrecv_LMR_Agg(array, true, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    if( (ret = wait_LMR_Agg(array, true, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    // 登録フィールドの通信済みを記録
+    commitFieldComm( array );
+    return CPM_SUCCESS;
+  }
+
+  // 辺、頂点方向の袖通信(送信側の内部セルのみを送るため、面の袖通信より先に開始する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = sendrecv_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -324,6 +355,18 @@ cpm_ParaManagerLMR::BndCommS4DEx( T *array, int nmax, int imax, int jmax, int km
   } // ZDIR
 
 
+  // 辺、頂点方向の袖通信(面の袖通信の展開後に展開する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = wait_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   // 正常終了
   return CPM_SUCCESS;
 }
@@ -341,6 +384,27 @@ cpm_ParaManagerLMR::BndCommS4DEx_nowait( T *array, int nmax, int imax, int jmax,
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    return sendrecv_LMR_Agg(array, true, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo);
+  }
+
+  // 辺、頂点方向の袖通信(送信側の内部セルのみを送るため、面の袖通信より先に開始する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = sendrecv_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -512,6 +576,24 @@ cpm_ParaManagerLMR::wait_BndCommS4DEx( T *array, int nmax, int imax, int jmax, i
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 非同期袖通信を省略したときは展開も省略
+  if( endFieldComm( array ) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 集約袖通信
+  if( m_bBndCommAggregate )
+  {
+    if( (ret = wait_LMR_Agg(array, true, imax, jmax, kmax, nmax, vc, vc_comm, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+    // 登録フィールドの通信済みを記録
+    commitFieldComm( array );
+    return CPM_SUCCESS;
+  }
+
   // 周期境界フラグ
   bool bPeriodic = false;
 
@@ -643,6 +725,18 @@ cpm_ParaManagerLMR::wait_BndCommS4DEx( T *array, int nmax, int imax, int jmax, i
   } // ZDIR
 
 
+  // 辺、頂点方向の袖通信(面の袖通信の展開後に展開する)
+  if( m_bBndCommEdge )
+  {
+    if( (ret = wait_LMR_Edge(array, true, imax, jmax, kmax, nmax, vc, vc_comm, 0, procGrpNo)) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   // 正常終了
   return CPM_SUCCESS;
 }
@@ -838,65 +932,10 @@ cpm_ParaManagerLMR::send_LMR_Ex( T *array, int nmax, int imax, int jmax, int kma
 
     // 送信サイズの計算とパック
     int commsize = 0;
-    T *ptr = sendbuf;
-    for( int j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
+    if( (ret = packLeafComm_LMR(array, true, imax, jmax, kmax, nmax, vc, vc_comm, pLeafCommInfo, sz_face, bPeriodic
+                              , face, sendbuf, commsize, procGrpNo)) != CPM_SUCCESS )
     {
-      cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
-      if( commInfo->bPeriodic == bPeriodic )
-      {
-        // リーフ間の送信サイズ
-        size_t csz = commInfo->CalcSendBufferSize(sz_face, vc_comm, nmax);
-
-        // パック
-        if( face == X_MINUS )
-        {
-          if( (ret = packMXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == X_PLUS )
-        {
-          if( (ret = packPXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_MINUS )
-        {
-          if( (ret = packMYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_PLUS )
-        {
-          if( (ret = packPYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_MINUS )
-        {
-          if( (ret = packMZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_PLUS )
-        {
-          if( (ret = packPZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // 送信サイズを加算
-        commsize += (int)csz;
-
-        // バッファのポインタも変更
-        ptr += csz;
-      }
+      return ret;
     }
 
     // 送信
@@ -922,25 +961,6 @@ cpm_ParaManagerLMR::copy_LMR_Ex( T *array, int nmax, int imax, int jmax, int kma
                                , LeafCommInfoMap &commInfoMapM, LeafCommInfoMap &commInfoMapP
                                , bool bPeriodic, cpm_DirFlag dir, cpm_PMFlag pm, int procGrpNo )
 {
-  cpm_ErrorCode ret;
-
-  size_t sz_face[2];
-  if( dir==X_DIR )
-  {
-    sz_face[0] = jmax;
-    sz_face[1] = kmax;
-  }
-  else if( dir==Y_DIR )
-  {
-    sz_face[0] = imax;
-    sz_face[1] = kmax;
-  }
-  else if( dir==Z_DIR )
-  {
-    sz_face[0] = imax;
-    sz_face[1] = jmax;
-  }
-
   // ランク内の通信情報を取得
   LeafCommInfoMap::iterator itM = commInfoMapM.find(m_rankNo);
   if( itM == commInfoMapM.end() )
@@ -957,126 +977,9 @@ cpm_ParaManagerLMR::copy_LMR_Ex( T *array, int nmax, int imax, int jmax, int kma
   cpm_LeafCommInfo* pLeafCommInfoM = itM->second;
   cpm_LeafCommInfo* pLeafCommInfoP = itP->second;
 
-  // バッファ
-  T* copybuf = (T*)pLeafCommInfoM->GetBndCommSendBufferPtr();
-
-  // マイナス側の通信情報を検索
-  for( int j=0;j<pLeafCommInfoM->m_vecCommInfo.size();j++ )
-  {
-    cpm_LeafCommInfo::stCommInfo* commInfoM = pLeafCommInfoM->m_vecCommInfo[j];
-    if( commInfoM->bPeriodic == bPeriodic )
-    {
-      // リーフ間の送信サイズ
-      size_t csz = commInfoM->CalcSendBufferSize(sz_face, vc_comm, nmax);
-
-      // 対応するプラス側の通信情報を検索
-      cpm_LeafCommInfo::stCommInfo* commInfoP = pLeafCommInfoP->SearchDistCommInfo(commInfoM);
-      if( !commInfoP )
-      {
-        return CPM_ERROR;
-      }
-
-      // パックと展開
-      if( dir == X_DIR )
-      {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-      }
-      else if( dir == Y_DIR )
-      {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-      }
-      else if( dir == Z_DIR )
-      {
-        // マイナス側からプラス側へのコピー
-        if( pm==MINUS2PLUS || pm==BOTH )
-        {
-          // マイナス側のパック
-          if( (ret = packMZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // プラス側に展開
-          if( (ret = unpackPZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // プラス側からマイナス側へのコピー
-        if( pm==PLUS2MINUS || pm==BOTH )
-        {
-          // プラス側のパック
-          if( (ret = packPZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoP, copybuf, csz, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-          // マイナス側に展開
-          if( (ret = unpackMZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfoM, copybuf, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-      }
-    }
-  }
-
-  return CPM_SUCCESS;
+  // リーフ間の直接コピー
+  return copyDirect_LMR<T, CPM_ARRAY_S4DEX>(array, imax, jmax, kmax, nmax, vc, vc_comm
+                                          , pLeafCommInfoM, pLeafCommInfoP, bPeriodic, dir, pm, procGrpNo);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1135,62 +1038,10 @@ cpm_ParaManagerLMR::recv_LMR_Ex_wait( T *array, int nmax, int imax, int jmax, in
     T* recvbuf = (T*)pLeafCommInfo->GetBndCommRecvBufferPtr();
 
     // 受信データの展開
-    T *ptr = recvbuf;
-    for( int j=0;j<pLeafCommInfo->m_vecCommInfo.size();j++ )
+    if( (ret = unpackLeafComm_LMR(array, true, imax, jmax, kmax, nmax, vc, vc_comm, pLeafCommInfo, sz_face, bPeriodic
+                                , face, recvbuf, procGrpNo)) != CPM_SUCCESS )
     {
-      cpm_LeafCommInfo::stCommInfo* commInfo = pLeafCommInfo->m_vecCommInfo[j];
-      if( commInfo->bPeriodic == bPeriodic )
-      {
-        // リーフ間の受信サイズ
-        size_t csz = commInfo->CalcRecvBufferSize(sz_face, vc_comm, nmax);
-
-        // 展開
-        if( face == X_MINUS )
-        {
-          if( (ret = unpackMXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == X_PLUS )
-        {
-          if( (ret = unpackPXEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_MINUS )
-        {
-          if( (ret = unpackMYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Y_PLUS )
-        {
-          if( (ret = unpackPYEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        if( face == Z_MINUS )
-        {
-          if( (ret = unpackMZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-        else if( face == Z_PLUS )
-        {
-          if( (ret = unpackPZEx(array, nmax, imax, jmax, kmax, vc, vc_comm, commInfo, ptr, procGrpNo)) != CPM_SUCCESS )
-          {
-            return ret;
-          }
-        }
-
-        // バッファのポインタも変更
-        ptr += csz;
-      }
+      return ret;
     }
   }
 
@@ -1202,7 +1053,7 @@ cpm_ParaManagerLMR::recv_LMR_Ex_wait( T *array, int nmax, int imax, int jmax, in
 // 袖通信(Scalar4DEx,Vector3DEx版)の-X面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1213,6 +1064,9 @@ cpm_ParaManagerLMR::packMXEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int js=0, je=jmax; //j方向範囲
@@ -1268,9 +1122,10 @@ cpm_ParaManagerLMR::packMXEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k);
   for( int i=0;i<gc;i++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFX(n,i,jj,kk,nmax,0,jmaxb,kmaxb,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFX(n,i,jj,kk,nmax,0,jmaxb,kmaxb,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1280,7 +1135,7 @@ cpm_ParaManagerLMR::packMXEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の+X面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1291,6 +1146,9 @@ cpm_ParaManagerLMR::packPXEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int js=0, je=jmax; //j方向範囲
@@ -1346,9 +1204,10 @@ cpm_ParaManagerLMR::packPXEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k);
   for( int i=imax-gc;i<imax;i++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFX(n,i,jj,kk,nmax,imax-gc,jmaxb,kmaxb,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFX(n,i,jj,kk,nmax,imax-gc,jmaxb,kmaxb,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1358,7 +1217,7 @@ cpm_ParaManagerLMR::packPXEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の-Y面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1369,6 +1228,9 @@ cpm_ParaManagerLMR::packMYEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1424,9 +1286,10 @@ cpm_ParaManagerLMR::packMYEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=0;j<gc;j++ ){
+  T *pa = a.Row(j,k);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFY(n,ii,j,kk,nmax,imaxb,0,kmaxb,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFY(n,ii,j,kk,nmax,imaxb,0,kmaxb,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1436,7 +1299,7 @@ cpm_ParaManagerLMR::packMYEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の+Y面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1447,6 +1310,9 @@ cpm_ParaManagerLMR::packPYEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1502,9 +1368,10 @@ cpm_ParaManagerLMR::packPYEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=ks-gc,kk=0-gc;k<ke+gc;k++,kk++ ){
   for( int j=jmax-gc;j<jmax;j++ ){
+  T *pa = a.Row(j,k);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFY(n,ii,j,kk,nmax,imaxb,jmax-gc,kmaxb,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFY(n,ii,j,kk,nmax,imaxb,jmax-gc,kmaxb,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1514,7 +1381,7 @@ cpm_ParaManagerLMR::packPYEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の-Z面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packMZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packMZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1525,6 +1392,9 @@ cpm_ParaManagerLMR::packMZEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1580,9 +1450,10 @@ cpm_ParaManagerLMR::packMZEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=0;k<gc;k++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFZ(n,ii,jj,k,nmax,imaxb,jmaxb,0,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFZ(n,ii,jj,k,nmax,imaxb,jmaxb,0,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1592,7 +1463,7 @@ cpm_ParaManagerLMR::packMZEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の+Z面への送信データのパック(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::packPZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::packPZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                             , cpm_LeafCommInfo::stCommInfo* commInfo, T* sendbuf, size_t nw, int procGrpNo )
 {
   // レベル差
@@ -1603,6 +1474,9 @@ cpm_ParaManagerLMR::packPZEx( T *array, int nmax, int imax, int jmax, int kmax,
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 送信範囲の確定
   int is=0, ie=imax; //i方向範囲
@@ -1658,9 +1532,10 @@ cpm_ParaManagerLMR::packPZEx( T *array, int nmax, int imax, int jmax, int kmax,
   // 格納
   for( int k=kmax-gc;k<kmax;k++ ){
   for( int j=js-gc,jj=0-gc;j<je+gc;j++,jj++ ){
+  T *pa = a.Row(j,k);
   for( int i=is-gc,ii=0-gc;i<ie+gc;i++,ii++ ){
   for( int n=0;n<nmax;n++){
-    sendbuf[_IDXFZ(n,ii,jj,k,nmax,imaxb,jmaxb,kmax-gc,gc)] = array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)];
+    sendbuf[_IDXFZ(n,ii,jj,k,nmax,imaxb,jmaxb,kmax-gc,gc)] = pa[i*si+n];
   }}}}
 
   return CPM_SUCCESS;
@@ -1670,7 +1545,7 @@ cpm_ParaManagerLMR::packPZEx( T *array, int nmax, int imax, int jmax, int kmax,
 // 袖通信(Scalar4DEx,Vector3DEx版)の-X面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -1681,6 +1556,9 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -1688,9 +1566,10 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<0;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFX(n,i,j,k,nmax,0-vc_comm,jmax,kmax,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFX(n,i,j,k,nmax,0-vc_comm,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -1736,6 +1615,7 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<0;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i   )*2;
@@ -1750,7 +1630,7 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFX(n,ii  ,jj+1,kk+1,nmax,0-gc,jmax,kmax,gc)]
             + recvbuf[_IDXFX(n,ii+1,jj+1,kk+1,nmax,0-gc,jmax,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -1767,12 +1647,13 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-gc;i<0;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFX(n,ii,jj,kk,nmax,0-vc_comm,jmaxb,kmaxb,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFX(n,ii,jj,kk,nmax,0-vc_comm,jmaxb,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -1783,7 +1664,7 @@ cpm_ParaManagerLMR::unpackMXEx( T *array, int nmax, int imax, int jmax, int kmax
 // 袖通信(Scalar4DEx,Vector3DEx版)の+X面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPXEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -1794,6 +1675,9 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -1801,9 +1685,10 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=imax;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFX(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFX(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -1850,6 +1735,7 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=imax;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i   )*2;
@@ -1864,7 +1750,7 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFX(n,ii  ,jj+1,kk+1,nmax,imax2,jmax,kmax,gc)]
             + recvbuf[_IDXFX(n,ii+1,jj+1,kk+1,nmax,imax2,jmax,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -1882,12 +1768,13 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=imax;i<imax+gc;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=i/2;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFX(n,ii,jj,kk,nmax,imax2,jmaxb,kmaxb,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFX(n,ii,jj,kk,nmax,imax2,jmaxb,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -1898,7 +1785,7 @@ cpm_ParaManagerLMR::unpackPXEx( T *array, int nmax, int imax, int jmax, int kmax
 // 袖通信(Scalar4DEx,Vector3DEx版)の-Y面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -1909,6 +1796,9 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -1916,9 +1806,10 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFY(n,i,j,k,nmax,imax,0-vc_comm,kmax,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFY(n,i,j,k,nmax,imax,0-vc_comm,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -1964,6 +1855,7 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i-is)*2;
@@ -1978,7 +1870,7 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFY(n,ii  ,jj+1,kk+1,nmax,imax,0-gc,kmax,gc)]
             + recvbuf[_IDXFY(n,ii+1,jj+1,kk+1,nmax,imax,0-gc,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -1995,12 +1887,13 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=0-gc;j<0;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-gc;i<imax+gc;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFY(n,ii,jj,kk,nmax,imaxb,0-vc_comm,kmaxb,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFY(n,ii,jj,kk,nmax,imaxb,0-vc_comm,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -2011,7 +1904,7 @@ cpm_ParaManagerLMR::unpackMYEx( T *array, int nmax, int imax, int jmax, int kmax
 // 袖通信(Scalar4DEx,Vector3DEx版)の+Y面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPYEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2022,6 +1915,9 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -2029,9 +1925,10 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFY(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFY(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2078,6 +1975,7 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=ks-vc_km;k<ke+vc_kp;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i-is)*2;
@@ -2092,7 +1990,7 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFY(n,ii  ,jj+1,kk+1,nmax,imax,jmax2,kmax,gc)]
             + recvbuf[_IDXFY(n,ii+1,jj+1,kk+1,nmax,imax,jmax2,kmax,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2110,12 +2008,13 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-gc;k<kmax+gc;k++ ){
     for( int j=jmax;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-gc;i<imax+gc;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i+2)/2-1;
       int jj=j/2;
       int kk=(k+2)/2-1;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFY(n,ii,jj,kk,nmax,imaxb,jmax2,kmaxb,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFY(n,ii,jj,kk,nmax,imaxb,jmax2,kmaxb,vc_comm)];
     }}}}
   }
 
@@ -2126,7 +2025,7 @@ cpm_ParaManagerLMR::unpackPYEx( T *array, int nmax, int imax, int jmax, int kmax
 // 袖通信(Scalar4DEx,Vector3DEx版)の-Z面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackMZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2137,6 +2036,9 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -2144,9 +2046,10 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFZ(n,i,j,k,nmax,imax,jmax,0-vc_comm,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFZ(n,i,j,k,nmax,imax,jmax,0-vc_comm,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2192,6 +2095,7 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i-is)*2;
@@ -2206,7 +2110,7 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFZ(n,ii  ,jj+1,kk+1,nmax,imax,jmax,0-gc,gc)]
             + recvbuf[_IDXFZ(n,ii+1,jj+1,kk+1,nmax,imax,jmax,0-gc,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2223,12 +2127,13 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=0-gc;k<0;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-gc;i<imax+gc;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=(k+2)/2-1;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFZ(n,ii,jj,kk,nmax,imaxb,jmaxb,0-vc_comm,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFZ(n,ii,jj,kk,nmax,imaxb,jmaxb,0-vc_comm,vc_comm)];
     }}}}
   }
 
@@ -2239,7 +2144,7 @@ cpm_ParaManagerLMR::unpackMZEx( T *array, int nmax, int imax, int jmax, int kmax
 // 袖通信(Scalar4DEx,Vector3DEx版)の+Z面からの受信データの展開(通信面毎)
 template<class T> CPM_INLINE
 cpm_ErrorCode
-cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm
+cpm_ParaManagerLMR::unpackPZEx( const cpm_ArrayViewLMR<T, CPM_ARRAY_S4DEX> &av, int nmax, int imax, int jmax, int kmax, int vc_comm
                               , cpm_LeafCommInfo::stCommInfo* commInfo, T* recvbuf, int procGrpNo )
 {
   // レベル差
@@ -2250,6 +2155,9 @@ cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax
 
   // リーフインデクス
   int leafIdx = GetLocalLeafIndex_byID(commInfo->iOwnLeafID, procGrpNo);
+  // リーフの配列ビュー
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a = av.Leaf( leafIdx );
+  const ptrdiff_t si = a.StrideI();
 
   // 展開
   if( levelDiff==0 )
@@ -2257,9 +2165,10 @@ cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax
     // 同じレベル
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
     for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFZ(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFZ(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
     }}}}
   }
   else if( levelDiff==1 )
@@ -2306,6 +2215,7 @@ cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=js-vc_jm;j<je+vc_jp;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=is-vc_im;i<ie+vc_ip;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i-is)*2;
@@ -2320,7 +2230,7 @@ cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax
             + recvbuf[_IDXFZ(n,ii  ,jj+1,kk+1,nmax,imax,jmax,kmax2,gc)]
             + recvbuf[_IDXFZ(n,ii+1,jj+1,kk+1,nmax,imax,jmax,kmax2,gc)];
       val *= 0.125;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = val;
+      pa[i*si+n] = val;
     }}}}
   }
   else if( levelDiff==-1 )
@@ -2338,12 +2248,13 @@ cpm_ParaManagerLMR::unpackPZEx( T *array, int nmax, int imax, int jmax, int kmax
 
     for( int k=kmax;k<kmax+gc;k++ ){
     for( int j=0-gc;j<jmax+gc;j++ ){
+    T *pa = a.Row(j,k);
     for( int i=0-gc;i<imax+gc;i++ ){
     for( int n=0;n<nmax;n++){
       int ii=(i+2)/2-1;
       int jj=(j+2)/2-1;
       int kk=k/2;
-      array[_IDX_S4DEX_LMR(n,i,j,k,leafIdx,nmax,imax,jmax,kmax,vc)] = recvbuf[_IDXFZ(n,ii,jj,kk,nmax,imaxb,jmaxb,kmax2,vc_comm)];
+      pa[i*si+n] = recvbuf[_IDXFZ(n,ii,jj,kk,nmax,imaxb,jmaxb,kmax2,vc_comm)];
     }}}}
   }
 
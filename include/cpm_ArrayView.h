@@ -0,0 +1,276 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ArrayView.h
+ * 多次元配列ビュークラスのヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_ARRAYVIEW_H_
+#define _CPM_ARRAYVIEW_H_
+
+#include "cpm_Define.h"
+#include <stddef.h>
+
+/** 多次元配列ビュークラス
+ *  - _IDX_*_PADマクロと同じ配列を、コンストラクタで計算したストライドで参照する
+ *  - 配列形状(Layout)はコンパイル時に決まるため、最内の連続方向のストライドは定数1となる
+ *  - VCに0以上を指定したときは仮想セル数をコンパイル時定数として扱う(負のときはコンストラクタの引数)
+ *  - インデクスは実セルの先頭を0とし、引数の並びは対応する_IDX_*マクロと同じ
+ *    (S3D:(i,j,k)、S4D,V3D:(i,j,k,n)、S4DEx,V3DEx:(n,i,j,k))
+ *  - 最内ループにはRow(),Cell()で取得したポインタを使用するとベクトル化しやすい
+ */
+template<class T, CPM_ARRAY_SHAPE Layout, int VC=-1>
+class cpm_ArrayView
+{
+public:
+  /** 成分が最内(Ex形式)かどうか */
+  static const bool IsEx = (Layout == CPM_ARRAY_S4DEX || Layout == CPM_ARRAY_V3DEX);
+
+  /** デフォルトコンストラクタ */
+  cpm_ArrayView()
+  {
+    m_ptr  = NULL;
+    m_org  = NULL;
+    m_vc   = (VC >= 0) ? VC : 0;
+    m_imax = m_jmax = m_kmax = m_nmax = 0;
+    m_si = m_sj = m_sk = m_sn = 0;
+    m_nz = m_nn = 0;
+  }
+
+  /** コンストラクタ
+   *  @param[in] ptr      配列ポインタ
+   *  @param[in] imax     i方向の実セル数
+   *  @param[in] jmax     j方向の実セル数
+   *  @param[in] kmax     k方向の実セル数
+   *  @param[in] nmax     成分数(S3Dのとき1、V3D,V3DExのときは3固定で無視される)
+   *  @param[in] vc       仮想セル数(VCが0以上のときは無視される)
+   *  @param[in] pad_size パディングサイズ(GetPaddingSize,Alloc*と同じ並び、NULLのときパディングなし)
+   */
+  cpm_ArrayView( T *ptr, int imax, int jmax, int kmax, int nmax, int vc, const int *pad_size=NULL )
+  {
+    Set( ptr, imax, jmax, kmax, nmax, vc, pad_size );
+  }
+
+  /** 配列情報のセット
+   *  @param[in] ptr      配列ポインタ
+   *  @param[in] imax     i方向の実セル数
+   *  @param[in] jmax     j方向の実セル数
+   *  @param[in] kmax     k方向の実セル数
+   *  @param[in] nmax     成分数(S3Dのとき1、V3D,V3DExのときは3固定で無視される)
+   *  @param[in] vc       仮想セル数(VCが0以上のときは無視される)
+   *  @param[in] pad_size パディングサイズ(GetPaddingSize,Alloc*と同じ並び、NULLのときパディングなし)
+   */
+  void Set( T *ptr, int imax, int jmax, int kmax, int nmax, int vc, const int *pad_size=NULL )
+  {
+    if( Layout == CPM_ARRAY_S3D ) nmax = 1;
+    if( Layout == CPM_ARRAY_V3D || Layout == CPM_ARRAY_V3DEX ) nmax = 3;
+
+    m_ptr  = ptr;
+    m_vc   = (VC >= 0) ? VC : vc;
+    m_imax = imax;
+    m_jmax = jmax;
+    m_kmax = kmax;
+    m_nmax = nmax;
+
+    // パディング
+    int ip = 0, jp = 0, kp = 0, np = 0;
+    if( pad_size )
+    {
+      if( IsEx )
+      {
+        np = pad_size[0];
+        ip = pad_size[1];
+        jp = pad_size[2];
+        kp = pad_size[3];
+      }
+      else
+      {
+        ip = pad_size[0];
+        jp = pad_size[1];
+        kp = pad_size[2];
+        if( Layout != CPM_ARRAY_S3D ) np = pad_size[3];
+      }
+    }
+
+    // ストライド
+    ptrdiff_t nx = ptrdiff_t(imax + 2*m_vc + ip);
+    ptrdiff_t ny = ptrdiff_t(jmax + 2*m_vc + jp);
+    ptrdiff_t nz = ptrdiff_t(kmax + 2*m_vc + kp);
+    if( IsEx )
+    {
+      m_sn = 1;
+      m_si = ptrdiff_t(nmax + np);
+    }
+    else
+    {
+      m_si = 1;
+      m_sn = nx * ny * nz;
+    }
+    m_sj = m_si * nx;
+    m_sk = m_sj * ny;
+    m_nz = nz;
+    m_nn = ptrdiff_t(nmax + np);
+
+    // 実セル(0,0,0)の位置
+    m_org = m_ptr ? m_ptr + ptrdiff_t(m_vc) * (m_si + m_sj + m_sk) : NULL;
+  }
+
+  /** 配列ポインタの取得
+   *  @return 配列ポインタ
+   */
+  T* Data() const { return m_ptr; }
+
+  /** 仮想セル数の取得
+   *  @return 仮想セル数
+   */
+  int Vc() const { return (VC >= 0) ? VC : m_vc; }
+
+  /** i方向の実セル数の取得 */
+  int Imax() const { return m_imax; }
+
+  /** j方向の実セル数の取得 */
+  int Jmax() const { return m_jmax; }
+
+  /** k方向の実セル数の取得 */
+  int Kmax() const { return m_kmax; }
+
+  /** 成分数の取得 */
+  int Nmax() const { return m_nmax; }
+
+  /** i方向のストライド(S3D,S4D,V3Dのとき定数1) */
+  ptrdiff_t StrideI() const { return IsEx ? m_si : 1; }
+
+  /** j方向のストライド */
+  ptrdiff_t StrideJ() const { return m_sj; }
+
+  /** k方向のストライド */
+  ptrdiff_t StrideK() const { return m_sk; }
+
+  /** 成分方向のストライド(S4DEx,V3DExのとき定数1) */
+  ptrdiff_t StrideN() const { return IsEx ? 1 : m_sn; }
+
+  /** 1次元インデクスの取得(_IDX_*_PADマクロと同じ値)
+   *  @param[in] i i方向インデクス
+   *  @param[in] j j方向インデクス
+   *  @param[in] k k方向インデクス
+   *  @param[in] n 成分インデクス
+   *  @return 1次元インデクス
+   */
+  ptrdiff_t Index( int i, int j, int k, int n=0 ) const
+  {
+    return (m_org - m_ptr) + Offset(i, j, k, n);
+  }
+
+  /** 要素の参照(S3D、Ex形式のときは成分0)
+   *  @param[in] i i方向インデクス
+   *  @param[in] j j方向インデクス
+   *  @param[in] k k方向インデクス
+   *  @return 要素の参照
+   */
+  T& operator()( int i, int j, int k ) const
+  {
+    return m_org[Offset(i, j, k, 0)];
+  }
+
+  /** 要素の参照(S4D,V3Dは(i,j,k,n)、S4DEx,V3DExは(n,i,j,k)の順)
+   *  @return 要素の参照
+   */
+  T& operator()( int a0, int a1, int a2, int a3 ) const
+  {
+    if( IsEx ) return m_org[Offset(a1, a2, a3, a0)];
+    return m_org[Offset(a0, a1, a2, a3)];
+  }
+
+  /** i方向1列の先頭ポインタの取得
+   *  - 戻り値pに対し、p[i*StrideI()]が(i,j,k,n)の要素となる(S3D,S4D,V3DではStrideI()=1)
+   *  - iは仮想セルを含め-Vc()から参照できる
+   *  @param[in] j j方向インデクス
+   *  @param[in] k k方向インデクス
+   *  @param[in] n 成分インデクス
+   *  @return (0,j,k,n)の要素のポインタ
+   */
+  T* Row( int j, int k, int n=0 ) const
+  {
+    return m_org + Offset(0, j, k, n);
+  }
+
+  /** セルの成分列の先頭ポインタの取得
+   *  - 戻り値pに対し、p[n*StrideN()]が(i,j,k,n)の要素となる(S4DEx,V3DExではStrideN()=1)
+   *  @param[in] i i方向インデクス
+   *  @param[in] j j方向インデクス
+   *  @param[in] k k方向インデクス
+   *  @return (i,j,k,0)の要素のポインタ
+   */
+  T* Cell( int i, int j, int k ) const
+  {
+    return m_org + Offset(i, j, k, 0);
+  }
+
+  /** 先頭位置をずらしたビューの取得
+   *  - 同じ形状の配列が連続して確保されている場合(LMRのリーフ等)に使用する
+   *  @param[in] off ずらす要素数
+   *  @return ビュー
+   */
+  cpm_ArrayView Shift( ptrdiff_t off ) const
+  {
+    cpm_ArrayView v = *this;
+    if( v.m_ptr )
+    {
+      v.m_ptr += off;
+      v.m_org += off;
+    }
+    return v;
+  }
+
+  /** 配列全体の要素数の取得(パディング込み)
+   *  @return 要素数
+   */
+  size_t Size() const
+  {
+    if( IsEx ) return size_t(m_sk) * size_t(m_nz);
+    return size_t(m_sn) * size_t(m_nn);
+  }
+
+protected:
+  /** 実セル(0,0,0,0)からのオフセット */
+  ptrdiff_t Offset( int i, int j, int k, int n ) const
+  {
+    return ptrdiff_t(i) * StrideI()
+         + ptrdiff_t(j) * m_sj
+         + ptrdiff_t(k) * m_sk
+         + ptrdiff_t(n) * StrideN();
+  }
+
+protected:
+  T *m_ptr;        ///< 配列ポインタ
+  T *m_org;        ///< 実セル(0,0,0,0)のポインタ
+  int m_vc;        ///< 仮想セル数
+  int m_imax;      ///< i方向の実セル数
+  int m_jmax;      ///< j方向の実セル数
+  int m_kmax;      ///< k方向の実セル数
+  int m_nmax;      ///< 成分数
+  ptrdiff_t m_si;  ///< i方向のストライド
+  ptrdiff_t m_sj;  ///< j方向のストライド
+  ptrdiff_t m_sk;  ///< k方向のストライド
+  ptrdiff_t m_sn;  ///< 成分方向のストライド
+  ptrdiff_t m_nz;  ///< k方向の配列サイズ(仮想セル、パディング込み)
+  ptrdiff_t m_nn;  ///< 成分方向の配列サイズ(パディング込み)
+};
+
+#endif /* _CPM_ARRAYVIEW_H_ */
@@ -27,15 +27,114 @@
 #include "cpm_Base.h"
 #include <map>
 #include <vector>
+#include <limits>
 #include <typeinfo>
 #include "cpm_DomainInfo.h"
 #include "cpm_VoxelInfo.h"
 #include "cpm_ObjList.h"
+#include "cpm_ObjPool.h"
+#include "cpm_ArrayView.h"
 #include <string.h> // for memset()
 
 /** プロセスグループ毎の定義点タイプ管理マップ */
 typedef std::map<int, cpm_DefPointType> DefPointMap;
 
+/** キャッシュ構成情報
+ *  - CPM_PADDING_CACHE,CPM_PADDING_AUTOのパディングサイズ計算に使用する
+ *  - 既定値はLinuxのsysfsから取得し、取得できない場合は一般的な値とする
+ */
+struct S_CACHE_GEOMETRY
+{
+  int m_lineSize;  ///< キャッシュラインサイズ[Byte]
+  int m_l1Size;    ///< L1データキャッシュ容量[Byte]
+  int m_l1Assoc;   ///< L1データキャッシュのウェイ数
+  int m_l2Size;    ///< L2キャッシュ容量[Byte]
+  int m_l2Assoc;   ///< L2キャッシュのウェイ数
+  int m_aliasSize; ///< ストアフォワーディングのアドレス比較周期[Byte](4KiBエイリアシング)
+
+  S_CACHE_GEOMETRY()
+  {
+    m_lineSize  = 64;
+    m_l1Size    = 32*1024;
+    m_l1Assoc   = 8;
+    m_l2Size    = 1024*1024;
+    m_l2Assoc   = 16;
+    m_aliasSize = 4096;
+  }
+
+  /** L1のセット周期の計算
+   *  @return 同一セットに対応するアドレスの周期[Byte]
+   */
+  long long L1SetStride() const
+  {
+    if( m_l1Assoc <= 0 ) return 0;
+    return (long long)m_l1Size / m_l1Assoc;
+  }
+
+  /** L2のセット周期の計算
+   *  @return 同一セットに対応するアドレスの周期[Byte]
+   */
+  long long L2SetStride() const
+  {
+    if( m_l2Assoc <= 0 ) return 0;
+    return (long long)m_l2Size / m_l2Assoc;
+  }
+};
+
+/** 点位置検索の結果 */
+struct S_POINT_LOCATION
+{
+  int rank;     ///< 担当ランク番号(計算領域外、不活性領域のとき-1)
+  int leaf;     ///< 担当ランク内のリーフ順番号(カーテシアンは0、計算領域外のとき-1)
+  int index[3]; ///< 担当領域(リーフ)内のローカルインデクス(実セルの先頭が0)
+};
+
+/** 担当ランクに転送した点位置検索の問い合わせ */
+struct S_POINT_QUERY
+{
+  double           pos[3];   ///< 座標
+  S_POINT_LOCATION loc;      ///< 検索結果
+  int              srcRank;  ///< 問い合わせ元のランク番号
+  int              srcIndex; ///< 問い合わせ元での点の番号
+};
+
+/** 試行計測で決定したパディングサイズのマップ
+ *  - キーは{配列形状,imax,jmax,kmax,vc,nmax,要素サイズ}
+ */
+typedef std::map<std::vector<int>, std::vector<int> > PaddingTuneMap;
+
+/** 袖通信の省略判定を行うフィールド(配列)の情報 */
+struct S_FIELD_INFO
+{
+  long long m_version;     ///< バージョン番号(更新毎に加算)
+  long long m_commVersion; ///< 最後に袖通信したときのバージョン番号(未通信のとき-1)
+  int       m_commProcGrp; ///< 最後に袖通信したプロセスグループ番号
+  int       m_commN;       ///< 最後に袖通信した成分数
+  int       m_commVC;      ///< 最後に袖通信した仮想セル数
+  bool      m_bSkipped;    ///< 非同期袖通信を省略したかどうか(wait_で参照)
+  long long m_pendVersion; ///< 完了待ちの袖通信のバージョン番号(無いとき-1)
+  int       m_pendProcGrp; ///< 完了待ちの袖通信のプロセスグループ番号
+  int       m_pendN;       ///< 完了待ちの袖通信の成分数
+  int       m_pendVC;      ///< 完了待ちの袖通信の仮想セル数
+
+  S_FIELD_INFO()
+  {
+    m_version     = 0;
+    m_commVersion = -1;
+    m_commProcGrp = -1;
+    m_commN       = 0;
+    m_commVC      = 0;
+    m_bSkipped    = false;
+    m_pendVersion = -1;
+    m_pendProcGrp = -1;
+    m_pendN       = 0;
+    m_pendVC      = 0;
+  }
+};
+
+/** 袖通信の省略判定を行うフィールドのマップ(キーは配列の先頭ポインタ) */
+typedef std::map<const void*, S_FIELD_INFO> FieldInfoMap;
+
 /** CPMの並列管理クラス
  *  - 現時点ではユーザがインスタンスすることを許していない
  *  - get_instance静的関数を用いて唯一のインスタンスを取得する
@@ -434,6 +533,39 @@ public:
   cpm_ErrorCode Allreduce( MPI_Datatype dtype, void *sendbuf, void *recvbuf
                          , int count, MPI_Op op, int procGrpNo=0 );
 
+  /** Iallreduce
+   *  - MPI_Iallreduceのインターフェイス
+   *  - 完了はWait,Waitallで待つ(完了までsendbuf,recvbufを変更、解放しないこと)
+   *  - MPI-3未満の環境ではAllreduceを実行し、完了済みのリクエストを返す
+   *
+   *  @param[in]  sendbuf   送信データ
+   *  @param[out] recvbuf   受信データ
+   *  @param[in]  count     送受信データのサイズ
+   *  @param[in]  op        オペレータ
+   *  @param[out] request   リクエストハンドル
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode Iallreduce( T *sendbuf, T *recvbuf, int count, MPI_Op op
+                          , MPI_Request *request, int procGrpNo=0 );
+
+  /** Iallreduce
+   *  - MPI_Iallreduceのインターフェイス
+   *  - MPI_Datatypeを指定するバージョン
+   *
+   *  @param[in]  dtype     送信データのMPI_Datatype
+   *  @param[in]  sendbuf   送信データ
+   *  @param[out] recvbuf   受信データ
+   *  @param[in]  count     送受信データのサイズ
+   *  @param[in]  op        オペレータ
+   *  @param[out] request   リクエストハンドル
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Iallreduce( MPI_Datatype dtype, void *sendbuf, void *recvbuf
+                          , int count, MPI_Op op, MPI_Request *request, int procGrpNo=0 );
+
   /** Gather
    *  - MPI_Gatherのインターフェイス
    *
@@ -581,6 +713,8 @@ public:
 
   /** cpm_Waitall
    *  - MPI_Waitallのインターフェイス
+   *  - リクエストは管理プールの領域に対して直接待つ(プール内で連続する番号はまとめてMPI_Waitallする)
+   *  - 登録されていないリクエスト番号が含まれるときは、待たずにエラーを返す
    *
    *  @param[in] count     リクエストの数
    *  @param[in] reqNoList リクエスト番号のリスト
@@ -616,6 +750,22 @@ public:
    */
   cpm_ErrorCode cpm_Irecv( void *buf, int count, int datatype, int source, int *reqNo, int procGrpNo=0 );
 
+  /** cpm_Iallreduce
+   *  - MPI_Iallreduceのインターフェイス
+   *  - Fortranインターフェイス用
+   *
+   *  @param[in]  sendbuf   送信データ
+   *  @param[out] recvbuf   受信データ
+   *  @param[in]  count     送受信データのサイズ
+   *  @param[in]  datatype  送受信データのデータタイプ(cpm_fparam.fi参照)
+   *  @param[in]  op        オペレータ(cpm_fparam.fi参照)
+   *  @param[out] reqNo     リクエスト番号(Fortran用)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode cpm_Iallreduce( void *sendbuf, void *recvbuf, int count, int datatype, int op
+                              , int *reqNo, int procGrpNo=0 );
+
 #if 0
   /** cpm_BndCommS3D_nowait
    *  - BndCommS3D_nowaitのインターフェイス
@@ -1891,6 +2041,174 @@ public:
 
 
 
+////// フィールド登録関数 //////
+
+  /** 袖通信の省略判定を行うフィールド(配列)の登録
+   *  - 登録した配列はバージョン番号を持ち、袖通信(BndCommS3D,V3D,S4D,V3DEx,S4DEx、面毎の通信袖数指定版を除く)は
+   *    前回の袖通信からバージョン番号が変わっていないとき通信を省略する
+   *  - 前回と同じプロセスグループ、成分数で、通信する仮想セル数が前回以下のときに省略する
+   *  - 登録直後は未通信として扱う。登録済みの配列を指定したときは何もしない
+   *  - 配列を解放するときはUnregisterFieldで登録を解除すること
+   *  - LMRのMigrateLeafArray_LMR,AdaptLeafArray*_LMRで置き換えた配列は登録を引き継ぐ。
+   *    領域分割、袖通信情報の再生成(SetBndCommBuffer,Rebalance_LMR,Adapt_LMR)後は未通信として扱う
+   *
+   *  @param[in] array 配列の先頭ポインタ
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode RegisterField( const void *array );
+
+  /** フィールドの登録解除
+   *  @param[in] array 配列の先頭ポインタ
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode UnregisterField( const void *array );
+
+  /** フィールドの更新の通知
+   *  - 実セルを更新したときに呼び出し、バージョン番号を進める
+   *  - 省略判定は通信なしで各ランクが独立に行うため、
+   *    プロセスグループ内の全ランクで同じ順序で呼び出すこと
+   *  - 逆方向袖通信(BndComm*_Reverse)は実セルを更新するため、完了時に自動で呼び出す
+   *
+   *  @param[in] array 配列の先頭ポインタ
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode MarkFieldDirty( const void *array );
+
+  /** フィールドのバージョン番号の取得
+   *  @param[in] array 配列の先頭ポインタ
+   *  @return バージョン番号(登録されていないとき-1)
+   */
+  long long GetFieldVersion( const void *array );
+
+  /** 登録フィールドの袖通信の統計の取得
+   *  @param[out] numComm 登録フィールドの袖通信の呼び出し回数
+   *  @param[out] numSkip 仮想セルが最新のため通信を省略した回数
+   */
+  void GetFieldCommStat( long long &numComm, long long &numSkip );
+
+  /** 登録フィールドの袖通信の統計のリセット */
+  void ResetFieldCommStat();
+
+
+
+
+////// 粒子移動関数 //////
+
+  /** 隣接ランク以外への粒子移動モードのセット
+   *  - trueのとき、MigrateParticlesは隣接ランク以外の領域へ移動する粒子も
+   *    全ランク間の送受信で移動先ランクに届ける
+   *  - そのような粒子の有無を判定するため、呼び出し毎にプロセスグループ内でAllreduceを行う
+   *  - false(既定)のときは隣接ランク間の送受信のみ行い、隣接ランク以外へ移動する粒子は削除する
+   *  @param[in] bFar 隣接ランク以外への粒子移動モード(true:行う、false:行わない(既定))
+   */
+  void SetParticleFarMigration( bool bFar )
+  {
+    m_bParticleFar = bFar;
+  }
+
+  /** 隣接ランク以外への粒子移動モードの取得
+   *  @retval true  隣接ランク以外へも移動する
+   *  @retval false 隣接ランクへのみ移動する
+   */
+  bool IsParticleFarMigration() const
+  {
+    return m_bParticleFar;
+  }
+
+  /** 粒子の隣接領域への移動
+   *  - 各粒子の位置を含む領域の担当ランクを移動先として判定し、
+   *    移動する粒子を送信して配列を詰め、受信した粒子を末尾に追加する
+   *  - 送受信は隣接ランク(カーテシアンは26方向の隣接領域、LMRは隣接リーフの担当ランク)間で
+   *    粒子数、粒子データの順に行う(プロセスグループ内の集団操作)
+   *  - 隣接ランク以外へ移動する粒子は、SetParticleFarMigration(true)のときのみ全ランク間で送受信する
+   *    (このときは呼び出し毎にAllreduceを追加で行う)。既定では削除し、numLostに数える
+   *  - periodicFlagのビットが立つ軸は周期境界として扱い、境界を越えた粒子の位置を全体領域幅だけ補正する
+   *    (1回の呼び出しでの移動量は全体領域幅以下とすること)
+   *  - 周期境界でない軸で計算領域外に出た粒子、不活性領域に入った粒子は削除し、numLostに数を返す
+   *  - Tはmemcpyでコピーできる構造体であること
+   *
+   *  @param[inout] particles    粒子の配列の先頭ポインタ
+   *  @param[inout] num          粒子数
+   *  @param[in]    maxNum       配列に格納できる最大粒子数
+   *  @param[in]    getPos       粒子の位置(3word)のポインタを返す関数
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[out]   numLost      削除した粒子数(NULLのとき出力しない)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了、最大粒子数を超えたときはCPM_ERROR_PARTICLE_OVERFLOW)
+   */
+  template<class T, class P> CPM_INLINE
+  cpm_ErrorCode MigrateParticles( T *particles, int &num, int maxNum, P* (*getPos)(T&)
+                                , int periodicFlag=0, int *numLost=NULL, int procGrpNo=0 );
+
+  /** 粒子の隣接領域への移動(std::vector版)
+   *  - 受信した粒子数に合わせて配列の長さを変更する
+   *
+   *  @param[inout] particles    粒子の配列
+   *  @param[in]    getPos       粒子の位置(3word)のポインタを返す関数
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[out]   numLost      削除した粒子数(NULLのとき出力しない)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, class P> CPM_INLINE
+  cpm_ErrorCode MigrateParticles( std::vector<T> &particles, P* (*getPos)(T&)
+                                , int periodicFlag=0, int *numLost=NULL, int procGrpNo=0 );
+
+
+
+
+////// 点位置検索関数 //////
+
+  /** 座標の担当ランク、リーフ、ローカルインデクスの一括検索
+   *  - カーテシアンは原点、ピッチ、領域分割数から算術的に求める
+   *  - LMRは木探索で座標を含むリーフを求める
+   *  - 通信は行わない(全ランクの座標を検索できる)
+   *  - 全体領域の上端の座標は端のセルに含める
+   *  - FDMのときは座標を含むセルの始点(頂点)のインデクスを返す
+   *
+   *  @param[in]  num       点の数
+   *  @param[in]  pos       座標(3word/点)
+   *  @param[out] loc       検索結果(num個)
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode LocatePoints( int num, const double *pos, S_POINT_LOCATION *loc, int procGrpNo=0 ) = 0;
+
+  /** 点位置検索の問い合わせの担当ランクへの転送
+   *  - LocatePointsの結果に従い、各点を担当ランクに送る(プロセスグループ内の集団操作)
+   *  - 計算領域外の点は送らない
+   *  - 受信した問い合わせは送信元のランク順、ランク内は点の番号順に並ぶ
+   *
+   *  @param[in]  num       点の数
+   *  @param[in]  pos       座標(3word/点)
+   *  @param[in]  loc       LocatePointsの検索結果(num個)
+   *  @param[out] query     自ランクが担当する問い合わせ
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode RoutePointsToOwner( int num, const double *pos, const S_POINT_LOCATION *loc
+                                  , std::vector<S_POINT_QUERY> &query, int procGrpNo=0 );
+
+  /** 問い合わせに対する値の問い合わせ元への返送
+   *  - RoutePointsToOwnerで受信した問い合わせ毎の値を問い合わせ元に返す(プロセスグループ内の集団操作)
+   *  - 値が返らなかった点(計算領域外)のresultは変更しない
+   *
+   *  @param[in]  query     RoutePointsToOwnerで受信した問い合わせ
+   *  @param[in]  value     問い合わせ毎の値(nval個/問い合わせ)
+   *  @param[in]  nval      1点あたりの値の数
+   *  @param[out] result    自ランクの点毎の値(nval個/点)
+   *  @param[in]  num       自ランクの点の数
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReturnPointValues( const std::vector<S_POINT_QUERY> &query, const T *value, int nval
+                                 , T *result, int num, int procGrpNo=0 );
+
+
+
+
 ////// ローカルボクセルサイズでの配列確保関数 //////
 
   /** 配列の初期化処理
@@ -1908,6 +2226,88 @@ public:
   template<class T>
   void CopyArray( T *source, T *dist, size_t size );
 
+  /** 配列レイアウトの変換 S4D(imax,jmax,kmax,nmax) -> S4DEx(nmax,imax,jmax,kmax)
+   *  - i方向をCPM_CONVERT_BLOCK毎にブロック化し、k,j方向をOpenMPで並列化する
+   *  - 変換元と変換先に同じ配列は指定できない
+   *  @param[in]  src     変換元配列(S4D)
+   *  @param[out] dst     変換先配列(S4DEx)
+   *  @param[in]  imax    配列サイズ(I方向)
+   *  @param[in]  jmax    配列サイズ(J方向)
+   *  @param[in]  kmax    配列サイズ(K方向)
+   *  @param[in]  nmax    成分数
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  pad_src 変換元のパディングサイズ(i,j,k,n)(NULLのときパディングなし)
+   *  @param[in]  pad_dst 変換先のパディングサイズ(n,i,j,k)(NULLのときパディングなし)
+   *  @param[in]  region  変換する領域(全領域、内部のみ、仮想セルのみ)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  static cpm_ErrorCode ConvertS4DtoS4DEx( const T *src, T *dst, int imax, int jmax, int kmax, int nmax, int vc
+                                        , const int *pad_src=NULL, const int *pad_dst=NULL
+                                        , CPM_CONVERT_REGION region=CPM_CONVERT_ALL );
+
+  /** 配列レイアウトの変換 S4DEx(nmax,imax,jmax,kmax) -> S4D(imax,jmax,kmax,nmax)
+   *  - i方向をCPM_CONVERT_BLOCK毎にブロック化し、k,j方向をOpenMPで並列化する
+   *  - 変換元と変換先に同じ配列は指定できない
+   *  @param[in]  src     変換元配列(S4DEx)
+   *  @param[out] dst     変換先配列(S4D)
+   *  @param[in]  nmax    成分数
+   *  @param[in]  imax    配列サイズ(I方向)
+   *  @param[in]  jmax    配列サイズ(J方向)
+   *  @param[in]  kmax    配列サイズ(K方向)
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  pad_src 変換元のパディングサイズ(n,i,j,k)(NULLのときパディングなし)
+   *  @param[in]  pad_dst 変換先のパディングサイズ(i,j,k,n)(NULLのときパディングなし)
+   *  @param[in]  region  変換する領域(全領域、内部のみ、仮想セルのみ)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  static cpm_ErrorCode ConvertS4DExtoS4D( const T *src, T *dst, int nmax, int imax, int jmax, int kmax, int vc
+                                        , const int *pad_src=NULL, const int *pad_dst=NULL
+                                        , CPM_CONVERT_REGION region=CPM_CONVERT_ALL );
+
+  /** 配列レイアウトの変換 V3D(imax,jmax,kmax,3) -> V3DEx(3,imax,jmax,kmax)
+   *  - ConvertS4DtoS4DExのnmax=3版
+   *  @param[in]  src     変換元配列(V3D)
+   *  @param[out] dst     変換先配列(V3DEx)
+   *  @param[in]  imax    配列サイズ(I方向)
+   *  @param[in]  jmax    配列サイズ(J方向)
+   *  @param[in]  kmax    配列サイズ(K方向)
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  pad_src 変換元のパディングサイズ(i,j,k,n)(NULLのときパディングなし)
+   *  @param[in]  pad_dst 変換先のパディングサイズ(n,i,j,k)(NULLのときパディングなし)
+   *  @param[in]  region  変換する領域(全領域、内部のみ、仮想セルのみ)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  static cpm_ErrorCode ConvertV3DtoV3DEx( const T *src, T *dst, int imax, int jmax, int kmax, int vc
+                                        , const int *pad_src=NULL, const int *pad_dst=NULL
+                                        , CPM_CONVERT_REGION region=CPM_CONVERT_ALL )
+  {
+    return ConvertS4DtoS4DEx( src, dst, imax, jmax, kmax, 3, vc, pad_src, pad_dst, region );
+  }
+
+  /** 配列レイアウトの変換 V3DEx(3,imax,jmax,kmax) -> V3D(imax,jmax,kmax,3)
+   *  - ConvertS4DExtoS4Dのnmax=3版
+   *  @param[in]  src     変換元配列(V3DEx)
+   *  @param[out] dst     変換先配列(V3D)
+   *  @param[in]  imax    配列サイズ(I方向)
+   *  @param[in]  jmax    配列サイズ(J方向)
+   *  @param[in]  kmax    配列サイズ(K方向)
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  pad_src 変換元のパディングサイズ(n,i,j,k)(NULLのときパディングなし)
+   *  @param[in]  pad_dst 変換先のパディングサイズ(i,j,k,n)(NULLのときパディングなし)
+   *  @param[in]  region  変換する領域(全領域、内部のみ、仮想セルのみ)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  static cpm_ErrorCode ConvertV3DExtoV3D( const T *src, T *dst, int imax, int jmax, int kmax, int vc
+                                        , const int *pad_src=NULL, const int *pad_dst=NULL
+                                        , CPM_CONVERT_REGION region=CPM_CONVERT_ALL )
+  {
+    return ConvertS4DExtoS4D( src, dst, 3, imax, jmax, kmax, vc, pad_src, pad_dst, region );
+  }
+
   /** 配列確保 double(imax,jmax,kmax)
    *  @param[in]  vc        仮想セル数
    *  @param[in]  padding   パディングフラグ(true:する、false:しない)
@@ -2057,13 +2457,51 @@ public:
   static int GetPaddingSize1D( const int size, const int vc );
 
   /** パディングサイズ取得処理(静的関数)
+   *  - paddingにCPM_PADDING_ONを指定したときはSetPaddingPolicyで設定された方式を使用する
+   *  - Alloc*(esize=確保する型のサイズ)とBndComm*(esize=sizeof(T))は同じ結果を返す
    *  @param[in]  atype    配列形状タイプ
    *  @param[in]  size     配列サイズ{imax,jmax,kmax}
    *  @param[in]  vc       仮想セル数
    *  @param[out] pad_size パディングサイズ(S3Dのとき3word、V3D,S4Dのとき4word{px,py,pz,pn}、V3DEx,S4DExのとき4word{pn,px,py,pz})
    *  @param[in]  nmax     成分数(S4D,S4DExのとき必須)
+   *  @param[in]  padding  パディングタイプ
+   *  @param[in]  esize    配列要素のサイズ[Byte]
+   */
+  static void GetPaddingSize( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax=0
+                            , CPM_PADDING padding=CPM_PADDING_ON, size_t esize=sizeof(double) );
+
+  /** パディング方式の設定(静的関数)
+   *  - CPM_PADDING_ON指定時に使用するパディング方式を設定する
+   *  - 配列確保後に変更すると、袖通信時のパディングサイズが一致しなくなるので注意
+   *  @param[in] policy パディング方式(CPM_PADDING_ODD,CPM_PADDING_CACHE,CPM_PADDING_AUTO)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  static cpm_ErrorCode SetPaddingPolicy( CPM_PADDING policy );
+
+  /** パディング方式の取得(静的関数)
+   *  @return CPM_PADDING_ON指定時に使用するパディング方式
+   */
+  static CPM_PADDING GetPaddingPolicy();
+
+  /** キャッシュ構成情報の設定(静的関数)
+   *  - 決定済みの配列形状のパディングサイズは変更しない(設定後に初めて求める形状から適用される)
+   *  @param[in] geom キャッシュ構成情報
+   */
+  static void SetCacheGeometry( const S_CACHE_GEOMETRY &geom );
+
+  /** キャッシュ構成情報の取得(静的関数)
+   *  @return キャッシュ構成情報
+   */
+  static const S_CACHE_GEOMETRY& GetCacheGeometry();
+
+  /** キャッシュ構成情報の検出(静的関数)
+   *  - Linuxのsysfs(/sys/devices/system/cpu/cpu0/cache)から取得する
+   *  - 取得できなかった項目は既定値のまま
+   *  @param[out] geom キャッシュ構成情報
+   *  @retval true  L1の情報を取得できた
+   *  @retval false 取得できなかった
    */
-  static void GetPaddingSize( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax=0 );
+  static bool DetectCacheGeometry( S_CACHE_GEOMETRY &geom );
 
 
 
@@ -2116,6 +2554,238 @@ protected:
   virtual
   int* AllocInt( int nmax, int sz[3], int vc, int procGrpNo ) = 0;
 
+  /** 粒子の移動先ランクの判定
+   *  - 各位置を含む領域のランク番号を求める(自ランクのときは自ランク番号、隣接ランクに限らない)
+   *  - 周期境界を越える位置は全体領域内に補正する
+   *
+   *  @param[in]    num          位置の数
+   *  @param[inout] pos          位置(3word/個)
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[out]   rank         移動先のランク番号(計算領域外のとき-1)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode FindParticleRank( int num, double *pos, int periodicFlag, int *rank, int procGrpNo ) = 0;
+
+  /** 粒子を送受信する隣接ランクリストの取得
+   *  - 自ランクを除き、昇順で重複のないリストとする
+   *  - 隣接関係は対称であること(ランクAのリストにBが含まれるとき、BのリストにもAが含まれる)
+   *
+   *  @param[out] rankList     隣接ランク番号のリスト
+   *  @param[in]  periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[in]  procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode GetParticleNeighborRank( std::vector<int> &rankList, int periodicFlag, int procGrpNo ) = 0;
+
+  /** 粒子の分類、送受信
+   *  - 移動しない粒子を配列の先頭に詰め、受信した粒子を受信バッファに格納する
+   *
+   *  @param[inout] particles    粒子の配列の先頭ポインタ
+   *  @param[inout] num          粒子数(移動しない粒子数を返す)
+   *  @param[in]    getPos       粒子の位置(3word)のポインタを返す関数
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ
+   *  @param[out]   recvBuf      受信バッファ
+   *  @param[out]   nrecv        受信した粒子数
+   *  @param[out]   numLost      削除した粒子数(NULLのとき出力しない)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, class P> CPM_INLINE
+  cpm_ErrorCode migrateParticles( T *particles, int &num, P* (*getPos)(T&), int periodicFlag
+                                , std::vector<char> &recvBuf, int &nrecv, int *numLost, int procGrpNo );
+
+  /** 粒子データの隣接ランク間の送受信
+   *  - 隣接ランク毎の粒子数を送受信した後、粒子データを送受信する
+   *
+   *  @param[in]  rankList  隣接ランク番号のリスト
+   *  @param[in]  scnt      隣接ランク毎の送信粒子数
+   *  @param[in]  sendBuf   送信バッファ(隣接ランク順に詰めた粒子データ)
+   *  @param[in]  esize     粒子1個のサイズ[Byte]
+   *  @param[out] recvBuf   受信バッファ(隣接ランク順に詰めた粒子データ)
+   *  @param[out] nrecv     受信した粒子数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode exchangeParticles( const std::vector<int> &rankList, const std::vector<int> &scnt
+                                 , const char *sendBuf, size_t esize, std::vector<char> &recvBuf
+                                 , int &nrecv, int procGrpNo );
+
+  /** 要素単位のAlltoallv(要素サイズのデータ型で送受信)
+   *  @param[in]  sendBuf   送信バッファ(ランク順に詰めたデータ)
+   *  @param[in]  scnt      ランク毎の送信要素数
+   *  @param[in]  esize     1要素のサイズ[Byte]
+   *  @param[out] recvBuf   受信バッファ(ランク順に詰めたデータ)
+   *  @param[out] rcnt      ランク毎の受信要素数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode alltoallvElement( const char *sendBuf, const std::vector<int> &scnt, size_t esize
+                                , std::vector<char> &recvBuf, std::vector<int> &rcnt, int procGrpNo );
+
+  /** 問い合わせに対する値の問い合わせ元への返送(値のサイズ指定)
+   *  @param[in]  query     RoutePointsToOwnerで受信した問い合わせ
+   *  @param[in]  value     問い合わせ毎の値
+   *  @param[in]  vsize     1点あたりの値のサイズ[Byte]
+   *  @param[out] result    自ランクの点毎の値
+   *  @param[in]  num       自ランクの点の数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode returnPointValues( const std::vector<S_POINT_QUERY> &query, const char *value, size_t vsize
+                                 , char *result, int num, int procGrpNo );
+
+  /** キャッシュ構成に基づくパディングサイズ取得処理(静的関数)
+   *  - j,k方向のステンシル参照およびS4Dの成分参照がL1/L2の同一セット、
+   *    4KiBエイリアシングに集中しないパディングサイズを求める
+   *  @param[in]  atype    配列形状タイプ(S4DまたはS4DEx)
+   *  @param[in]  size     配列サイズ{imax,jmax,kmax}
+   *  @param[in]  vc       仮想セル数
+   *  @param[out] pad_size パディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[in]  nmax     成分数
+   *  @param[in]  esize    配列要素のサイズ[Byte]
+   */
+  static void GetPaddingSizeCache( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax
+                                 , size_t esize );
+
+  /** 試行計測によるパディングサイズ取得処理(静的関数)
+   *  - 候補毎に7点ステンシルの計測を行い、最速のパディングサイズを選択する
+   *  - 計測時間で選択するため、実行毎、ランク毎に結果が異なることがある
+   *    (GetPaddingSizeで配列形状毎にm_padTuneMapに保持し、以降は再計算しない)
+   *  @param[in]  atype    配列形状タイプ(S4DまたはS4DEx)
+   *  @param[in]  size     配列サイズ{imax,jmax,kmax}
+   *  @param[in]  vc       仮想セル数
+   *  @param[out] pad_size パディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[in]  nmax     成分数
+   *  @param[in]  esize    配列要素のサイズ[Byte]
+   */
+  static void GetPaddingSizeAuto( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax
+                                , size_t esize );
+
+  /** アドレスオフセット群のキャッシュ競合度の評価(静的関数)
+   *  @param[in] offset アドレスオフセット[Byte]
+   *  @param[in] noff   オフセット数
+   *  @return 競合度(小さいほど良い)
+   */
+  static long long EvalCacheConflict( const long long *offset, int noff );
+
+  /** パディングサイズの試行計測(静的関数)
+   *  - 7点ステンシルを試行用の配列(kmax方向は数面のみ)に適用した時間を計測する
+   *  @param[in] nx   i方向サイズ(仮想セル、パディング込み)
+   *  @param[in] ny   j方向サイズ(仮想セル、パディング込み)
+   *  @param[in] nz   k方向サイズ(仮想セル込み)
+   *  @param[in] nb   セルあたりの要素数(S4DExのとき成分数+成分パディング数)
+   *  @return 計測時間[sec]
+   */
+  template<class T>
+  static double PaddingProbe( int nx, int ny, int nz, int nb );
+
+  /** 配列レイアウトの変換処理(静的関数)
+   *  - ConvertS4DtoS4DEx,ConvertS4DExtoS4Dの実処理
+   *  - LS,LDには変換元、変換先の配列形状(S4DまたはS4DEx)を指定する
+   *  @param[in]  src     変換元配列
+   *  @param[out] dst     変換先配列
+   *  @param[in]  imax    配列サイズ(I方向)
+   *  @param[in]  jmax    配列サイズ(J方向)
+   *  @param[in]  kmax    配列サイズ(K方向)
+   *  @param[in]  nmax    成分数
+   *  @param[in]  vc      仮想セル数
+   *  @param[in]  pad_src 変換元のパディングサイズ
+   *  @param[in]  pad_dst 変換先のパディングサイズ
+   *  @param[in]  region  変換する領域
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, CPM_ARRAY_SHAPE LS, CPM_ARRAY_SHAPE LD>
+  static cpm_ErrorCode ConvertLayout( const T *src, T *dst, int imax, int jmax, int kmax, int nmax, int vc
+                                    , const int *pad_src, const int *pad_dst, CPM_CONVERT_REGION region );
+
+  /** 逆方向袖通信の集約演算が対応しているかを判定(静的関数)
+   *  @param[in] op 集約演算(CPM_SUM,CPM_MIN,CPM_MAXに対応)
+   *  @retval true  対応している
+   *  @retval false 対応していない
+   */
+  static bool IsReverseOp( CPM_Op op )
+  {
+    return (op==CPM_SUM || op==CPM_MIN || op==CPM_MAX);
+  }
+
+  /** 集約演算の単位元の取得(静的関数)
+   *  - CPM_SUMは0、CPM_MINは型の最大値、CPM_MAXは型の最小値
+   *  @param[in] op 集約演算
+   *  @return 単位元
+   */
+  template<class T>
+  static T ReduceIdentity( CPM_Op op );
+
+  /** 配列の部分領域へのバッファの値の集約(静的関数)
+   *  - バッファは(i,j,k,n)の順に部分領域のサイズで詰めて格納されているものとする
+   *  @param[inout] a   配列ビュー
+   *  @param[in]    box 部分領域(始点3word、サイズ3word、実セル先頭を0とする)
+   *  @param[in]    buf バッファ
+   *  @param[in]    op  集約演算(CPM_SUM,CPM_MIN,CPM_MAX)
+   */
+  template<class T>
+  static void ReduceBox( const cpm_ArrayView<T, CPM_ARRAY_S4D> &a, const int box[6], const T *buf, CPM_Op op );
+
+  /** 配列の部分領域を指定値で埋める(静的関数)
+   *  @param[inout] a   配列ビュー
+   *  @param[in]    box 部分領域(始点3word、サイズ3word、実セル先頭を0とする)
+   *  @param[in]    val 値
+   */
+  template<class T>
+  static void FillBox( const cpm_ArrayView<T, CPM_ARRAY_S4D> &a, const int box[6], T val );
+
+  /** 登録フィールドの袖通信の開始判定
+   *  - 仮想セルが最新のときはtrueを返し、呼び出し側は通信を省略する
+   *  - 通信するときは通信済みの記録を消し、現在のバージョン番号を完了待ちとして記録する
+   *    (通信が正常に完了したときにcommitFieldCommで通信済みとする)
+   *  - 登録されていない配列のときは常にfalse
+   *
+   *  @param[in] array     配列の先頭ポインタ
+   *  @param[in] nmax      成分数
+   *  @param[in] vc_comm   通信する仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @retval    true      通信を省略する
+   *  @retval    false     通信する
+   */
+  bool beginFieldComm( const void *array, int nmax, int vc_comm, int procGrpNo );
+
+  /** 登録フィールドの非同期袖通信の完了判定
+   *  @param[in] array 配列の先頭ポインタ
+   *  @retval    true  直前の非同期袖通信を省略した(wait_での展開も省略する)
+   *  @retval    false 通信した、または登録されていない
+   */
+  bool endFieldComm( const void *array );
+
+  /** 登録フィールドの袖通信の完了の記録
+   *  - beginFieldCommで完了待ちとした通信を通信済みとして記録する
+   *  - 袖通信(wait_を含む)が正常に終了したときのみ呼ぶ(エラー時は通信済みとしない)
+   *  - 登録されていない配列のときは何もしない
+   *
+   *  @param[in] array 配列の先頭ポインタ
+   */
+  void commitFieldComm( const void *array );
+
+  /** 登録フィールドの配列の置き換え
+   *  - ライブラリ内で配列を確保し直したときに、登録をoldArrayからnewArrayに移す
+   *  - 配列の内容が変わるため、仮想セルは最新でないとする
+   *  - oldArrayが登録されていないときは何もしない
+   *
+   *  @param[in] oldArray 置き換え前の配列の先頭ポインタ
+   *  @param[in] newArray 置き換え後の配列の先頭ポインタ
+   */
+  void moveField( const void *oldArray, const void *newArray );
+
+  /** 登録フィールドの仮想セルの無効化
+   *  - 領域分割、木情報、袖通信情報を再生成したときに、指定プロセスグループで
+   *    通信した登録フィールドの仮想セルを最新でないとする
+   *
+   *  @param[in] procGrpNo プロセスグループ番号
+   */
+  void invalidateFieldComm( int procGrpNo );
+
 
 
 
@@ -2144,16 +2814,45 @@ protected:
    */
   std::vector<MPI_Comm> m_procGrpList;
 
-  /** MPI_Requestの管理マップ
+  /** MPI_Requestの管理プール
    *  - Fortranインターフェイス用
    */
-  cpm_ObjList<MPI_Request> m_reqList;
+  cpm_ObjPool<MPI_Request> m_reqList;
+
+  /** Waitall,cpm_Waitall用のステータス作業領域(呼び出し毎の確保を避けるため保持する) */
+  std::vector<MPI_Status> m_waitStat;
 
   /** プロセスグループ毎の定義点タイプ管理マップ
    *  - プロセスグループ番号をキーとした定義点タイプマップ
    *  - 自ランクが含まれるプロセスグループのみを管理する
    */
   DefPointMap m_defPointMap;
+
+  /** CPM_PADDING_ON指定時のパディング方式 */
+  static CPM_PADDING m_paddingPolicy;
+
+  /** パディングサイズ計算用のキャッシュ構成情報 */
+  static S_CACHE_GEOMETRY m_cacheGeom;
+
+  /** キャッシュ構成情報の検出済みフラグ */
+  static bool m_cacheGeomInit;
+
+  /** CPM_PADDING_CACHE,CPM_PADDING_AUTOで決定したパディングサイズのマップ
+   *  - 配列形状毎に最初に求めた結果を保持する(OpenMPのcriticalで排他する)
+   */
+  static PaddingTuneMap m_padTuneMap;
+
+  /** 袖通信の省略判定を行うフィールドのマップ */
+  FieldInfoMap m_fieldMap;
+
+  /** 登録フィールドの袖通信の呼び出し回数 */
+  long long m_fieldCommCount;
+
+  /** 登録フィールドの袖通信を省略した回数 */
+  long long m_fieldSkipCount;
+
+  /** 隣接ランク以外への粒子移動モード */
+  bool m_bParticleFar;
 };
 
 //インライン関数
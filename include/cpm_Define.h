@@ -62,6 +62,7 @@
 )
 
 /** 3次元インデクス(i,j,k) -> 1次元インデクス変換マクロ(パディング対応)
+ *  - パディング数にはAlloc*のpad_size、またはGetPaddingSizeで取得した値を指定する
  *  @param[in] _I  i方向インデクス
  *  @param[in] _J  j方向インデクス
  *  @param[in] _K  k方向インデクス
@@ -75,9 +76,9 @@
  *  @return 1次元インデクス
  */
 #define _IDX_S3D_PAD(_I,_J,_K,_NI,_NJ,_NK,_VC,_IP,_JP,_KP) \
-( (long long)(_K+_VC) * (long long)(_NI+2*(_VC)+_IP) * (long long)(_NJ+2*(_VC)+_JP) \
-+ (long long)(_J+_VC) * (long long)(_NI+2*(_VC)+_IP) \
-+ (long long)(_I+_VC) \
+( (long long)(_K+(_VC)) * (long long)(_NI+2*(_VC)+(_IP)) * (long long)(_NJ+2*(_VC)+(_JP)) \
++ (long long)(_J+(_VC)) * (long long)(_NI+2*(_VC)+(_IP)) \
++ (long long)(_I+(_VC)) \
 )
 
 /** 4次元インデクス(i,j,k,n) -> 1次元インデクス変換マクロ
@@ -111,7 +112,7 @@
  *  @return 1次元インデクス
  */
 #define _IDX_S4D_PAD(_I,_J,_K,_N,_NI,_NJ,_NK,_VC,_IP,_JP,_KP) \
-( (long long)(_N) * (long long)(_NI+2*(_VC)+_IP) * (long long)(_NJ+2*(_VC)+_JP) * (long long)(_NK+2*(_VC)+_KP) \
+( (long long)(_N) * (long long)(_NI+2*(_VC)+(_IP)) * (long long)(_NJ+2*(_VC)+(_JP)) * (long long)(_NK+2*(_VC)+(_KP)) \
 + _IDX_S3D_PAD(_I,_J,_K,_NI,_NJ,_NK,_VC,_IP,_JP,_KP) \
 )
 
@@ -159,6 +160,7 @@
 + (long long)(_N) )
 
 /** 4次元インデクス(n,i,j,k) -> 1次元インデクス変換マクロ(パディング対応)
+ *  - パディング数はAlloc*のpad_sizeと同じ{_NP,_IP,_JP,_KP}の順
  *  @param[in] _N  成分インデクス
  *  @param[in] _I  i方向インデクス
  *  @param[in] _J  j方向インデクス
@@ -175,7 +177,7 @@
  *  @return 1次元インデクス
  */
 #define _IDX_S4DEX_PAD(_N,_I,_J,_K,_NN,_NI,_NJ,_NK,_VC,_NP,_IP,_JP,_KP) \
-( (long long)(_NN+_NP) * _IDX_S3D_PAD(_I,_J,_K,_NI,_NJ,_NK,_VC,_IP,_JP,_KP) \
+( (long long)(_NN+(_NP)) * _IDX_S3D_PAD(_I,_J,_K,_NI,_NJ,_NK,_VC,_IP,_JP,_KP) \
 + (long long)(_N) )
 
 /** 3次元インデクス(3,i,j,k) -> 1次元インデクス変換マクロ
@@ -271,6 +273,7 @@ enum cpm_ErrorCode
 , CPM_ERROR_INVALID_DOMAIN_NO     = 1003 ///< 領域番号が不正
 , CPM_ERROR_INVALID_OBJKEY        = 1004 ///< 指定登録番号のオブジェクトが存在しない
 , CPM_ERROR_REGIST_OBJKEY         = 1005 ///< オブジェクト登録に失敗:
+, CPM_ERROR_INVALID_PADDING       = 1006 ///< パディングタイプが不正
 
 , CPM_ERROR_TEXTPARSER            = 2000 ///< テキストパーサーに関するエラー
 , CPM_ERROR_NO_TEXTPARSER         = 2001 ///< テキストパーサーを組み込んでいない
@@ -330,6 +333,8 @@ enum cpm_ErrorCode
 , CPM_ERROR_LMR_READ_OCT_HEADER   = 3203 ///< LMR用木情報ファイルのヘッダー情報読み込みエラー
 , CPM_ERROR_LMR_READ_OCT_PEDIGREE = 3204 ///< LMR用木情報ファイルのぺディグリー情報読み込みエラー
 , CPM_ERROR_LMR_MISMATCH_NP_NUMLEAF = 3205 ///< LMRでリーフ数と並列数が一致しない
+, CPM_ERROR_LMR_INVALID_WEIGHT    = 3206 ///< LMRのリーフの重みが不正
+, CPM_ERROR_LMR_ADAPT             = 3207 ///< LMRのリーフの細分化、粗大化でエラー
 
 , CPM_ERROR_GET_INFO              = 4000 ///< 情報取得系関数でエラー
 , CPM_ERROR_GET_DIVNUM            = 4001 ///< 領域分割数の取得エラー
@@ -372,6 +377,17 @@ enum cpm_ErrorCode
 , CPM_ERROR_MPI_GATHERV           = 9014 ///< MPI_Gathervでエラー
 , CPM_ERROR_MPI_ALLGATHERV        = 9015 ///< MPI_Allgathervでエラー
 , CPM_ERROR_MPI_DIMSCREATE        = 9016 ///< MPI_Dims_createでエラー
+, CPM_ERROR_MPI_IALLREDUCE        = 9017 ///< MPI_Iallreduceでエラー
+, CPM_ERROR_MPI_ALLTOALLV         = 9018 ///< MPI_Alltoallvでエラー
+, CPM_ERROR_MPI_FILE_OPEN         = 9019 ///< MPI_File_openでエラー
+, CPM_ERROR_MPI_FILE_VIEW         = 9020 ///< MPI_File_set_viewでエラー
+, CPM_ERROR_MPI_FILE_WRITE        = 9021 ///< MPI_File_write_allでエラー
+, CPM_ERROR_MPI_FILE_READ         = 9022 ///< MPI_File_read_allでエラー
+, CPM_ERROR_MPI_FILE_SIZE         = 9023 ///< ファイルサイズが全体配列サイズと一致しない
+, CPM_ERROR_MPI_TYPE_CREATE       = 9024 ///< 派生データ型の作成でエラー
+, CPM_ERROR_MPI_IALLTOALLV        = 9025 ///< MPI_Ialltoallvでエラー
+, CPM_ERROR_MPI_COMM_SPLIT        = 9026 ///< MPI_Comm_splitでエラー
+, CPM_ERROR_MPI_ALLTOALL          = 9027 ///< MPI_Alltoallでエラー
 
 , CPM_ERROR_BNDCOMM               = 9500 ///< BndCommでエラー
 , CPM_ERROR_BNDCOMM_VOXELSIZE     = 9501 ///< VoxelSize取得でエラー
@@ -383,6 +399,18 @@ enum cpm_ErrorCode
 , CPM_ERROR_PERIODIC_INVALID_DIR  = 9601 ///< 不正な軸方向フラグが指定された
 , CPM_ERROR_PERIODIC_INVALID_PM   = 9602 ///< 不正な正負方向フラグが指定された
 
+, CPM_ERROR_PENCIL                = 9700 ///< ペンシル転置でエラー
+, CPM_ERROR_PENCIL_INVALID_DIR    = 9701 ///< 不正な転置軸方向フラグが指定された
+, CPM_ERROR_PENCIL_DEFPOINT       = 9702 ///< 定義点がVOXEL(FVM)でない
+, CPM_ERROR_PENCIL_INACTIVE       = 9703 ///< 転置軸方向のラインに不活性な領域がある
+, CPM_ERROR_PENCIL_BUSY           = 9704 ///< 完了していない非同期転置がある
+
+, CPM_ERROR_PARTICLE              = 9800 ///< 粒子移動でエラー
+, CPM_ERROR_PARTICLE_OVERFLOW     = 9801 ///< 受信した粒子が配列の最大数を超えた
+
+, CPM_ERROR_FIELD                 = 9900 ///< フィールド登録でエラー
+, CPM_ERROR_FIELD_NOTREGIST       = 9901 ///< 登録されていない配列が指定された
+
 , CPM_ERROR_MPI_INVALID_COMM      = 9100 ///< MPIコミュニケータが不正
 , CPM_ERROR_MPI_INVALID_DATATYPE  = 9101 ///< 対応しない型が指定された
 , CPM_ERROR_MPI_INVALID_OPERATOR  = 9102 ///< 対応しないオペレータが指定された
@@ -444,12 +472,34 @@ enum CPM_ARRAY_SHAPE
 , CPM_ARRAY_S4DEX   = 4  ///< Scalar4DEx {n,imax,jmax,kmax}
 };
 
+/** パディングタイプ
+ *  - CPM_PADDING_ONはSetPaddingPolicyで設定された方式(既定値はCPM_PADDING_ODD)でパディングする
+ *  - 配列確保(Alloc*)と袖通信(BndComm*)には同じパディングタイプを指定すること
+ */
 enum CPM_PADDING
 {
-  CPM_PADDING_ON  = true,
-  CPM_PADDING_OFF = false,
+  CPM_PADDING_ON    = true,  ///< パディングする(SetPaddingPolicyで設定された方式)
+  CPM_PADDING_OFF   = false, ///< パディングしない
+  CPM_PADDING_ODD   = 2,     ///< 偶数サイズの次元を+1する(従来方式)
+  CPM_PADDING_CACHE = 3,     ///< キャッシュ構成情報からセット競合を回避するサイズを求める
+  CPM_PADDING_AUTO  = 4,     ///< 試行計測によりパディングサイズを決定する(配列形状毎に最初の結果を保持)
 };
 
+/** 配列レイアウト変換の対象領域 */
+enum CPM_CONVERT_REGION
+{
+  CPM_CONVERT_ALL   = 0 ///< 仮想セルを含む全領域
+, CPM_CONVERT_INNER = 1 ///< 内部領域のみ
+, CPM_CONVERT_GHOST = 2 ///< 仮想セルのみ
+};
+
+/** 配列レイアウト変換のi方向ブロックサイズ
+ *  - ブロック内の変換先(変換元)がL1キャッシュに収まるように設定する
+ */
+#ifndef CPM_CONVERT_BLOCK
+  #define CPM_CONVERT_BLOCK 32
+#endif
+
 /** デバッグライト用 */
 #ifndef stmpd_printf
   #define stmpd_printf printf("%s (%d):  ",__FILE__, __LINE__); printf
@@ -0,0 +1,184 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ObjPool.h
+ * 値型オブジェクトのプール管理クラスのヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_OBJPOOL_H_
+#define _CPM_OBJPOOL_H_
+
+#include <vector>
+#include "cpm_Base.h"
+
+/** CPMの値型オブジェクトプール管理クラス
+ *  - オブジェクトを連続領域に値で保持し、空きスロットをフリーリストで管理する
+ *  - 登録、取得、削除はO(1)で、定常状態ではメモリ確保を行わない
+ *  - 登録番号は1以上(スロット番号+1)
+ *  - Getで取得したポインタは、次のAddまで有効(領域拡張で移動する場合がある)
+ */
+template<class T>
+class cpm_ObjPool : public cpm_Base
+{
+////////////////////////////////////////////////////////////////////////////////
+// メンバー変数
+////////////////////////////////////////////////////////////////////////////////
+public:
+
+
+private:
+  /** 使用中スロットのリンク値 */
+  static const int USED = -2;
+
+  /** オブジェクトの配列 */
+  std::vector<T> m_obj;
+
+  /** フリーリストのリンク(空きスロットは次の空きスロット番号、終端は-1、使用中はUSED) */
+  std::vector<int> m_link;
+
+  /** 先頭の空きスロット番号(-1のとき空きなし) */
+  int m_freeHead;
+
+  /** 使用中のスロット数 */
+  int m_nUsed;
+
+  /** 削除時にスロットに設定する値 */
+  T m_init;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// メンバー関数
+////////////////////////////////////////////////////////////////////////////////
+public:
+
+  /** コンストラクタ
+   *  @param[in] init     削除したスロットに設定する値
+   *  @param[in] nreserve 初期に確保するスロット数
+   */
+  cpm_ObjPool( const T &init=T(), int nreserve=64 )
+  {
+    m_init     = init;
+    m_freeHead = -1;
+    m_nUsed    = 0;
+    Reserve( nreserve );
+  };
+
+  /** デストラクタ */
+  ~cpm_ObjPool()
+  {
+    m_obj.clear();
+    m_link.clear();
+  };
+
+  /** オブジェクトの追加
+   *  - 空きスロットが無い場合は、スロット数を倍に拡張する
+   *  @param[in] obj 追加するオブジェクト(値をコピーする)
+   *  @return 登録番号(負のとき登録失敗)
+   */
+  int Add( const T &obj )
+  {
+    if( m_freeHead < 0 )
+    {
+      int n = int(m_obj.size());
+      Reserve( (n > 0) ? 2*n : 64 );
+      if( m_freeHead < 0 )
+      {
+        return -1;
+      }
+    }
+
+    int idx = m_freeHead;
+    m_freeHead = m_link[idx];
+    m_link[idx] = USED;
+    m_obj[idx] = obj;
+    m_nUsed++;
+
+    return idx + 1;
+  };
+
+  /** オブジェクトの削除
+   *  @param[in] key Addの戻り値である登録番号
+   *  @return CPM終了コード(0,CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Delete( int key )
+  {
+    int idx = key - 1;
+    if( idx < 0 || idx >= int(m_link.size()) || m_link[idx] != USED )
+    {
+      return CPM_ERROR_INVALID_OBJKEY;
+    }
+
+    m_obj[idx] = m_init;
+    m_link[idx] = m_freeHead;
+    m_freeHead = idx;
+    m_nUsed--;
+
+    return CPM_SUCCESS;
+  };
+
+  /** オブジェクトの取得
+   *  @param[in] key Addの戻り値である登録番号
+   *  @return オブジェクトのポインタ(登録されていないときNULL)
+   */
+  T* Get( int key )
+  {
+    int idx = key - 1;
+    if( idx < 0 || idx >= int(m_link.size()) || m_link[idx] != USED )
+    {
+      return NULL;
+    }
+
+    return &m_obj[idx];
+  };
+
+  /** 使用中のオブジェクト数の取得
+   *  @return オブジェクト数
+   */
+  int GetCount() const
+  {
+    return m_nUsed;
+  };
+
+
+private:
+
+  /** スロットの拡張
+   *  - 追加したスロットはフリーリストの先頭に、番号の小さい順につなぐ
+   *  @param[in] n 拡張後のスロット数
+   */
+  void Reserve( int n )
+  {
+    int n0 = int(m_obj.size());
+    if( n <= n0 )
+    {
+      return;
+    }
+
+    m_obj.resize( n, m_init );
+    m_link.resize( n, -1 );
+    for( int i=n-1;i>=n0;i-- )
+    {
+      m_link[i] = m_freeHead;
+      m_freeHead = i;
+    }
+  };
+
+};
+
+#endif /* _CPM_OBJPOOL_H_ */
@@ -32,7 +32,8 @@ typedef std::map<int, cpm_VoxelInfo*> VoxelInfoMap;
 /** 袖通信バッファ情報 */
 struct S_BNDCOMM_BUFFER
 {
-  size_t m_maxVC; ///< 最大袖数
+  size_t m_maxVC; ///< 最大袖数(面毎の最大袖数の最大値)
+  size_t m_maxVCFace[6]; ///< 面毎の最大袖数(cpm_FaceFlag順)
   size_t m_maxN;  ///< 最大成分数
   size_t m_nwX;   ///< バッファサイズ
   size_t m_nwY;   ///< バッファサイズ
@@ -40,10 +41,15 @@ struct S_BNDCOMM_BUFFER
   REAL_BUF_TYPE *m_bufX[4]; ///< バッファ
   REAL_BUF_TYPE *m_bufY[4]; ///< バッファ
   REAL_BUF_TYPE *m_bufZ[4]; ///< バッファ
+  std::vector<char> m_bufRev[3][4]; ///< 逆方向袖通信のX,Y,Z方向毎のバッファ(必要に応じて拡張)
 
   S_BNDCOMM_BUFFER()
   {
     m_maxVC = m_maxN = 0;
+    for( int i=0;i<6;i++ )
+    {
+      m_maxVCFace[i] = 0;
+    }
     m_nwX = m_nwY = m_nwZ = 0;
     for( int i=0;i<4;i++ )
     {
@@ -68,7 +74,103 @@ struct S_BNDCOMM_BUFFER
    */
   size_t CalcBufferSize()
   {
-    return (m_nwX*4 + m_nwY*4 + m_nwZ*4) * sizeof(REAL_BUF_TYPE);
+    size_t sz = (m_nwX*4 + m_nwY*4 + m_nwZ*4) * sizeof(REAL_BUF_TYPE);
+    for( int d=0;d<3;d++ ){
+    for( int i=0;i<4;i++ ){
+      sz += m_bufRev[d][i].size();
+    }}
+    return sz;
+  }
+};
+
+/** データ再配置プラン
+ *  - 再配置元、再配置先のプロセスグループの部分領域の交差を保持する
+ *  - 領域は自ランクの配列の実セル先頭を0とした始点(3word)とサイズ(3word)の6wordで表す
+ */
+struct S_REDIST_PLAN
+{
+  int m_parentProcGrpNo;       ///< 通信を行う親プロセスグループ番号
+  int m_srcSize[3];            ///< 再配置元の自ランクの配列サイズ(含まれないとき0)
+  int m_dstSize[3];            ///< 再配置先の自ランクの配列サイズ(含まれないとき0)
+  std::vector<int> m_sendRank; ///< 送信先ランク番号(親プロセスグループでのランク)
+  std::vector<int> m_sendBox;  ///< 送信領域(再配置元の配列基準、6word/ランク)
+  std::vector<int> m_recvRank; ///< 受信元ランク番号(親プロセスグループでのランク)
+  std::vector<int> m_recvBox;  ///< 受信領域(再配置先の配列基準、6word/ランク)
+  int m_selfSend;              ///< 自ランク内コピーの送信領域番号(無いとき-1)
+  int m_selfRecv;              ///< 自ランク内コピーの受信領域番号(無いとき-1)
+
+  S_REDIST_PLAN()
+  {
+    m_parentProcGrpNo = 0;
+    for( int i=0;i<3;i++ )
+    {
+      m_srcSize[i] = m_dstSize[i] = 0;
+    }
+    m_selfSend = m_selfRecv = -1;
+  }
+};
+
+/** ペンシル転置プラン
+ *  - 転置軸方向のライン(転置軸以外の分割位置が同じランク)内で、
+ *    ブロック分割とペンシル(転置軸方向に全体を持つ)の間のAlltoallvの情報を保持する
+ *  - ペンシルは自ランクのブロックの分割軸(転置軸の次の軸)の範囲をライン内のランク数で分割する
+ *  - 領域は配列の実セル先頭を0とした始点(3word)とサイズ(3word)の6wordで表す
+ */
+struct S_PENCIL_PLAN
+{
+  MPI_Comm m_comm;               ///< 転置軸方向のラインのコミュニケータ
+  int m_nrank;                   ///< ライン内のランク数
+  int m_myPos;                   ///< ライン内の自ランク位置(転置軸方向の分割位置)
+  int m_blkSize[3];              ///< 自ランクのブロックのVOXEL数
+  int m_pencilSize[3];           ///< 自ランクのペンシルのVOXEL数
+  int m_pencilHead[3];           ///< 自ランクのペンシルの始点インデクス(全体空間)
+  std::vector<int> m_blkBox;     ///< ライン内の各ランクとやりとりするブロック側の領域(6word/ランク)
+  std::vector<int> m_pencilBox;  ///< ライン内の各ランクとやりとりするペンシル側の領域(6word/ランク)
+  std::vector<int> m_scnt;       ///< 送信要素数(Ialltoallv実行中は保持する)
+  std::vector<int> m_sdsp;       ///< 送信変位
+  std::vector<int> m_rcnt;       ///< 受信要素数
+  std::vector<int> m_rdsp;       ///< 受信変位
+  std::vector<char> m_sendBuf;   ///< 送信バッファ
+  std::vector<char> m_recvBuf;   ///< 受信バッファ
+  std::map<size_t, MPI_Datatype> m_elemType; ///< 要素サイズ毎の転送用データ型
+  int m_pending;                 ///< 実行中の非同期転置(0:なし、1:ブロック->ペンシル、2:ペンシル->ブロック)
+
+  S_PENCIL_PLAN()
+  {
+    m_comm = MPI_COMM_NULL;
+    m_nrank = 0;
+    m_myPos = 0;
+    for( int i=0;i<3;i++ )
+    {
+      m_blkSize[i] = m_pencilSize[i] = m_pencilHead[i] = 0;
+    }
+    m_pending = 0;
+  }
+};
+
+/** マルチグリッドの粗視化レベル情報
+ *  - 細格子のプロセスグループから作成した粗格子(VOXEL数1/2)のプロセスグループと、
+ *    レベル間の転送に使うデータ再配置プランを保持する
+ *  - 転送は粗格子の各ランクの領域を細格子で見た領域(粗格子の2倍)の作業配列を介して行う
+ */
+struct S_MG_LEVEL
+{
+  int m_fineProcGrpNo;   ///< 細格子のプロセスグループ番号
+  int m_coarseProcGrpNo; ///< 粗格子のプロセスグループ番号(含まれないとき-1)
+  int m_restrictPlanNo;  ///< 制限(細格子->作業配列)のデータ再配置プラン番号
+  int m_prolongPlanNo;   ///< 補間(作業配列->細格子)のデータ再配置プラン番号
+  int m_fineSize[3];     ///< 細格子の自ランクのVOXEL数
+  int m_coarseSize[3];   ///< 粗格子の自ランクのVOXEL数(含まれないとき0)
+
+  S_MG_LEVEL()
+  {
+    m_fineProcGrpNo = 0;
+    m_coarseProcGrpNo = -1;
+    m_restrictPlanNo = m_prolongPlanNo = -1;
+    for( int i=0;i<3;i++ )
+    {
+      m_fineSize[i] = m_coarseSize[i] = 0;
+    }
   }
 };
 
@@ -447,6 +549,20 @@ public:
    */
   bool Global2LocalIndex( int iG, int jG, int kG, int &iL, int &jL, int &kL, int procGrpNo=0 );
 
+  /** 座標の担当ランク、ローカルインデクスの一括検索
+   *  - 全体空間の原点、ピッチ、領域分割数から担当ランクとローカルインデクスを算術的に求める
+   *  - 通信は行わない(全ランクの座標を検索できる)
+   *  - 全体領域の上端の座標は端のセルに含める
+   *
+   *  @param[in]  num       点の数
+   *  @param[in]  pos       座標(3word/点)
+   *  @param[out] loc       検索結果(num個、leafは0、計算領域外、不活性領域のときrank,leaf,indexは-1)
+   *  @param[in]  procGrpNo プロセスグループ番号(省略時=0)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode LocatePoints( int num, const double *pos, S_POINT_LOCATION *loc, int procGrpNo=0 );
+
   /** 自ランクの境界が外部境界かどうかを判定
    *  @param[in] face      面方向
    *  @param[in] procGrpNo プロセスグループ番号(省略時=0)
@@ -480,6 +596,19 @@ public:
   virtual
   cpm_ErrorCode SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo=0 );
 
+  /** 袖通信バッファのセット(面毎の袖数指定)
+   *  - 6face分の送受信バッファを面毎の最大袖数に合わせて確保する
+   *  - X方向のバッファサイズは
+   *    (J方向サイズ+maxVC[Y_MINUS]+maxVC[Y_PLUS])*(K方向サイズ+maxVC[Z_MINUS]+maxVC[Z_PLUS])
+   *    *max(maxVC[X_MINUS],maxVC[X_PLUS])*maxN(Y,Z方向も同様)
+   *
+   *  @param[in] maxVC     送受信バッファの面毎の最大袖数(cpm_FaceFlag順)
+   *  @param[in] maxN      送受信バッファの最大成分数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode SetBndCommBuffer( const size_t maxVC[6], size_t maxN, int procGrpNo=0 );
+
   /** 袖通信バッファサイズの取得
    *  - 袖通信バッファとして確保されている配列サイズ(byte)を返す
    *
@@ -489,6 +618,39 @@ public:
   virtual
   size_t GetBndCommBufferSize( int procGrpNo=0 );
 
+  /** 時間ブロッキング用の袖通信バッファのセット
+   *  - ステンシル半径radiusの計算をnsweep回続けて行うための幅広の袖(radius*nsweep層)を
+   *    1回の袖通信で送受信できるバッファを確保する
+   *  - 既存のバッファの面毎の最大袖数、最大成分数より小さくはしない(全面が足りているときは再確保しない)
+   *
+   *  @param[in] radius    ステンシル半径(1回の計算で参照する仮想セル数)
+   *  @param[in] nsweep    袖通信1回あたりの計算回数
+   *  @param[in] maxN      送受信バッファの最大成分数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode SetTemporalBlockBuffer( int radius, int nsweep, size_t maxN, int procGrpNo=0 );
+
+  /** 時間ブロッキングの計算範囲の取得
+   *  - vc層の袖通信後、袖通信をせずにsweep回目の計算で正しい値が得られるセル範囲
+   *    [sta,end)を返す(ローカルインデクス、仮想セル側は負値またはサイズ以上)
+   *  - 隣接ランクのある面はvc-sweep*radius層だけ仮想セル側に広げた範囲、
+   *    隣接ランクの無い面(外部境界、内部境界)は実セルの端までの範囲となる
+   *  - 袖通信はX,Y,Zの順に仮想セルを含めて行うため、範囲内の辺、角の仮想セルも有効
+   *  - sweep回目の計算はsweep-1回目の結果を参照し、最終回(vc/radius回目)の範囲が実セル
+   *    (+隣接ランクの無い面の外側は利用側の境界条件で更新)となる
+   *
+   *  @param[in]  vc        袖通信した仮想セル数
+   *  @param[in]  radius    ステンシル半径
+   *  @param[in]  sweep     計算回数(1～vc/radius)
+   *  @param[out] sta       計算範囲の始点(I,J,K)
+   *  @param[out] end       計算範囲の終点+1(I,J,K)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode GetTemporalBlockRange( int vc, int radius, int sweep, int sta[3], int end[3]
+                                     , int procGrpNo=0 );
+
   /** 袖通信(Scalar3D版)
    *  - (imax,jmax,kmax)の形式の配列の袖通信を行う
    *
@@ -1129,6 +1291,326 @@ public:
                                , int vc, int vc_comm, cpm_DirFlag dir, cpm_PMFlag pm
                                , int pad_size[4], int procGrpNo );
 
+  /** 逆方向袖通信(Scalar3D版)
+   *  - (imax,jmax,kmax)の形式の配列の仮想セルの値を隣接ランクの内部セルへ送り、op で集約する
+   *  - 順方向の袖通信(BndCommS3D)の逆操作で、Z,Y,X方向の順に集約する
+   *  - CPM_SUMのときは送信した仮想セルを0にする(CPM_MIN,CPM_MAXのときは変更しない)
+   *  - 定義点がFDMのときは隣接ランクと共有する境界面も集約し、両ランクで同じ値になる
+   *  - 外部境界の仮想セルは変更しない
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z、外部境界で周期境界の隣接ランクへ送る)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @param[in]    padding      パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0
+                                  , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 逆方向袖通信(Vector3D版)
+   *  - (imax,jmax,kmax,3)の形式の配列の逆方向袖通信を行う
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @param[in]    padding      パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommV3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0
+                                  , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 逆方向袖通信(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の逆方向袖通信を行う
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @param[in]    padding      パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , CPM_Op op=CPM_SUM, int periodicFlag=0, int procGrpNo=0
+                                  , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 逆方向袖通信(Scalar4D版, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の逆方向袖通信を行う
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    pad_size     パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                  , CPM_Op op, int periodicFlag, int pad_size[4], int procGrpNo );
+
+  /** 非同期版逆方向袖通信(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の逆方向袖通信を開始する
+   *  - 方向毎の集約に依存関係があるため、ここではZ方向の送受信のみ開始し、
+   *    Y,X方向はwait_BndCommS4D_Reverseで順に処理する
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[out]   req          MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @param[in]    padding      パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                         , MPI_Request req[12], CPM_Op op=CPM_SUM, int periodicFlag=0
+                                         , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 非同期版逆方向袖通信(Scalar4D版, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の逆方向袖通信を開始する
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[out]   req          MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    pad_size     パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                         , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                         , int pad_size[4], int procGrpNo );
+
+  /** 非同期版逆方向袖通信のwait、集約(Scalar4D版)
+   *  - BndCommS4D_Reverse_nowaitと同じ引数で呼び出す
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[inout] req          MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @param[in]    padding      パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                       , MPI_Request req[12], CPM_Op op=CPM_SUM, int periodicFlag=0
+                                       , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 非同期版逆方向袖通信のwait、集約(Scalar4D版, パディングサイズ指定)
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[inout] req          MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[in]    pad_size     パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                       , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                       , int pad_size[4], int procGrpNo );
+
+  /** 袖通信(Scalar3D版, 面毎の通信袖数指定)
+   *  - (imax,jmax,kmax)の形式の配列の袖通信を行う
+   *  - vc_comm[face]はface側の仮想セルに受信する層数で、隣接ランクへはその反対側の層数を送信する
+   *  - vc_comm[face]は0以上vc以下で、プロセスグループ内で同じ値を指定する
+   *    (範囲外はCPM_ERROR_BNDCOMM、ランク間の不一致は_DEBUG定義時のみ検出してCPM_ERROR_BNDCOMM)
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @param[in]    padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS3D( T *array, int imax, int jmax, int kmax, int vc, const int vc_comm[6]
+                          , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 袖通信(Vector3D版, 面毎の通信袖数指定)
+   *  - (imax,jmax,kmax,3)の形式の配列の袖通信を行う
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @param[in]    padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommV3D( T *array, int imax, int jmax, int kmax, int vc, const int vc_comm[6]
+                          , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 袖通信(Scalar4D版, 面毎の通信袖数指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の袖通信を行う
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @param[in]    padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                          , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 袖通信(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の袖通信を行う
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]    pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                          , int pad_size[4], int procGrpNo );
+
+  /** 非同期版袖通信(Scalar4D版, 面毎の通信袖数指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の袖通信を行う
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[out]   req       MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @param[in]    padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                 , MPI_Request req[12], int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 非同期版袖通信(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の袖通信を行う
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[out]   req       MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                 , MPI_Request req[12], int pad_size[4], int procGrpNo );
+
+  /** 非同期版袖通信のwait、展開(Scalar4D版, 面毎の通信袖数指定)
+   *  - BndCommS4D_nowaitと同じ引数で呼び出す
+   *
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[inout] req       MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @param[in]    padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                               , MPI_Request req[12], int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 非同期版袖通信のwait、展開(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定)
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[inout] req       MPI_Request配列のポインタ(サイズ12)
+   *  @param[in]    pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                               , MPI_Request req[12], int pad_size[4], int procGrpNo );
+
   /** 袖通信(Vector3DEx版)
    *  - (3,imax,jmax,kmax)の形式の配列の袖通信を行う
    *
@@ -1617,72 +2099,862 @@ public:
 
 
 
-////// MPI処理のFortran用インターフェイス関数 //////
+////// 並列ファイル入出力関数 //////
 
-  /** cpm_BndCommS3D_nowait
-   *  - BndCommS3D_nowaitのインターフェイス
-   *  - Fortranインターフェイス用
+  /** 並列ファイル入出力のヒント設定
+   *  - WriteField*,ReadField*のMPI_File_openに渡すMPI_Infoの内容を設定する
+   *  - 集団バッファリング(two-phase I/O)のアグリゲータ数とバッファサイズを指定する
+   *  - 0以下を指定した項目はMPI実装のデフォルトを使用する
    *
-   *  @param[in]   array     袖通信をする配列の先頭ポインタ
-   *  @param[in]   imax      配列サイズ(I方向)
-   *  @param[in]   jmax      配列サイズ(J方向)
-   *  @param[in]   kmax      配列サイズ(K方向)
-   *  @param[in]   vc        仮想セル数
-   *  @param[in]   vc_comm   通信する仮想セル数
-   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
-   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
-   *  @param[in]   procGrpNo プロセスグループ番号
-   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   *  @param[in] cb_nodes       アグリゲータ数(cb_nodes)
+   *  @param[in] cb_buffer_size 集団バッファサイズ[Byte](cb_buffer_size)
    */
-  cpm_ErrorCode cpm_BndCommS3D_nowait( void *array, int imax, int jmax, int kmax
-                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+  void SetFieldIOHint( int cb_nodes, int cb_buffer_size );
 
-  /** cpm_BndCommV3D_nowait
-   *  - BndCommV3D_nowaitのインターフェイス
-   *  - Fortranインターフェイス用
+  /** 並列ファイル書き出し(Scalar3D版)
+   *  - (imax,jmax,kmax)の形式の配列の内部セル(仮想セル、パディングを除く)を
+   *    全体配列としてひとつのファイルに集団書き出しする
+   *  - ファイルは全体VOXEL数の配列をFortran順(i,j,k)で並べたバイナリ(ヘッダなし)
    *
-   *  @param[in]   array     袖通信をする配列の先頭ポインタ
-   *  @param[in]   imax      配列サイズ(I方向)
-   *  @param[in]   jmax      配列サイズ(J方向)
-   *  @param[in]   kmax      配列サイズ(K方向)
-   *  @param[in]   vc        仮想セル数
-   *  @param[in]   vc_comm   通信する仮想セル数
-   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
-   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
-   *  @param[in]   procGrpNo プロセスグループ番号
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @param[in] padding   パディングフラグ(true:ON、false:OFF)
    *  @return 終了コード(CPM_SUCCESS=正常終了)
    */
-  cpm_ErrorCode cpm_BndCommV3D_nowait( void *array, int imax, int jmax, int kmax
-                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldS3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                             , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル書き出し(Vector3D版)
+   *  - (imax,jmax,kmax,3)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - ファイルはFortran順(i,j,k,3)
+   *
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @param[in] padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldV3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                             , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル書き出し(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - ファイルはFortran順(i,j,k,n)
+   *
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @param[in] padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                             , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル書き出し(Scalar4D版, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                             , int pad_size[4], int procGrpNo=0 );
 
-  /** cpm_BndCommS4D_nowait
-   *  - BndCommS4D_nowaitのインターフェイス
-   *  - Fortranインターフェイス用
+  /** 並列ファイル書き出し(Scalar4D版, MPI_Datatype指定, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - MPI_Datatypeを指定するバージョン
    *
-   *  @param[in]   array     袖通信をする配列の先頭ポインタ
-   *  @param[in]   imax      配列サイズ(I方向)
-   *  @param[in]   jmax      配列サイズ(J方向)
-   *  @param[in]   kmax      配列サイズ(K方向)
-   *  @param[in]   nmax      配列サイズ(成分数)
-   *  @param[in]   vc        仮想セル数
-   *  @param[in]   vc_comm   通信する仮想セル数
-   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
-   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
-   *  @param[in]   procGrpNo プロセスグループ番号
+   *  @param[in] dtype     配列要素のMPI_Datatype
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in] procGrpNo プロセスグループ番号
    *  @return 終了コード(CPM_SUCCESS=正常終了)
    */
-  cpm_ErrorCode cpm_BndCommS4D_nowait( void *array, int imax, int jmax, int kmax, int nmax
-                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+  cpm_ErrorCode WriteFieldS4D( MPI_Datatype dtype, const char *fileName, void *array
+                             , int imax, int jmax, int kmax, int nmax, int vc
+                             , int pad_size[4], int procGrpNo=0 );
 
-  /** cpm_wait_BndCommS3D
-   *  - wait_BndCommS3Dのインターフェイス
-   *  - Fortranインターフェイス用
+  /** 並列ファイル書き出し(Vector3DEx版)
+   *  - (3,imax,jmax,kmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - ファイルはFortran順(3,i,j,k)
    *
-   *  @param[in]   array     袖通信をする配列の先頭ポインタ
-   *  @param[in]   imax      配列サイズ(I方向)
-   *  @param[in]   jmax      配列サイズ(J方向)
-   *  @param[in]   kmax      配列サイズ(K方向)
-   *  @param[in]   vc        仮想セル数
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @param[in] padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldV3DEx( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                               , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル書き出し(Scalar4DEx版)
+   *  - (nmax,imax,jmax,kmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - ファイルはFortran順(n,i,j,k)
+   *
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @param[in] padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                               , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル書き出し(Scalar4DEx版, パディングサイズ指定)
+   *  - (nmax,imax,jmax,kmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] pad_size  パディングサイズ(n,i,j,k)
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode WriteFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                               , int pad_size[4], int procGrpNo=0 );
+
+  /** 並列ファイル書き出し(Scalar4DEx版, MPI_Datatype指定, パディングサイズ指定)
+   *  - (nmax,imax,jmax,kmax)の形式の配列の内部セルをひとつのファイルに集団書き出しする
+   *  - MPI_Datatypeを指定するバージョン
+   *
+   *  @param[in] dtype     配列要素のMPI_Datatype
+   *  @param[in] fileName  ファイル名
+   *  @param[in] array     書き出す配列の先頭ポインタ
+   *  @param[in] nmax      配列サイズ(成分数)
+   *  @param[in] imax      配列サイズ(I方向)
+   *  @param[in] jmax      配列サイズ(J方向)
+   *  @param[in] kmax      配列サイズ(K方向)
+   *  @param[in] vc        仮想セル数
+   *  @param[in] pad_size  パディングサイズ(n,i,j,k)
+   *  @param[in] procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode WriteFieldS4DEx( MPI_Datatype dtype, const char *fileName, void *array
+                               , int nmax, int imax, int jmax, int kmax, int vc
+                               , int pad_size[4], int procGrpNo=0 );
+
+  /** 並列ファイル読み込み(Scalar3D版)
+   *  - WriteFieldS3Dで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *  - ファイルは全体配列なので、書き出し時と異なるランク数、領域分割でも読み込める
+   *  - 仮想セル、パディングの値は変更しない
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldS3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                            , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル読み込み(Vector3D版)
+   *  - WriteFieldV3Dで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldV3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                            , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル読み込み(Scalar4D版)
+   *  - WriteFieldS4Dで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                            , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル読み込み(Scalar4D版, パディングサイズ指定)
+   *  - WriteFieldS4Dで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                            , int pad_size[4], int procGrpNo=0 );
+
+  /** 並列ファイル読み込み(Scalar4D版, MPI_Datatype指定, パディングサイズ指定)
+   *  - WriteFieldS4Dで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *  - MPI_Datatypeを指定するバージョン
+   *
+   *  @param[in]  dtype     配列要素のMPI_Datatype
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode ReadFieldS4D( MPI_Datatype dtype, const char *fileName, void *array
+                            , int imax, int jmax, int kmax, int nmax, int vc
+                            , int pad_size[4], int procGrpNo=0 );
+
+  /** 並列ファイル読み込み(Vector3DEx版)
+   *  - WriteFieldV3DExで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldV3DEx( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                              , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル読み込み(Scalar4DEx版)
+   *  - WriteFieldS4DExで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                              , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 並列ファイル読み込み(Scalar4DEx版, パディングサイズ指定)
+   *  - WriteFieldS4DExで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(n,i,j,k)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ReadFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                              , int pad_size[4], int procGrpNo=0 );
+
+  /** 並列ファイル読み込み(Scalar4DEx版, MPI_Datatype指定, パディングサイズ指定)
+   *  - WriteFieldS4DExで書き出したファイルから自ランクの内部セルを集団読み込みする
+   *  - MPI_Datatypeを指定するバージョン
+   *
+   *  @param[in]  dtype     配列要素のMPI_Datatype
+   *  @param[in]  fileName  ファイル名
+   *  @param[out] array     読み込む配列の先頭ポインタ
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(n,i,j,k)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode ReadFieldS4DEx( MPI_Datatype dtype, const char *fileName, void *array
+                              , int nmax, int imax, int jmax, int kmax, int vc
+                              , int pad_size[4], int procGrpNo=0 );
+
+
+
+
+
+////// データ再配置関数 //////
+
+  /** データ再配置プランの作成
+   *  - 同じ全体空間を異なる領域分割をしたプロセスグループ間で、配列を移動するためのプランを作成する
+   *  - 各ランクの部分領域の交差(送受信領域)を一度だけ計算して保持する
+   *  - 親プロセスグループの全ランクでコールする(集団操作)
+   *  - 再配置元、再配置先に含まれないランクは、それぞれのプロセスグループ番号に-1を指定する
+   *  - 全ランクで同じ順番にコールすれば、同じプラン番号が返る
+   *
+   *  @param[in] srcProcGrpNo    再配置元のプロセスグループ番号(含まれないとき-1)
+   *  @param[in] dstProcGrpNo    再配置先のプロセスグループ番号(含まれないとき-1)
+   *  @param[in] parentProcGrpNo 両方のプロセスグループを含む親プロセスグループ番号
+   *  @return プラン番号(エラーのとき-1)
+   */
+  int CreateRedistPlan( int srcProcGrpNo, int dstProcGrpNo, int parentProcGrpNo=0 );
+
+  /** データ再配置プランの削除
+   *  @param[in] planNo プラン番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode DeleteRedistPlan( int planNo );
+
+  /** データ再配置(Scalar3D版)
+   *  - (imax,jmax,kmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *  - 配列サイズはプラン作成時の各プロセスグループの自ランクの配列サイズ
+   *  - 再配置先の仮想セル、パディングの値は変更しない
+   *  - 親プロセスグループの全ランクでコールする(含まれない側の配列はNULLでよい)
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  padding パディングフラグ(true:ON、false:OFF、両方の配列に適用)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeS3D( int planNo, T *src, int vcSrc, T *dst, int vcDst
+                               , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** データ再配置(Vector3D版)
+   *  - (imax,jmax,kmax,3)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  padding パディングフラグ(true:ON、false:OFF、両方の配列に適用)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeV3D( int planNo, T *src, int vcSrc, T *dst, int vcDst
+                               , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** データ再配置(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  nmax    成分数
+   *  @param[in]  padding パディングフラグ(true:ON、false:OFF、両方の配列に適用)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeS4D( int planNo, T *src, int vcSrc, T *dst, int vcDst, int nmax
+                               , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** データ再配置(Scalar4D版, パディングサイズ指定)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[in]  padSrc  再配置元のパディングサイズ(i,j,k,n)
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  padDst  再配置先のパディングサイズ(i,j,k,n)
+   *  @param[in]  nmax    成分数
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeS4D( int planNo, T *src, int vcSrc, int padSrc[4]
+                               , T *dst, int vcDst, int padDst[4], int nmax );
+
+  /** データ再配置(Vector3DEx版)
+   *  - (3,imax,jmax,kmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  padding パディングフラグ(true:ON、false:OFF、両方の配列に適用)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeV3DEx( int planNo, T *src, int vcSrc, T *dst, int vcDst
+                                 , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** データ再配置(Scalar4DEx版)
+   *  - (nmax,imax,jmax,kmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  nmax    成分数
+   *  @param[in]  padding パディングフラグ(true:ON、false:OFF、両方の配列に適用)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeS4DEx( int planNo, T *src, int vcSrc, T *dst, int vcDst, int nmax
+                                 , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** データ再配置(Scalar4DEx版, パディングサイズ指定)
+   *  - (nmax,imax,jmax,kmax)の形式の配列の実セルを再配置元から再配置先の領域分割に移動する
+   *
+   *  @param[in]  planNo  プラン番号
+   *  @param[in]  src     再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc   再配置元の仮想セル数
+   *  @param[in]  padSrc  再配置元のパディングサイズ(n,i,j,k)
+   *  @param[out] dst     再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst   再配置先の仮想セル数
+   *  @param[in]  padDst  再配置先のパディングサイズ(n,i,j,k)
+   *  @param[in]  nmax    成分数
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RedistributeS4DEx( int planNo, T *src, int vcSrc, int padSrc[4]
+                                 , T *dst, int vcDst, int padDst[4], int nmax );
+
+
+
+
+
+////// ペンシル転置関数 //////
+
+  /** ペンシルのVOXEL数と始点インデクスの取得
+   *  - dir方向のペンシル(dir方向に全体空間を持つ)での自ランクの領域を取得する
+   *  - ペンシルはブロック(VoxelInitの領域分割)の次の軸(X:Y軸、Y:Z軸、Z:X軸)の範囲を、
+   *    dir方向のライン内のランク数で分割した形状
+   *  - 初回はプロセスグループ内の集団操作(ライン毎のコミュニケータを作成、以降はキャッシュ)
+   *  - 定義点がVOXEL(FVM)で、不活性領域が無い領域分割のみ対応
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[out] size      ペンシルのVOXEL数
+   *  @param[out] head      ペンシルの始点インデクス(全体空間の先頭を0としたC型のインデクス)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode GetPencilSize( cpm_DirFlag dir, int size[3], int head[3], int procGrpNo=0 );
+
+  /** ブロックからペンシルへの転置(Scalar3D版)
+   *  - (imax,jmax,kmax)の形式の配列の実セルを、dir方向のペンシルの配列に転置する
+   *  - ペンシルの配列は仮想セル、パディングなしの(size[0],size[1],size[2])の形式(GetPencilSize参照)
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  array     ブロックの配列の先頭ポインタ
+   *  @param[in]  vc        仮想セル数
+   *  @param[out] pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeToPencilS3D( cpm_DirFlag dir, T *array, int vc, T *pencil
+                                    , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** ブロックからペンシルへの転置(Scalar4D版)
+   *  - (imax,jmax,kmax,nmax)の形式の配列の実セルを、dir方向のペンシルの配列に転置する
+   *  - ペンシルの配列は仮想セル、パディングなしの(size[0],size[1],size[2],nmax)の形式
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  array     ブロックの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[in]  vc        仮想セル数
+   *  @param[out] pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeToPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, T *pencil
+                                    , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** ブロックからペンシルへの転置(Scalar4D版, パディングサイズ指定)
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  array     ブロックの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n、NULLのときパディングなし)
+   *  @param[out] pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeToPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4], T *pencil
+                                    , int procGrpNo=0 );
+
+  /** ブロックからペンシルへの非同期転置(Scalar4D版)
+   *  - 送信データをパックしてIalltoallvを発行し、requestを返す
+   *  - 受信データの展開はwait_TransposeToPencilS4Dをコールする
+   *  - 同じ転置軸、プロセスグループで同時に実行できる非同期転置は1つ
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  array     ブロックの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n、NULLのときパディングなし)
+   *  @param[out] req       MPIリクエスト
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeToPencilS4D_nowait( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4]
+                                           , MPI_Request *req, int procGrpNo=0 );
+
+  /** ブロックからペンシルへの非同期転置のwait、展開(Scalar4D版)
+   *
+   *  @param[in]    dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[out]   pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]    nmax      成分数
+   *  @param[inout] req       MPIリクエスト
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_TransposeToPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, MPI_Request *req
+                                         , int procGrpNo=0 );
+
+  /** ペンシルからブロックへの転置(Scalar3D版)
+   *  - dir方向のペンシルの配列を、(imax,jmax,kmax)の形式の配列の実セルに転置する
+   *  - ブロックの配列の仮想セル、パディングの値は変更しない
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  pencil    ペンシルの配列の先頭ポインタ
+   *  @param[out] array     ブロックの配列の先頭ポインタ
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeFromPencilS3D( cpm_DirFlag dir, T *pencil, T *array, int vc
+                                      , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** ペンシルからブロックへの転置(Scalar4D版)
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[out] array     ブロックの配列の先頭ポインタ
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @param[in]  padding   パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeFromPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, T *array, int vc
+                                      , int procGrpNo=0, CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** ペンシルからブロックへの転置(Scalar4D版, パディングサイズ指定)
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[out] array     ブロックの配列の先頭ポインタ
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n、NULLのときパディングなし)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeFromPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, T *array, int vc, int pad_size[4]
+                                      , int procGrpNo=0 );
+
+  /** ペンシルからブロックへの非同期転置(Scalar4D版)
+   *  - 送信データをパックしてIalltoallvを発行し、requestを返す
+   *  - 受信データの展開はwait_TransposeFromPencilS4Dをコールする
+   *
+   *  @param[in]  dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  pencil    ペンシルの配列の先頭ポインタ
+   *  @param[in]  nmax      成分数
+   *  @param[out] req       MPIリクエスト
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode TransposeFromPencilS4D_nowait( cpm_DirFlag dir, T *pencil, int nmax, MPI_Request *req
+                                             , int procGrpNo=0 );
+
+  /** ペンシルからブロックへの非同期転置のwait、展開(Scalar4D版)
+   *
+   *  @param[in]    dir       転置軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[out]   array     ブロックの配列の先頭ポインタ
+   *  @param[in]    nmax      成分数
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    pad_size  パディングサイズ(i,j,k,n、NULLのときパディングなし)
+   *  @param[inout] req       MPIリクエスト
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode wait_TransposeFromPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4]
+                                           , MPI_Request *req, int procGrpNo=0 );
+
+
+
+
+
+////// マルチグリッド関数 //////
+
+  /** マルチグリッドの粗視化レベルの作成
+   *  - fineProcGrpNoの全体VOXEL数を各軸1/2にした粗格子の領域分割を作成する
+   *  - 粗格子の1ランクあたりのVOXEL数がminLocalVoxel未満になる軸は、分割数を半分にして
+   *    少ないランクに集約する(集約後のランクで粗格子のプロセスグループを作成)
+   *  - 粗格子の領域分割は細格子と同じ原点、領域サイズ、袖通信バッファサイズでVoxelInitする
+   *  - 粗格子の袖通信は既存の袖通信関数にGetCoarseProcGrpのプロセスグループ番号を指定して行う
+   *  - fineProcGrpNo内の集団操作
+   *  - 細格子は定義点がVOXEL(FVM)で、不活性領域の無い領域分割であること
+   *
+   *  @param[in] fineProcGrpNo 細格子のプロセスグループ番号
+   *  @param[in] minLocalVoxel 粗格子の1ランクあたりの各軸の最小VOXEL数
+   *  @return レベル番号(エラー時-1、全体VOXEL数が奇数の軸があるときもエラー)
+   */
+  int CreateCoarseLevel( int fineProcGrpNo=0, int minLocalVoxel=4 );
+
+  /** 粗格子のプロセスグループ番号の取得
+   *
+   *  @param[in] levelNo レベル番号
+   *  @return 粗格子のプロセスグループ番号(自ランクが含まれないとき、レベルが存在しないとき-1)
+   */
+  int GetCoarseProcGrp( int levelNo );
+
+  /** 細格子から粗格子への制限(Scalar3D版)
+   *  - 粗格子の各セルに、対応する細格子の2x2x2セルの平均値をセットする
+   *  - 細格子、粗格子とも実セルのみを対象とする(粗格子の仮想セルは袖通信で更新する)
+   *  - fineProcGrpNo内の集団操作(粗格子に含まれないランクはcoarseにNULLを指定できる)
+   *
+   *  @param[in]  levelNo  レベル番号
+   *  @param[in]  fine     細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine   細格子の仮想セル数
+   *  @param[out] coarse   粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse 粗格子の仮想セル数
+   *  @param[in]  padding  パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RestrictS3D( int levelNo, T *fine, int vcFine, T *coarse, int vcCoarse
+                           , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 細格子から粗格子への制限(Scalar4D版)
+   *
+   *  @param[in]  levelNo  レベル番号
+   *  @param[in]  fine     細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine   細格子の仮想セル数
+   *  @param[out] coarse   粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse 粗格子の仮想セル数
+   *  @param[in]  nmax     成分数
+   *  @param[in]  padding  パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RestrictS4D( int levelNo, T *fine, int vcFine, T *coarse, int vcCoarse, int nmax
+                           , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 細格子から粗格子への制限(Scalar4D版, パディングサイズ指定)
+   *
+   *  @param[in]  levelNo   レベル番号
+   *  @param[in]  fine      細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine    細格子の仮想セル数
+   *  @param[in]  padFine   細格子のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[out] coarse    粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse  粗格子の仮想セル数
+   *  @param[in]  padCoarse 粗格子のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[in]  nmax      成分数
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode RestrictS4D( int levelNo, T *fine, int vcFine, int padFine[4]
+                           , T *coarse, int vcCoarse, int padCoarse[4], int nmax );
+
+  /** 粗格子から細格子への補間(Scalar3D版)
+   *  - 細格子の各セルに、対応する粗格子のセルの値をセットする(区分一定補間)
+   *  - 細格子の値は上書きされるので、修正量を加算するときは作業配列に補間してから加算する
+   *  - fineProcGrpNo内の集団操作(粗格子に含まれないランクはcoarseにNULLを指定できる)
+   *
+   *  @param[in]  levelNo  レベル番号
+   *  @param[in]  coarse   粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse 粗格子の仮想セル数
+   *  @param[out] fine     細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine   細格子の仮想セル数
+   *  @param[in]  padding  パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ProlongS3D( int levelNo, T *coarse, int vcCoarse, T *fine, int vcFine
+                          , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 粗格子から細格子への補間(Scalar4D版)
+   *
+   *  @param[in]  levelNo  レベル番号
+   *  @param[in]  coarse   粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse 粗格子の仮想セル数
+   *  @param[out] fine     細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine   細格子の仮想セル数
+   *  @param[in]  nmax     成分数
+   *  @param[in]  padding  パディングフラグ(true:ON、false:OFF)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ProlongS4D( int levelNo, T *coarse, int vcCoarse, T *fine, int vcFine, int nmax
+                          , CPM_PADDING padding=CPM_PADDING_OFF );
+
+  /** 粗格子から細格子への補間(Scalar4D版, パディングサイズ指定)
+   *
+   *  @param[in]  levelNo   レベル番号
+   *  @param[in]  coarse    粗格子の配列の先頭ポインタ
+   *  @param[in]  vcCoarse  粗格子の仮想セル数
+   *  @param[in]  padCoarse 粗格子のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[out] fine      細格子の配列の先頭ポインタ
+   *  @param[in]  vcFine    細格子の仮想セル数
+   *  @param[in]  padFine   細格子のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[in]  nmax      成分数
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode ProlongS4D( int levelNo, T *coarse, int vcCoarse, int padCoarse[4]
+                          , T *fine, int vcFine, int padFine[4], int nmax );
+
+
+
+
+
+////// MPI処理のFortran用インターフェイス関数 //////
+
+  /** cpm_BndCommS3D_nowait
+   *  - BndCommS3D_nowaitのインターフェイス
+   *  - Fortranインターフェイス用
+   *
+   *  @param[in]   array     袖通信をする配列の先頭ポインタ
+   *  @param[in]   imax      配列サイズ(I方向)
+   *  @param[in]   jmax      配列サイズ(J方向)
+   *  @param[in]   kmax      配列サイズ(K方向)
+   *  @param[in]   vc        仮想セル数
+   *  @param[in]   vc_comm   通信する仮想セル数
+   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
+   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
+   *  @param[in]   procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode cpm_BndCommS3D_nowait( void *array, int imax, int jmax, int kmax
+                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+
+  /** cpm_BndCommV3D_nowait
+   *  - BndCommV3D_nowaitのインターフェイス
+   *  - Fortranインターフェイス用
+   *
+   *  @param[in]   array     袖通信をする配列の先頭ポインタ
+   *  @param[in]   imax      配列サイズ(I方向)
+   *  @param[in]   jmax      配列サイズ(J方向)
+   *  @param[in]   kmax      配列サイズ(K方向)
+   *  @param[in]   vc        仮想セル数
+   *  @param[in]   vc_comm   通信する仮想セル数
+   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
+   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
+   *  @param[in]   procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode cpm_BndCommV3D_nowait( void *array, int imax, int jmax, int kmax
+                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+
+  /** cpm_BndCommS4D_nowait
+   *  - BndCommS4D_nowaitのインターフェイス
+   *  - Fortranインターフェイス用
+   *
+   *  @param[in]   array     袖通信をする配列の先頭ポインタ
+   *  @param[in]   imax      配列サイズ(I方向)
+   *  @param[in]   jmax      配列サイズ(J方向)
+   *  @param[in]   kmax      配列サイズ(K方向)
+   *  @param[in]   nmax      配列サイズ(成分数)
+   *  @param[in]   vc        仮想セル数
+   *  @param[in]   vc_comm   通信する仮想セル数
+   *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
+   *  @param[out]  reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
+   *  @param[in]   procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode cpm_BndCommS4D_nowait( void *array, int imax, int jmax, int kmax, int nmax
+                                     , int vc, int vc_comm, int datatype, int *reqNo, int procGrpNo=0 );
+
+  /** cpm_wait_BndCommS3D
+   *  - wait_BndCommS3Dのインターフェイス
+   *  - Fortranインターフェイス用
+   *
+   *  @param[in]   array     袖通信をする配列の先頭ポインタ
+   *  @param[in]   imax      配列サイズ(I方向)
+   *  @param[in]   jmax      配列サイズ(J方向)
+   *  @param[in]   kmax      配列サイズ(K方向)
+   *  @param[in]   vc        仮想セル数
    *  @param[in]   vc_comm   通信する仮想セル数
    *  @param[in]   datatype  袖通信データのデータタイプ(cpm_fparam.fi参照)
    *  @param[in]   reqNo     リクエスト番号配列(サイズ48,CARTの場合12でも良い)
@@ -1849,6 +3121,31 @@ protected:
   virtual
   int* AllocInt( int nmax, int sz[3], int vc, int procGrpNo );
 
+  /** 粒子の移動先ランクの判定
+   *  - 周期境界を補正した位置をLocatePointsで検索し、担当ランク番号を求める(隣接領域に限らない)
+   *  - 周期境界を越える位置は全体領域内[始点,終点)に補正する(丸め誤差で端面に一致するときは始点とする)
+   *
+   *  @param[in]    num          位置の数
+   *  @param[inout] pos          位置(3word/個)
+   *  @param[in]    periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[out]   rank         移動先のランク番号(計算領域外、不活性領域のとき-1)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode FindParticleRank( int num, double *pos, int periodicFlag, int *rank, int procGrpNo );
+
+  /** 粒子を送受信する隣接ランクリストの取得
+   *  - 26方向の隣接領域のランク番号(自ランク、不活性領域を除く)
+   *
+   *  @param[out] rankList     隣接ランク番号のリスト
+   *  @param[in]  periodicFlag 周期境界とする軸のビットフラグ(bit0:X、bit1:Y、bit2:Z)
+   *  @param[in]  procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  virtual
+  cpm_ErrorCode GetParticleNeighborRank( std::vector<int> &rankList, int periodicFlag, int procGrpNo );
+
   /** 並列プロセス数からI,J,K方向の分割数を取得する
    *  - 通信面のトータルサイズが小さい分割パターンを採用する
    *
@@ -2186,6 +3483,255 @@ protected:
   cpm_ErrorCode sendrecv( T *sendm, T *recvm, T *sendp, T *recvp, size_t nw, MPI_Request *req
                         , int nIDsm, int nIDrm, int nIDsp, int nIDrp, int procGrpNo=0 );
 
+  /** 逆方向袖通信の隣接ランク番号と送信、受信、仮想セルの領域を取得
+   *  - 領域は始点3word、サイズ3wordで、通信面内の軸は仮想セルを含む全範囲
+   *  - 定義点がFDMのときは隣接ランクと共有する境界面を送信、受信領域に含める
+   *
+   *  @param[in]  sz           配列サイズ(I,J,K方向)
+   *  @param[in]  vc_comm      通信する仮想セル数
+   *  @param[in]  dir          通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]  periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[out] nIDm         マイナス方向の隣接ランク番号
+   *  @param[out] nIDp         プラス方向の隣接ランク番号
+   *  @param[out] sbox         送信領域(マイナス方向、プラス方向)
+   *  @param[out] rbox         受信値を集約する領域(マイナス方向、プラス方向)
+   *  @param[out] gbox         送信する仮想セルの領域(マイナス方向、プラス方向)
+   *  @param[in]  procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode getReverseInfo( const int sz[3], int vc_comm, cpm_DirFlag dir, int periodicFlag
+                              , int &nIDm, int &nIDp, int sbox[2][6], int rbox[2][6], int gbox[2][6]
+                              , int procGrpNo );
+
+  /** 逆方向袖通信の１方向(プラス、マイナス)の仮想セルのパックと送受信の開始
+   *  - 和のときは送信した仮想セルを0にする
+   *
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    pad_size     パディングサイズ(i,j,k,n)
+   *  @param[in]    dir          通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[out]   req          MPI_Request配列のポインタ(サイズ4)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode sendrecvReverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
+                               , cpm_DirFlag dir, CPM_Op op, int periodicFlag, MPI_Request req[4], int procGrpNo );
+
+  /** 逆方向袖通信の１方向(プラス、マイナス)の受信待機と内部セルへの集約
+   *  @param[inout] array        袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax         配列サイズ(I方向)
+   *  @param[in]    jmax         配列サイズ(J方向)
+   *  @param[in]    kmax         配列サイズ(K方向)
+   *  @param[in]    nmax         配列サイズ(成分数)
+   *  @param[in]    vc           仮想セル数
+   *  @param[in]    vc_comm      通信する仮想セル数
+   *  @param[in]    pad_size     パディングサイズ(i,j,k,n)
+   *  @param[in]    dir          通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[in]    op           集約の演算子(CPM_SUM, CPM_MIN, CPM_MAX)
+   *  @param[in]    periodicFlag 周期境界フラグ(bit0:X, bit1:Y, bit2:Z)
+   *  @param[inout] req          MPI_Request配列のポインタ(サイズ4)
+   *  @param[in]    procGrpNo    プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode waitReverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
+                           , cpm_DirFlag dir, CPM_Op op, int periodicFlag, MPI_Request req[4], int procGrpNo );
+
+  /** 送受信サイズを指定した１方向(プラス、マイナス)の双方向袖通信処理
+   *  - サイズが0の送受信は行わない
+   *
+   *  @param[in]  sendm     マイナス方向送信バッファ
+   *  @param[in]  nwsm      マイナス方向送信サイズ
+   *  @param[in]  recvm     マイナス方向受信バッファ
+   *  @param[in]  nwrm      マイナス方向受信サイズ
+   *  @param[in]  sendp     プラス方向送信バッファ
+   *  @param[in]  nwsp      プラス方向送信サイズ
+   *  @param[in]  recvp     プラス方向受信バッファ
+   *  @param[in]  nwrp      プラス方向受信サイズ
+   *  @param[out] req       MPI_Request配列のポインタ(サイズ4)
+   *  @param[in]  nIDm      マイナス方向の隣接ランク番号
+   *  @param[in]  nIDp      プラス方向の隣接ランク番号
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T>
+  cpm_ErrorCode sendrecv( T *sendm, size_t nwsm, T *recvm, size_t nwrm, T *sendp, size_t nwsp, T *recvp, size_t nwrp
+                        , MPI_Request *req, int nIDm, int nIDp, int procGrpNo=0 );
+
+  /** 面毎の通信袖数指定の袖通信の隣接ランク番号と送信、受信領域を取得
+   *  - 領域は始点3word、サイズ3wordで、通信面内の軸は面毎の通信袖数を含む範囲
+   *  - マイナス側へはプラス側の袖数、プラス側へはマイナス側の袖数の層を送信する
+   *
+   *  @param[in]  sz        配列サイズ(I,J,K方向)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]  dir       通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[out] nIDm      マイナス方向の隣接ランク番号
+   *  @param[out] nIDp      プラス方向の隣接ランク番号
+   *  @param[out] sbox      送信領域(マイナス方向、プラス方向)
+   *  @param[out] rbox      受信領域(マイナス方向、プラス方向)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode getFaceCommInfo( const int sz[3], int vc, const int vc_comm[6], cpm_DirFlag dir
+                               , int &nIDm, int &nIDp, int sbox[2][6], int rbox[2][6], int procGrpNo );
+
+  /** 面毎の通信袖数がプロセスグループ内の全ランクで一致するかどうかのチェック
+   *  - 集団通信で最小値、最大値を比較する(_DEBUG定義時に面毎の通信袖数指定の袖通信から呼ぶ)
+   *
+   *  @param[in]  vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=一致、CPM_ERROR_BNDCOMM=不一致)
+   */
+  cpm_ErrorCode checkFaceCommWidth( const int vc_comm[6], int procGrpNo );
+
+  /** 面毎の通信袖数指定の袖通信の１方向(プラス、マイナス)のパックと送受信の開始
+   *  @param[in]  array     袖通信をする配列の先頭ポインタ
+   *  @param[in]  imax      配列サイズ(I方向)
+   *  @param[in]  jmax      配列サイズ(J方向)
+   *  @param[in]  kmax      配列サイズ(K方向)
+   *  @param[in]  nmax      配列サイズ(成分数)
+   *  @param[in]  vc        仮想セル数
+   *  @param[in]  vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]  pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]  dir       通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[out] req       MPI_Request配列のポインタ(サイズ4)
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode sendrecvFace( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                            , int pad_size[4], cpm_DirFlag dir, MPI_Request req[4], int procGrpNo );
+
+  /** 面毎の通信袖数指定の袖通信の１方向(プラス、マイナス)の受信待機と展開
+   *  @param[inout] array     袖通信をする配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    vc_comm   面毎の通信する仮想セル数(cpm_FaceFlag順)
+   *  @param[in]    pad_size  パディングサイズ(i,j,k,n)
+   *  @param[in]    dir       通信する軸方向(X_DIR or Y_DIR or Z_DIR)
+   *  @param[inout] req       MPI_Request配列のポインタ(サイズ4)
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T> CPM_INLINE
+  cpm_ErrorCode waitFace( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                        , int pad_size[4], cpm_DirFlag dir, MPI_Request req[4], int procGrpNo );
+
+  /** 並列ファイル入出力の実処理
+   *  - 配列側、ファイル側ともにMPI_Type_create_subarrayで内部セルを切り出し、
+   *    ファイルビューを設定して集団入出力を行う
+   *
+   *  @param[in]    bWrite    true:書き出し、false:読み込み
+   *  @param[in]    dtype     配列要素のMPI_Datatype
+   *  @param[in]    fileName  ファイル名
+   *  @param[inout] array     入出力する配列の先頭ポインタ
+   *  @param[in]    imax      配列サイズ(I方向)
+   *  @param[in]    jmax      配列サイズ(J方向)
+   *  @param[in]    kmax      配列サイズ(K方向)
+   *  @param[in]    nmax      配列サイズ(成分数)
+   *  @param[in]    vc        仮想セル数
+   *  @param[in]    bEx       true:S4DEx形式(n,i,j,k)、false:S4D形式(i,j,k,n)
+   *  @param[in]    pad_size  パディングサイズ(S4Dのとき(i,j,k,n)、S4DExのとき(n,i,j,k))
+   *  @param[in]    procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode FieldIO( bool bWrite, MPI_Datatype dtype, const char *fileName, void *array
+                       , int imax, int jmax, int kmax, int nmax, int vc, bool bEx
+                       , int pad_size[4], int procGrpNo );
+
+  /** 自ランクの領域からデータ再配置プランを作成
+   *  - 親プロセスグループ内の集団操作
+   *
+   *  @param[in] mine            自ランクの領域(再配置元の始点、サイズ、全体サイズ、
+   *                             再配置先の始点、サイズ、全体サイズの各3word、含まれないときサイズ0)
+   *  @param[in] parentProcGrpNo 通信を行う親プロセスグループ番号
+   *  @return プラン番号(エラー時-1)
+   */
+  int createRedistPlan( const int mine[18], int parentProcGrpNo );
+
+  /** データ再配置プランの検索
+   *  @param[in] planNo プラン番号
+   *  @return プランのポインタ(存在しないときNULL)
+   */
+  S_REDIST_PLAN* FindRedistPlan( int planNo );
+
+  /** データ再配置の実処理
+   *  - 送受信領域を配列形状(Layout)の並びでパックしてIsend/Irecvで送受信する
+   *  - 自ランク内の領域はバッファを介さずに直接コピーする
+   *
+   *  @param[in]  planNo プラン番号
+   *  @param[in]  src    再配置元の配列の先頭ポインタ
+   *  @param[in]  vcSrc  再配置元の仮想セル数
+   *  @param[in]  padSrc 再配置元のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[out] dst    再配置先の配列の先頭ポインタ
+   *  @param[in]  vcDst  再配置先の仮想セル数
+   *  @param[in]  padDst 再配置先のパディングサイズ(GetPaddingSizeと同じ並び)
+   *  @param[in]  nmax   成分数
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  cpm_ErrorCode redistribute( int planNo, T *src, int vcSrc, int padSrc[4]
+                            , T *dst, int vcDst, int padDst[4], int nmax );
+
+  /** データ再配置の領域のパック、展開
+   *  - 領域内の要素を配列形状(Layout)のメモリ順に並べたバッファとの間でコピーする
+   *
+   *  @param[in]    a     配列ビュー
+   *  @param[in]    box   領域(始点3word、サイズ3word)
+   *  @param[inout] buf   バッファ
+   *  @param[in]    bPack true:配列からバッファへ、false:バッファから配列へ
+   */
+  template<class T, CPM_ARRAY_SHAPE Layout>
+  static void copyRedistBox( const cpm_ArrayView<T, Layout> &a, const int box[6], T *buf, bool bPack );
+
+  /** マルチグリッドの粗視化レベル情報の検索
+   *  @param[in] levelNo レベル番号
+   *  @return レベル情報のポインタ(存在しないときNULL)
+   */
+  S_MG_LEVEL* FindMGLevel( int levelNo );
+
+  /** ペンシル転置プランの取得
+   *  - 未作成のときは作成する(プロセスグループ内の集団操作)
+   *
+   *  @param[in]  dir       転置軸方向
+   *  @param[out] plan      プランのポインタ
+   *  @param[in]  procGrpNo プロセスグループ番号
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode GetPencilPlan( cpm_DirFlag dir, S_PENCIL_PLAN *&plan, int procGrpNo );
+
+  /** ペンシル転置の送受信の準備
+   *  - 送受信要素数、変位を計算し、バッファを確保する
+   *
+   *  @param[inout] plan      プラン
+   *  @param[in]    bToPencil true:ブロックからペンシル、false:ペンシルからブロック
+   *  @param[in]    nmax      成分数
+   *  @param[in]    esize     要素のサイズ[Byte]
+   */
+  static void preparePencilExchange( S_PENCIL_PLAN *plan, bool bToPencil, int nmax, size_t esize );
+
+  /** ペンシル転置のIalltoallvの発行
+   *  - MPI-3未満の環境ではAlltoallvを実行し、完了済みのリクエストを返す
+   *
+   *  @param[inout] plan  プラン
+   *  @param[in]    esize 要素のサイズ[Byte]
+   *  @param[out]   req   MPIリクエスト
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode startPencilExchange( S_PENCIL_PLAN *plan, size_t esize, MPI_Request *req );
+
 
 
 
@@ -2205,10 +3751,34 @@ protected:
   /** プロセスグループ毎の袖通信バッファ情報
    */
   BndCommInfoMap m_bndCommInfoMap;
+
+  /** 並列ファイル入出力のアグリゲータ数(0以下のときMPI実装のデフォルト)
+   */
+  int m_fieldIOCbNodes;
+
+  /** 並列ファイル入出力の集団バッファサイズ[Byte](0以下のときMPI実装のデフォルト)
+   */
+  int m_fieldIOCbBufferSize;
+
+  /** データ再配置プランのリスト(プラン番号がインデクス、削除済みはNULL)
+   */
+  std::vector<S_REDIST_PLAN*> m_redistPlanList;
+
+  /** ペンシル転置プランのマップ(プロセスグループ番号*3+転置軸方向がキー)
+   */
+  std::map<int, S_PENCIL_PLAN*> m_pencilPlanMap;
+
+  /** マルチグリッドの粗視化レベル情報のリスト(レベル番号がインデクス)
+   */
+  std::vector<S_MG_LEVEL*> m_mgLevelList;
 };
 
 //インライン関数
 #include "inline/cpm_ParaManager_BndComm.h"
 #include "inline/cpm_ParaManager_BndCommEx.h"
+#include "inline/cpm_ParaManager_FieldIO.h"
+#include "inline/cpm_ParaManager_Redist.h"
+#include "inline/cpm_ParaManager_Pencil.h"
+#include "inline/cpm_ParaManager_Multigrid.h"
 
 #endif /* _CPM_PARAMANAGER_H_ */
@@ -0,0 +1,180 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ReductionBatch.h
+ * 集約リダクションクラスのヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_REDUCTIONBATCH_H_
+#define _CPM_REDUCTIONBATCH_H_
+
+#include "cpm_BaseParaManager.h"
+
+/** 集約リダクションクラス
+ *  - 複数の内積等のローカル値をAdd,AddDotで登録し、Flush(またはStart,Wait)で
+ *    1回のAllreduce(Iallreduce)にまとめて集約する
+ *  - 集約結果はGetで参照できる。Addに結果の格納先を指定した場合はそこにも格納する
+ *  - 集約後に次のAddをコールすると、登録内容はクリアされる
+ *  - 使用例(BiCGstabの2つの内積をまとめる)
+ *    @code
+ *    cpm_ReductionBatch batch( paraMngr );
+ *    batch.AddDot( t, t, n, &tt );
+ *    batch.AddDot( t, s, n, &ts );
+ *    batch.Start();
+ *    // 通信と重ねられる処理
+ *    batch.Wait();   // tt,tsに全ランクの和が格納される
+ *    @endcode
+ */
+class cpm_ReductionBatch : public cpm_Base
+{
+////////////////////////////////////////////////////////////////////////////////
+// メンバー関数
+////////////////////////////////////////////////////////////////////////////////
+public:
+  /** コンストラクタ
+   *  @param[in] paraMngr  並列管理クラスのポインタ
+   *  @param[in] op        オペレータ(既定値はMPI_SUM)
+   *  @param[in] procGrpNo プロセスグループ番号
+   */
+  cpm_ReductionBatch( cpm_BaseParaManager *paraMngr, MPI_Op op=MPI_SUM, int procGrpNo=0 );
+
+  /** デストラクタ
+   *  - 通信中の場合は完了を待つ
+   */
+  virtual ~cpm_ReductionBatch();
+
+  /** ローカル値の登録
+   *  @param[in]  val    ローカル値
+   *  @param[out] result 集約結果の格納先(NULLのとき格納しない)
+   *  @return 登録番号(Getで使用する、通信中のとき-1)
+   */
+  int Add( double val, double *result=NULL );
+
+  /** ローカル値の登録(配列版)
+   *  - 複数右辺ベクトルの内積等、num個の値を連続した登録番号で登録する
+   *  @param[in]  num    値の数
+   *  @param[in]  val    ローカル値(num word)
+   *  @param[out] result 集約結果の格納先(num word、NULLのとき格納しない)
+   *  @return 先頭の登録番号(通信中、または引数が不正のとき-1)
+   */
+  int Add( int num, const double *val, double *result=NULL );
+
+  /** 内積のローカル値を計算して登録
+   *  - 内積はdoubleで累積する
+   *  @param[in]  x      ベクトルx
+   *  @param[in]  y      ベクトルy
+   *  @param[in]  n      要素数
+   *  @param[out] result 集約結果の格納先(NULLのとき格納しない)
+   *  @return 登録番号(通信中、または引数が不正のとき-1)
+   */
+  template<class T>
+  int AddDot( const T *x, const T *y, size_t n, double *result=NULL )
+  {
+    if( !x || !y ) return -1;
+    double dot = 0.0;
+    for( size_t i=0;i<n;i++ )
+    {
+      dot += double(x[i]) * double(y[i]);
+    }
+    return Add( dot, result );
+  }
+
+  /** 登録した値の集約(同期版)
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Flush();
+
+  /** 登録した値の集約開始(非同期版)
+   *  - 完了はWaitで待つ
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Start();
+
+  /** 非同期集約の完了待ち
+   *  - 完了後、Addで指定した格納先に集約結果を格納する
+   *  @return 終了コード(CPM_SUCCESS=正常終了)
+   */
+  cpm_ErrorCode Wait();
+
+  /** 集約結果の取得
+   *  @param[in] idx 登録番号
+   *  @return 集約結果(未集約、または登録番号が不正のときは0.0)
+   */
+  double Get( int idx ) const;
+
+  /** 登録数の取得
+   *  @return 登録数
+   */
+  int GetCount() const
+  {
+    return int(m_send.size());
+  }
+
+  /** 通信中かどうか
+   *  @retval true  Start後、Wait前
+   *  @retval false それ以外
+   */
+  bool IsActive() const
+  {
+    return m_active;
+  }
+
+  /** 登録内容のクリア
+   *  - 通信中の場合は何もしない
+   */
+  void Clear();
+
+protected:
+  /** 集約結果の格納 */
+  void Scatter();
+
+
+////////////////////////////////////////////////////////////////////////////////
+// メンバー変数
+////////////////////////////////////////////////////////////////////////////////
+protected:
+  /** 並列管理クラス */
+  cpm_BaseParaManager *m_paraMngr;
+
+  /** オペレータ */
+  MPI_Op m_op;
+
+  /** プロセスグループ番号 */
+  int m_procGrpNo;
+
+  /** 登録したローカル値 */
+  std::vector<double> m_send;
+
+  /** 集約結果 */
+  std::vector<double> m_recv;
+
+  /** 集約結果の格納先 */
+  std::vector<double*> m_result;
+
+  /** リクエストハンドル */
+  MPI_Request m_req;
+
+  /** 通信中フラグ */
+  bool m_active;
+
+  /** 集約済みフラグ */
+  bool m_done;
+};
+
+#endif /* _CPM_REDUCTIONBATCH_H_ */
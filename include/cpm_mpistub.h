@@ -20,6 +20,16 @@ typedef int MPI_Comm;		///< mpi communicator
 typedef int MPI_Group;		///< mpi group
 typedef int MPI_Request;	///< mpi request
 typedef int MPI_Status;		///< mpi status
+typedef int MPI_Info;		///< mpi info
+typedef long long MPI_Offset;	///< mpi file offset
+
+const int MPI_INFO_NULL		= 0;	///< null info
+const int MPI_ORDER_C		= 56;	///< C order(subarray)
+const int MPI_ORDER_FORTRAN	= 57;	///< Fortran order(subarray)
+const int MPI_MODE_CREATE	= 1;	///< create file
+const int MPI_MODE_RDONLY	= 2;	///< read only
+const int MPI_MODE_WRONLY	= 4;	///< write only
+const int MPI_MODE_RDWR		= 8;	///< read and write
 
 static int cpm_MPIInitialized = 0;	///< initialized flag
 static int cpm_MPIFinalized   = 0;	///< finalized flag
@@ -100,6 +110,33 @@ struct CPM_STUBCOMMBUF_INFO
 /// send/recv buffer list (FIFO)
 static std::vector<CPM_STUBCOMMBUF_INFO*> cpm_StubCommBufInfo;
 
+/// first id of derived data types
+const int CPM_STUB_DERIVED_TYPE = 1000;
+
+/// size of derived data types (byte, index = type - CPM_STUB_DERIVED_TYPE)
+static std::vector<size_t> cpm_StubDerivedTypeSize;
+
+/// struct of subarray data type information
+struct CPM_STUBSUBARRAY_INFO
+{
+  int order;			///< MPI_ORDER_C or MPI_ORDER_FORTRAN
+  size_t esize;			///< size of old type
+  std::vector<int> sizes;	///< sizes of full array
+  std::vector<int> subsizes;	///< sizes of subarray
+  std::vector<int> starts;	///< starting coordinates of subarray
+};
+
+/// subarray information of derived data types (index = type - CPM_STUB_DERIVED_TYPE, empty for contiguous)
+static std::vector<CPM_STUBSUBARRAY_INFO> cpm_StubDerivedTypeInfo;
+
+/// file handle (serial)
+struct CPM_STUBFILE
+{
+  FILE *fp;		///< file pointer
+  MPI_Offset disp;	///< displacement of file view
+};
+typedef CPM_STUBFILE* MPI_File;	///< mpi file handle
+
 /// get new request
 static int cpm_StubGetRequest()
 {
@@ -125,6 +162,11 @@ static int cpm_StubGetRequest()
 /// get size of MPI_Datatype(return value : byte)
 static size_t cpm_StubGetDatatypeSize(MPI_Datatype type)
 {
+  if( int(type) >= CPM_STUB_DERIVED_TYPE )
+  {
+    size_t idx = size_t(int(type) - CPM_STUB_DERIVED_TYPE);
+    return (idx < cpm_StubDerivedTypeSize.size()) ? cpm_StubDerivedTypeSize[idx] : 0;
+  }
   if( type == MPI_CHAR )
     return sizeof(char);
   else if( type == MPI_UNSIGNED_CHAR )
@@ -186,6 +228,20 @@ static int MPI_Initialized(int *flag)
   return MPI_SUCCESS;
 }
 
+/// Creates new communicators based on colors and keys 
+static int MPI_Comm_split(MPI_Comm comm, int color, int key, MPI_Comm *newcomm)
+{
+  *newcomm = 0;
+  return MPI_SUCCESS;
+}
+
+/// Marks the communicator object for deallocation 
+static int MPI_Comm_free(MPI_Comm *comm)
+{
+  *comm = MPI_COMM_NULL;
+  return MPI_SUCCESS;
+}
+
 /// Terminates MPI execution environment 
 static int MPI_Finalize()
 {
@@ -489,6 +545,17 @@ static int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
   return MPI_SUCCESS;
 }
 
+/// Combines values from all processes and distributes the result back to all processes (nonblocking)
+static int MPI_Iallreduce(const void *sendbuf, void *recvbuf, int count,
+                  MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Request *request)
+{
+  *request = cpm_StubGetRequest();
+  size_t sz = cpm_StubGetDatatypeSize(datatype);
+  if( sz==0 ) return MPI_SUCCESS;
+  memcpy(recvbuf, sendbuf, sz*count);
+  return MPI_SUCCESS;
+}
+
 /// Gathers together values from a group of processes 
 static int MPI_Gather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
                void *recvbuf, int recvcount, MPI_Datatype recvtype,
@@ -535,6 +602,252 @@ static int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendt
   return MPI_SUCCESS;
 }
 
+/// Sends data from all to all processes 
+static int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
+                 void *recvbuf, int recvcount, MPI_Datatype recvtype,
+                 MPI_Comm comm)
+{
+  size_t sz = cpm_StubGetDatatypeSize(recvtype);
+  if( sz==0 ) return MPI_SUCCESS;
+  memcpy(recvbuf, sendbuf, sz*recvcount);
+  return MPI_SUCCESS;
+}
+
+/// Sends data from all to all processes; each process may send a different amount of data 
+static int MPI_Alltoallv(const void *sendbuf, const int *sendcounts, const int *sdispls,
+                  MPI_Datatype sendtype, void *recvbuf, const int *recvcounts,
+                  const int *rdispls, MPI_Datatype recvtype, MPI_Comm comm)
+{
+  size_t sz = cpm_StubGetDatatypeSize(recvtype);
+  if( sz==0 ) return MPI_SUCCESS;
+  const char *sendptr = (const char*)sendbuf + sz*sdispls[0];
+  char *recvptr = (char*)recvbuf + sz*rdispls[0];
+  memcpy(recvptr, sendptr, sz*recvcounts[0]);
+  return MPI_SUCCESS;
+}
+
+/// Sends data from all to all processes; each process may send a different amount of data (nonblocking)
+static int MPI_Ialltoallv(const void *sendbuf, const int *sendcounts, const int *sdispls,
+                   MPI_Datatype sendtype, void *recvbuf, const int *recvcounts,
+                   const int *rdispls, MPI_Datatype recvtype, MPI_Comm comm, MPI_Request *request)
+{
+  *request = cpm_StubGetRequest();
+  return MPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype, recvbuf, recvcounts, rdispls, recvtype, comm);
+}
+
+/// Creates a contiguous datatype 
+static int MPI_Type_contiguous(int count, MPI_Datatype oldtype, MPI_Datatype *newtype)
+{
+  cpm_StubDerivedTypeSize.push_back(cpm_StubGetDatatypeSize(oldtype) * size_t(count));
+  cpm_StubDerivedTypeInfo.push_back(CPM_STUBSUBARRAY_INFO());
+  *newtype = (MPI_Datatype)(CPM_STUB_DERIVED_TYPE + int(cpm_StubDerivedTypeSize.size()) - 1);
+  return MPI_SUCCESS;
+}
+
+/// Commits the datatype 
+static int MPI_Type_commit(MPI_Datatype *datatype)
+{
+  return MPI_SUCCESS;
+}
+
+/// Frees the datatype 
+static int MPI_Type_free(MPI_Datatype *datatype)
+{
+  *datatype = MPI_DATATYPE_NULL;
+  return MPI_SUCCESS;
+}
+
+/// Creates a datatype describing a subarray of a multidimensional array 
+static int MPI_Type_create_subarray(int ndims, const int array_of_sizes[],
+                             const int array_of_subsizes[], const int array_of_starts[],
+                             int order, MPI_Datatype oldtype, MPI_Datatype *newtype)
+{
+  CPM_STUBSUBARRAY_INFO info;
+  info.order = order;
+  info.esize = cpm_StubGetDatatypeSize(oldtype);
+  size_t sz = info.esize;
+  for( int i=0;i<ndims;i++ )
+  {
+    info.sizes.push_back(array_of_sizes[i]);
+    info.subsizes.push_back(array_of_subsizes[i]);
+    info.starts.push_back(array_of_starts[i]);
+    sz *= size_t(array_of_subsizes[i]);
+  }
+  cpm_StubDerivedTypeSize.push_back(sz);
+  cpm_StubDerivedTypeInfo.push_back(info);
+  *newtype = (MPI_Datatype)(CPM_STUB_DERIVED_TYPE + int(cpm_StubDerivedTypeSize.size()) - 1);
+  return MPI_SUCCESS;
+}
+
+/// Returns the number of bytes occupied by entries in the datatype 
+static int MPI_Type_size(MPI_Datatype datatype, int *size)
+{
+  *size = int(cpm_StubGetDatatypeSize(datatype));
+  return MPI_SUCCESS;
+}
+
+/// pack(bPack=true) or unpack(bPack=false) the elements of datatype
+static void cpm_StubPackDatatype(void *buf, int count, MPI_Datatype datatype, char *packed, bool bPack)
+{
+  size_t tsz = cpm_StubGetDatatypeSize(datatype);
+  size_t idx = size_t(int(datatype) - CPM_STUB_DERIVED_TYPE);
+  if( int(datatype) < CPM_STUB_DERIVED_TYPE || idx >= cpm_StubDerivedTypeInfo.size() ||
+      cpm_StubDerivedTypeInfo[idx].sizes.empty() )
+  {
+    // 連続領域
+    if( bPack ) memcpy(packed, buf, tsz*size_t(count));
+    else        memcpy(buf, packed, tsz*size_t(count));
+    return;
+  }
+
+  // subarray(Fortran順に並べ替え、最内側の連続部分ごとにコピー)
+  const CPM_STUBSUBARRAY_INFO &info = cpm_StubDerivedTypeInfo[idx];
+  int n = int(info.sizes.size());
+  std::vector<int> sz(n), sub(n), st(n), pos(n, 0);
+  for( int d=0;d<n;d++ )
+  {
+    int s = (info.order == MPI_ORDER_C) ? n-1-d : d;
+    sz[d] = info.sizes[s]; sub[d] = info.subsizes[s]; st[d] = info.starts[s];
+  }
+  size_t extent = info.esize;
+  for( int d=0;d<n;d++ ) extent *= size_t(sz[d]);
+  size_t run = info.esize * size_t(sub[0]);
+
+  for( int c=0;c<count;c++ )
+  {
+    char *base = (char*)buf + extent * size_t(c);
+    while( true )
+    {
+      size_t off = size_t(st[0]);
+      size_t stride = size_t(sz[0]);
+      for( int d=1;d<n;d++ )
+      {
+        off += size_t(st[d] + pos[d]) * stride;
+        stride *= size_t(sz[d]);
+      }
+      if( bPack ) memcpy(packed, base + off*info.esize, run);
+      else        memcpy(base + off*info.esize, packed, run);
+      packed += run;
+
+      int d = 1;
+      for( ;d<n;d++ )
+      {
+        if( ++pos[d] < sub[d] ) break;
+        pos[d] = 0;
+      }
+      if( d >= n ) break;
+    }
+  }
+}
+
+/// Creates a new info object 
+static int MPI_Info_create(MPI_Info *info)
+{
+  *info = 1;
+  return MPI_SUCCESS;
+}
+
+/// Adds a (key,value) pair to info 
+static int MPI_Info_set(MPI_Info info, const char *key, const char *value)
+{
+  return MPI_SUCCESS;
+}
+
+/// Frees an info object 
+static int MPI_Info_free(MPI_Info *info)
+{
+  *info = MPI_INFO_NULL;
+  return MPI_SUCCESS;
+}
+
+/// Deletes a file 
+static int MPI_File_delete(const char *filename, MPI_Info info)
+{
+  return ( remove(filename) == 0 ) ? MPI_SUCCESS : 1;
+}
+
+/// Opens a file 
+static int MPI_File_open(MPI_Comm comm, const char *filename, int amode,
+                  MPI_Info info, MPI_File *fh)
+{
+  FILE *fp = NULL;
+  if( amode & MPI_MODE_RDONLY )
+  {
+    fp = fopen(filename, "rb");
+  }
+  else
+  {
+    fp = fopen(filename, "r+b");
+    if( !fp && (amode & MPI_MODE_CREATE) )
+    {
+      fp = fopen(filename, "w+b");
+    }
+  }
+  if( !fp )
+  {
+    *fh = NULL;
+    return 1;
+  }
+  *fh = new CPM_STUBFILE();
+  (*fh)->fp = fp;
+  (*fh)->disp = 0;
+  return MPI_SUCCESS;
+}
+
+/// Closes a file 
+static int MPI_File_close(MPI_File *fh)
+{
+  if( *fh )
+  {
+    fclose((*fh)->fp);
+    delete *fh;
+  }
+  *fh = NULL;
+  return MPI_SUCCESS;
+}
+
+/// Returns the current size of the file 
+static int MPI_File_get_size(MPI_File fh, MPI_Offset *size)
+{
+  fseek(fh->fp, 0, SEEK_END);
+  *size = MPI_Offset(ftell(fh->fp));
+  return MPI_SUCCESS;
+}
+
+/// Changes process's view of data in file (逐次なのでファイルタイプは全体を覆う連続領域とみなす) 
+static int MPI_File_set_view(MPI_File fh, MPI_Offset disp, MPI_Datatype etype,
+                      MPI_Datatype filetype, const char *datarep, MPI_Info info)
+{
+  fh->disp = disp;
+  return MPI_SUCCESS;
+}
+
+/// Collective write using individual file pointer 
+static int MPI_File_write_all(MPI_File fh, const void *buf, int count,
+                       MPI_Datatype datatype, MPI_Status *status)
+{
+  size_t sz = cpm_StubGetDatatypeSize(datatype) * size_t(count);
+  std::vector<char> packed(sz);
+  if( sz == 0 ) return MPI_SUCCESS;
+  cpm_StubPackDatatype((void*)buf, count, datatype, &packed[0], true);
+  fseek(fh->fp, long(fh->disp), SEEK_SET);
+  if( fwrite(&packed[0], 1, sz, fh->fp) != sz ) return 1;
+  return MPI_SUCCESS;
+}
+
+/// Collective read using individual file pointer 
+static int MPI_File_read_all(MPI_File fh, void *buf, int count,
+                      MPI_Datatype datatype, MPI_Status *status)
+{
+  size_t sz = cpm_StubGetDatatypeSize(datatype) * size_t(count);
+  std::vector<char> packed(sz);
+  if( sz == 0 ) return MPI_SUCCESS;
+  fseek(fh->fp, long(fh->disp), SEEK_SET);
+  if( fread(&packed[0], 1, sz, fh->fp) != sz ) return 1;
+  cpm_StubPackDatatype(buf, count, datatype, &packed[0], false);
+  return MPI_SUCCESS;
+}
+
 } // extern "C"
 
 #ifdef __cplusplus
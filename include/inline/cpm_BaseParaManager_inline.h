@@ -44,6 +44,170 @@ cpm_BaseParaManager::CopyArray( T *source, T *dist, size_t size )
   memcpy( dist, source, sz );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 配列レイアウトの変換 S4D -> S4DEx
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::ConvertS4DtoS4DEx( const T *src, T *dst, int imax, int jmax, int kmax, int nmax, int vc
+                                      , const int *pad_src, const int *pad_dst, CPM_CONVERT_REGION region )
+{
+  return ConvertLayout<T, CPM_ARRAY_S4D, CPM_ARRAY_S4DEX>( src, dst, imax, jmax, kmax, nmax, vc
+                                                        , pad_src, pad_dst, region );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 配列レイアウトの変換 S4DEx -> S4D
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::ConvertS4DExtoS4D( const T *src, T *dst, int nmax, int imax, int jmax, int kmax, int vc
+                                      , const int *pad_src, const int *pad_dst, CPM_CONVERT_REGION region )
+{
+  return ConvertLayout<T, CPM_ARRAY_S4DEX, CPM_ARRAY_S4D>( src, dst, imax, jmax, kmax, nmax, vc
+                                                        , pad_src, pad_dst, region );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 配列レイアウトの変換処理
+template<class T, CPM_ARRAY_SHAPE LS, CPM_ARRAY_SHAPE LD> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::ConvertLayout( const T *src, T *dst, int imax, int jmax, int kmax, int nmax, int vc
+                                  , const int *pad_src, const int *pad_dst, CPM_CONVERT_REGION region )
+{
+  if( !src || !dst || (const T*)dst == src )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( imax < 1 || jmax < 1 || kmax < 1 || nmax < 1 || vc < 0 )
+  {
+    return CPM_ERROR_INVALID_VOXELSIZE;
+  }
+
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<const T, LS> s( src, imax, jmax, kmax, nmax, vc, pad_src );
+  cpm_ArrayView<T, LD>       d( dst, imax, jmax, kmax, nmax, vc, pad_dst );
+  const ptrdiff_t ssi = s.StrideI();
+  const ptrdiff_t ssn = s.StrideN();
+  const ptrdiff_t dsi = d.StrideI();
+  const ptrdiff_t dsn = d.StrideN();
+
+  // 対象領域
+  int lo = -vc;
+  int ni = imax + 2*vc;
+  int nj = jmax + 2*vc;
+  int nk = kmax + 2*vc;
+  if( region == CPM_CONVERT_INNER )
+  {
+    lo = 0;
+    ni = imax;
+    nj = jmax;
+    nk = kmax;
+  }
+  else if( region == CPM_CONVERT_GHOST && vc == 0 )
+  {
+    return CPM_SUCCESS;
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2) schedule(static)
+#endif
+  for( int kk=0;kk<nk;kk++ ){
+  for( int jj=0;jj<nj;jj++ ){
+    int k = kk + lo;
+    int j = jj + lo;
+
+    // i方向の変換範囲(仮想セルのみのとき、内部の行は両端の仮想セルだけを変換する)
+    int iseg[2][2] = { {lo, lo+ni}, {0, 0} };
+    int nseg = 1;
+    if( region == CPM_CONVERT_GHOST && j >= 0 && j < jmax && k >= 0 && k < kmax )
+    {
+      iseg[0][0] = -vc;  iseg[0][1] = 0;
+      iseg[1][0] = imax; iseg[1][1] = imax + vc;
+      nseg = 2;
+    }
+
+    const T *sr = s.Row(j, k);
+    T       *dr = d.Row(j, k);
+    for( int m=0;m<nseg;m++ ){
+    for( int ib=iseg[m][0];ib<iseg[m][1];ib+=CPM_CONVERT_BLOCK ){
+      int ie = ib + CPM_CONVERT_BLOCK;
+      if( ie > iseg[m][1] ) ie = iseg[m][1];
+      for( int n=0;n<nmax;n++ ){
+        const T *sp = sr + n*ssn;
+        T       *dp = dr + n*dsn;
+        for( int i=ib;i<ie;i++ ){
+          dp[i*dsi] = sp[i*ssi];
+        }
+      }
+    }}
+  }}
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約演算の単位元の取得
+template<class T> CPM_INLINE
+T
+cpm_BaseParaManager::ReduceIdentity( CPM_Op op )
+{
+  if( op == CPM_MIN )
+  {
+    return std::numeric_limits<T>::max();
+  }
+  if( op == CPM_MAX )
+  {
+    return std::numeric_limits<T>::is_integer ? std::numeric_limits<T>::min()
+                                              : -std::numeric_limits<T>::max();
+  }
+  return T(0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 配列の部分領域へのバッファの値の集約
+template<class T> CPM_INLINE
+void
+cpm_BaseParaManager::ReduceBox( const cpm_ArrayView<T, CPM_ARRAY_S4D> &a, const int box[6], const T *buf, CPM_Op op )
+{
+  const int ni = box[3];
+  const int nj = box[4];
+  const int nk = box[5];
+  const int nmax = a.Nmax();
+
+  for( int n=0;n<nmax;n++ ){
+  for( int k=0;k<nk;k++ ){
+  for( int j=0;j<nj;j++ ){
+    T *p = a.Row(box[1]+j,box[2]+k,n) + box[0];
+    if( op == CPM_SUM )
+    {
+      for( int i=0;i<ni;i++ ) p[i] += buf[i];
+    }
+    else if( op == CPM_MIN )
+    {
+      for( int i=0;i<ni;i++ ) if( buf[i] < p[i] ) p[i] = buf[i];
+    }
+    else if( op == CPM_MAX )
+    {
+      for( int i=0;i<ni;i++ ) if( buf[i] > p[i] ) p[i] = buf[i];
+    }
+    buf += ni;
+  }}}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 配列の部分領域を指定値で埋める
+template<class T> CPM_INLINE
+void
+cpm_BaseParaManager::FillBox( const cpm_ArrayView<T, CPM_ARRAY_S4D> &a, const int box[6], T val )
+{
+  const int nmax = a.Nmax();
+  for( int n=0;n<nmax;n++ ){
+  for( int k=0;k<box[5];k++ ){
+  for( int j=0;j<box[4];j++ ){
+    T *p = a.Row(box[1]+j,box[2]+k,n) + box[0];
+    for( int i=0;i<box[3];i++ ) p[i] = val;
+  }}}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // MPI_Datatypeを取得
 template<class T> CPM_INLINE
@@ -182,6 +346,23 @@ cpm_BaseParaManager::Allreduce( T *sendbuf, T *recvbuf, int count, MPI_Op op, in
   return Allreduce( dtype, sendbuf, recvbuf, count, op, procGrpNo );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Iallreduce
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::Iallreduce( T *sendbuf, T *recvbuf, int count, MPI_Op op, MPI_Request *request, int procGrpNo )
+{
+  // 型を取得
+  MPI_Datatype dtype = cpm_BaseParaManager::GetMPI_Datatype(sendbuf);
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  // Iallreduce
+  return Iallreduce( dtype, sendbuf, recvbuf, count, op, request, procGrpNo );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Gather
 template<class Ts, class Tr> CPM_INLINE
@@ -270,4 +451,243 @@ cpm_BaseParaManager::Allgatherv( Ts *sendbuf, int sendcnt, Tr *recvbuf, int *rec
   return Allgatherv( stype, (void*)sendbuf, sendcnt, rtype, (void*)recvbuf, recvcnts, displs, procGrpNo );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 粒子の隣接領域への移動
+template<class T, class P> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::MigrateParticles( T *particles, int &num, int maxNum, P* (*getPos)(T&)
+                                     , int periodicFlag, int *numLost, int procGrpNo )
+{
+  // 分類、送受信
+  std::vector<char> recvBuf;
+  int nrecv = 0;
+  cpm_ErrorCode ret = migrateParticles( particles, num, getPos, periodicFlag, recvBuf, nrecv, numLost, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 受信した粒子を末尾に追加(入りきらない分は捨てる)
+  int nfit = std::min(nrecv, std::max(maxNum - num, 0));
+  if( nfit > 0 )
+  {
+    memcpy( particles + num, &recvBuf[0], sizeof(T) * size_t(nfit) );
+    num += nfit;
+  }
+  if( nfit < nrecv )
+  {
+    return CPM_ERROR_PARTICLE_OVERFLOW;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子の隣接領域への移動(std::vector版)
+template<class T, class P> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::MigrateParticles( std::vector<T> &particles, P* (*getPos)(T&)
+                                     , int periodicFlag, int *numLost, int procGrpNo )
+{
+  // 分類、送受信
+  std::vector<char> recvBuf;
+  int nrecv = 0;
+  int num = int(particles.size());
+  T *ptr = particles.empty() ? NULL : &particles[0];
+  cpm_ErrorCode ret = migrateParticles( ptr, num, getPos, periodicFlag, recvBuf, nrecv, numLost, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 受信した粒子を末尾に追加
+  particles.resize( size_t(num) + size_t(nrecv) );
+  if( nrecv > 0 )
+  {
+    memcpy( &particles[num], &recvBuf[0], sizeof(T) * size_t(nrecv) );
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子の分類、送受信
+template<class T, class P> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::migrateParticles( T *particles, int &num, P* (*getPos)(T&), int periodicFlag
+                                     , std::vector<char> &recvBuf, int &nrecv, int *numLost, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+  nrecv = 0;
+  if( numLost ) *numLost = 0;
+  if( !getPos || (num > 0 && !particles) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  int myrank = GetMyRankID(procGrpNo);
+  if( myrank < 0 )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 隣接ランクリスト
+  std::vector<int> rankList;
+  if( (ret = GetParticleNeighborRank( rankList, periodicFlag, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  const int nnbr = int(rankList.size());
+
+  // 位置の取得、移動先ランクの判定(周期境界の補正後の位置を書き戻す)
+  std::vector<double> pos(size_t(num) * 3);
+  std::vector<int> dest(num);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for( int i=0;i<num;i++ )
+  {
+    const P *p = getPos(particles[i]);
+    pos[i*3  ] = double(p[0]);
+    pos[i*3+1] = double(p[1]);
+    pos[i*3+2] = double(p[2]);
+  }
+  if( num > 0 && (ret = FindParticleRank( num, &pos[0], periodicFlag, &dest[0], procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 移動先を隣接ランクリストの番号に変換
+  //  - -1:移動しない、-2:削除(計算領域外)
+  //  - 0～nnbr-1:隣接ランクリストの番号、nnbr以上:隣接ランク以外のランク番号+nnbr
+  //  - 隣接ランク以外への移動モードでないときは、隣接ランク以外への移動は削除とする
+  int nrank = GetNumRank(procGrpNo);
+  std::vector<int> scnt(nnbr, 0);
+  std::vector<int> fcnt(nrank, 0);
+  int nlost = 0;
+  int nfar  = 0;
+  for( int i=0;i<num;i++ )
+  {
+    int r = dest[i];
+    if( r == myrank )
+    {
+      dest[i] = -1;
+    }
+    else if( r < 0 || r >= nrank )
+    {
+      dest[i] = -2;
+      nlost++;
+    }
+    else
+    {
+      std::vector<int>::const_iterator it = std::lower_bound(rankList.begin(), rankList.end(), r);
+      if( it != rankList.end() && *it == r )
+      {
+        dest[i] = int(it - rankList.begin());
+        scnt[dest[i]]++;
+      }
+      else if( m_bParticleFar )
+      {
+        dest[i] = nnbr + r;
+        fcnt[r]++;
+        nfar++;
+      }
+      else
+      {
+        dest[i] = -2;
+        nlost++;
+      }
+    }
+    if( dest[i] != -2 )
+    {
+      P *p = getPos(particles[i]);
+      p[0] = P(pos[i*3  ]);
+      p[1] = P(pos[i*3+1]);
+      p[2] = P(pos[i*3+2]);
+    }
+  }
+
+  // 送信バッファへのパックと、移動しない粒子の前詰め
+  std::vector<size_t> soff(nnbr+1, 0);
+  for( int n=0;n<nnbr;n++ )
+  {
+    soff[n+1] = soff[n] + size_t(scnt[n]);
+  }
+  std::vector<size_t> foff(nrank+1, 0);
+  for( int r=0;r<nrank;r++ )
+  {
+    foff[r+1] = foff[r] + size_t(fcnt[r]);
+  }
+  std::vector<char> sendBuf(soff[nnbr] * sizeof(T));
+  std::vector<char> farBuf(foff[nrank] * sizeof(T));
+  int nstay = 0;
+  for( int i=0;i<num;i++ )
+  {
+    if( dest[i] >= nnbr )
+    {
+      memcpy( &farBuf[foff[dest[i]-nnbr] * sizeof(T)], &particles[i], sizeof(T) );
+      foff[dest[i]-nnbr]++;
+    }
+    else if( dest[i] >= 0 )
+    {
+      memcpy( &sendBuf[soff[dest[i]] * sizeof(T)], &particles[i], sizeof(T) );
+      soff[dest[i]]++;
+    }
+    else if( dest[i] == -1 )
+    {
+      if( nstay != i ) memcpy( &particles[nstay], &particles[i], sizeof(T) );
+      nstay++;
+    }
+  }
+  num = nstay;
+  if( numLost ) *numLost = nlost;
+
+  // 隣接ランクとの送受信
+  if( (ret = exchangeParticles( rankList, scnt, sendBuf.empty() ? NULL : &sendBuf[0], sizeof(T)
+                              , recvBuf, nrecv, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 隣接ランク以外への移動モードのときは、隣接ランク以外へ移動する粒子がいずれかのランクにあれば
+  // 全ランク間で送受信して受信バッファに追加
+  if( !m_bParticleFar )
+  {
+    return CPM_SUCCESS;
+  }
+  int nfarMax = 0;
+  if( (ret = Allreduce( &nfar, &nfarMax, 1, MPI_MAX, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  if( nfarMax == 0 )
+  {
+    return CPM_SUCCESS;
+  }
+  std::vector<char> farRecv;
+  std::vector<int> rcnt;
+  if( (ret = alltoallvElement( farBuf.empty() ? NULL : &farBuf[0], fcnt, sizeof(T), farRecv, rcnt
+                             , procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  recvBuf.insert( recvBuf.end(), farRecv.begin(), farRecv.end() );
+  nrecv += int(farRecv.size() / sizeof(T));
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 問い合わせに対する値の問い合わせ元への返送
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_BaseParaManager::ReturnPointValues( const std::vector<S_POINT_QUERY> &query, const T *value, int nval
+                                      , T *result, int num, int procGrpNo )
+{
+  if( nval < 1 || (!query.empty() && !value) || (num > 0 && !result) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  return returnPointValues( query, (const char*)value, sizeof(T) * size_t(nval), (char*)result, num, procGrpNo );
+}
+
 #endif /* _CPM_BASEPARAMANAGER_INLINE_H_ */
@@ -54,7 +54,7 @@ cpm_ParaManager::BndCommS3D( T *array, int imax, int jmax, int kmax, int vc, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return BndCommS4D( array, imax, jmax, kmax, 1, vc, vc_comm, pad_size, procGrpNo );
 }
@@ -69,7 +69,7 @@ cpm_ParaManager::BndCommV3D( T *array, int imax, int jmax, int kmax, int vc, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return BndCommS4D( array, imax, jmax, kmax, 3, vc, vc_comm, pad_size, procGrpNo );
 }
@@ -84,7 +84,7 @@ cpm_ParaManager::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, i
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return BndCommS4D( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, procGrpNo );
 }
@@ -100,7 +100,7 @@ cpm_ParaManager::BndCommS3D_nowait( T *array, int imax, int jmax, int kmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return BndCommS4D_nowait( array, imax, jmax, kmax, 1, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -116,7 +116,7 @@ cpm_ParaManager::BndCommV3D_nowait( T *array, int imax, int jmax, int kmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return BndCommS4D_nowait( array, imax, jmax, kmax, 3, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -132,7 +132,7 @@ cpm_ParaManager::BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return BndCommS4D_nowait( array, imax, jmax, kmax, nmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -148,7 +148,7 @@ cpm_ParaManager::wait_BndCommS3D( T *array, int imax, int jmax, int kmax, int vc
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return wait_BndCommS4D( array, imax, jmax, kmax, 1, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -164,7 +164,7 @@ cpm_ParaManager::wait_BndCommV3D( T *array, int imax, int jmax, int kmax, int vc
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return wait_BndCommS4D( array, imax, jmax, kmax, 3, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -180,7 +180,7 @@ cpm_ParaManager::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nm
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return wait_BndCommS4D( array, imax, jmax, kmax, nmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -196,7 +196,7 @@ cpm_ParaManager::PeriodicCommS3D( T *array, int imax, int jmax, int kmax, int vc
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return PeriodicCommS4D( array, imax, jmax, kmax, 1, vc, vc_comm, dir, pm, pad_size, procGrpNo );
 }
@@ -212,7 +212,7 @@ cpm_ParaManager::PeriodicCommV3D( T *array, int imax, int jmax, int kmax, int vc
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size);
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
   }
   return PeriodicCommS4D( array, imax, jmax, kmax, 3, vc, vc_comm, dir, pm, pad_size, procGrpNo );
 }
@@ -228,7 +228,7 @@ cpm_ParaManager::PeriodicCommS4D( T *array, int imax, int jmax, int kmax, int nm
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return PeriodicCommS4D( array, imax, jmax, kmax, nmax, vc, vc_comm, dir, pm, pad_size, procGrpNo );
 }
@@ -247,6 +247,12 @@ cpm_ParaManager::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, i
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -335,6 +341,9 @@ cpm_ParaManager::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, i
   // unpack
   if( (ret = unpackZ( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, recvmz, recvpz, nIDmz, nIDpz )) != CPM_SUCCESS ) return ret;
 
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   return CPM_SUCCESS;
 }
 
@@ -357,6 +366,12 @@ cpm_ParaManager::BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int
     req[i] = MPI_REQUEST_NULL;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -441,6 +456,12 @@ cpm_ParaManager::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nm
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 非同期袖通信を省略したときは展開も省略
+  if( endFieldComm( array ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -502,6 +523,9 @@ cpm_ParaManager::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nm
   // unpack
   if( (ret = unpackZ( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, recvmz, recvpz, nIDmz, nIDpz )) != CPM_SUCCESS ) return ret;
 
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   return CPM_SUCCESS;
 }
 
@@ -655,6 +679,341 @@ cpm_ParaManager::PeriodicCommS4D( T *array, int imax, int jmax, int kmax, int nm
   return CPM_SUCCESS;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                   , CPM_Op op, int periodicFlag, int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return BndCommS4D_Reverse( array, imax, jmax, kmax, 1, vc, vc_comm, op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Vector3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommV3D_Reverse( T *array, int imax, int jmax, int kmax, int vc, int vc_comm
+                                   , CPM_Op op, int periodicFlag, int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return BndCommS4D_Reverse( array, imax, jmax, kmax, 3, vc, vc_comm, op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , CPM_Op op, int periodicFlag, int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return BndCommS4D_Reverse( array, imax, jmax, kmax, nmax, vc, vc_comm, op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                   , CPM_Op op, int periodicFlag, int pad_size[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  MPI_Request req[12];
+  if( (ret = BndCommS4D_Reverse_nowait( array, imax, jmax, kmax, nmax, vc, vc_comm, req
+                                      , op, periodicFlag, pad_size, procGrpNo )) != CPM_SUCCESS ) return ret;
+
+  return wait_BndCommS4D_Reverse( array, imax, jmax, kmax, nmax, vc, vc_comm, req
+                                , op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版、waitなし)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                          , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                          , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return BndCommS4D_Reverse_nowait( array, imax, jmax, kmax, nmax, vc, vc_comm, req, op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信(Scalar4D版、waitなし、パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_Reverse_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                          , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                          , int pad_size[4], int procGrpNo )
+{
+  if( !array || !req )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  for( int i=0;i<12;i++ )
+  {
+    req[i] = MPI_REQUEST_NULL;
+  }
+  if( !IsReverseOp(op) )
+  {
+    return CPM_ERROR_MPI_INVALID_OPERATOR;
+  }
+
+  // Z方向の送受信を開始(Y,X方向はZ方向の集約後に順に行うため、wait_BndCommS4D_Reverseで処理する)
+  return sendrecvReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, Z_DIR, op, periodicFlag, &req[8], procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信のwait、集約(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                        , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                        , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return wait_BndCommS4D_Reverse( array, imax, jmax, kmax, nmax, vc, vc_comm, req, op, periodicFlag, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信のwait、集約(Scalar4D版、パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_BndCommS4D_Reverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm
+                                        , MPI_Request req[12], CPM_Op op, int periodicFlag
+                                        , int pad_size[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array || !req )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( !IsReverseOp(op) )
+  {
+    return CPM_ERROR_MPI_INVALID_OPERATOR;
+  }
+
+  //// Z face ////
+  if( (ret = waitReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, Z_DIR, op, periodicFlag, &req[8], procGrpNo )) != CPM_SUCCESS ) return ret;
+
+  //// Y face ////
+  if( (ret = sendrecvReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, Y_DIR, op, periodicFlag, &req[4], procGrpNo )) != CPM_SUCCESS ) return ret;
+  if( (ret = waitReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, Y_DIR, op, periodicFlag, &req[4], procGrpNo )) != CPM_SUCCESS ) return ret;
+
+  //// X face ////
+  if( (ret = sendrecvReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, X_DIR, op, periodicFlag, &req[0], procGrpNo )) != CPM_SUCCESS ) return ret;
+  if( (ret = waitReverse( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, X_DIR, op, periodicFlag, &req[0], procGrpNo )) != CPM_SUCCESS ) return ret;
+
+  // 実セルを更新したので登録フィールドのバージョンを進める(登録されていないときは何もしない)
+  MarkFieldDirty( array );
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Scalar3D版, 面毎の通信袖数指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS3D( T *array, int imax, int jmax, int kmax, int vc, const int vc_comm[6]
+                           , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return BndCommS4D( array, imax, jmax, kmax, 1, vc, vc_comm, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Vector3D版, 面毎の通信袖数指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommV3D( T *array, int imax, int jmax, int kmax, int vc, const int vc_comm[6]
+                           , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return BndCommS4D( array, imax, jmax, kmax, 3, vc, vc_comm, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Scalar4D版, 面毎の通信袖数指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                           , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return BndCommS4D( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                           , int pad_size[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array || !vc_comm )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+#ifdef _DEBUG
+  // 面毎の通信袖数が全ランクで一致しているか
+  if( (ret = checkFaceCommWidth( vc_comm, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+#endif
+
+  MPI_Request req[12];
+  for( int i=0;i<12;i++ ) req[i] = MPI_REQUEST_NULL;
+
+  // 方向毎に送受信、展開する(後の方向の通信面内の仮想セルに前の方向の受信値を含める)
+  const cpm_DirFlag dirs[3] = {X_DIR, Y_DIR, Z_DIR};
+  for( int d=0;d<3;d++ )
+  {
+    if( (ret = sendrecvFace( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, dirs[d], &req[4*d], procGrpNo )) != CPM_SUCCESS ) return ret;
+    if( (ret = waitFace( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, dirs[d], &req[4*d], procGrpNo )) != CPM_SUCCESS ) return ret;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Scalar4D版, 面毎の通信袖数指定, waitなし)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                  , MPI_Request req[12], int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return BndCommS4D_nowait( array, imax, jmax, kmax, nmax, vc, vc_comm, req, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定, waitなし)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::BndCommS4D_nowait( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                  , MPI_Request req[12], int pad_size[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array || !vc_comm )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  for( int i=0;i<12;i++ )
+  {
+    req[i] = MPI_REQUEST_NULL;
+  }
+
+#ifdef _DEBUG
+  // 面毎の通信袖数が全ランクで一致しているか
+  if( (ret = checkFaceCommWidth( vc_comm, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+#endif
+
+  const cpm_DirFlag dirs[3] = {X_DIR, Y_DIR, Z_DIR};
+  for( int d=0;d<3;d++ )
+  {
+    if( (ret = sendrecvFace( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, dirs[d], &req[4*d], procGrpNo )) != CPM_SUCCESS ) return ret;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信のwait、展開(Scalar4D版, 面毎の通信袖数指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                , MPI_Request req[12], int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return wait_BndCommS4D( array, imax, jmax, kmax, nmax, vc, vc_comm, req, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信のwait、展開(Scalar4D版, 面毎の通信袖数指定, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_BndCommS4D( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                                , MPI_Request req[12], int pad_size[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  if( !array || !vc_comm )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  const cpm_DirFlag dirs[3] = {X_DIR, Y_DIR, Z_DIR};
+  for( int d=0;d<3;d++ )
+  {
+    if( (ret = waitFace( array, imax, jmax, kmax, nmax, vc, vc_comm, pad_size, dirs[d], &req[4*d], procGrpNo )) != CPM_SUCCESS ) return ret;
+  }
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 袖通信(Scalar3D,4D,Vector3D版)のX方向送信バッファのセット
 template<class T> CPM_INLINE
@@ -669,22 +1028,20 @@ cpm_ParaManager::packX( T *array, int imax, int jmax, int kmax, int nmax, int vc
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) is = 1;
 
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0;i<vc_comm;i++ ){
-
-      sendm[_IDXFX(i,j,k,n,0,jmax,kmax,vc_comm)] = array[_IDX_S4D_PAD(i+is,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k,n) + is;
+      T *dst = &sendm[_IDXFX(0,j,k,n,0,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -692,11 +1049,12 @@ cpm_ParaManager::packX( T *array, int imax, int jmax, int kmax, int nmax, int vc
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=imax-vc_comm;i<imax;i++ ){
-
-      sendp[_IDXFX(i,j,k,n,imax-vc_comm,jmax,kmax,vc_comm)] = array[_IDX_S4D_PAD(i-is,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k,n) + (imax-vc_comm-is);
+      T *dst = &sendp[_IDXFX(imax-vc_comm,j,k,n,imax-vc_comm,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -709,20 +1067,20 @@ cpm_ErrorCode
 cpm_ParaManager::unpackX( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
                             , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<0;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvm[_IDXFX(i,j,k,n,0-vc_comm,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n) - vc_comm;
+      const T *src = &recvm[_IDXFX(0-vc_comm,j,k,n,0-vc_comm,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -730,9 +1088,12 @@ cpm_ParaManager::unpackX( T *array, int imax, int jmax, int kmax, int nmax, int
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=imax;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvp[_IDXFX(i,j,k,n,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n) + imax;
+      const T *src = &recvp[_IDXFX(imax,j,k,n,imax,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -752,22 +1113,20 @@ cpm_ParaManager::packY( T *array, int imax, int jmax, int kmax, int nmax, int vc
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) js = 1;
 
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0;j<vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-
-      sendm[_IDXFY(i,j,k,n,imax,0,kmax,vc_comm)] = array[_IDX_S4D_PAD(i,j+js,k,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j+js,k,n);
+      T *dst = &sendm[_IDXFY(0,j,k,n,imax,0,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -775,11 +1134,12 @@ cpm_ParaManager::packY( T *array, int imax, int jmax, int kmax, int nmax, int vc
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax-vc_comm;j<jmax;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-
-      sendp[_IDXFY(i,j,k,n,imax,jmax-vc_comm,kmax,vc_comm)] = array[_IDX_S4D_PAD(i,j-js,k,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j-js,k,n);
+      T *dst = &sendp[_IDXFY(0,j,k,n,imax,jmax-vc_comm,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -792,20 +1152,20 @@ cpm_ErrorCode
 cpm_ParaManager::unpackY( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
                             , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvm[_IDXFY(i,j,k,n,imax,0-vc_comm,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n);
+      const T *src = &recvm[_IDXFY(0,j,k,n,imax,0-vc_comm,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -813,9 +1173,12 @@ cpm_ParaManager::unpackY( T *array, int imax, int jmax, int kmax, int nmax, int
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvp[_IDXFY(i,j,k,n,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n);
+      const T *src = &recvp[_IDXFY(0,j,k,n,imax,jmax,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -836,22 +1199,20 @@ cpm_ParaManager::packZ( T *array, int imax, int jmax, int kmax, int nmax, int vc
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) ks = 1;
 
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0;k<vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-
-      sendm[_IDXFZ(i,j,k,n,imax,jmax,0,vc_comm)] = array[_IDX_S4D_PAD(i,j,k+ks,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k+ks,n);
+      T *dst = &sendm[_IDXFZ(0,j,k,n,imax,jmax,0,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -859,11 +1220,12 @@ cpm_ParaManager::packZ( T *array, int imax, int jmax, int kmax, int nmax, int vc
     for( int n=0;n<nmax;n++){
     for( int k=kmax-vc_comm;k<kmax;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-
-      sendp[_IDXFZ(i,j,k,n,imax,jmax,kmax-vc_comm,vc_comm)] = array[_IDX_S4D_PAD(i,j,k-ks,n,imax,jmax,kmax,vc,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k-ks,n);
+      T *dst = &sendp[_IDXFZ(0,j,k,n,imax,jmax,kmax-vc_comm,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -876,20 +1238,20 @@ cpm_ErrorCode
 cpm_ParaManager::unpackZ( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
                             , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int ip = pad_size[0];
-  int jp = pad_size[1];
-  int kp = pad_size[2];
-  int np = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
 
   if( !IsRankNull(nIDm) )
   {
     for( int n=0;n<nmax;n++){
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvm[_IDXFZ(i,j,k,n,imax,jmax,0-vc_comm,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n);
+      const T *src = &recvm[_IDXFZ(0,j,k,n,imax,jmax,0-vc_comm,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   if( !IsRankNull(nIDp) )
@@ -897,9 +1259,12 @@ cpm_ParaManager::unpackZ( T *array, int imax, int jmax, int kmax, int nmax, int
     for( int n=0;n<nmax;n++){
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-      array[_IDX_S4D_PAD(i,j,k,n,imax,jmax,kmax,vc,ip,jp,kp)] = recvp[_IDXFZ(i,j,k,n,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k,n);
+      const T *src = &recvp[_IDXFZ(0,j,k,n,imax,jmax,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+        dst[i] = src[i];
+      }
+    }}}
   }
 
   return CPM_SUCCESS;
@@ -959,6 +1324,289 @@ cpm_ParaManager::sendrecv( T *sendm, T *recvm, T *sendp, T *recvp, size_t nw, MP
   return CPM_SUCCESS;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１方向(プラス、マイナス)の仮想セルのパックと送受信の開始
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::sendrecvReverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
+                                , cpm_DirFlag dir, CPM_Op op, int periodicFlag, MPI_Request req[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  for( int i=0;i<4;i++ )
+  {
+    req[i] = MPI_REQUEST_NULL;
+  }
+
+  // 通信バッファを取得
+  S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
+  if( !bufInfo )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+
+  // 隣接ランク、送信、受信、仮想セルの領域を取得
+  int nIDm, nIDp;
+  int sbox[2][6], rbox[2][6], gbox[2][6];
+  int sz[3] = {imax, jmax, kmax};
+  if( (ret = getReverseInfo( sz, vc_comm, dir, periodicFlag, nIDm, nIDp, sbox, rbox, gbox, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 通信バッファ(拡張のみ)
+  size_t nw = size_t(sbox[0][3]) * size_t(sbox[0][4]) * size_t(sbox[0][5]) * size_t(nmax);
+  std::vector<char> *buf = bufInfo->m_bufRev[dir];
+  for( int i=0;i<4;i++ )
+  {
+    if( buf[i].size() < nw * sizeof(T) ) buf[i].resize(nw * sizeof(T));
+  }
+  T *sendm = (T*)&buf[0][0];
+  T *recvm = (T*)&buf[1][0];
+  T *sendp = (T*)&buf[2][0];
+  T *recvp = (T*)&buf[3][0];
+
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+
+  // pack(和のときは送信した仮想セルを0クリアして、後の方向で二重に送らないようにする)
+  int  nID[2]  = {nIDm, nIDp};
+  T   *send[2] = {sendm, sendp};
+  for( int pm=0;pm<2;pm++ )
+  {
+    if( IsRankNull(nID[pm]) ) continue;
+    copyRedistBox( a, sbox[pm], send[pm], true );
+    if( op == CPM_SUM )
+    {
+      FillBox( a, gbox[pm], T(0) );
+    }
+  }
+
+  // Isend/Irecv
+  return sendrecv( sendm, recvm, sendp, recvp, nw, req, nIDm, nIDm, nIDp, nIDp, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の１方向(プラス、マイナス)の受信待機と内部セルへの集約
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::waitReverse( T *array, int imax, int jmax, int kmax, int nmax, int vc, int vc_comm, int pad_size[4]
+                            , cpm_DirFlag dir, CPM_Op op, int periodicFlag, MPI_Request req[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  // wait
+  if( (ret = Waitall( 4, req )) != CPM_SUCCESS ) return ret;
+
+  // 通信バッファを取得
+  S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
+  if( !bufInfo )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+
+  // 隣接ランク、送信、受信、仮想セルの領域を取得
+  int nIDm, nIDp;
+  int sbox[2][6], rbox[2][6], gbox[2][6];
+  int sz[3] = {imax, jmax, kmax};
+  if( (ret = getReverseInfo( sz, vc_comm, dir, periodicFlag, nIDm, nIDp, sbox, rbox, gbox, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  std::vector<char> *buf = bufInfo->m_bufRev[dir];
+  if( buf[1].empty() || buf[3].empty() )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+
+  // unpack(マイナス側から受信した値は0側、プラス側から受信した値はmax側の内部セルへ集約)
+  if( !IsRankNull(nIDm) )
+  {
+    ReduceBox( a, rbox[0], (const T*)&buf[1][0], op );
+  }
+  if( !IsRankNull(nIDp) )
+  {
+    ReduceBox( a, rbox[1], (const T*)&buf[3][0], op );
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 送受信サイズを指定した１方向(プラス、マイナス)の双方向袖通信処理
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::sendrecv( T *sendm, size_t nwsm, T *recvm, size_t nwrm, T *sendp, size_t nwsp, T *recvp, size_t nwrp
+                         , MPI_Request *req, int nIDm, int nIDp, int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  for( int i=0;i<4;i++ )
+  {
+    req[i] = MPI_REQUEST_NULL;
+  }
+
+  if( !IsRankNull(nIDm) && nwrm > 0 )
+  {
+    if( (ret = Irecv( recvm, nwrm, nIDm, &req[0], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  if( !IsRankNull(nIDp) && nwrp > 0 )
+  {
+    if( (ret = Irecv( recvp, nwrp, nIDp, &req[1], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  if( !IsRankNull(nIDp) && nwsp > 0 )
+  {
+    if( (ret = Isend( sendp, nwsp, nIDp, &req[2], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  if( !IsRankNull(nIDm) && nwsm > 0 )
+  {
+    if( (ret = Isend( sendm, nwsm, nIDm, &req[3], procGrpNo )) != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 面毎の通信袖数指定の袖通信の１方向(プラス、マイナス)のパックと送受信の開始
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::sendrecvFace( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                             , int pad_size[4], cpm_DirFlag dir, MPI_Request req[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  for( int i=0;i<4;i++ )
+  {
+    req[i] = MPI_REQUEST_NULL;
+  }
+
+  // 通信バッファを取得
+  S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
+  if( !bufInfo )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+
+  // 隣接ランク、送信、受信領域を取得
+  int nIDm, nIDp;
+  int sbox[2][6], rbox[2][6];
+  int sz[3] = {imax, jmax, kmax};
+  if( (ret = getFaceCommInfo( sz, vc, vc_comm, dir, nIDm, nIDp, sbox, rbox, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 送受信サイズ(マイナス側、プラス側)
+  size_t nws[2], nwr[2];
+  for( int pm=0;pm<2;pm++ )
+  {
+    nws[pm] = size_t(sbox[pm][3]) * size_t(sbox[pm][4]) * size_t(sbox[pm][5]) * size_t(nmax);
+    nwr[pm] = size_t(rbox[pm][3]) * size_t(rbox[pm][4]) * size_t(rbox[pm][5]) * size_t(nmax);
+  }
+
+  // 通信バッファサイズをチェック
+  REAL_BUF_TYPE **buf = bufInfo->m_bufX;
+  size_t nwBuf = bufInfo->m_nwX;
+  if( dir == Y_DIR )
+  {
+    buf = bufInfo->m_bufY;
+    nwBuf = bufInfo->m_nwY;
+  }
+  else if( dir == Z_DIR )
+  {
+    buf = bufInfo->m_bufZ;
+    nwBuf = bufInfo->m_nwZ;
+  }
+  for( int pm=0;pm<2;pm++ )
+  {
+    if( nws[pm] > nwBuf || nwr[pm] > nwBuf )
+    {
+      return CPM_ERROR_BNDCOMM_BUFFERLENGTH;
+    }
+  }
+  T *sendm = (T*)(buf[0]);
+  T *recvm = (T*)(buf[1]);
+  T *sendp = (T*)(buf[2]);
+  T *recvp = (T*)(buf[3]);
+
+  // pack
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  if( !IsRankNull(nIDm) && nws[0] > 0 )
+  {
+    copyRedistBox( a, sbox[0], sendm, true );
+  }
+  if( !IsRankNull(nIDp) && nws[1] > 0 )
+  {
+    copyRedistBox( a, sbox[1], sendp, true );
+  }
+
+  // Isend/Irecv
+  return sendrecv( sendm, nws[0], recvm, nwr[0], sendp, nws[1], recvp, nwr[1], req, nIDm, nIDp, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 面毎の通信袖数指定の袖通信の１方向(プラス、マイナス)の受信待機と展開
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::waitFace( T *array, int imax, int jmax, int kmax, int nmax, int vc, const int vc_comm[6]
+                         , int pad_size[4], cpm_DirFlag dir, MPI_Request req[4], int procGrpNo )
+{
+  cpm_ErrorCode ret;
+
+  // wait
+  if( (ret = Waitall( 4, req )) != CPM_SUCCESS ) return ret;
+
+  // 通信バッファを取得
+  S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
+  if( !bufInfo )
+  {
+    return CPM_ERROR_BNDCOMM_BUFFER;
+  }
+
+  // 隣接ランク、送信、受信領域を取得
+  int nIDm, nIDp;
+  int sbox[2][6], rbox[2][6];
+  int sz[3] = {imax, jmax, kmax};
+  if( (ret = getFaceCommInfo( sz, vc, vc_comm, dir, nIDm, nIDp, sbox, rbox, procGrpNo )) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  REAL_BUF_TYPE **buf = bufInfo->m_bufX;
+  if( dir == Y_DIR )      buf = bufInfo->m_bufY;
+  else if( dir == Z_DIR ) buf = bufInfo->m_bufZ;
+
+  // unpack
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  if( !IsRankNull(nIDm) && rbox[0][3] * rbox[0][4] * rbox[0][5] > 0 )
+  {
+    copyRedistBox( a, rbox[0], (T*)(buf[1]), false );
+  }
+  if( !IsRankNull(nIDp) && rbox[1][3] * rbox[1][4] * rbox[1][5] > 0 )
+  {
+    copyRedistBox( a, rbox[1], (T*)(buf[3]), false );
+  }
+
+  return CPM_SUCCESS;
+}
+
 #undef _IDXFX
 #undef _IDXFY
 #undef _IDXFZ
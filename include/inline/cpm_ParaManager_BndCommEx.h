@@ -61,7 +61,7 @@ cpm_ParaManager::BndCommV3DEx( T *array, int imax, int jmax, int kmax, int vc, i
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3);
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
   }
   return BndCommS4DEx( array, 3, imax, jmax, kmax, vc, vc_comm, pad_size, procGrpNo );
 }
@@ -76,7 +76,7 @@ cpm_ParaManager::BndCommS4DEx( T *array, int nmax, int imax, int jmax, int kmax,
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return BndCommS4DEx( array, nmax, imax, jmax, kmax, vc, vc_comm, pad_size, procGrpNo );
 }
@@ -92,7 +92,7 @@ cpm_ParaManager::BndCommV3DEx_nowait( T *array, int imax, int jmax, int kmax, in
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3);
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
   }
   return BndCommS4DEx_nowait( array, 3, imax, jmax, kmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -108,7 +108,7 @@ cpm_ParaManager::BndCommS4DEx_nowait( T *array, int nmax, int imax, int jmax, in
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return BndCommS4DEx_nowait( array, nmax, imax, jmax, kmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -124,7 +124,7 @@ cpm_ParaManager::wait_BndCommV3DEx( T *array, int imax, int jmax, int kmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3);
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
   }
   return wait_BndCommS4DEx( array, 3, imax, jmax, kmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -140,7 +140,7 @@ cpm_ParaManager::wait_BndCommS4DEx( T *array, int nmax, int imax, int jmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return wait_BndCommS4DEx( array, nmax, imax, jmax, kmax, vc, vc_comm, req, pad_size, procGrpNo );
 }
@@ -156,7 +156,7 @@ cpm_ParaManager::PeriodicCommV3DEx( T *array, int imax, int jmax, int kmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3);
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
   }
   return PeriodicCommS4DEx( array, 3, imax, jmax, kmax, vc, vc_comm, dir, pm, pad_size, procGrpNo );
 }
@@ -172,7 +172,7 @@ cpm_ParaManager::PeriodicCommS4DEx( T *array, int nmax, int imax, int jmax, int
   int pad_size[4] = {0, 0, 0, 0};
   if( padding )
   {
-    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax);
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
   }
   return PeriodicCommS4DEx( array, nmax, imax, jmax, kmax, vc, vc_comm, dir, pm, pad_size, procGrpNo );
 }
@@ -190,6 +190,12 @@ cpm_ParaManager::BndCommS4DEx( T *array, int nmax, int imax, int jmax, int kmax,
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -278,6 +284,9 @@ cpm_ParaManager::BndCommS4DEx( T *array, int nmax, int imax, int jmax, int kmax,
   // unpack
   if( (ret = unpackZEx( array, nmax, imax, jmax, kmax, vc, vc_comm, pad_size, recvmz, recvpz, nIDmz, nIDpz )) != CPM_SUCCESS ) return ret;
 
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   return CPM_SUCCESS;
 }
 
@@ -300,6 +309,12 @@ cpm_ParaManager::BndCommS4DEx_nowait( T *array, int nmax, int imax, int jmax, in
     req[i] = MPI_REQUEST_NULL;
   }
 
+  // 登録フィールドの仮想セルが最新のときは通信を省略
+  if( beginFieldComm( array, nmax, vc_comm, procGrpNo ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -384,6 +399,12 @@ cpm_ParaManager::wait_BndCommS4DEx( T *array, int nmax, int imax, int jmax, int
     return CPM_ERROR_INVALID_PTR;
   }
 
+  // 非同期袖通信を省略したときは展開も省略
+  if( endFieldComm( array ) )
+  {
+    return CPM_SUCCESS;
+  }
+
   // 通信バッファを取得
   S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
   if( !bufInfo )
@@ -445,6 +466,9 @@ cpm_ParaManager::wait_BndCommS4DEx( T *array, int nmax, int imax, int jmax, int
   // unpack
   if( (ret = unpackZEx( array, nmax, imax, jmax, kmax, vc, vc_comm, pad_size, recvmz, recvpz, nIDmz, nIDpz )) != CPM_SUCCESS ) return ret;
 
+  // 登録フィールドの通信済みを記録
+  commitFieldComm( array );
+
   return CPM_SUCCESS;
 }
 
@@ -612,34 +636,34 @@ cpm_ParaManager::packXEx( T *array, int nmax, int imax, int jmax, int kmax, int
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) is = 1;
 
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0;i<vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendm[_IDXFX(n,i,j,k,nmax,0,jmax,kmax,vc_comm)] = array[_IDX_S4DEX_PAD(n,i+is,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k) + is*si;
+      T *dst = &sendm[_IDXFX(0,0,j,k,nmax,0,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=imax-vc_comm;i<imax;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendp[_IDXFX(n,i,j,k,nmax,imax-vc_comm,jmax,kmax,vc_comm)] = array[_IDX_S4DEX_PAD(n,i-is,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k) + (imax-vc_comm-is)*si;
+      T *dst = &sendp[_IDXFX(0,imax-vc_comm,j,k,nmax,imax-vc_comm,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -652,30 +676,34 @@ cpm_ErrorCode
 cpm_ParaManager::unpackXEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm, int pad_size[4]
                               , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<0;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvm[_IDXFX(n,i,j,k,nmax,0-vc_comm,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k) - vc_comm*si;
+      const T *src = &recvm[_IDXFX(0,0-vc_comm,j,k,nmax,0-vc_comm,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=imax;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvp[_IDXFX(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k) + imax*si;
+      const T *src = &recvp[_IDXFX(0,imax,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      for( int i=0;i<vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -695,34 +723,34 @@ cpm_ParaManager::packYEx( T *array, int nmax, int imax, int jmax, int kmax, int
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) js = 1;
 
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0;j<vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendm[_IDXFY(n,i,j,k,nmax,imax,0,kmax,vc_comm)] = array[_IDX_S4DEX_PAD(n,i,j+js,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j+js,k);
+      T *dst = &sendm[_IDXFY(0,0,j,k,nmax,imax,0,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax-vc_comm;j<jmax;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendp[_IDXFY(n,i,j,k,nmax,imax,jmax-vc_comm,kmax,vc_comm)] = array[_IDX_S4DEX_PAD(n,i,j-js,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j-js,k);
+      T *dst = &sendp[_IDXFY(0,0,j,k,nmax,imax,jmax-vc_comm,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -735,30 +763,34 @@ cpm_ErrorCode
 cpm_ParaManager::unpackYEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm, int pad_size[4]
                               , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<0;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvm[_IDXFY(n,i,j,k,nmax,imax,0-vc_comm,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k);
+      const T *src = &recvm[_IDXFY(0,0,j,k,nmax,imax,0-vc_comm,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=0-vc_comm;k<kmax+vc_comm;k++ ){
     for( int j=jmax;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvp[_IDXFY(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k);
+      const T *src = &recvp[_IDXFY(0,0,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -778,34 +810,34 @@ cpm_ParaManager::packZEx( T *array, int nmax, int imax, int jmax, int kmax, int
   //定義点がNODEのとき
   if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) ks = 1;
 
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0;k<vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendm[_IDXFZ(n,i,j,k,nmax,imax,jmax,0,vc_comm)] = array[_IDX_S4DEX_PAD(n,i,j,k+ks,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k+ks);
+      T *dst = &sendm[_IDXFZ(0,0,j,k,nmax,imax,jmax,0,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=kmax-vc_comm;k<kmax;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-
-      sendp[_IDXFZ(n,i,j,k,nmax,imax,jmax,kmax-vc_comm,vc_comm)] = array[_IDX_S4DEX_PAD(n,i,j,k-ks,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)];
-
-    }}}}
+      const T *src = a.Row(j,k-ks);
+      T *dst = &sendp[_IDXFZ(0,0,j,k,nmax,imax,jmax,kmax-vc_comm,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*nmax+n] = src[i*si+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -818,30 +850,34 @@ cpm_ErrorCode
 cpm_ParaManager::unpackZEx( T *array, int nmax, int imax, int jmax, int kmax, int vc, int vc_comm, int pad_size[4]
                               , T *recvm, T *recvp, int nIDm, int nIDp )
 {
-  // パディング
-  int np = pad_size[0];
-  int ip = pad_size[1];
-  int jp = pad_size[2];
-  int kp = pad_size[3];
+  // 配列ビュー(パディング込み)
+  cpm_ArrayView<T, CPM_ARRAY_S4DEX> a( array, imax, jmax, kmax, nmax, vc, pad_size );
+  ptrdiff_t si = a.StrideI();
 
   if( !IsRankNull(nIDm) )
   {
     for( int k=0-vc_comm;k<0;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvm[_IDXFZ(n,i,j,k,nmax,imax,jmax,0-vc_comm,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k);
+      const T *src = &recvm[_IDXFZ(0,0,j,k,nmax,imax,jmax,0-vc_comm,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   if( !IsRankNull(nIDp) )
   {
     for( int k=kmax;k<kmax+vc_comm;k++ ){
     for( int j=0-vc_comm;j<jmax+vc_comm;j++ ){
-    for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
-    for( int n=0;n<nmax;n++){
-      array[_IDX_S4DEX_PAD(n,i,j,k,nmax,imax,jmax,kmax,vc,np,ip,jp,kp)] = recvp[_IDXFZ(n,i,j,k,nmax,imax,jmax,kmax,vc_comm)];
-    }}}}
+      T *dst = a.Row(j,k);
+      const T *src = &recvp[_IDXFZ(0,0,j,k,nmax,imax,jmax,kmax,vc_comm)];
+      for( int i=0-vc_comm;i<imax+vc_comm;i++ ){
+      for( int n=0;n<nmax;n++){
+        dst[i*si+n] = src[i*nmax+n];
+      }}
+    }}
   }
 
   return CPM_SUCCESS;
@@ -0,0 +1,255 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_FieldIO.h
+ * カーテシアン用パラレルマネージャクラスの並列ファイル入出力のインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_FIELDIO_H_
+#define _CPM_PARAMANAGER_FIELDIO_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                              , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return WriteFieldS4D( fileName, array, imax, jmax, kmax, 1, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Vector3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldV3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                              , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 3, padding, sizeof(T));
+  }
+  return WriteFieldS4D( fileName, array, imax, jmax, kmax, 3, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                              , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return WriteFieldS4D( fileName, array, imax, jmax, kmax, nmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                              , int pad_size[4], int procGrpNo )
+{
+  // 型を取得
+  MPI_Datatype dtype = GetMPI_Datatype(array);
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  return WriteFieldS4D( dtype, fileName, (void*)array, imax, jmax, kmax, nmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Vector3DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldV3DEx( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                                , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
+  }
+  return WriteFieldS4DEx( fileName, array, 3, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                                , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return WriteFieldS4DEx( fileName, array, nmax, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4DEx版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                                , int pad_size[4], int procGrpNo )
+{
+  // 型を取得
+  MPI_Datatype dtype = GetMPI_Datatype(array);
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  return WriteFieldS4DEx( dtype, fileName, (void*)array, nmax, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                             , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(T));
+  }
+  return ReadFieldS4D( fileName, array, imax, jmax, kmax, 1, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Vector3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldV3D( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                             , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3D, sz, vc, pad_size, 3, padding, sizeof(T));
+  }
+  return ReadFieldS4D( fileName, array, imax, jmax, kmax, 3, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                             , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return ReadFieldS4D( fileName, array, imax, jmax, kmax, nmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4D( const char *fileName, T *array, int imax, int jmax, int kmax, int nmax, int vc
+                             , int pad_size[4], int procGrpNo )
+{
+  // 型を取得
+  MPI_Datatype dtype = GetMPI_Datatype(array);
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  return ReadFieldS4D( dtype, fileName, (void*)array, imax, jmax, kmax, nmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Vector3DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldV3DEx( const char *fileName, T *array, int imax, int jmax, int kmax, int vc
+                               , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3DEX, sz, vc, pad_size, 3, padding, sizeof(T));
+  }
+  return ReadFieldS4DEx( fileName, array, 3, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                               , int procGrpNo, CPM_PADDING padding )
+{
+  int sz[3] = {imax, jmax, kmax};
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4DEX, sz, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return ReadFieldS4DEx( fileName, array, nmax, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4DEx版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4DEx( const char *fileName, T *array, int nmax, int imax, int jmax, int kmax, int vc
+                               , int pad_size[4], int procGrpNo )
+{
+  // 型を取得
+  MPI_Datatype dtype = GetMPI_Datatype(array);
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  return ReadFieldS4DEx( dtype, fileName, (void*)array, nmax, imax, jmax, kmax, vc, pad_size, procGrpNo );
+}
+
+#endif /* _CPM_PARAMANAGER_FIELDIO_H_ */
@@ -0,0 +1,242 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Multigrid.h
+ * カーテシアン用パラレルマネージャクラスのマルチグリッドのインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_MULTIGRID_H_
+#define _CPM_PARAMANAGER_MULTIGRID_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// 細格子から粗格子への制限(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RestrictS3D( int levelNo, T *fine, int vcFine, T *coarse, int vcCoarse
+                            , CPM_PADDING padding )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padFine[4]   = {0, 0, 0, 0};
+  int padCoarse[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, level->m_fineSize, vcFine, padFine, 0, padding, sizeof(T));
+    if( level->m_coarseProcGrpNo >= 0 )
+    {
+      GetPaddingSize(CPM_ARRAY_S3D, level->m_coarseSize, vcCoarse, padCoarse, 0, padding, sizeof(T));
+    }
+  }
+  return RestrictS4D( levelNo, fine, vcFine, padFine, coarse, vcCoarse, padCoarse, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 細格子から粗格子への制限(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RestrictS4D( int levelNo, T *fine, int vcFine, T *coarse, int vcCoarse, int nmax
+                            , CPM_PADDING padding )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padFine[4]   = {0, 0, 0, 0};
+  int padCoarse[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, level->m_fineSize, vcFine, padFine, nmax, padding, sizeof(T));
+    if( level->m_coarseProcGrpNo >= 0 )
+    {
+      GetPaddingSize(CPM_ARRAY_S4D, level->m_coarseSize, vcCoarse, padCoarse, nmax, padding, sizeof(T));
+    }
+  }
+  return RestrictS4D( levelNo, fine, vcFine, padFine, coarse, vcCoarse, padCoarse, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 細格子から粗格子への制限(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RestrictS4D( int levelNo, T *fine, int vcFine, int padFine[4]
+                            , T *coarse, int vcCoarse, int padCoarse[4], int nmax )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  bool bCoarse = (level->m_coarseProcGrpNo >= 0);
+  if( bCoarse && !coarse )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 作業配列(粗格子の領域を細格子で見た領域、仮想セルなし)
+  const int *cs = level->m_coarseSize;
+  int ws[3] = {cs[0]*2, cs[1]*2, cs[2]*2};
+  std::vector<T> work;
+  if( bCoarse )
+  {
+    work.resize(size_t(ws[0]) * size_t(ws[1]) * size_t(ws[2]) * size_t(nmax));
+  }
+  T *pw = work.empty() ? NULL : &work[0];
+
+  // 細格子から作業配列へ再配置
+  int padWork[4] = {0, 0, 0, 0};
+  cpm_ErrorCode ret = redistribute<T, CPM_ARRAY_S4D>( level->m_restrictPlanNo, fine, vcFine, padFine
+                                                    , pw, 0, padWork, nmax );
+  if( ret != CPM_SUCCESS || !bCoarse )
+  {
+    return ret;
+  }
+
+  // 2x2x2セルの平均
+  cpm_ArrayView<T, CPM_ARRAY_S4D> w( pw, ws[0], ws[1], ws[2], nmax, 0 );
+  cpm_ArrayView<T, CPM_ARRAY_S4D> c( coarse, cs[0], cs[1], cs[2], nmax, vcCoarse, padCoarse );
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2)
+#endif
+  for( int n=0;n<nmax;n++ ){
+  for( int k=0;k<cs[2];k++ ){
+    for( int j=0;j<cs[1];j++ ){
+      const T *w00 = w.Row(2*j  ,2*k  ,n);
+      const T *w10 = w.Row(2*j+1,2*k  ,n);
+      const T *w01 = w.Row(2*j  ,2*k+1,n);
+      const T *w11 = w.Row(2*j+1,2*k+1,n);
+      T *pc = c.Row(j,k,n);
+      for( int i=0;i<cs[0];i++ ){
+        pc[i] = T( ( w00[2*i] + w00[2*i+1] + w10[2*i] + w10[2*i+1]
+                   + w01[2*i] + w01[2*i+1] + w11[2*i] + w11[2*i+1] ) * 0.125 );
+      }
+    }
+  }}
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粗格子から細格子への補間(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ProlongS3D( int levelNo, T *coarse, int vcCoarse, T *fine, int vcFine
+                           , CPM_PADDING padding )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padFine[4]   = {0, 0, 0, 0};
+  int padCoarse[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, level->m_fineSize, vcFine, padFine, 0, padding, sizeof(T));
+    if( level->m_coarseProcGrpNo >= 0 )
+    {
+      GetPaddingSize(CPM_ARRAY_S3D, level->m_coarseSize, vcCoarse, padCoarse, 0, padding, sizeof(T));
+    }
+  }
+  return ProlongS4D( levelNo, coarse, vcCoarse, padCoarse, fine, vcFine, padFine, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粗格子から細格子への補間(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ProlongS4D( int levelNo, T *coarse, int vcCoarse, T *fine, int vcFine, int nmax
+                           , CPM_PADDING padding )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padFine[4]   = {0, 0, 0, 0};
+  int padCoarse[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, level->m_fineSize, vcFine, padFine, nmax, padding, sizeof(T));
+    if( level->m_coarseProcGrpNo >= 0 )
+    {
+      GetPaddingSize(CPM_ARRAY_S4D, level->m_coarseSize, vcCoarse, padCoarse, nmax, padding, sizeof(T));
+    }
+  }
+  return ProlongS4D( levelNo, coarse, vcCoarse, padCoarse, fine, vcFine, padFine, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粗格子から細格子への補間(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::ProlongS4D( int levelNo, T *coarse, int vcCoarse, int padCoarse[4]
+                           , T *fine, int vcFine, int padFine[4], int nmax )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  bool bCoarse = (level->m_coarseProcGrpNo >= 0);
+  if( bCoarse && !coarse )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 作業配列(粗格子の領域を細格子で見た領域、仮想セルなし)
+  const int *cs = level->m_coarseSize;
+  int ws[3] = {cs[0]*2, cs[1]*2, cs[2]*2};
+  std::vector<T> work;
+  if( bCoarse )
+  {
+    work.resize(size_t(ws[0]) * size_t(ws[1]) * size_t(ws[2]) * size_t(nmax));
+  }
+  T *pw = work.empty() ? NULL : &work[0];
+
+  // 粗格子の値を2x2x2セルにコピー
+  if( bCoarse )
+  {
+    cpm_ArrayView<T, CPM_ARRAY_S4D> w( pw, ws[0], ws[1], ws[2], nmax, 0 );
+    cpm_ArrayView<T, CPM_ARRAY_S4D> c( coarse, cs[0], cs[1], cs[2], nmax, vcCoarse, padCoarse );
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2)
+#endif
+    for( int n=0;n<nmax;n++ ){
+    for( int k=0;k<ws[2];k++ ){
+      for( int j=0;j<ws[1];j++ ){
+        const T *pc = c.Row(j/2,k/2,n);
+        T *pf = w.Row(j,k,n);
+        for( int i=0;i<ws[0];i++ ){
+          pf[i] = pc[i/2];
+        }
+      }
+    }}
+  }
+
+  // 作業配列から細格子へ再配置
+  int padWork[4] = {0, 0, 0, 0};
+  return redistribute<T, CPM_ARRAY_S4D>( level->m_prolongPlanNo, pw, 0, padWork
+                                       , fine, vcFine, padFine, nmax );
+}
+
+#endif /* _CPM_PARAMANAGER_MULTIGRID_H_ */
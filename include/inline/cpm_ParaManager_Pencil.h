@@ -0,0 +1,311 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Pencil.h
+ * カーテシアン用パラレルマネージャクラスのペンシル転置のインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_PENCIL_H_
+#define _CPM_PARAMANAGER_PENCIL_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// ブロックからペンシルへの転置(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeToPencilS3D( cpm_DirFlag dir, T *array, int vc, T *pencil
+                                     , int procGrpNo, CPM_PADDING padding )
+{
+  return TransposeToPencilS4D( dir, array, 1, vc, pencil, procGrpNo, padding );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ブロックからペンシルへの転置(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeToPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, T *pencil
+                                     , int procGrpNo, CPM_PADDING padding )
+{
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, plan->m_blkSize, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return TransposeToPencilS4D( dir, array, nmax, vc, pad_size, pencil, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ブロックからペンシルへの転置(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeToPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4], T *pencil
+                                     , int procGrpNo )
+{
+  MPI_Request req;
+  cpm_ErrorCode ret = TransposeToPencilS4D_nowait( dir, array, nmax, vc, pad_size, &req, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  return wait_TransposeToPencilS4D( dir, pencil, nmax, &req, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ブロックからペンシルへの非同期転置(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeToPencilS4D_nowait( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4]
+                                            , MPI_Request *req, int procGrpNo )
+{
+  if( !array || !req || nmax < 1 )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  if( plan->m_pending != 0 )
+  {
+    return CPM_ERROR_PENCIL_BUSY;
+  }
+
+  // 送信データのパック(ライン内のランク毎)
+  preparePencilExchange( plan, true, nmax, sizeof(T) );
+  const int *bs = plan->m_blkSize;
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, bs[0], bs[1], bs[2], nmax, vc, pad_size );
+  T *sendbuf = plan->m_sendBuf.empty() ? NULL : (T*)&plan->m_sendBuf[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int q=0;q<plan->m_nrank;q++ )
+  {
+    if( plan->m_scnt[q] == 0 ) continue;
+    copyRedistBox( a, &plan->m_blkBox[q*6], sendbuf + plan->m_sdsp[q], true );
+  }
+
+  // Ialltoallv
+  ret = startPencilExchange( plan, sizeof(T), req );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  plan->m_pending = 1;
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ブロックからペンシルへの非同期転置のwait、展開(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_TransposeToPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, MPI_Request *req
+                                          , int procGrpNo )
+{
+  if( !pencil || !req )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  if( plan->m_pending != 1 )
+  {
+    return CPM_ERROR_MPI_INVALID_REQUEST;
+  }
+
+  // wait
+  ret = Wait( req );
+  plan->m_pending = 0;
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 受信データの展開(ペンシルは仮想セル、パディングなし)
+  const int *ps = plan->m_pencilSize;
+  cpm_ArrayView<T, CPM_ARRAY_S4D> p( pencil, ps[0], ps[1], ps[2], nmax, 0 );
+  T *recvbuf = plan->m_recvBuf.empty() ? NULL : (T*)&plan->m_recvBuf[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int q=0;q<plan->m_nrank;q++ )
+  {
+    if( plan->m_rcnt[q] == 0 ) continue;
+    copyRedistBox( p, &plan->m_pencilBox[q*6], recvbuf + plan->m_rdsp[q], false );
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルからブロックへの転置(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeFromPencilS3D( cpm_DirFlag dir, T *pencil, T *array, int vc
+                                       , int procGrpNo, CPM_PADDING padding )
+{
+  return TransposeFromPencilS4D( dir, pencil, 1, array, vc, procGrpNo, padding );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルからブロックへの転置(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeFromPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, T *array, int vc
+                                       , int procGrpNo, CPM_PADDING padding )
+{
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  int pad_size[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, plan->m_blkSize, vc, pad_size, nmax, padding, sizeof(T));
+  }
+  return TransposeFromPencilS4D( dir, pencil, nmax, array, vc, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルからブロックへの転置(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeFromPencilS4D( cpm_DirFlag dir, T *pencil, int nmax, T *array, int vc, int pad_size[4]
+                                       , int procGrpNo )
+{
+  MPI_Request req;
+  cpm_ErrorCode ret = TransposeFromPencilS4D_nowait( dir, pencil, nmax, &req, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  return wait_TransposeFromPencilS4D( dir, array, nmax, vc, pad_size, &req, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルからブロックへの非同期転置(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::TransposeFromPencilS4D_nowait( cpm_DirFlag dir, T *pencil, int nmax, MPI_Request *req
+                                              , int procGrpNo )
+{
+  if( !pencil || !req || nmax < 1 )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  if( plan->m_pending != 0 )
+  {
+    return CPM_ERROR_PENCIL_BUSY;
+  }
+
+  // 送信データのパック(ライン内のランク毎)
+  preparePencilExchange( plan, false, nmax, sizeof(T) );
+  const int *ps = plan->m_pencilSize;
+  cpm_ArrayView<T, CPM_ARRAY_S4D> p( pencil, ps[0], ps[1], ps[2], nmax, 0 );
+  T *sendbuf = plan->m_sendBuf.empty() ? NULL : (T*)&plan->m_sendBuf[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int q=0;q<plan->m_nrank;q++ )
+  {
+    if( plan->m_scnt[q] == 0 ) continue;
+    copyRedistBox( p, &plan->m_pencilBox[q*6], sendbuf + plan->m_sdsp[q], true );
+  }
+
+  // Ialltoallv
+  ret = startPencilExchange( plan, sizeof(T), req );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  plan->m_pending = 2;
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルからブロックへの非同期転置のwait、展開(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::wait_TransposeFromPencilS4D( cpm_DirFlag dir, T *array, int nmax, int vc, int pad_size[4]
+                                            , MPI_Request *req, int procGrpNo )
+{
+  if( !array || !req )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  if( plan->m_pending != 2 )
+  {
+    return CPM_ERROR_MPI_INVALID_REQUEST;
+  }
+
+  // wait
+  ret = Wait( req );
+  plan->m_pending = 0;
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 受信データの展開(ブロックの実セルのみ)
+  const int *bs = plan->m_blkSize;
+  cpm_ArrayView<T, CPM_ARRAY_S4D> a( array, bs[0], bs[1], bs[2], nmax, vc, pad_size );
+  T *recvbuf = plan->m_recvBuf.empty() ? NULL : (T*)&plan->m_recvBuf[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+  for( int q=0;q<plan->m_nrank;q++ )
+  {
+    if( plan->m_rcnt[q] == 0 ) continue;
+    copyRedistBox( a, &plan->m_blkBox[q*6], recvbuf + plan->m_rdsp[q], false );
+  }
+
+  return CPM_SUCCESS;
+}
+
+#endif /* _CPM_PARAMANAGER_PENCIL_H_ */
@@ -0,0 +1,318 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Redist.h
+ * カーテシアン用パラレルマネージャクラスのデータ再配置のインラインヘッダーファイル
+ * @date   2026/10/19
+ */
+
+#ifndef _CPM_PARAMANAGER_REDIST_H_
+#define _CPM_PARAMANAGER_REDIST_H_
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Scalar3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeS3D( int planNo, T *src, int vcSrc, T *dst, int vcDst, CPM_PADDING padding )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padSrc[4] = {0, 0, 0, 0};
+  int padDst[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S3D, plan->m_srcSize, vcSrc, padSrc, 0, padding, sizeof(T));
+    GetPaddingSize(CPM_ARRAY_S3D, plan->m_dstSize, vcDst, padDst, 0, padding, sizeof(T));
+  }
+  return redistribute<T, CPM_ARRAY_S4D>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, 1 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Vector3D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeV3D( int planNo, T *src, int vcSrc, T *dst, int vcDst, CPM_PADDING padding )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padSrc[4] = {0, 0, 0, 0};
+  int padDst[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3D, plan->m_srcSize, vcSrc, padSrc, 3, padding, sizeof(T));
+    GetPaddingSize(CPM_ARRAY_V3D, plan->m_dstSize, vcDst, padDst, 3, padding, sizeof(T));
+  }
+  return redistribute<T, CPM_ARRAY_S4D>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Scalar4D版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeS4D( int planNo, T *src, int vcSrc, T *dst, int vcDst, int nmax
+                                , CPM_PADDING padding )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padSrc[4] = {0, 0, 0, 0};
+  int padDst[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4D, plan->m_srcSize, vcSrc, padSrc, nmax, padding, sizeof(T));
+    GetPaddingSize(CPM_ARRAY_S4D, plan->m_dstSize, vcDst, padDst, nmax, padding, sizeof(T));
+  }
+  return redistribute<T, CPM_ARRAY_S4D>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Scalar4D版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeS4D( int planNo, T *src, int vcSrc, int padSrc[4]
+                                , T *dst, int vcDst, int padDst[4], int nmax )
+{
+  return redistribute<T, CPM_ARRAY_S4D>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Vector3DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeV3DEx( int planNo, T *src, int vcSrc, T *dst, int vcDst, CPM_PADDING padding )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padSrc[4] = {0, 0, 0, 0};
+  int padDst[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_V3DEX, plan->m_srcSize, vcSrc, padSrc, 3, padding, sizeof(T));
+    GetPaddingSize(CPM_ARRAY_V3DEX, plan->m_dstSize, vcDst, padDst, 3, padding, sizeof(T));
+  }
+  return redistribute<T, CPM_ARRAY_S4DEX>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, 3 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Scalar4DEx版)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeS4DEx( int planNo, T *src, int vcSrc, T *dst, int vcDst, int nmax
+                                  , CPM_PADDING padding )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  int padSrc[4] = {0, 0, 0, 0};
+  int padDst[4] = {0, 0, 0, 0};
+  if( padding )
+  {
+    GetPaddingSize(CPM_ARRAY_S4DEX, plan->m_srcSize, vcSrc, padSrc, nmax, padding, sizeof(T));
+    GetPaddingSize(CPM_ARRAY_S4DEX, plan->m_dstSize, vcDst, padDst, nmax, padding, sizeof(T));
+  }
+  return redistribute<T, CPM_ARRAY_S4DEX>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置(Scalar4DEx版, パディングサイズ指定)
+template<class T> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::RedistributeS4DEx( int planNo, T *src, int vcSrc, int padSrc[4]
+                                  , T *dst, int vcDst, int padDst[4], int nmax )
+{
+  return redistribute<T, CPM_ARRAY_S4DEX>( planNo, src, vcSrc, padSrc, dst, vcDst, padDst, nmax );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置の実処理
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+cpm_ErrorCode
+cpm_ParaManager::redistribute( int planNo, T *src, int vcSrc, int padSrc[4]
+                             , T *dst, int vcDst, int padDst[4], int nmax )
+{
+  cpm_ErrorCode ret;
+
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  if( (!src && !plan->m_sendRank.empty()) || (!dst && !plan->m_recvRank.empty()) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 配列ビュー(パディング込み)
+  const int *ss = plan->m_srcSize;
+  const int *ds = plan->m_dstSize;
+  cpm_ArrayView<T, Layout> a( src, ss[0], ss[1], ss[2], nmax, vcSrc, padSrc );
+  cpm_ArrayView<T, Layout> b( dst, ds[0], ds[1], ds[2], nmax, vcDst, padDst );
+
+  // 送受信バッファのオフセット(自ランク分は除く)
+  int nsend = int(plan->m_sendRank.size());
+  int nrecv = int(plan->m_recvRank.size());
+  std::vector<size_t> soff(nsend+1, 0);
+  std::vector<size_t> roff(nrecv+1, 0);
+  for( int i=0;i<nsend;i++ )
+  {
+    const int *box = &plan->m_sendBox[i*6];
+    size_t nw = (i == plan->m_selfSend) ? 0 : size_t(box[3]) * size_t(box[4]) * size_t(box[5]) * size_t(nmax);
+    soff[i+1] = soff[i] + nw;
+  }
+  for( int i=0;i<nrecv;i++ )
+  {
+    const int *box = &plan->m_recvBox[i*6];
+    size_t nw = (i == plan->m_selfRecv) ? 0 : size_t(box[3]) * size_t(box[4]) * size_t(box[5]) * size_t(nmax);
+    roff[i+1] = roff[i] + nw;
+  }
+  T *sendbuf = (soff[nsend] > 0) ? new T[soff[nsend]] : NULL;
+  T *recvbuf = (roff[nrecv] > 0) ? new T[roff[nrecv]] : NULL;
+  std::vector<MPI_Request> req(nsend+nrecv, MPI_REQUEST_NULL);
+  int procGrpNo = plan->m_parentProcGrpNo;
+
+  // Irecv
+  ret = CPM_SUCCESS;
+  for( int i=0;i<nrecv && ret==CPM_SUCCESS;i++ )
+  {
+    if( i == plan->m_selfRecv ) continue;
+    ret = Irecv( recvbuf + roff[i], int(roff[i+1]-roff[i]), plan->m_recvRank[i], &req[nsend+i], procGrpNo );
+  }
+
+  // パック
+  if( ret == CPM_SUCCESS )
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for( int i=0;i<nsend;i++ )
+    {
+      if( i == plan->m_selfSend ) continue;
+      copyRedistBox( a, &plan->m_sendBox[i*6], sendbuf + soff[i], true );
+    }
+  }
+
+  // Isend
+  for( int i=0;i<nsend && ret==CPM_SUCCESS;i++ )
+  {
+    if( i == plan->m_selfSend ) continue;
+    ret = Isend( sendbuf + soff[i], int(soff[i+1]-soff[i]), plan->m_sendRank[i], &req[i], procGrpNo );
+  }
+
+  // 自ランク内は直接コピー(送信領域と受信領域は同じ大きさ)
+  if( ret == CPM_SUCCESS && plan->m_selfSend >= 0 && plan->m_selfRecv >= 0 )
+  {
+    const int *sb = &plan->m_sendBox[plan->m_selfSend*6];
+    const int *rb = &plan->m_recvBox[plan->m_selfRecv*6];
+#ifdef _OPENMP
+#pragma omp parallel for collapse(2)
+#endif
+    for( int k=0;k<sb[5];k++ ){
+    for( int j=0;j<sb[4];j++ ){
+      for( int n=0;n<nmax;n++ ){
+        if( cpm_ArrayView<T, Layout>::IsEx )
+        {
+          for( int i=0;i<sb[3];i++ ){
+            b(n,rb[0]+i,rb[1]+j,rb[2]+k) = a(n,sb[0]+i,sb[1]+j,sb[2]+k);
+          }
+        }
+        else
+        {
+          const T *s = a.Row(sb[1]+j,sb[2]+k,n) + sb[0];
+          T *d = b.Row(rb[1]+j,rb[2]+k,n) + rb[0];
+          for( int i=0;i<sb[3];i++ ){
+            d[i] = s[i];
+          }
+        }
+      }
+    }}
+  }
+
+  // wait(エラー時も発行済みの通信は完了させる)
+  cpm_ErrorCode retw = Waitall( nsend+nrecv, (nsend+nrecv > 0) ? &req[0] : NULL );
+  if( ret == CPM_SUCCESS ) ret = retw;
+
+  // 展開
+  if( ret == CPM_SUCCESS )
+  {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for( int i=0;i<nrecv;i++ )
+    {
+      if( i == plan->m_selfRecv ) continue;
+      copyRedistBox( b, &plan->m_recvBox[i*6], recvbuf + roff[i], false );
+    }
+  }
+
+  if( sendbuf ) delete [] sendbuf;
+  if( recvbuf ) delete [] recvbuf;
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置の領域のパック、展開
+template<class T, CPM_ARRAY_SHAPE Layout> CPM_INLINE
+void
+cpm_ParaManager::copyRedistBox( const cpm_ArrayView<T, Layout> &a, const int box[6], T *buf, bool bPack )
+{
+  const int ni = box[3];
+  const int nj = box[4];
+  const int nk = box[5];
+  const int nmax = a.Nmax();
+
+  if( cpm_ArrayView<T, Layout>::IsEx )
+  {
+    // (n,i,j,k)の順
+    for( int k=0;k<nk;k++ ){
+    for( int j=0;j<nj;j++ ){
+    for( int i=0;i<ni;i++ ){
+      T *p = a.Cell(box[0]+i,box[1]+j,box[2]+k);
+      if( bPack ) for( int n=0;n<nmax;n++ ) buf[n] = p[n];
+      else        for( int n=0;n<nmax;n++ ) p[n] = buf[n];
+      buf += nmax;
+    }}}
+  }
+  else
+  {
+    // (i,j,k,n)の順
+    for( int n=0;n<nmax;n++ ){
+    for( int k=0;k<nk;k++ ){
+    for( int j=0;j<nj;j++ ){
+      T *p = a.Row(box[1]+j,box[2]+k,n) + box[0];
+      if( bPack ) for( int i=0;i<ni;i++ ) buf[i] = p[i];
+      else        for( int i=0;i<ni;i++ ) p[i] = buf[i];
+      buf += ni;
+    }}}
+  }
+}
+
+#endif /* _CPM_PARAMANAGER_REDIST_H_ */
@@ -32,6 +32,8 @@ BCMOctree::BCMOctree(RootGrid* rootGrid, Divider* divider, Ordering ordering)
   }
 
   if (ordering == RANDOM) randomShuffle();
+
+  buildNodeTable();
 }
 
 
@@ -54,6 +56,8 @@ BCMOctree::BCMOctree(RootGrid* rootGrid, Ordering ordering,
   }
 
   if (ordering == RANDOM) randomShuffle();
+
+  buildNodeTable();
 }
 
 // コンストラクタ(ファイルロード用)
@@ -87,6 +91,7 @@ BCMOctree::BCMOctree(RootGrid* rootGrid, const std::vector<Pedigree>& pedigrees)
 		leafNodeArray.push_back(node);
 	}
 
+	buildNodeTable();
 }
 
 // デストラクタ.
@@ -269,6 +274,14 @@ void BCMOctree::deleteNode(Node* node)
 
 // 隣接ノード探索.
 Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
+{
+  int rootID = node->getPedigree().getRootID();
+  return findNeighborNode(node, face, rootGrid->getNeighborRoot(rootID, face));
+}
+
+
+// 隣接ノード探索(隣接ルートを指定).
+Node* BCMOctree::findNeighborNode(const Node* node, Face face, int neighborRootID) const
 {
   const Pedigree& pedigree = node->getPedigree();
   int max0 = pedigree.getUpperBound() - 1; // 2^level - 1
@@ -285,7 +298,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case X_M:
       x--;
       if (x < 0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         x = max0;
       }
@@ -293,7 +306,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case X_P:
       x++;
       if (x > max0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         x = 0;
       }
@@ -301,7 +314,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case Y_M:
       y--;
       if (y < 0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         y = max0;
       }
@@ -309,7 +322,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case Y_P:
       y++;
       if (y > max0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         y = 0;
       }
@@ -317,7 +330,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case Z_M:
       z--;
       if (z < 0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         z = max0;
       }
@@ -325,7 +338,7 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
     case Z_P:
       z++;
       if (z > max0) {
-        rootID = rootGrid->getNeighborRoot(rootID, face);
+        rootID = neighborRootID;
         if (rootID < 0) return 0;
         z = 0;
       }
@@ -336,14 +349,12 @@ Node* BCMOctree::findNeighborNode(const Node* node, Face face) const
 
   Pedigree neighborPedigree(level, x, y, z, rootID);
 
-  // Pedigreeからノードを求める.
-  Node* neighbor = rootNodes[rootID];
-  for (int l = 1; l <= level; l++) {
-    if (neighbor->isLeafNode()) break;
-    int ijk = neighborPedigree.getX(l)
-            + neighborPedigree.getY(l) * 2
-            + neighborPedigree.getZ(l) * 4;
-    neighbor = neighbor->getChild(ijk);
+  // ハッシュテーブルから，隣接位置を含む最も深いノードを求める.
+  // (2:1制約下では同レベルか1つ上のレベルで見つかる)
+  Node* neighbor = 0;
+  for (int l = level; l >= 0 && !neighbor; l--) {
+    int s = level - l;
+    neighbor = findNode(Pedigree(l, x >> s, y >> s, z >> s, rootID));
   }
   // 外部境界の除外はすんでいるので，隣接ノードは必ず存在しなくてはいけない.
   if (neighbor == 0) {
@@ -416,59 +427,142 @@ Vec3d BCMOctree::getOrigin(const Node* node) const
 // 指定されたノードの隣接情報を計算.
 NeighborInfo* BCMOctree::makeNeighborInfo(const Node* node, const Partition* partition) const
 {
-  int level = node->getLevel();
-
   NeighborInfo* neighborInfo = new NeighborInfo[NUM_FACE];
 
   // 隣接情報
   for (int i = 0; i < NUM_FACE; ++i) {
     Face face = Face(i);
     Node* neighbor = findNeighborNode(node, face);
+    setNeighborInfo(node, face, neighbor, partition, neighborInfo[face]);
+  }
+  return neighborInfo;
+}
 
-    if (!neighbor) {
-      continue;
-    }
 
-    int neighborLevel = neighbor->getLevel();
-    int levelDiff = neighborLevel - level;
-
-    if (levelDiff == -1) {
-      if (!neighbor->isActive()) continue;
-      neighborInfo[face].setLevelDifference(-1);
-      neighborInfo[face].setID(neighbor->getBlockID());
-      neighborInfo[face].setRank(partition->getRank(neighbor->getBlockID()));
-      Subface subface = NeighborInfo::childIdToSubface(face,
-                                                       node->getPedigree().getChildId(level));
-      neighborInfo[face].setNeighborSubface(subface);
+// 指定されたノードの隣接情報を計算(非周期境界、周期境界を同時に計算).
+void BCMOctree::makeNeighborInfo(const Node* node, const Partition* partition,
+                                 NeighborInfo* neighborInfo, NeighborInfo* periodicInfo) const
+{
+  int rootID = node->getPedigree().getRootID();
+
+  for (int i = 0; i < NUM_FACE; ++i) {
+    Face face = Face(i);
+    int rootID0 = rootGrid->getNeighborRoot(rootID, face, false);
+    int rootID1 = rootGrid->getNeighborRoot(rootID, face, true);
+
+    Node* neighbor = findNeighborNode(node, face, rootID0);
+    setNeighborInfo(node, face, neighbor, partition, neighborInfo[face]);
+
+    // 周期境界で隣接ルートが変わる場合のみ再探索
+    if (rootID1 != rootID0) neighbor = findNeighborNode(node, face, rootID1);
+    setNeighborInfo(node, face, neighbor, partition, periodicInfo[face]);
+  }
+}
+
+
+// 隣接ノードから1面分の隣接情報をセット.
+void BCMOctree::setNeighborInfo(const Node* node, Face face, const Node* neighbor,
+                                const Partition* partition, NeighborInfo& neighborInfo) const
+{
+  if (!neighbor) return;
+
+  int level = node->getLevel();
+  int neighborLevel = neighbor->getLevel();
+  int levelDiff = neighborLevel - level;
+
+  if (levelDiff == -1) {
+    if (!neighbor->isActive()) return;
+    neighborInfo.setLevelDifference(-1);
+    neighborInfo.setID(neighbor->getBlockID());
+    neighborInfo.setRank(partition->getRank(neighbor->getBlockID()));
+    Subface subface = NeighborInfo::childIdToSubface(face,
+                                                     node->getPedigree().getChildId(level));
+    neighborInfo.setNeighborSubface(subface);
+  }
+  else if (levelDiff == 0) {
+    if (neighbor->isLeafNode()) {
+      if (!neighbor->isActive()) return;
+      neighborInfo.setLevelDifference(0);
+      neighborInfo.setID(neighbor->getBlockID());
+      neighborInfo.setRank(partition->getRank(neighbor->getBlockID()));
     }
-    else if (levelDiff == 0) {
-      if (neighbor->isLeafNode()) {
-        if (!neighbor->isActive()) continue;
-        neighborInfo[face].setLevelDifference(0);
-        neighborInfo[face].setID(neighbor->getBlockID());
-        neighborInfo[face].setRank(partition->getRank(neighbor->getBlockID()));
-      }
-      else {
-        neighborInfo[face].setLevelDifference(+1);
-        for (int j = 0; j < NUM_SUBFACE; j++) {
-          Subface subface = Subface(j);
-          Node* child = neighbor->getChild(NeighborInfo::getNeighborChildId(face, subface));
-          if (!child->isLeafNode()) {
-            std::cout << "***error: 2 to 1 constraint is broken." << std::endl;
-            std::cout << "      node: " << node->getPedigree() << std::endl;
-            std::cout << "   subface: " << subface << std::endl;
-            std::cout << "  neigibor: " << neighbor->getPedigree() << std::endl;
-            Exit(EX_FAILURE);
-          }
-          if (!child->isActive()) continue;
-          neighborInfo[face].setID(subface, child->getBlockID());
-          neighborInfo[face].setRank(subface, partition->getRank(child->getBlockID()));
+    else {
+      neighborInfo.setLevelDifference(+1);
+      for (int j = 0; j < NUM_SUBFACE; j++) {
+        Subface subface = Subface(j);
+        const Node* child = neighbor->getChild(NeighborInfo::getNeighborChildId(face, subface));
+        if (!child->isLeafNode()) {
+          std::cout << "***error: 2 to 1 constraint is broken." << std::endl;
+          std::cout << "      node: " << node->getPedigree() << std::endl;
+          std::cout << "   subface: " << subface << std::endl;
+          std::cout << "  neigibor: " << neighbor->getPedigree() << std::endl;
+          Exit(EX_FAILURE);
         }
+        if (!child->isActive()) continue;
+        neighborInfo.setID(subface, child->getBlockID());
+        neighborInfo.setRank(subface, partition->getRank(child->getBlockID()));
       }
     }
+  }
+}
 
+
+// Pedigreeからノードを検索.
+Node* BCMOctree::findNode(const Pedigree& pedigree) const
+{
+  if (nodeTable.empty()) return 0;
+
+  uint64_t key = pedigree.getKey();
+  size_t mask = nodeTable.size() - 1;
+  size_t i = hashKey(key) & mask;
+  while (Node* node = nodeTable[i]) {
+    if (node->getPedigree().getKey() == key) return node;
+    i = (i + 1) & mask;
+  }
+  return 0;
+}
+
+
+// ノード検索用ハッシュテーブルの作成.
+void BCMOctree::buildNodeTable()
+{
+  size_t numNode = 0;
+  for (int id = 0; id < rootGrid->getSize(); id++) numNode += countNode(rootNodes[id]);
+
+  // 使用率が1/2以下となる2のべき乗サイズ
+  size_t size = 1;
+  while (size < 2 * numNode) size <<= 1;
+  nodeTable.assign(size, (Node*)0);
+
+  for (int id = 0; id < rootGrid->getSize(); id++) insertNode(rootNodes[id]);
+}
+
+
+// 再帰呼び出しによるノード数のカウント.
+size_t BCMOctree::countNode(const Node* node) const
+{
+  if (!node) return 0;
+  size_t n = 1;
+  if (!node->isLeafNode()) {
+    for (int i = 0; i < 8; i++) n += countNode(node->getChild(i));
+  }
+  return n;
+}
+
+
+// 再帰呼び出しによるハッシュテーブルへのノード登録.
+void BCMOctree::insertNode(Node* node)
+{
+  if (!node) return;
+
+  size_t mask = nodeTable.size() - 1;
+  size_t i = hashKey(node->getPedigree().getKey()) & mask;
+  while (nodeTable[i]) i = (i + 1) & mask;
+  nodeTable[i] = node;
+
+  if (!node->isLeafNode()) {
+    for (int j = 0; j < 8; j++) insertNode(node->getChild(j));
   }
-  return neighborInfo;
 }
 
 
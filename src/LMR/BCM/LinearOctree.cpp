@@ -0,0 +1,402 @@
+/*
+ * BCMTools
+ *
+ * Copyright (C) 2011-2014 Institute of Industrial Science, The University of Tokyo.
+ * All rights reserved.
+ *
+ * Copyright (c) 2012-2015 Advanced Institute for Computational Science, RIKEN.
+ * All rights reserved.
+ *
+ */
+
+#include <algorithm>  // for sort, upper_bound, lower_bound
+#include "LinearOctree.h"
+
+
+// コンストラクタ.
+LinearOctree::LinearOctree(RootGrid* rootGrid, const std::vector<Pedigree>& pedigrees)
+  : rootGrid(rootGrid)
+{
+  int numLeaf = pedigrees.size();
+
+  // キーとリーフIDの組をキー順にソート
+  std::vector< std::pair<uint64_t, int> > work(numLeaf);
+  for (int id = 0; id < numLeaf; id++) {
+    work[id] = std::make_pair(pedigreeToKey(pedigrees[id]), id);
+  }
+  std::sort(work.begin(), work.end());
+
+  keys.resize(numLeaf);
+  sortedID.resize(numLeaf);
+  position.resize(numLeaf);
+  for (int i = 0; i < numLeaf; i++) {
+    keys[i] = work[i].first;
+    sortedID[i] = work[i].second;
+    position[work[i].second] = i;
+  }
+
+  // ルート毎の先頭位置
+  int nRoot = rootGrid->getSize();
+  rootHead.assign(nRoot + 1, numLeaf);
+  for (int i = numLeaf - 1; i >= 0; i--) rootHead[keyRootID(keys[i])] = i;
+  for (int id = nRoot - 1; id >= 0; id--) {
+    if (rootHead[id] > rootHead[id + 1]) rootHead[id] = rootHead[id + 1];
+  }
+}
+
+
+// デストラクタ.
+LinearOctree::~LinearOctree()
+{
+  delete rootGrid;
+}
+
+
+// ビットを3ビット間隔に展開(下位21ビット).
+uint64_t LinearOctree::spreadBits(uint64_t v)
+{
+  v &= 0x1fffff;
+  v = (v | (v << 32)) & 0x1f00000000ffffULL;
+  v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+  v = (v | (v <<  8)) & 0x100f00f00f00f00fULL;
+  v = (v | (v <<  4)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v <<  2)) & 0x1249249249249249ULL;
+  return v;
+}
+
+
+// 3ビット間隔のビットを詰める(spreadBitsの逆変換).
+unsigned LinearOctree::compactBits(uint64_t v)
+{
+  v &= 0x1249249249249249ULL;
+  v = (v | (v >>  2)) & 0x10c30c30c30c30c3ULL;
+  v = (v | (v >>  4)) & 0x100f00f00f00f00fULL;
+  v = (v | (v >>  8)) & 0x1f0000ff0000ffULL;
+  v = (v | (v >> 16)) & 0x1f00000000ffffULL;
+  v = (v | (v >> 32)) & 0x1fffff;
+  return unsigned(v);
+}
+
+
+// Pedigreeからキーを作成.
+uint64_t LinearOctree::pedigreeToKey(const Pedigree& pedigree)
+{
+  // 最大レベルでの位置に換算してビットをインターリーブ
+  int shift = Pedigree::MaxLevel - pedigree.getLevel();
+  uint64_t x = uint64_t(pedigree.getX()) << shift;
+  uint64_t y = uint64_t(pedigree.getY()) << shift;
+  uint64_t z = uint64_t(pedigree.getZ()) << shift;
+  uint64_t morton = spreadBits(x) | (spreadBits(y) << 1) | (spreadBits(z) << 2);
+  return (uint64_t(pedigree.getRootID()) << (MortonBits + LevelBits))
+       | (morton << LevelBits)
+       | uint64_t(pedigree.getLevel());
+}
+
+
+// キーからPedigreeを作成.
+Pedigree LinearOctree::keyToPedigree(uint64_t key)
+{
+  int level = keyLevel(key);
+  uint64_t morton = (key >> LevelBits) & ((uint64_t(1) << MortonBits) - 1);
+  unsigned x = compactBits(morton);
+  unsigned y = compactBits(morton >> 1);
+  unsigned z = compactBits(morton >> 2);
+  int shift = Pedigree::MaxLevel - level;
+  return Pedigree(level, x >> shift, y >> shift, z >> shift, keyRootID(key));
+}
+
+
+// 指定したキー位置を含むリーフノードを検索.
+int LinearOctree::findContaining(uint64_t begin, int rootID) const
+{
+  std::vector<uint64_t>::const_iterator first = keys.begin() + rootHead[rootID];
+  std::vector<uint64_t>::const_iterator last  = keys.begin() + rootHead[rootID + 1];
+
+  // 先頭がbegin以下の最後のリーフ(キーのレベル部分があるのでbegin+レベル最大値で探索)
+  std::vector<uint64_t>::const_iterator it =
+    std::upper_bound(first, last, begin | ((1 << LevelBits) - 1));
+  if (it == first) return -1;
+  --it;
+  if (begin >= keyEnd(*it)) return -1;
+  return it - keys.begin();
+}
+
+
+// 指定したキー範囲にリーフノードがあるかどうか.
+bool LinearOctree::hasLeaf(uint64_t begin, uint64_t end, int rootID) const
+{
+  std::vector<uint64_t>::const_iterator first = keys.begin() + rootHead[rootID];
+  std::vector<uint64_t>::const_iterator last  = keys.begin() + rootHead[rootID + 1];
+  std::vector<uint64_t>::const_iterator it = std::lower_bound(first, last, begin);
+  return it != last && *it < end;
+}
+
+
+// 指定したノードの領域を含むリーフノードを検索.
+int LinearOctree::findLeaf(const Pedigree& pedigree) const
+{
+  int p = findContaining(keyBegin(pedigreeToKey(pedigree)), pedigree.getRootID());
+  if (p < 0 || keyLevel(keys[p]) > int(pedigree.getLevel())) return -1;
+  return sortedID[p];
+}
+
+
+// 指定したリーフノードの面が外部境界(周期境界も含む)かどうかチェック.
+bool LinearOctree::checkOnOuterBoundary(int id, Face face) const
+{
+  Pedigree pedigree = getPedigree(id);
+  int rootID = pedigree.getRootID();
+  unsigned max0 = pedigree.getUpperBound() - 1;
+  switch (face) {
+    case X_M:
+      return pedigree.getX() == 0 && rootGrid->isOuterBoundary(rootID, face);
+    case X_P:
+      return pedigree.getX() == max0 && rootGrid->isOuterBoundary(rootID, face);
+    case Y_M:
+      return pedigree.getY() == 0 && rootGrid->isOuterBoundary(rootID, face);
+    case Y_P:
+      return pedigree.getY() == max0 && rootGrid->isOuterBoundary(rootID, face);
+    case Z_M:
+      return pedigree.getZ() == 0 && rootGrid->isOuterBoundary(rootID, face);
+    case Z_P:
+      return pedigree.getZ() == max0 && rootGrid->isOuterBoundary(rootID, face);
+    default:
+      assert(0);
+      return false;
+  }
+}
+
+
+// 指定されたリーフノードの原点位置を取得.
+Vec3d LinearOctree::getOrigin(int id) const
+{
+  Pedigree pedigree = getPedigree(id);
+  int rootID = pedigree.getRootID();
+  int ix = rootGrid->rootID2indexX(rootID);
+  int iy = rootGrid->rootID2indexY(rootID);
+  int iz = rootGrid->rootID2indexZ(rootID);
+  int upperBound = pedigree.getUpperBound();
+  return Vec3d(ix + (double)pedigree.getX()/upperBound,
+               iy + (double)pedigree.getY()/upperBound,
+               iz + (double)pedigree.getZ()/upperBound);
+}
+
+
+// 指定されたリーフノードの隣接情報を計算.
+NeighborInfo* LinearOctree::makeNeighborInfo(int id, const Partition* partition) const
+{
+  NeighborInfo* neighborInfo = new NeighborInfo[NUM_FACE];
+
+  Pedigree pedigree = getPedigree(id);
+  int rootID = pedigree.getRootID();
+  for (int i = 0; i < NUM_FACE; ++i) {
+    Face face = Face(i);
+    setNeighborInfo(pedigree, face, rootGrid->getNeighborRoot(rootID, face),
+                    partition, neighborInfo[face]);
+  }
+  return neighborInfo;
+}
+
+
+// 指定されたリーフノードの隣接情報を計算(非周期境界、周期境界を同時に計算).
+void LinearOctree::makeNeighborInfo(int id, const Partition* partition,
+                                    NeighborInfo* neighborInfo, NeighborInfo* periodicInfo) const
+{
+  Pedigree pedigree = getPedigree(id);
+  int rootID = pedigree.getRootID();
+  for (int i = 0; i < NUM_FACE; ++i) {
+    Face face = Face(i);
+    int rootID0 = rootGrid->getNeighborRoot(rootID, face, false);
+    int rootID1 = rootGrid->getNeighborRoot(rootID, face, true);
+    setNeighborInfo(pedigree, face, rootID0, partition, neighborInfo[face]);
+
+    // 周期境界で隣接ルートが変わらない場合は同じ結果
+    if (rootID1 == rootID0) {
+      periodicInfo[face] = neighborInfo[face];
+    } else {
+      setNeighborInfo(pedigree, face, rootID1, partition, periodicInfo[face]);
+    }
+  }
+}
+
+
+// 隣接ノードのPedigreeを計算.
+bool LinearOctree::neighborPedigree(const Pedigree& pedigree, Face face, int neighborRootID,
+                                    Pedigree& neighbor)
+{
+  int max0 = pedigree.getUpperBound() - 1; // 2^level - 1
+
+  int level = pedigree.getLevel();
+  int x = pedigree.getX();
+  int y = pedigree.getY();
+  int z = pedigree.getZ();
+  int rootID = pedigree.getRootID();
+
+  // ルートをまたぐ場合は隣接ルートへ
+  // 周期境界以外の外部境界面に接している場合は，隣接ノードなし
+  switch (face) {
+    case X_M:
+      if (--x < 0)    { rootID = neighborRootID; x = max0; }
+      break;
+    case X_P:
+      if (++x > max0) { rootID = neighborRootID; x = 0; }
+      break;
+    case Y_M:
+      if (--y < 0)    { rootID = neighborRootID; y = max0; }
+      break;
+    case Y_P:
+      if (++y > max0) { rootID = neighborRootID; y = 0; }
+      break;
+    case Z_M:
+      if (--z < 0)    { rootID = neighborRootID; z = max0; }
+      break;
+    case Z_P:
+      if (++z > max0) { rootID = neighborRootID; z = 0; }
+      break;
+    default:
+      return false;
+  }
+  if (rootID < 0) return false;
+
+  neighbor = Pedigree(level, x, y, z, rootID);
+  return true;
+}
+
+
+// 1面分の隣接情報をセット.
+void LinearOctree::setNeighborInfo(const Pedigree& pedigree, Face face, int neighborRootID,
+                                   const Partition* partition, NeighborInfo& neighborInfo) const
+{
+  Pedigree neighbor;
+  if (!neighborPedigree(pedigree, face, neighborRootID, neighbor)) return;
+
+  int level = pedigree.getLevel();
+  int rootID = neighbor.getRootID();
+  uint64_t begin = keyBegin(pedigreeToKey(neighbor));
+
+  // 隣接位置を含むリーフ
+  int p = findContaining(begin, rootID);
+  int levelDiff = (p >= 0) ? keyLevel(keys[p]) - level : 0;
+
+  if (p >= 0 && levelDiff == -1) {
+    int id = sortedID[p];
+    neighborInfo.setLevelDifference(-1);
+    neighborInfo.setID(id);
+    neighborInfo.setRank(partition->getRank(id));
+    Subface subface = NeighborInfo::childIdToSubface(face, pedigree.getChildId(level));
+    neighborInfo.setNeighborSubface(subface);
+  }
+  else if (p >= 0 && levelDiff == 0) {
+    int id = sortedID[p];
+    neighborInfo.setLevelDifference(0);
+    neighborInfo.setID(id);
+    neighborInfo.setRank(partition->getRank(id));
+  }
+  else if ((p >= 0 && levelDiff > 0) ||
+           (p < 0 && hasLeaf(begin, keyEnd(begin | level), rootID))) {
+    // 隣接ノードは細分化されている
+    neighborInfo.setLevelDifference(+1);
+    for (int j = 0; j < NUM_SUBFACE; j++) {
+      Subface subface = Subface(j);
+      Pedigree child(neighbor, NeighborInfo::getNeighborChildId(face, subface));
+      uint64_t childBegin = keyBegin(pedigreeToKey(child));
+      int q = findContaining(childBegin, rootID);
+      if (q >= 0 && keyLevel(keys[q]) == level + 1) {
+        int id = sortedID[q];
+        neighborInfo.setID(subface, id);
+        neighborInfo.setRank(subface, partition->getRank(id));
+      }
+      else if (q >= 0 || hasLeaf(childBegin, keyEnd(childBegin | (level + 1)), rootID)) {
+        std::cout << "***error: 2 to 1 constraint is broken." << std::endl;
+        std::cout << "      node: " << pedigree << std::endl;
+        std::cout << "   subface: " << subface << std::endl;
+        std::cout << "  neigibor: " << neighbor << std::endl;
+        Exit(EX_FAILURE);
+      }
+    }
+  }
+  // レベル差が-2以下(2:1制約違反)，またはリーフの無い領域は隣接なし
+}
+
+
+// 辺，頂点方向の隣接リーフを検索.
+bool LinearOctree::findEdgeNeighbor(int id, const int dir[3], std::vector<int>& leafIDs,
+                                    std::vector<int>& offsets, int& crossMask) const
+{
+  static const Face faceM[3] = { X_M, Y_M, Z_M };
+  static const Face faceP[3] = { X_P, Y_P, Z_P };
+
+  leafIDs.clear();
+  offsets.clear();
+  crossMask = 0;
+
+  // 軸毎に順に隣接ノードへ移動して，同レベルの斜め方向の隣接ノードを求める
+  Pedigree pedigree = getPedigree(id);
+  Pedigree neighbor = pedigree;
+  for (int a = 0; a < 3; a++) {
+    if (dir[a] == 0) continue;
+    Face face = (dir[a] < 0) ? faceM[a] : faceP[a];
+    int rootID = neighbor.getRootID();
+    int rootID0 = rootGrid->getNeighborRoot(rootID, face, false);
+    int rootID1 = rootGrid->getNeighborRoot(rootID, face, true);
+    Pedigree next;
+    if (!neighborPedigree(neighbor, face, rootID1, next)) return false;
+
+    // ルートをまたぎ，非周期では隣接ルートが無い場合は周期境界を越えている
+    int x = (a == 0) ? neighbor.getX() : (a == 1) ? neighbor.getY() : neighbor.getZ();
+    int xEnd = (dir[a] < 0) ? 0 : int(neighbor.getUpperBound()) - 1;
+    if (x == xEnd && rootID0 < 0) crossMask |= (1 << a);
+    neighbor = next;
+  }
+
+  // 辺，頂点に接するリーフ
+  std::vector<Pedigree> nodes;
+  collectEdgeLeaf(neighbor, dir, nodes, leafIDs);
+
+  // 原点位置(細かい方のリーフの大きさ単位)
+  int level = pedigree.getLevel();
+  unsigned r[3] = { neighbor.getX(), neighbor.getY(), neighbor.getZ() };
+  for (size_t n = 0; n < nodes.size(); n++) {
+    int nl = nodes[n].getLevel();
+    unsigned b[3] = { nodes[n].getX(), nodes[n].getY(), nodes[n].getZ() };
+    for (int a = 0; a < 3; a++) {
+      if (nl <= level) {
+        offsets.push_back(dir[a] - int(r[a] - (b[a] << (level - nl))));
+      } else {
+        offsets.push_back(dir[a] * (1 << (nl - level)) + int(b[a] - (r[a] << (nl - level))));
+      }
+    }
+  }
+
+  return true;
+}
+
+
+// 辺，頂点に接するリーフを再帰的に収集.
+void LinearOctree::collectEdgeLeaf(const Pedigree& node, const int dir[3],
+                                   std::vector<Pedigree>& nodes, std::vector<int>& leafIDs) const
+{
+  int level = node.getLevel();
+  int rootID = node.getRootID();
+  uint64_t begin = keyBegin(pedigreeToKey(node));
+
+  // ノード自身または祖先がリーフ
+  int p = findContaining(begin, rootID);
+  if (p >= 0 && keyLevel(keys[p]) <= level) {
+    nodes.push_back(keyToPedigree(keys[p]));
+    leafIDs.push_back(sortedID[p]);
+    return;
+  }
+
+  // 細分化されている場合は，基準ノードの辺，頂点側の子ノードを探索
+  if (level >= int(Pedigree::MaxLevel)) return;
+  if (!hasLeaf(begin, keyEnd(begin | level), rootID)) return;
+  for (int c = 0; c < 8; c++) {
+    bool touch = true;
+    for (int a = 0; a < 3; a++) {
+      int bit = (c >> a) & 1;
+      if ((dir[a] > 0 && bit != 0) || (dir[a] < 0 && bit != 1)) touch = false;
+    }
+    if (touch) collectEdgeLeaf(Pedigree(node, c), dir, nodes, leafIDs);
+  }
+}
@@ -33,6 +33,11 @@ cpm_LeafCommInfo::cpm_LeafCommInfo(int distRankID)
   m_pCommRecvBuf = NULL;
   m_reqSend = MPI_REQUEST_NULL;
   m_reqRecv = MPI_REQUEST_NULL;
+  m_CommSendBufSize = 0;
+  m_CommRecvBufSize = 0;
+  m_offsetFace[0] = 0;
+  m_offsetFace[1] = 0;
+  m_offsetVC = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -162,9 +167,75 @@ cpm_LeafCommInfo::SetBndCommBuffer( int myRankNo, size_t sz_face[2], size_t maxV
     return false;
   }
 
+  // 通信情報毎のバッファオフセット
+  SetCommOffset( sz_face, maxVC );
+
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 通信情報毎のバッファオフセットの計算
+void
+cpm_LeafCommInfo::SetCommOffset( size_t sz_face[2], size_t maxVC )
+{
+  size_t n1 = m_vecCommInfo.size() + 1;
+
+  m_offsetFace[0] = sz_face[0];
+  m_offsetFace[1] = sz_face[1];
+  m_offsetVC      = maxVC;
+  for( int p=0;p<2;p++ )
+  {
+    bool bPeriodic = (p==1);
+    m_sendOffset[p].assign( maxVC*n1, 0 );
+    m_recvOffset[p].assign( maxVC*n1, 0 );
+    for( size_t vc=1;vc<=maxVC;vc++ )
+    {
+      CalcCommOffset( true , sz_face, vc, bPeriodic, &m_sendOffset[p][(vc-1)*n1] );
+      CalcCommOffset( false, sz_face, vc, bPeriodic, &m_recvOffset[p][(vc-1)*n1] );
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 通信情報毎のバッファオフセットの取得
+const size_t*
+cpm_LeafCommInfo::GetCommOffset( bool bSend, size_t sz_face[2], size_t vc_comm, bool bPeriodic
+                               , std::vector<size_t> &work )
+{
+  // 計算済みの条件か(バッファサイズは面内の２軸について対称)
+  bool bFace = ( sz_face[0]==m_offsetFace[0] && sz_face[1]==m_offsetFace[1] )
+            || ( sz_face[0]==m_offsetFace[1] && sz_face[1]==m_offsetFace[0] );
+  if( bFace && vc_comm >= 1 && vc_comm <= m_offsetVC )
+  {
+    size_t n1 = m_vecCommInfo.size() + 1;
+    std::vector<size_t> &off = bSend ? m_sendOffset[bPeriodic ? 1 : 0] : m_recvOffset[bPeriodic ? 1 : 0];
+    return &off[(vc_comm-1)*n1];
+  }
+
+  // 作業領域に計算
+  work.resize( m_vecCommInfo.size() + 1 );
+  CalcCommOffset( bSend, sz_face, vc_comm, bPeriodic, &work[0] );
+  return &work[0];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 通信情報毎のバッファオフセットを計算
+void
+cpm_LeafCommInfo::CalcCommOffset( bool bSend, size_t sz_face[2], size_t vc_comm, bool bPeriodic, size_t *off )
+{
+  off[0] = 0;
+  for( size_t i=0;i<m_vecCommInfo.size();i++ )
+  {
+    size_t csz = 0;
+    if( m_vecCommInfo[i]->bPeriodic == bPeriodic )
+    {
+      csz = bSend ? m_vecCommInfo[i]->CalcSendBufferSize(sz_face, vc_comm, 1)
+                  : m_vecCommInfo[i]->CalcRecvBufferSize(sz_face, vc_comm, 1);
+    }
+    off[i+1] = off[i] + csz;
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 対となる通信情報を検索
 cpm_LeafCommInfo::stCommInfo* cpm_LeafCommInfo::SearchDistCommInfo(cpm_LeafCommInfo::stCommInfo *commInfo)
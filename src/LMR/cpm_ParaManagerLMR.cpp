@@ -90,6 +90,12 @@ cpm_ParaManagerLMR::cpm_ParaManagerLMR()
 
   // 領域分割タイプ
   m_domainType = CPM_DOMAIN_LMR;
+
+  // 集約袖通信モード
+  m_bBndCommAggregate = false;
+
+  // 辺、頂点袖通信モード
+  m_bBndCommEdge = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -123,7 +129,9 @@ cpm_ParaManagerLMR::~cpm_ParaManagerLMR()
 // LMR用の領域分割
 cpm_ErrorCode
 cpm_ParaManagerLMR::VoxelInit_LMR( std::string treeFile
-                              , size_t maxVC, size_t maxN, int procGrpNo )
+                              , size_t maxVC, size_t maxN, int procGrpNo
+                              , const double *leafWeight, double cutTol
+                              , S_LMR_PARTITION_INFO *partInfo )
 {
   cpm_ErrorCode ret = CPM_SUCCESS;
   cpm_VoxelInfoLMR *voxelInfo = NULL;
@@ -151,7 +159,9 @@ cpm_ParaManagerLMR::VoxelInit_LMR( std::string treeFile
 
   // 領域分割情報の生成
   LeafMap leafMap;
-  if( (ret = cpm_VoxelInfoLMR::Init( comm, treeFile, leafMap )) != CPM_SUCCESS )
+  stLMRDomainInfo lmrInfo;
+  if( (ret = cpm_VoxelInfoLMR::Init( comm, treeFile, leafMap, leafWeight, cutTol, partInfo
+                                   , &lmrInfo.treeInfo )) != CPM_SUCCESS )
   {
     Abort(ret);
     return ret;
@@ -171,12 +181,272 @@ cpm_ParaManagerLMR::VoxelInit_LMR( std::string treeFile
     return CPM_ERROR_INSERT_VOXELMAP;
   }
 
+  // 再分割用に木情報と分割を保持
+  lmrInfo.maxVC = maxVC;
+  lmrInfo.maxN  = maxN;
+  m_lmrDomainInfoMap[procGrpNo] = lmrInfo;
+
   // LMR用の袖通信情報を生成
   SetBndCommBuffer( maxVC, maxN, procGrpNo );
 
   return ret;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// LMR用のリーフ再分割
+cpm_ErrorCode
+cpm_ParaManagerLMR::Rebalance_LMR( const double *leafWeight, double cutTol
+                                 , S_LMR_PARTITION_INFO *partInfo, int procGrpNo )
+{
+  cpm_ErrorCode ret = CPM_SUCCESS;
+
+  // 領域分割済みか
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  VoxelInfoMapLMR::iterator itV = m_voxelInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() || itV == m_voxelInfoMap.end() )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  stLMRDomainInfo &lmrInfo = itD->second;
+  S_LMR_TREE_INFO &treeInfo = lmrInfo.treeInfo;
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm( procGrpNo );
+  if( IsCommNull( comm ) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+  int nRank;
+  MPI_Comm_size(comm, &nRank);
+
+  // 重みのチェック
+  if( (ret = cpm_VoxelInfoLMR::CheckLeafWeight((int)treeInfo.octHeader.numLeaf, leafWeight)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // リーフ分割
+  std::vector<int> prevHead = treeInfo.head;
+  cpm_VoxelInfoLMR::PartitionLeaf(nRank, treeInfo, leafWeight, cutTol, partInfo);
+  lmrInfo.prevHead = prevHead;
+  lmrInfo.adaptSrc.clear();
+  lmrInfo.adaptOp.clear();
+  lmrInfo.prevChildId.clear();
+  if( treeInfo.head == prevHead )
+  {
+    // 分割が変わらない
+    return CPM_SUCCESS;
+  }
+
+  // 新しい担当リーフのVOXEL空間情報を生成
+  LeafMap leafMap;
+  if( (ret = cpm_VoxelInfoLMR::CreateLeafMap(comm, treeInfo, leafMap)) != CPM_SUCCESS )
+  {
+    for( LeafMap::iterator it=leafMap.begin();it!=leafMap.end();it++ )
+    {
+      delete it->second;
+    }
+    treeInfo.head = prevHead;
+    lmrInfo.prevHead.clear();
+    return ret;
+  }
+
+  // VOXEL空間マップを置き換え
+  LeafMap &oldMap = itV->second;
+  for( LeafMap::iterator it=oldMap.begin();it!=oldMap.end();it++ )
+  {
+    delete it->second;
+  }
+  oldMap.swap(leafMap);
+
+  // 登録フィールドの仮想セルは最新でない
+  invalidateFieldComm( procGrpNo );
+
+  // LMR用の袖通信情報を再生成
+  ClearBndCommInfo( procGrpNo );
+  return SetBndCommBuffer( lmrInfo.maxVC, lmrInfo.maxN, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// LMR用のリーフの細分化、粗大化
+cpm_ErrorCode
+cpm_ParaManagerLMR::Adapt_LMR( int *leafFlag, int procGrpNo )
+{
+  cpm_ErrorCode ret = CPM_SUCCESS;
+
+  // 領域分割済みか
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  VoxelInfoMapLMR::iterator itV = m_voxelInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() || itV == m_voxelInfoMap.end() )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  stLMRDomainInfo &lmrInfo = itD->second;
+  S_LMR_TREE_INFO &treeInfo = lmrInfo.treeInfo;
+
+  // 細分化、粗大化には偶数の格子数が必要(通信、状態の変更の前に判定する)
+  const int *sz = treeInfo.domainInfo.size;
+  if( sz[0]%2 != 0 || sz[1]%2 != 0 || sz[2]%2 != 0 )
+  {
+    return CPM_ERROR_LMR_ADAPT;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm( procGrpNo );
+  if( IsCommNull( comm ) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+  int nRank, myRank;
+  MPI_Comm_size(comm, &nRank);
+  MPI_Comm_rank(comm, &myRank);
+
+  // 全リーフのフラグを収集
+  const std::vector<int> &head = treeInfo.head;
+  int numLeaf = int(treeInfo.pedigrees.size());
+  int nLocal  = head[myRank+1] - head[myRank];
+  if( nLocal > 0 && !leafFlag )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  std::vector<int> flag(numLeaf, 0);
+  std::vector<int> count(nRank);
+  for( int r=0;r<nRank;r++ )
+  {
+    count[r] = head[r+1] - head[r];
+  }
+  std::vector<int> sendFlag(leafFlag, leafFlag+nLocal);
+  sendFlag.push_back(0);
+  if( MPI_Allgatherv( &sendFlag[0], nLocal, MPI_INT, &flag[0], &count[0]
+                    , const_cast<int*>(&head[0]), MPI_INT, comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_ALLGATHERV;
+  }
+
+  // 木情報の更新
+  S_LMR_TREE_INFO newTreeInfo;
+  std::vector<int> srcLeaf, srcOp;
+  if( (ret = cpm_VoxelInfoLMR::AdaptTree(treeInfo, flag, newTreeInfo, srcLeaf, srcOp)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 実際に行う操作を返す
+  bool bAdapt = false;
+  for( int i=0;i<numLeaf;i++ )
+  {
+    if( flag[i] != 0 ) bAdapt = true;
+  }
+  for( int i=0;i<nLocal;i++ )
+  {
+    leafFlag[i] = flag[head[myRank]+i];
+  }
+
+  // 変わらない
+  lmrInfo.prevHead.clear();
+  lmrInfo.adaptSrc.clear();
+  lmrInfo.adaptOp.clear();
+  lmrInfo.prevChildId.clear();
+  if( !bAdapt )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 新しいリーフのVOXEL空間情報を生成
+  LeafMap leafMap;
+  if( (ret = cpm_VoxelInfoLMR::CreateLeafMap(comm, newTreeInfo, leafMap)) != CPM_SUCCESS )
+  {
+    for( LeafMap::iterator it=leafMap.begin();it!=leafMap.end();it++ )
+    {
+      delete it->second;
+    }
+    return ret;
+  }
+
+  // 自ランクのリーフの対応
+  const std::vector<int> &newHead = newTreeInfo.head;
+  for( int n=newHead[myRank];n<newHead[myRank+1];n++ )
+  {
+    lmrInfo.adaptSrc.push_back( srcLeaf[n] - head[myRank] );
+    lmrInfo.adaptOp.push_back( srcOp[n] );
+  }
+  for( int i=head[myRank];i<head[myRank+1];i++ )
+  {
+    const Pedigree &ped = treeInfo.pedigrees[i];
+    lmrInfo.prevChildId.push_back( ped.getLevel() > 0 ? int(ped.getChildId(ped.getLevel())) : 0 );
+  }
+
+  // 自ランクのリーフが変わらないときは配列の置き換えは不要
+  bool bLocal = false;
+  for( size_t n=0;n<lmrInfo.adaptOp.size();n++ )
+  {
+    if( lmrInfo.adaptOp[n] != 0 ) bLocal = true;
+  }
+  if( !bLocal )
+  {
+    lmrInfo.adaptSrc.clear();
+    lmrInfo.adaptOp.clear();
+    lmrInfo.prevChildId.clear();
+  }
+
+  // 木情報とVOXEL空間マップを置き換え
+  treeInfo = newTreeInfo;
+  LeafMap &oldMap = itV->second;
+  for( LeafMap::iterator it=oldMap.begin();it!=oldMap.end();it++ )
+  {
+    delete it->second;
+  }
+  oldMap.swap(leafMap);
+
+  // 登録フィールドの仮想セルは最新でない
+  invalidateFieldComm( procGrpNo );
+
+  // LMR用の袖通信情報を再生成
+  ClearBndCommInfo( procGrpNo );
+  return SetBndCommBuffer( lmrInfo.maxVC, lmrInfo.maxN, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 直前のAdapt_LMRでリーフが変わったかどうか
+bool
+cpm_ParaManagerLMR::IsLeafAdapted( int procGrpNo )
+{
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() )
+  {
+    return false;
+  }
+  return ( itD->second.adaptSrc.size() > 0 );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 直前のRebalance_LMRでリーフの担当ランクが変わったかどうか
+bool
+cpm_ParaManagerLMR::IsLeafMigrated( int procGrpNo )
+{
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() )
+  {
+    return false;
+  }
+  const stLMRDomainInfo &lmrInfo = itD->second;
+  return ( lmrInfo.prevHead.size() > 0 && lmrInfo.prevHead != lmrInfo.treeInfo.head );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ毎の配列サイズ(要素数)の取得
+size_t
+cpm_ParaManagerLMR::GetLeafArrayLength( int nmax, int vc, int procGrpNo )
+{
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() )
+  {
+    return 0;
+  }
+  const int *sz = itD->second.treeInfo.domainInfo.size;
+  return size_t(sz[0]+2*vc) * size_t(sz[1]+2*vc) * size_t(sz[2]+2*vc) * size_t(nmax);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 木情報ファイルからリーフ数を取得する
 int
@@ -185,6 +455,14 @@ cpm_ParaManagerLMR::GetNumLeaf( std::string treeFile )
    return cpm_VoxelInfoLMR::GetNumLeaf( treeFile );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 木情報ファイルからリーフ数を取得する(ランク0で読み込み、ブロードキャスト)
+int
+cpm_ParaManagerLMR::GetNumLeaf( MPI_Comm comm, std::string treeFile )
+{
+   return cpm_VoxelInfoLMR::GetNumLeaf( comm, treeFile );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 袖通信バッファサイズの取得
 size_t
@@ -234,6 +512,34 @@ cpm_ParaManagerLMR::GetBndCommBufferSize( int procGrpNo )
     }
   }
 
+  // 集約袖通信のバッファ
+  for( BndAggCommInfoMap::iterator itP=m_bndAggCommInfoMap.begin();itP!=m_bndAggCommInfoMap.end();itP++ )
+  {
+    if( procGrpNo >= 0 && itP->first != procGrpNo )
+    {
+      continue;
+    }
+    AggCommInfoMap &aggMap = itP->second;
+    for( AggCommInfoMap::iterator it=aggMap.begin();it!=aggMap.end();it++ )
+    {
+      mem += it->second.sendbuf.size() + it->second.recvbuf.size();
+    }
+  }
+
+  // 辺、頂点方向の袖通信のバッファ
+  for( BndEdgeCommInfoMap::iterator itP=m_bndEdgeCommInfoMap.begin();itP!=m_bndEdgeCommInfoMap.end();itP++ )
+  {
+    if( procGrpNo >= 0 && itP->first != procGrpNo )
+    {
+      continue;
+    }
+    EdgeCommInfoMap &edgeMap = itP->second;
+    for( EdgeCommInfoMap::iterator it=edgeMap.begin();it!=edgeMap.end();it++ )
+    {
+      mem += it->second.sendbuf.size() + it->second.recvbuf.size();
+    }
+  }
+
   mem *= sizeof(REAL_BUF_TYPE);
   return mem;
 }
@@ -253,6 +559,9 @@ cpm_ParaManagerLMR::SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo )
   const int *sz = GetLocalVoxelSize(procGrpNo);
   if( !sz ) return CPM_ERROR_BNDCOMM_VOXELSIZE;
 
+  // 袖通信情報を作り直すため、登録フィールドの仮想セルは最新でない
+  invalidateFieldComm( procGrpNo );
+
   // 隣接面方向ごとに情報を生成
   const cpm_FaceFlag face[6] = {X_MINUS, X_PLUS, Y_MINUS, Y_PLUS, Z_MINUS, Z_PLUS};
   BndCommInfoMap* pBndCommInfoMapList[6] = { &m_bndCommInfoMapMX
@@ -377,6 +686,13 @@ cpm_ParaManagerLMR::SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo )
     }
   }
 
+  // 辺、頂点方向の袖通信情報
+  cpm_ErrorCode ret = SetBndEdgeCommInfo(procGrpNo);
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
 #if 1
 fflush(stdout);
 Barrier(procGrpNo);
@@ -418,6 +734,322 @@ Barrier(procGrpNo);
   return CPM_SUCCESS;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信情報の削除
+void
+cpm_ParaManagerLMR::ClearBndCommInfo( int procGrpNo )
+{
+  BndCommInfoMap* pBndCommInfoMapList[6] = { &m_bndCommInfoMapMX
+                                           , &m_bndCommInfoMapPX
+                                           , &m_bndCommInfoMapMY
+                                           , &m_bndCommInfoMapPY
+                                           , &m_bndCommInfoMapMZ
+                                           , &m_bndCommInfoMapPZ
+                                           };
+  for( int i=0;i<6;i++ )
+  {
+    BndCommInfoMap* pBndCommInfoMap = pBndCommInfoMapList[i];
+    BndCommInfoMap::iterator itP = pBndCommInfoMap->find(procGrpNo);
+    if( itP == pBndCommInfoMap->end() )
+    {
+      continue;
+    }
+    LeafCommInfoMap &CommInfoMap = itP->second;
+    for( LeafCommInfoMap::iterator it=CommInfoMap.begin();it!=CommInfoMap.end();it++ )
+    {
+      delete it->second;
+    }
+    pBndCommInfoMap->erase(itP);
+  }
+
+  // 集約袖通信の通信相手情報
+  m_bndAggCommInfoMap.erase(procGrpNo);
+
+  // 辺、頂点方向の袖通信情報
+  m_bndEdgeCommInfoMap.erase(procGrpNo);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 指定面の袖通信情報マップの取得
+LeafCommInfoMap*
+cpm_ParaManagerLMR::FindLeafCommInfoMap( cpm_FaceFlag face, int procGrpNo )
+{
+  BndCommInfoMap *pBndCommInfoMap = NULL;
+  switch( face )
+  {
+  case X_MINUS: pBndCommInfoMap = &m_bndCommInfoMapMX; break;
+  case X_PLUS : pBndCommInfoMap = &m_bndCommInfoMapPX; break;
+  case Y_MINUS: pBndCommInfoMap = &m_bndCommInfoMapMY; break;
+  case Y_PLUS : pBndCommInfoMap = &m_bndCommInfoMapPY; break;
+  case Z_MINUS: pBndCommInfoMap = &m_bndCommInfoMapMZ; break;
+  case Z_PLUS : pBndCommInfoMap = &m_bndCommInfoMapPZ; break;
+  default     : return NULL;
+  }
+
+  BndCommInfoMap::iterator it = pBndCommInfoMap->find(procGrpNo);
+  if( it == pBndCommInfoMap->end() )
+  {
+    return NULL;
+  }
+  return &(it->second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約袖通信の通信相手情報マップの取得
+AggCommInfoMap*
+cpm_ParaManagerLMR::GetAggCommInfoMap( int procGrpNo )
+{
+  // 生成済み
+  BndAggCommInfoMap::iterator itP = m_bndAggCommInfoMap.find(procGrpNo);
+  if( itP != m_bndAggCommInfoMap.end() )
+  {
+    return &(itP->second);
+  }
+
+  // 6面の通信相手を集める
+  const cpm_FaceFlag face[6] = {X_MINUS, X_PLUS, Y_MINUS, Y_PLUS, Z_MINUS, Z_PLUS};
+  AggCommInfoMap aggMap;
+  for( int i=0;i<6;i++ )
+  {
+    LeafCommInfoMap *pCommInfoMap = FindLeafCommInfoMap(face[i], procGrpNo);
+    if( !pCommInfoMap )
+    {
+      return NULL;
+    }
+    for( LeafCommInfoMap::iterator it=pCommInfoMap->begin();it!=pCommInfoMap->end();it++ )
+    {
+      if( it->first != m_rankNo )
+      {
+        aggMap[it->first];
+      }
+    }
+  }
+
+  // 辺、頂点方向のみで隣接する通信相手
+  EdgeCommInfoMap *pEdgeMap = FindEdgeCommInfoMap(procGrpNo);
+  if( !pEdgeMap )
+  {
+    return NULL;
+  }
+  for( EdgeCommInfoMap::iterator it=pEdgeMap->begin();it!=pEdgeMap->end();it++ )
+  {
+    if( it->first != m_rankNo )
+    {
+      aggMap[it->first];
+    }
+  }
+
+  m_bndAggCommInfoMap[procGrpNo] = aggMap;
+  return &m_bndAggCommInfoMap[procGrpNo];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信情報の生成
+cpm_ErrorCode
+cpm_ParaManagerLMR::SetBndEdgeCommInfo( int procGrpNo )
+{
+  // 生成済み
+  if( m_bndEdgeCommInfoMap.find(procGrpNo) != m_bndEdgeCommInfoMap.end() )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm( procGrpNo );
+  if( IsCommNull( comm ) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+  int nRank;
+  MPI_Comm_size(comm, &nRank);
+
+  // 受信パスを通信相手ランク毎に登録(自ランクのリーフ順、方向番号順)
+  EdgeCommInfoMap edgeMap;
+  std::vector<int> leafIDs = GetLocalLeafIDs(procGrpNo);
+  for( size_t l=0;l<leafIDs.size();l++ )
+  {
+    const cpm_VoxelInfoLMR *pVoxelInfo = FindLeafVoxelInfo_byID(leafIDs[l], procGrpNo);
+    if( !pVoxelInfo )
+    {
+      return CPM_ERROR_BNDCOMM;
+    }
+    for( int d=0;d<27;d++ )
+    {
+      int num = 0;
+      const S_LMR_EDGE_NEIGHBOR *nb = pVoxelInfo->GetEdgeNeighborList(d%3-1, (d/3)%3-1, d/9-1, num);
+      for( int n=0;n<num;n++ )
+      {
+        stEdgeCommPath path;
+        path.iRecvLeafID = leafIDs[l];
+        path.iSendLeafID = nb[n].leafID;
+        path.iDir        = nb[n].dir;
+        path.iLevelDiff  = nb[n].levelDiff;
+        path.iOffset[0]  = nb[n].offset[0];
+        path.iOffset[1]  = nb[n].offset[1];
+        path.iOffset[2]  = nb[n].offset[2];
+        path.iPeriodic   = nb[n].periodic;
+        edgeMap[nb[n].rankNo].recvPath.push_back(path);
+      }
+    }
+  }
+
+  // 受信パスを送信側ランクに送り、送信パスとする(1パス8整数、自ランク宛は送らない)
+  const int nw = 8;
+  std::vector<int> scount(nRank, 0), sdispl(nRank, 0);
+  std::vector<int> rcount(nRank, 0), rdispl(nRank, 0);
+  for( EdgeCommInfoMap::iterator it=edgeMap.begin();it!=edgeMap.end();it++ )
+  {
+    if( it->first != m_rankNo )
+    {
+      scount[it->first] = nw * int(it->second.recvPath.size());
+    }
+  }
+  if( MPI_Alltoall( &scount[0], 1, MPI_INT, &rcount[0], 1, MPI_INT, comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI;
+  }
+  int ns = 0, nr = 0;
+  for( int r=0;r<nRank;r++ )
+  {
+    sdispl[r] = ns;
+    rdispl[r] = nr;
+    ns += scount[r];
+    nr += rcount[r];
+  }
+  std::vector<int> sbuf(ns+1), rbuf(nr+1);
+  for( EdgeCommInfoMap::iterator it=edgeMap.begin();it!=edgeMap.end();it++ )
+  {
+    if( it->first == m_rankNo ) continue;
+    int *p = &sbuf[sdispl[it->first]];
+    const std::vector<stEdgeCommPath> &recvPath = it->second.recvPath;
+    for( size_t n=0;n<recvPath.size();n++ )
+    {
+      const stEdgeCommPath &path = recvPath[n];
+      p[0] = path.iRecvLeafID;
+      p[1] = path.iSendLeafID;
+      p[2] = path.iDir;
+      p[3] = path.iLevelDiff;
+      p[4] = path.iOffset[0];
+      p[5] = path.iOffset[1];
+      p[6] = path.iOffset[2];
+      p[7] = path.iPeriodic;
+      p += nw;
+    }
+  }
+  if( MPI_Alltoallv( &sbuf[0], &scount[0], &sdispl[0], MPI_INT
+                   , &rbuf[0], &rcount[0], &rdispl[0], MPI_INT, comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_ALLTOALLV;
+  }
+  for( int r=0;r<nRank;r++ )
+  {
+    if( rcount[r] == 0 ) continue;
+    std::vector<stEdgeCommPath> &sendPath = edgeMap[r].sendPath;
+    const int *p = &rbuf[rdispl[r]];
+    for( int n=0;n<rcount[r]/nw;n++ )
+    {
+      stEdgeCommPath path;
+      path.iRecvLeafID = p[0];
+      path.iSendLeafID = p[1];
+      path.iDir        = p[2];
+      path.iLevelDiff  = p[3];
+      path.iOffset[0]  = p[4];
+      path.iOffset[1]  = p[5];
+      path.iOffset[2]  = p[6];
+      path.iPeriodic   = p[7];
+      sendPath.push_back(path);
+      p += nw;
+    }
+  }
+
+  m_bndEdgeCommInfoMap[procGrpNo].swap(edgeMap);
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信情報マップの取得
+EdgeCommInfoMap*
+cpm_ParaManagerLMR::FindEdgeCommInfoMap( int procGrpNo )
+{
+  BndEdgeCommInfoMap::iterator it = m_bndEdgeCommInfoMap.find(procGrpNo);
+  if( it == m_bndEdgeCommInfoMap.end() )
+  {
+    return NULL;
+  }
+  return &(it->second);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信パスの通信範囲を取得
+bool
+cpm_ParaManagerLMR::GetEdgeCommRange( const stEdgeCommPath &path, const int sz[3], int vc, int vc_comm
+                                    , int rs[3], int re[3], int so[3] )
+{
+  int ld = path.iLevelDiff;
+  int r  = 1 << (ld < 0 ? -ld : ld);
+  const int dir[3] = { path.iDir%3-1, (path.iDir/3)%3-1, path.iDir/9-1 };
+
+  // 袖の幅(粗→細は面の袖通信と同様に2^|レベル差|倍、仮想セル数まで)
+  int gc = (ld < 0) ? std::min(vc_comm*r, vc) : vc_comm;
+
+  for( int a=0;a<3;a++ )
+  {
+    int n = sz[a];
+
+    // 受信側の袖の範囲
+    int gs = (dir[a] < 0) ? -gc : ((dir[a] > 0) ? n    : 0);
+    int ge = (dir[a] < 0) ?  0  : ((dir[a] > 0) ? n+gc : n);
+
+    // 送信側リーフが覆う範囲(受信側のインデクス)
+    int ss, se;
+    if( ld <= 0 )
+    {
+      ss = path.iOffset[a] * n;
+      se = ss + r * n;
+      so[a] = -ss;
+    }
+    else
+    {
+      if( n % r != 0 )
+      {
+        return false;
+      }
+      ss = path.iOffset[a] * (n / r);
+      se = ss + n / r;
+      so[a] = -path.iOffset[a] * n;
+    }
+
+    rs[a] = std::max(gs, ss);
+    re[a] = std::min(ge, se);
+    if( rs[a] >= re[a] )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の袖通信パス毎のデータ数と先頭位置を取得
+size_t
+cpm_ParaManagerLMR::GetEdgeCommOffset( const std::vector<stEdgeCommPath> &paths, const int sz[3], int nmax
+                                     , int vc, int vc_comm, int periodicMask, std::vector<size_t> &offset )
+{
+  offset.resize(paths.size()+1);
+  offset[0] = 0;
+  for( size_t n=0;n<paths.size();n++ )
+  {
+    size_t cnt = 0;
+    int rs[3], re[3], so[3];
+    if( IsEdgeCommTarget(paths[n], periodicMask) && GetEdgeCommRange(paths[n], sz, vc, vc_comm, rs, re, so) )
+    {
+      cnt = size_t(nmax) * size_t(re[0]-rs[0]) * size_t(re[1]-rs[1]) * size_t(re[2]-rs[2]);
+    }
+    offset[n+1] = offset[n] + cnt;
+  }
+  return offset[paths.size()];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // VOXEL空間マップを検索
 const cpm_VoxelInfo*
@@ -518,6 +1150,118 @@ cpm_ParaManagerLMR::GetLocalLeafIndex_byID( int leafID, int procGrpNo )
   return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 座標の担当ランク、リーフ、ローカルインデクスの一括検索
+cpm_ErrorCode
+cpm_ParaManagerLMR::LocatePoints( int num, const double *pos, S_POINT_LOCATION *loc, int procGrpNo )
+{
+  if( num > 0 && (!pos || !loc) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 木情報
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  const S_LMR_TREE_INFO &treeInfo = itD->second.treeInfo;
+  const std::vector<int> &head = treeInfo.head;
+  const double *org = treeInfo.domainInfo.origin;
+  const double *rgn = treeInfo.domainInfo.region;
+  const int    *sz  = treeInfo.domainInfo.size;
+  // ヘッダはpacked構造体なので、ルート分割数はローカルにコピーして参照する
+  unsigned rootDims[3];
+  for( int i=0;i<3;i++ )
+  {
+    rootDims[i] = treeInfo.octHeader.rootDims[i];
+  }
+  const int maxLevel = int(treeInfo.octHeader.maxLevel);
+  if( num <= 0 )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // LinearOctree(自ランクのリーフで共有しているもの、リーフが無いときは一時的に生成)
+  const LinearOctree *octree = NULL;
+  LinearOctree *tmpOctree = NULL;
+  VoxelInfoMapLMR::iterator itV = m_voxelInfoMap.find(procGrpNo);
+  if( itV != m_voxelInfoMap.end() && !itV->second.empty() )
+  {
+    octree = itV->second.begin()->second->m_octree;
+  }
+  else
+  {
+    RootGrid *rootGrid = new RootGrid(rootDims[0], rootDims[1], rootDims[2]);
+    octree = tmpOctree = new LinearOctree(rootGrid, treeInfo.pedigrees);
+  }
+  const RootGrid *rootGrid = octree->getRootGrid();
+
+  // ルートの幅、最大レベルのリーフの分割数
+  double rootSize[3];
+  for( int i=0;i<3;i++ )
+  {
+    rootSize[i] = rgn[i] / double(rootDims[i]);
+  }
+  const unsigned nMax = 1u << maxLevel;
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for( int n=0;n<num;n++ )
+  {
+    S_POINT_LOCATION &l = loc[n];
+    l.rank = l.leaf = -1;
+    l.index[0] = l.index[1] = l.index[2] = -1;
+
+    // ルート位置と、ルート内の位置(ルート幅単位、上端は端のセルに含める)
+    int ir[3];
+    double f[3];
+    bool bOut = false;
+    for( int i=0;i<3;i++ )
+    {
+      double x = pos[n*3+i];
+      if( !(x >= org[i] && x <= org[i] + rgn[i]) )
+      {
+        bOut = true;
+        break;
+      }
+      double r = (x - org[i]) / rootSize[i];
+      ir[i] = std::min( int(r), int(rootDims[i]) - 1 );
+      f[i]  = std::min( r - double(ir[i]), 1.0 );
+    }
+    if( bOut ) continue;
+
+    // 最大レベルでの位置を含むリーフと担当ランク
+    unsigned c[3];
+    for( int i=0;i<3;i++ )
+    {
+      c[i] = std::min( unsigned(f[i] * double(nMax)), nMax - 1 );
+    }
+    int rootID = rootGrid->index2rootID(ir[0], ir[1], ir[2]);
+    int leafID = octree->findLeaf( Pedigree(maxLevel, c[0], c[1], c[2], rootID) );
+    if( leafID < 0 ) continue;
+    int rank = int(std::upper_bound(head.begin(), head.end(), leafID) - head.begin()) - 1;
+
+    // リーフ内のインデクス
+    const Pedigree &ped = treeInfo.pedigrees[leafID];
+    unsigned nl = 1u << ped.getLevel();
+    unsigned lp[3] = {ped.getX(), ped.getY(), ped.getZ()};
+    for( int i=0;i<3;i++ )
+    {
+      double t = (f[i] * double(nl) - double(lp[i])) * double(sz[i]);
+      l.index[i] = std::max( std::min( int(t), sz[i] - 1 ), 0 );
+    }
+    l.rank = rank;
+    l.leaf = leafID - head[rank];
+  }
+
+  delete tmpOctree;
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 領域分割数を取得
 const int*
@@ -678,6 +1422,20 @@ cpm_ParaManagerLMR::GetNeighborLeafList( int leafIndex, cpm_FaceFlag face, int &
   return pVoxelInfo->GetNeighborLeafList( face, num );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 指定リーフの辺、頂点方向の隣接リーフ情報を取得
+const S_LMR_EDGE_NEIGHBOR*
+cpm_ParaManagerLMR::GetEdgeNeighborList( int leafIndex, int dx, int dy, int dz, int &num, int procGrpNo )
+{
+  num = 0;
+
+  //VOXEL空間マップを検索
+  const cpm_VoxelInfoLMR *pVoxelInfo = FindLeafVoxelInfo( leafIndex, procGrpNo );
+  if( !pVoxelInfo ) return NULL;
+
+  return pVoxelInfo->GetEdgeNeighborList( dx, dy, dz, num );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 指定リーフの指定面における自リーフの周期境界の隣接リーフ番号を取得
 const int*
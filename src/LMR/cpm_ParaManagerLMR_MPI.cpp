@@ -370,3 +370,72 @@ cpm_ParaManagerLMR::PeriodicCommS4DEx( MPI_Datatype dtype, void *array, int nmax
 
   return CPM_ERROR_MPI_INVALID_DATATYPE;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフデータの移動(MPI_Datatype指定)
+cpm_ErrorCode
+cpm_ParaManagerLMR::MigrateLeafData( MPI_Datatype dtype, const void *sendArray, void *recvArray
+                                   , size_t nwLeaf, int procGrpNo )
+{
+  if( !IsLeafMigrated(procGrpNo) )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm( procGrpNo );
+  if( IsCommNull( comm ) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+  int nRank, myRank;
+  MPI_Comm_size(comm, &nRank);
+  MPI_Comm_rank(comm, &myRank);
+
+  // 再分割前後の各ランクの先頭リーフID
+  const stLMRDomainInfo &lmrInfo = m_lmrDomainInfoMap[procGrpNo];
+  const std::vector<int> &oldHead = lmrInfo.prevHead;
+  const std::vector<int> &newHead = lmrInfo.treeInfo.head;
+
+  // リーフ単位の送受信数と変位
+  //  - 送信:自ランクの再分割前の範囲と各ランクの再分割後の範囲の重なり
+  //  - 受信:各ランクの再分割前の範囲と自ランクの再分割後の範囲の重なり
+  std::vector<int> scount(nRank, 0), sdispl(nRank, 0);
+  std::vector<int> rcount(nRank, 0), rdispl(nRank, 0);
+  for( int r=0;r<nRank;r++ )
+  {
+    int sh = std::max(oldHead[myRank], newHead[r]);
+    int st = std::min(oldHead[myRank+1], newHead[r+1]);
+    if( sh < st )
+    {
+      scount[r] = st - sh;
+      sdispl[r] = sh - oldHead[myRank];
+    }
+    int rh = std::max(oldHead[r], newHead[myRank]);
+    int rt = std::min(oldHead[r+1], newHead[myRank+1]);
+    if( rh < rt )
+    {
+      rcount[r] = rt - rh;
+      rdispl[r] = rh - newHead[myRank];
+    }
+  }
+
+  // 1リーフ分のデータ型
+  MPI_Datatype leafType;
+  if( MPI_Type_contiguous( int(nwLeaf), dtype, &leafType ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI;
+  }
+  MPI_Type_commit( &leafType );
+
+  // Alltoallv
+  int iret = MPI_Alltoallv( const_cast<void*>(sendArray), &scount[0], &sdispl[0], leafType
+                          , recvArray, &rcount[0], &rdispl[0], leafType, comm );
+  MPI_Type_free( &leafType );
+  if( iret != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_ALLTOALLV;
+  }
+
+  return CPM_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManagerLMR_Particle.cpp
+ * LMRパラレルマネージャクラスの粒子移動関数ソースファイル
+ * @date   2026/10/19
+ */
+#include <stdlib.h>
+#include "cpm_ParaManagerLMR.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子の移動先ランクの判定
+cpm_ErrorCode
+cpm_ParaManagerLMR::FindParticleRank( int num, double *pos, int periodicFlag, int *rank, int procGrpNo )
+{
+  if( num > 0 && (!pos || !rank) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 木情報
+  std::map<int, stLMRDomainInfo>::iterator itD = m_lmrDomainInfoMap.find(procGrpNo);
+  if( itD == m_lmrDomainInfoMap.end() )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  const double *org = itD->second.treeInfo.domainInfo.origin;
+  const double *rgn = itD->second.treeInfo.domainInfo.region;
+
+  // 周期境界の補正(補正後も計算領域外の位置は検索しない)
+  std::vector<char> bOut(num, 0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for( int n=0;n<num;n++ )
+  {
+    double *x = &pos[n*3];
+    for( int i=0;i<3;i++ )
+    {
+      if( x[i] >= org[i] && x[i] < org[i] + rgn[i] ) continue;
+      if( periodicFlag & (1<<i) )
+      {
+        if( x[i] < org[i] )
+        {
+          // 始点のごく近くでは丸め誤差で終点に一致するので、周期的に同じ位置の始点とする
+          x[i] += rgn[i];
+          if( x[i] >= org[i] + rgn[i] ) x[i] = org[i];
+        }
+        else
+        {
+          // 終点のごく近くでは丸め誤差で始点を下回るので、始点とする
+          x[i] -= rgn[i];
+          if( x[i] < org[i] ) x[i] = org[i];
+        }
+      }
+      if( !(x[i] >= org[i] && x[i] < org[i] + rgn[i]) )
+      {
+        bOut[n] = 1;
+      }
+    }
+  }
+
+  // 担当ランク
+  std::vector<S_POINT_LOCATION> loc(num);
+  if( num > 0 )
+  {
+    cpm_ErrorCode ret = LocatePoints( num, pos, &loc[0], procGrpNo );
+    if( ret != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+  for( int n=0;n<num;n++ )
+  {
+    rank[n] = bOut[n] ? -1 : loc[n].rank;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子を送受信する隣接ランクリストの取得
+cpm_ErrorCode
+cpm_ParaManagerLMR::GetParticleNeighborRank( std::vector<int> &rankList, int periodicFlag, int procGrpNo )
+{
+  rankList.clear();
+
+  int myrank = GetMyRankID(procGrpNo);
+  if( myrank < 0 )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  VoxelInfoMapLMR::iterator itV = m_voxelInfoMap.find(procGrpNo);
+  if( itV == m_voxelInfoMap.end() )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // 自ランクの各リーフの面、辺、頂点方向の隣接ランク
+  for( LeafMap::iterator it=itV->second.begin();it!=itV->second.end();it++ )
+  {
+    const cpm_VoxelInfoLMR *pVoxelInfo = it->second;
+    for( int f=0;f<6;f++ )
+    {
+      int num = 0;
+      const int *list = pVoxelInfo->GetNeighborRankList( cpm_FaceFlag(f), num );
+      for( int n=0;n<num && list;n++ ) rankList.push_back(list[n]);
+
+      if( !(periodicFlag & (1<<(f/2))) ) continue;
+      list = pVoxelInfo->GetPeriodicRankList( cpm_FaceFlag(f), num );
+      for( int n=0;n<num && list;n++ ) rankList.push_back(list[n]);
+    }
+    for( int d=0;d<27;d++ )
+    {
+      int num = 0;
+      const S_LMR_EDGE_NEIGHBOR *nb = pVoxelInfo->GetEdgeNeighborList( d%3-1, (d/3)%3-1, d/9-1, num );
+      for( int n=0;n<num && nb;n++ )
+      {
+        // 周期境界としない軸を越える隣接は除く
+        if( nb[n].periodic & ~periodicFlag ) continue;
+        rankList.push_back(nb[n].rankNo);
+      }
+    }
+  }
+
+  // 自ランク、無効なランクを除き、昇順、重複なし
+  std::vector<int> tmp;
+  tmp.swap(rankList);
+  for( size_t n=0;n<tmp.size();n++ )
+  {
+    if( tmp[n] < 0 || tmp[n] == myrank || IsRankNull(tmp[n]) ) continue;
+    rankList.push_back(tmp[n]);
+  }
+  std::sort(rankList.begin(), rankList.end());
+  rankList.erase(std::unique(rankList.begin(), rankList.end()), rankList.end());
+
+  return CPM_SUCCESS;
+}
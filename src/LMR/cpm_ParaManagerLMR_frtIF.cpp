@@ -72,6 +72,7 @@
   #define cpm_Isend_LMR_               cpm_isend_lmr_
   #define cpm_Irecv_LMR_               cpm_irecv_lmr_
   #define cpm_Allreduce_LMR_           cpm_allreduce_lmr_
+  #define cpm_Iallreduce_LMR_          cpm_iallreduce_lmr_
   #define cpm_Gather_LMR_              cpm_gather_lmr_
   #define cpm_Allgather_LMR_           cpm_allgather_lmr_
   #define cpm_Gatherv_LMR_             cpm_gatherv_lmr_
@@ -133,6 +134,7 @@
   #define cpm_Isend_LMR_               CPM_ISEND_LMR
   #define cpm_Irecv_LMR_               CPM_IRECV_LMR
   #define cpm_Allreduce_LMR_           CPM_ALLREDUCE_LMR
+  #define cpm_Iallreduce_LMR_          CPM_IALLREDUCE_LMR
   #define cpm_Gather_LMR_              CPM_GATHER_LMR
   #define cpm_Allgather_LMR_           CPM_ALLGATHER_LMR
   #define cpm_Gatherv_LMR_             CPM_GATHERV_LMR
@@ -1788,6 +1790,41 @@ cpm_Allreduce_LMR_( void *sendbuf, void *recvbuf, int *count, int *datatype, int
   *ierr = paraMngr->Allreduce( dtype, sendbuf, recvbuf, *count, ope, *procGrpNo );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/** MPI_IallreduceのFortranインターフェイス
+ *  - MPI_IallreduceのFortranインターフェイス関数
+ *  - 完了はcpm_Wait_LMR,cpm_Waitall_LMRで待つ
+ *  @param[in]  sendbuf   送信データ
+ *  @param[out] recvbuf   受信データ
+ *  @param[in]  count     送受信データのサイズ
+ *  @param[in]  datatype  送受信データのデータタイプ(cpm_fparam.fiを参照)
+ *  @param[in]  op        オペレータ
+ *  @param[in]  procGrpNo プロセスグループ番号
+ *  @param[out] reqNo     リクエスト番号
+ *  @param[out] ierr      終了コード(0=正常終了、0以外=cpm_ErrorCodeの値)
+ */
+CPM_EXTERN
+void
+cpm_Iallreduce_LMR_( void *sendbuf, void *recvbuf, int *count, int *datatype, int *op, int *procGrpNo, int *reqNo, int *ierr )
+{
+  if( !sendbuf || !recvbuf || !count || !datatype || !op || !procGrpNo || !reqNo || !ierr )
+  {
+    if( ierr ) *ierr = CPM_ERROR_INVALID_PTR;
+    return;
+  }
+
+  // インスタンス取得
+  cpm_ParaManagerLMR *paraMngr = cpm_ParaManagerLMR::get_instance();
+  if( !paraMngr )
+  {
+    *ierr = CPM_ERROR_PM_INSTANCE;
+    return;
+  }
+
+  // cpm_Iallreduce
+  *ierr = paraMngr->cpm_Iallreduce( sendbuf, recvbuf, *count, *datatype, *op, reqNo, *procGrpNo );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /** MPI_GatherのFortranインターフェイス
  *  - MPI_GatherのFortranインターフェイス関数
@@ -21,6 +21,7 @@
  * @date   2012/05/31
  */
 #include "cpm_VoxelInfoLMR.h"
+#include <math.h>
 using namespace BCMFileIO;
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -29,6 +30,7 @@ cpm_VoxelInfoLMR::cpm_VoxelInfoLMR()
   : cpm_VoxelInfo()
 {
   m_octree = NULL;
+  m_octreeRef = NULL;
   m_neighborInfo = NULL;
   for( int m=0;m<6;m++ )
   {
@@ -41,19 +43,31 @@ cpm_VoxelInfoLMR::cpm_VoxelInfoLMR()
     }
     m_neighborLevelDiff[m] = 0;
   }
+  for( int d=0;d<28;d++ )
+  {
+    m_edgeHead[d] = 0;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // デストラクタ
 cpm_VoxelInfoLMR::~cpm_VoxelInfoLMR()
 {
+  // 木情報は同じランクのリーフで共有しているので、最後の参照で解放
+  if( m_octreeRef && --(*m_octreeRef) > 0 )
+  {
+    return;
+  }
   delete m_octree;
+  delete m_octreeRef;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // 領域分割情報の生成
 cpm_ErrorCode
-cpm_VoxelInfoLMR::Init( MPI_Comm comm, std::string treeFile, LeafMap &leafMap )
+cpm_VoxelInfoLMR::Init( MPI_Comm comm, std::string treeFile, LeafMap &leafMap
+                      , const double *leafWeight, double cutTol, S_LMR_PARTITION_INFO *partInfo
+                      , S_LMR_TREE_INFO *treeInfo )
 {
   cpm_ErrorCode ret = CPM_SUCCESS;
 
@@ -73,17 +87,11 @@ cpm_VoxelInfoLMR::Init( MPI_Comm comm, std::string treeFile, LeafMap &leafMap )
   MPI_Comm_size(comm, &nRank);
   MPI_Comm_rank(comm, &rankNo);
 
-  // 領域情報の読み込み
+  // 領域情報、木情報の読み込み(ランク0のみ読み込んでブロードキャスト)
   S_OCT_DOMAIN_INFO domainInfo;
-  if( (ret = cpm_TextParserDomainLMR::Read(treeFile, domainInfo)) != CPM_SUCCESS )
-  {
-    return ret;
-  }
-
-  // 木情報を読み込み
   BCMFileIO::OctHeader octHeader;
   std::vector<Pedigree> pedigrees;
-  if( (ret = LoadOctreeFile(domainInfo.octFile, octHeader, pedigrees)) != CPM_SUCCESS )
+  if( (ret = LoadTreeInfo(comm, treeFile, domainInfo, octHeader, pedigrees)) != CPM_SUCCESS )
   {
     return ret;
   }
@@ -108,70 +116,180 @@ if( rankNo==0 )
   }
 #endif
 
-  // 各ランクの担当リーフマップを取得
-  std::map<int,int> leafIDmap = GetLeafIDMap(nRank, (int)octHeader.numLeaf);
+  // 重みのチェック
+  if( (ret = CheckLeafWeight((int)octHeader.numLeaf, leafWeight)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 木情報
+  S_LMR_TREE_INFO tInfo;
+  S_LMR_TREE_INFO &info = treeInfo ? *treeInfo : tInfo;
+  info.domainInfo = domainInfo;
+  info.octHeader  = octHeader;
+  info.pedigrees.swap(pedigrees);
+
+  // リーフ分割
+  PartitionLeaf(nRank, info, leafWeight, cutTol, partInfo);
 
   // 各リーフの情報を生成
-  for( std::map<int,int>::iterator it=leafIDmap.begin();it!=leafIDmap.end();it++ )
+  return CreateLeafMap(comm, info, leafMap);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 重みのチェック
+cpm_ErrorCode
+cpm_VoxelInfoLMR::CheckLeafWeight( int numLeaf, const double *leafWeight )
+{
+  if( leafWeight )
   {
-    // リーフ番号
-    int leafID = it->first;
+    for( int i=0;i<numLeaf;i++ )
+    {
+      if( !(leafWeight[i] >= 0.0) )
+      {
+        return CPM_ERROR_LMR_INVALID_WEIGHT;
+      }
+    }
+  }
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ分割
+void
+cpm_VoxelInfoLMR::PartitionLeaf( int nRank, S_LMR_TREE_INFO &treeInfo, const double *leafWeight
+                               , double cutTol, S_LMR_PARTITION_INFO *partInfo )
+{
+  const BCMFileIO::OctHeader &octHeader = treeInfo.octHeader;
+  std::vector<int> &head = treeInfo.head;
 
-    // ランク番号のチェック
-    if( it->second != rankNo )
+  // 各ランクの先頭リーフID(リーフ順の重みの累積和で分割)
+  int numLeaf = (int)octHeader.numLeaf;
+  GetLeafHead(nRank, numLeaf, leafWeight, head);
+
+  // 分割位置の調整と統計情報
+  if( cutTol > 0.0 || partInfo )
+  {
+    // 全リーフの隣接リーフリスト
+    std::vector< std::vector<int> > neighbor;
     {
-      continue;
+      RootGrid *rootGrid = new RootGrid(octHeader.rootDims[0], octHeader.rootDims[1], octHeader.rootDims[2]);
+      LinearOctree *octree = new LinearOctree(rootGrid, treeInfo.pedigrees);
+      GetLeafNeighborList(octree, neighbor);
+      delete octree;
     }
 
-    // RootGrid、BCMOctreeの生成:
-    RootGrid *rootGrid = new RootGrid(octHeader.rootDims[0], octHeader.rootDims[1], octHeader.rootDims[2]);
-    BCMOctree *octree  = new BCMOctree(rootGrid, pedigrees);
-    if( !octree )
+    // ランク間の隣接リーフ面が減るように分割位置を調整
+    if( cutTol > 0.0 )
     {
-      return CPM_ERROR_LMR_INVALID_OCTFILE;
+      RefineLeafHead(neighbor, leafWeight, cutTol, head);
     }
 
-    // 自身の担当リーフを決定
-    std::vector<Node*> &leafNodeArray = octree->getLeafNodeArray();
-    Node *node = leafNodeArray[leafID];
+    // 統計情報
+    if( partInfo )
+    {
+      GetPartitionInfo(neighbor, leafWeight, head, *partInfo);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフ分割結果から自ランクのリーフ毎のVOXEL空間情報を生成
+cpm_ErrorCode
+cpm_VoxelInfoLMR::CreateLeafMap( MPI_Comm comm, const S_LMR_TREE_INFO &treeInfo, LeafMap &leafMap )
+{
+  cpm_ErrorCode ret = CPM_SUCCESS;
+
+  // 入力チェック
+  if( IsCommNull(comm) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+
+  // ランク数、ランク番号
+  int nRank, rankNo;
+  MPI_Comm_size(comm, &nRank);
+  MPI_Comm_rank(comm, &rankNo);
+  if( (int)treeInfo.head.size() != nRank+1 )
+  {
+    return CPM_ERROR_LMR_INVALID_OCTFILE;
+  }
+
+  const BCMFileIO::OctHeader &octHeader = treeInfo.octHeader;
+  const std::vector<Pedigree> &pedigrees = treeInfo.pedigrees;
+  S_OCT_DOMAIN_INFO domainInfo = treeInfo.domainInfo;
+
+  // 各ランクの担当リーフマップを取得
+  std::map<int,int> leafIDmap = GetLeafIDMap(treeInfo.head);
+
+  // 自ランクの担当リーフ
+  std::vector<int> localLeafID;
+  for( std::map<int,int>::iterator it=leafIDmap.begin();it!=leafIDmap.end();it++ )
+  {
+    if( it->second == rankNo )
+    {
+      localLeafID.push_back(it->first);
+    }
+  }
+  int nLocal = int(localLeafID.size());
+  if( nLocal == 0 )
+  {
+    return ret;
+  }
+
+  // RootGrid、LinearOctreeの生成(自ランクのリーフで共有する)
+  RootGrid *rootGrid = new RootGrid(octHeader.rootDims[0], octHeader.rootDims[1], octHeader.rootDims[2]);
+  LinearOctree *octree = new LinearOctree(rootGrid, pedigrees);
+  int *octreeRef = new int(nLocal);
 
 #ifdef _DEBUG
 if( rankNo==0 )
 {
   std::cout << "*** pedigree info @ octree" << std::endl;
-  for( size_t i=0;i<leafNodeArray.size();i++ )
+  for( int i=0;i<octree->getNumLeafNode();i++ )
   {
-    int BlockID = leafNodeArray[i]->getBlockID();
-    Vec3d org = octree->getOrigin(leafNodeArray[i]);
-    std::cout << leafNodeArray[i]->getPedigree() << " , "
+    int BlockID = i;
+    Vec3d org = octree->getOrigin(i);
+    std::cout << octree->getPedigree(i) << " , "
               << "org=(" <<org[0] << "," << org[1] << "," << org[2] << ")" << " , "
               << "blocID=" << BlockID
               << std::endl;
   }
 }
-std::cout << "*** Node @ " << rankNo << node->getPedigree() << std::endl;
+#endif
+
+  // 各リーフの情報を生成(隣接探索はハッシュ検索のみなのでリーフ毎に並列化)
+  std::vector<cpm_VoxelInfoLMR*> voxelInfos(nLocal);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,16)
+#endif
+  for( int l=0;l<nLocal;l++ )
+  {
+    // 自身の担当リーフを決定
+    int leafID = localLeafID[l];
+
+#ifdef _DEBUG
+std::cout << "*** Node @ " << rankNo << octree->getPedigree(leafID) << std::endl;
 #endif
 
     // VoxelInfoの生成
     cpm_VoxelInfoLMR *voxelInfo = new cpm_VoxelInfoLMR();
-    if( !voxelInfo )
-    {
-      return CPM_ERROR_INVALID_PTR;
-    }
     voxelInfo->m_comm = comm;
     voxelInfo->m_nRank = nRank;
     voxelInfo->m_rankNo = rankNo;
     voxelInfo->m_leafID = leafID;
     voxelInfo->m_octHeader = octHeader;
     voxelInfo->m_octree = octree;
-    voxelInfo->m_node = node;
+    voxelInfo->m_octreeRef = octreeRef;
 
     // 領域情報のセット
-    voxelInfo->SetGlobaliDomainInfo( domainInfo );
-    voxelInfo->SetLocalDomainInfo( domainInfo );
+    S_OCT_DOMAIN_INFO dInfo = domainInfo;
+    voxelInfo->SetGlobaliDomainInfo( dInfo );
+    voxelInfo->SetLocalDomainInfo( dInfo );
 
     // 隣接情報の取得
     voxelInfo->SetNeighborInfo(leafIDmap);
+    voxelInfo->SetEdgeNeighborInfo(leafIDmap);
 
 #ifdef _DEBUG
 {
@@ -180,8 +298,13 @@ std::cout << "*** Node @ " << rankNo << node->getPedigree() << std::endl;
 }
 #endif
 
-    // マップに追加
-    leafMap.insert(std::make_pair(leafID, voxelInfo));
+    voxelInfos[l] = voxelInfo;
+  }
+
+  // マップに追加
+  for( int l=0;l<nLocal;l++ )
+  {
+    leafMap.insert(std::make_pair(localLeafID[l], voxelInfos[l]));
   }
 
 #ifdef _DEBUG
@@ -204,6 +327,115 @@ std::cout << "*** Node @ " << rankNo << node->getPedigree() << std::endl;
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// 領域情報と木情報の読み込み(ランク0で読み込み、全ランクにブロードキャスト)
+cpm_ErrorCode
+cpm_VoxelInfoLMR::LoadTreeInfo( MPI_Comm comm, std::string treeFile, S_OCT_DOMAIN_INFO &domainInfo
+                              , OctHeader &header, std::vector<Pedigree> &pedigrees )
+{
+  cpm_ErrorCode ret = CPM_SUCCESS;
+
+  // 入力チェック
+  if( IsCommNull(comm) )
+  {
+    return CPM_ERROR_MPI_INVALID_COMM;
+  }
+  int rankNo;
+  MPI_Comm_rank(comm, &rankNo);
+
+  // ランク0のみファイルを読み込む
+  int iret = CPM_SUCCESS;
+  if( rankNo == 0 )
+  {
+    iret = cpm_TextParserDomainLMR::Read(treeFile, domainInfo);
+    if( iret == CPM_SUCCESS )
+    {
+      iret = LoadOctreeFile(domainInfo.octFile, header, pedigrees);
+    }
+  }
+
+  // 読み込み結果を全ランクで共有
+  if( MPI_Bcast(&iret, 1, MPI_INT, 0, comm) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_BCAST;
+  }
+  if( iret != CPM_SUCCESS )
+  {
+    return cpm_ErrorCode(iret);
+  }
+
+  // 領域情報
+  if( (ret = BcastDomainInfo(comm, domainInfo)) != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // ヘッダー(ランク0でエンディアン変換済み)
+  if( MPI_Bcast(&header, int(sizeof(OctHeader)), MPI_BYTE, 0, comm) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_BCAST;
+  }
+
+  // ぺディグリー(バイト数がintを超えないよう、ぺディグリー単位の型で送る)
+  pedigrees.resize(header.numLeaf);
+  if( header.numLeaf > 0 )
+  {
+    MPI_Datatype pedType;
+    MPI_Type_contiguous(int(sizeof(Pedigree)), MPI_BYTE, &pedType);
+    MPI_Type_commit(&pedType);
+    int err = MPI_Bcast(&pedigrees[0], int(header.numLeaf), pedType, 0, comm);
+    MPI_Type_free(&pedType);
+    if( err != MPI_SUCCESS )
+    {
+      return CPM_ERROR_MPI_BCAST;
+    }
+  }
+
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 領域情報のブロードキャスト
+cpm_ErrorCode
+cpm_VoxelInfoLMR::BcastDomainInfo( MPI_Comm comm, S_OCT_DOMAIN_INFO &domainInfo )
+{
+  // 数値
+  double dbuf[6];
+  int    ibuf[5];
+  for( int i=0;i<3;i++ )
+  {
+    dbuf[i  ] = domainInfo.origin[i];
+    dbuf[i+3] = domainInfo.region[i];
+    ibuf[i  ] = domainInfo.size[i];
+  }
+  ibuf[3] = int(domainInfo.octFile.size());
+  ibuf[4] = int(domainInfo.unitLength.size());
+  if( MPI_Bcast(dbuf, 6, MPI_DOUBLE, 0, comm) != MPI_SUCCESS ||
+      MPI_Bcast(ibuf, 5, MPI_INT   , 0, comm) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_BCAST;
+  }
+  for( int i=0;i<3;i++ )
+  {
+    domainInfo.origin[i] = dbuf[i  ];
+    domainInfo.region[i] = dbuf[i+3];
+    domainInfo.size[i]   = ibuf[i  ];
+  }
+
+  // 文字列
+  std::vector<char> cbuf(ibuf[3]+ibuf[4]+1, 0);
+  memcpy(&cbuf[0], domainInfo.octFile.c_str(), ibuf[3]);
+  memcpy(&cbuf[ibuf[3]], domainInfo.unitLength.c_str(), ibuf[4]);
+  if( MPI_Bcast(&cbuf[0], int(cbuf.size()), MPI_CHAR, 0, comm) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_BCAST;
+  }
+  domainInfo.octFile    = std::string(&cbuf[0], ibuf[3]);
+  domainInfo.unitLength = std::string(&cbuf[ibuf[3]], ibuf[4]);
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 木情報ファイルの読み込み
 cpm_ErrorCode
@@ -316,28 +548,70 @@ cpm_VoxelInfoLMR::LoadOctreeHeader( FILE *fp, OctHeader &header, bool &isNeedSwa
 // map<leafID,rankNo>
 std::map<int,int> cpm_VoxelInfoLMR::GetLeafIDMap(int nRank, int numLeaf)
 {
-  std::map<int,int> leafIDs;
+  std::vector<int> head;
+  GetLeafHead(nRank, numLeaf, NULL, head);
+  return GetLeafIDMap(head);
+}
 
-  // 各ランクのリーフ数
-  int *nLeaf = new int[nRank];
-  for( int i=0;i<nRank;i++ )
+////////////////////////////////////////////////////////////////////////////////
+// 重み付きで各ランクの先頭リーフIDを取得
+void
+cpm_VoxelInfoLMR::GetLeafHead(int nRank, int numLeaf, const double *weight, std::vector<int> &head)
+{
+  head.assign(nRank+1, 0);
+  head[nRank] = numLeaf;
+
+  // 重みの累積和
+  std::vector<double> sum(numLeaf+1, 0.0);
+  for( int i=0;weight && i<numLeaf;i++ )
   {
-    nLeaf[i] = numLeaf / nRank;
-    if( i < numLeaf%nRank )
+    sum[i+1] = sum[i] + weight[i];
+  }
+
+  // 重み無し、重みの合計が0以下、またはリーフ数が並列数より少ないときはリーフ数で均等に分割
+  if( !weight || !(sum[numLeaf] > 0.0) || numLeaf < nRank )
+  {
+    for( int i=1;i<nRank+1;i++ )
     {
-      nLeaf[i]++;
+      int nLeaf = numLeaf / nRank;
+      if( i-1 < numLeaf%nRank )
+      {
+        nLeaf++;
+      }
+      head[i] = head[i-1] + nLeaf;
     }
+    return;
   }
 
-  // 各ランクの先頭リーフID
-  int *head = new int[nRank+1];
-  head[0] = 0;
-  for( int i=1;i<nRank+1;i++ )
+  // 累積和がランク毎の目標値に最も近い位置で分割
+  //  - 各ランクが1リーフ以上を担当するように範囲を制限する
+  int b = 0;
+  for( int r=1;r<nRank;r++ )
   {
-    head[i] = head[i-1] + nLeaf[i-1];
+    double target = sum[numLeaf] * double(r) / double(nRank);
+    int lo = head[r-1] + 1;
+    int hi = numLeaf - (nRank - r);
+    b = std::max(b, lo);
+    while( b < hi && sum[b] < target )
+    {
+      b++;
+    }
+    if( b > lo && (target - sum[b-1]) <= (sum[b] - target) )
+    {
+      b--;
+    }
+    head[r] = b;
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 各ランクの先頭リーフIDからリーフマップを生成
+std::map<int,int> cpm_VoxelInfoLMR::GetLeafIDMap(const std::vector<int> &head)
+{
+  std::map<int,int> leafIDs;
 
   // マップに登録
+  int nRank = int(head.size()) - 1;
   for( int rankNo=0;rankNo<nRank;rankNo++ )
   {
     for( int leafID=head[rankNo];leafID<head[rankNo+1];leafID++ )
@@ -349,6 +623,382 @@ std::map<int,int> cpm_VoxelInfoLMR::GetLeafIDMap(int nRank, int numLeaf)
   return leafIDs;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 全リーフの隣接リーフリストを取得
+void
+cpm_VoxelInfoLMR::GetLeafNeighborList(const LinearOctree *octree, std::vector< std::vector<int> > &neighbor
+                                     , bool bPeriodic)
+{
+  int numLeaf = octree->getNumLeafNode();
+
+  // makeNeighborInfoのランク番号は使用しないので、1ランクの分割を渡す
+  Partition part(1, numLeaf);
+
+  neighbor.clear();
+  neighbor.resize(numLeaf);
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic,64)
+#endif
+  for( int i=0;i<numLeaf;i++ )
+  {
+    NeighborInfo nInfo[NUM_FACE], pInfo[NUM_FACE];
+    octree->makeNeighborInfo( i, &part, nInfo, pInfo );
+    const NeighborInfo *info = bPeriodic ? pInfo : nInfo;
+    for( int m=0;m<NUM_FACE;m++ )
+    {
+      if( info[m].isOuterBoundary() ) continue;
+      for( int n=0;n<NUM_SUBFACE;n++ )
+      {
+        int leafID = info[m].getID(Subface(n));
+        if( leafID >= 0 )
+        {
+          neighbor[i].push_back(leafID);
+        }
+      }
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ランク間の隣接リーフ面が減るように分割位置を調整
+void
+cpm_VoxelInfoLMR::RefineLeafHead(const std::vector< std::vector<int> > &neighbor, const double *weight, double tol
+                                , std::vector<int> &head)
+{
+  int nRank   = int(head.size()) - 1;
+  int numLeaf = int(neighbor.size());
+  if( nRank < 2 || numLeaf < nRank )
+  {
+    return;
+  }
+
+  // 重みの累積和(重みの合計が0以下のときは均等)
+  std::vector<double> sum(numLeaf+1, 0.0);
+  for( int i=0;i<numLeaf;i++ )
+  {
+    sum[i+1] = sum[i] + (weight ? weight[i] : 1.0);
+  }
+  if( !(sum[numLeaf] > 0.0) )
+  {
+    for( int i=0;i<numLeaf;i++ )
+    {
+      sum[i+1] = sum[i] + 1.0;
+    }
+  }
+  double limit = (1.0 + tol) * sum[numLeaf] / double(nRank);
+
+  // リーフ毎の担当ランク
+  std::vector<int> rank(numLeaf);
+  for( int r=0;r<nRank;r++ )
+  {
+    for( int i=head[r];i<head[r+1];i++ )
+    {
+      rank[i] = r;
+    }
+  }
+
+  // 分割位置毎に調整(ランクr-1とrの境界)
+  for( int r=1;r<nRank;r++ )
+  {
+    // 探索範囲(両ランクとも1リーフ以上、元の範囲の1/4まで)
+    int w  = std::max(1, (head[r+1] - head[r-1]) / 4);
+    int lo = std::max(head[r-1] + 1, head[r] - w);
+    int hi = std::min(head[r+1] - 1, head[r] + w);
+
+    // 元の位置の重みを超えない範囲で許容する
+    double lim = std::max(limit, std::max(sum[head[r]] - sum[head[r-1]], sum[head[r+1]] - sum[head[r]]));
+
+    // 探索開始位置(b=lo)での担当ランクと、探索範囲内のリーフが関わる面のうちランクが異なる面の数
+    //  - 範囲外のリーフのランクは固定なので、差分の比較にはこれで十分
+    //  - 範囲内どうしの面は1度だけ数える
+    for( int i=lo;i<hi;i++ )
+    {
+      rank[i] = r;
+    }
+    int cut = 0;
+    for( int i=lo;i<hi;i++ )
+    {
+      for( size_t n=0;n<neighbor[i].size();n++ )
+      {
+        int j = neighbor[i][n];
+        if( j >= lo && j < hi && j < i ) continue;
+        if( rank[i] != rank[j] ) cut++;
+      }
+    }
+
+    int    bBest   = head[r];
+    int    cutBest = -1;
+    double wBest   = 0.0;
+    for( int b=lo;b<=hi;b++ )
+    {
+      // 分割位置がb-1からbに移るとき、リーフb-1がランクrからr-1に移る
+      //  - 変化するのはリーフb-1の面のみなので、その面だけ数え直す
+      if( b > lo )
+      {
+        int i = b-1;
+        for( size_t n=0;n<neighbor[i].size();n++ )
+        {
+          int rj = rank[neighbor[i][n]];
+          if( rj == r )
+          {
+            cut++;
+          }
+          else if( rj == r-1 )
+          {
+            cut--;
+          }
+        }
+        rank[i] = r-1;
+      }
+
+      double w0 = sum[b] - sum[head[r-1]];
+      double w1 = sum[head[r+1]] - sum[b];
+      if( b != head[r] && (w0 > lim || w1 > lim) ) continue;
+
+      // 面の数が少ない位置、同じときは重みの差が小さい位置を選ぶ
+      double wdiff = fabs(w0 - w1);
+      if( cutBest < 0 || cut < cutBest || (cut == cutBest && wdiff < wBest) )
+      {
+        bBest   = b;
+        cutBest = cut;
+        wBest   = wdiff;
+      }
+    }
+
+    // 分割位置を更新
+    for( int i=lo;i<hi;i++ )
+    {
+      rank[i] = (i < bBest) ? r-1 : r;
+    }
+    head[r] = bBest;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 分割の統計情報を取得
+void
+cpm_VoxelInfoLMR::GetPartitionInfo(const std::vector< std::vector<int> > &neighbor, const double *weight
+                                  , const std::vector<int> &head, S_LMR_PARTITION_INFO &info)
+{
+  int nRank   = int(head.size()) - 1;
+  int numLeaf = int(neighbor.size());
+
+  // ランク毎の重み
+  std::vector<int>    rank(numLeaf);
+  std::vector<double> wRank(nRank, 0.0);
+  for( int r=0;r<nRank;r++ )
+  {
+    for( int i=head[r];i<head[r+1];i++ )
+    {
+      rank[i] = r;
+      wRank[r] += weight ? weight[i] : 1.0;
+    }
+  }
+
+  // ランク間の隣接リーフ面の数
+  std::vector<int> cutRank(nRank, 0);
+  int cut = 0;
+  for( int i=0;i<numLeaf;i++ )
+  {
+    for( size_t n=0;n<neighbor[i].size();n++ )
+    {
+      int j = neighbor[i][n];
+      if( j <= i || rank[i] == rank[j] ) continue;
+      cut++;
+      cutRank[rank[i]]++;
+      cutRank[rank[j]]++;
+    }
+  }
+
+  info.nRank       = nRank;
+  info.numLeaf     = numLeaf;
+  info.totalWeight = 0.0;
+  info.maxWeight   = wRank[0];
+  info.minWeight   = wRank[0];
+  info.maxRankCutFace = 0;
+  for( int r=0;r<nRank;r++ )
+  {
+    info.totalWeight += wRank[r];
+    info.maxWeight = std::max(info.maxWeight, wRank[r]);
+    info.minWeight = std::min(info.minWeight, wRank[r]);
+    info.maxRankCutFace = std::max(info.maxRankCutFace, cutRank[r]);
+  }
+  info.imbalance  = (info.totalWeight > 0.0) ? info.maxWeight / (info.totalWeight / double(nRank)) : 1.0;
+  info.numCutFace = cut;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// リーフの細分化、粗大化による木情報の更新
+cpm_ErrorCode
+cpm_VoxelInfoLMR::AdaptTree(const S_LMR_TREE_INFO &treeInfo, std::vector<int> &leafFlag
+                           , S_LMR_TREE_INFO &newTreeInfo, std::vector<int> &srcLeaf, std::vector<int> &srcOp)
+{
+  const std::vector<Pedigree> &ped  = treeInfo.pedigrees;
+  const std::vector<int>      &head = treeInfo.head;
+  int numLeaf = int(ped.size());
+  int nRank   = int(head.size()) - 1;
+  if( int(leafFlag.size()) != numLeaf || nRank < 1 )
+  {
+    return CPM_ERROR_LMR_ADAPT;
+  }
+
+  // リーフ毎の担当ランク
+  std::vector<int> rank(numLeaf);
+  for( int r=0;r<nRank;r++ )
+  {
+    for( int i=head[r];i<head[r+1];i++ ) rank[i] = r;
+  }
+
+  // 操作できないフラグを落とす
+  for( int i=0;i<numLeaf;i++ )
+  {
+    if( leafFlag[i] > 0 )
+    {
+      leafFlag[i] = ( ped[i].getLevel() < Pedigree::MaxLevel ) ? 1 : 0;
+    }
+    else if( leafFlag[i] < 0 )
+    {
+      leafFlag[i] = ( ped[i].getLevel() > 0 ) ? -1 : 0;
+    }
+  }
+
+  // 粗大化する兄弟グループ(リーフ順に連続した同じ親の8リーフ、同じランク)
+  //  - group[i]はグループの先頭のリーフID(グループに属さないとき-1)
+  std::vector<int> group(numLeaf, -1);
+  for( int i=0;i<numLeaf; )
+  {
+    if( leafFlag[i] >= 0 )
+    {
+      i++;
+      continue;
+    }
+    bool bGroup = ( i+8 <= numLeaf );
+    for( int n=1;n<8 && bGroup;n++ )
+    {
+      const Pedigree &p0 = ped[i];
+      const Pedigree &pn = ped[i+n];
+      bGroup = ( leafFlag[i+n] < 0 && rank[i+n] == rank[i]
+              && pn.getLevel()  == p0.getLevel()  && pn.getRootID() == p0.getRootID()
+              && (pn.getX()>>1) == (p0.getX()>>1) && (pn.getY()>>1) == (p0.getY()>>1)
+              && (pn.getZ()>>1) == (p0.getZ()>>1) );
+    }
+    if( !bGroup )
+    {
+      leafFlag[i] = 0;
+      i++;
+      continue;
+    }
+    for( int n=0;n<8;n++ ) group[i+n] = i;
+    i += 8;
+  }
+
+  // 隣接リーフとのレベル差が1以下になるように調整
+  //  - 更新前の木は2:1を満たしているので、更新前の隣接関係でレベル差を判定すればよい
+  if( numLeaf > 1 )
+  {
+    std::vector< std::vector<int> > neighbor;
+    {
+      const BCMFileIO::OctHeader &octHeader = treeInfo.octHeader;
+      RootGrid *rootGrid = new RootGrid(octHeader.rootDims[0], octHeader.rootDims[1], octHeader.rootDims[2]);
+      LinearOctree *octree = new LinearOctree(rootGrid, ped);
+      GetLeafNeighborList(octree, neighbor, true);
+      delete octree;
+    }
+
+    bool bChanged = true;
+    while( bChanged )
+    {
+      bChanged = false;
+      for( int i=0;i<numLeaf;i++ )
+      {
+        for( size_t n=0;n<neighbor[i].size();n++ )
+        {
+          int j = neighbor[i][n];
+          int lvi = int(ped[i].getLevel()) + leafFlag[i];
+          int lvj = int(ped[j].getLevel()) + leafFlag[j];
+          if( lvj - lvi <= 1 ) continue;
+
+          if( leafFlag[i] < 0 )
+          {
+            // 粗大化を取り消す
+            int g = group[i];
+            for( int m=0;m<8;m++ )
+            {
+              leafFlag[g+m] = 0;
+              group[g+m] = -1;
+            }
+          }
+          else if( ped[i].getLevel() < Pedigree::MaxLevel )
+          {
+            // 細分化を追加
+            leafFlag[i] = 1;
+          }
+          else
+          {
+            // 最大レベルのときは隣接リーフの細分化を取り消す
+            leafFlag[j] = 0;
+          }
+          bChanged = true;
+        }
+      }
+    }
+  }
+
+  // 新しいリーフのリスト
+  std::vector<Pedigree> &newPed = newTreeInfo.pedigrees;
+  std::vector<int> firstNew(numLeaf+1, 0);
+  newPed.clear();
+  srcLeaf.clear();
+  srcOp.clear();
+  unsigned maxLevel = 0;
+  for( int i=0;i<numLeaf;i++ )
+  {
+    firstNew[i] = int(newPed.size());
+    const Pedigree &p = ped[i];
+    if( leafFlag[i] > 0 )
+    {
+      // 子番号順に8リーフ
+      for( unsigned c=0;c<8;c++ )
+      {
+        newPed.push_back( Pedigree(p, c) );
+        srcLeaf.push_back( i );
+        srcOp.push_back( int(c)+1 );
+      }
+      maxLevel = std::max(maxLevel, p.getLevel()+1);
+    }
+    else if( leafFlag[i] < 0 )
+    {
+      // 兄弟の先頭の位置に親リーフ
+      if( group[i] != i ) continue;
+      newPed.push_back( Pedigree(p.getLevel()-1, p.getX()>>1, p.getY()>>1, p.getZ()>>1, p.getRootID()) );
+      srcLeaf.push_back( i );
+      srcOp.push_back( -1 );
+      maxLevel = std::max(maxLevel, p.getLevel()-1);
+    }
+    else
+    {
+      newPed.push_back( p );
+      srcLeaf.push_back( i );
+      srcOp.push_back( 0 );
+      maxLevel = std::max(maxLevel, p.getLevel());
+    }
+  }
+  firstNew[numLeaf] = int(newPed.size());
+
+  // 木情報と分割(元のリーフの担当ランクを引き継ぐ)
+  newTreeInfo.domainInfo         = treeInfo.domainInfo;
+  newTreeInfo.octHeader          = treeInfo.octHeader;
+  newTreeInfo.octHeader.numLeaf  = newPed.size();
+  newTreeInfo.octHeader.maxLevel = maxLevel;
+  newTreeInfo.head.resize(nRank+1);
+  for( int r=0;r<=nRank;r++ )
+  {
+    newTreeInfo.head[r] = firstNew[head[r]];
+  }
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // グローバルの領域情報をセット
 void
@@ -359,7 +1009,7 @@ cpm_VoxelInfoLMR::SetGlobaliDomainInfo( S_OCT_DOMAIN_INFO &domainInfo )
   m_globalDomainInfo.SetRegion( domainInfo.region );
 
   // 1ルートあたりの自身のリーフレベルでの領域分割数
-  int divNum = 1 << m_node->getLevel();
+  int divNum = 1 << m_octree->getLevel(m_leafID);
 
   // ピッチ、格子数、領域分割数(自身のリーフレベルにおける格子数、ピッチ、領域分割数とする)
   int vox[3], div[3];
@@ -384,7 +1034,7 @@ void
 cpm_VoxelInfoLMR::SetLocalDomainInfo( S_OCT_DOMAIN_INFO &domainInfo )
 {
   // 自身のぺディグリーを取得
-  const Pedigree& pedigree = m_node->getPedigree();
+  Pedigree pedigree = m_octree->getPedigree(m_leafID);
 
   // 自身のレベルでの領域分割数(1ルートあたり)
   int div = pedigree.getUpperBound();
@@ -398,7 +1048,7 @@ cpm_VoxelInfoLMR::SetLocalDomainInfo( S_OCT_DOMAIN_INFO &domainInfo )
   m_localDomainInfo.SetVoxNum(vox);
 
   // origin
-  Vec3d oct_origin = m_octree->getOrigin( m_node ); // 0.0～1.0の範囲でのリーフ原点座標
+  Vec3d oct_origin = m_octree->getOrigin( m_leafID ); // 0.0～1.0の範囲でのリーフ原点座標
   double org[3];
   for( int m=0;m<3;m++ )
   {
@@ -425,7 +1075,7 @@ cpm_VoxelInfoLMR::SetLocalDomainInfo( S_OCT_DOMAIN_INFO &domainInfo )
   // pos
   // 自身のリーフレベルでの分割位置をセット
   int pos[3];
-  int divNum = 1 << m_node->getLevel();
+  int divNum = 1 << pedigree.getLevel();
   int rootID = pedigree.getRootID();
   const RootGrid *rootGrid = m_octree->getRootGrid();
   int ix = rootGrid->rootID2indexX(rootID);
@@ -454,17 +1104,16 @@ void
 cpm_VoxelInfoLMR::SetNeighborInfo(const std::map<int,int> &leafIDmap)
 {
   Partition part(m_nRank, m_octHeader.numLeaf);
-  RootGrid *rootGrid = (RootGrid*)m_octree->getRootGrid();
 
   int cpm_face[6] = {X_MINUS, X_PLUS, Y_MINUS, Y_PLUS, Z_MINUS, Z_PLUS};
   int bcm_face[6] = {X_M    , X_P   , Y_M    , Y_P   , Z_M    , Z_P   };
 
-  // 通常の隣接情報の生成
+  // 通常の隣接情報と周期境界の隣接情報を1回の探索で生成
+  NeighborInfo nInfo[NUM_FACE], pInfo[NUM_FACE];
+  m_octree->makeNeighborInfo( m_leafID, &part, nInfo, pInfo );
+
+  // 通常の隣接情報
   {
-    rootGrid->clearPeriodicX();
-    rootGrid->clearPeriodicY();
-    rootGrid->clearPeriodicZ();
-    NeighborInfo *nInfo = m_octree->makeNeighborInfo( m_node, &part );
     for( int m=0;m<6;m++ )
     {
       // 隣接領域のレベル差
@@ -485,15 +1134,10 @@ cpm_VoxelInfoLMR::SetNeighborInfo(const std::map<int,int> &leafIDmap)
       }
       m_neighborRankID[cpm_face[m]] = m_neighborRankID_LMR[cpm_face[m]][0];
     }
-    delete [] nInfo;
   }
 
-  // 周期境界の隣接情報の生成
+  // 周期境界の隣接情報
   {
-    rootGrid->setPeriodicX();
-    rootGrid->setPeriodicY();
-    rootGrid->setPeriodicZ();
-    NeighborInfo *pInfo = m_octree->makeNeighborInfo( m_node, &part );
     for( int m=0;m<6;m++ )
     {
       // 隣接領域のレベル差
@@ -514,13 +1158,65 @@ cpm_VoxelInfoLMR::SetNeighborInfo(const std::map<int,int> &leafIDmap)
       }
       m_periodicRankID[cpm_face[m]] = m_periodicRankID_LMR[cpm_face[m]][0];
     }
-    delete [] pInfo;
   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の隣接情報の取得
+void
+cpm_VoxelInfoLMR::SetEdgeNeighborInfo(const std::map<int,int> &leafIDmap)
+{
+  m_edgeNeighbor.clear();
+
+  int level = m_octree->getLevel(m_leafID);
+  std::vector<int> leafIDs, offsets;
+  for( int d=0;d<27;d++ )
+  {
+    m_edgeHead[d] = (int)m_edgeNeighbor.size();
+
+    // 2軸以上が0以外の方向(辺12方向、頂点8方向)
+    int dir[3] = { d%3-1, (d/3)%3-1, d/9-1 };
+    int nz = (dir[0]!=0) + (dir[1]!=0) + (dir[2]!=0);
+    if( nz < 2 ) continue;
+
+    int crossMask = 0;
+    if( !m_octree->findEdgeNeighbor( m_leafID, dir, leafIDs, offsets, crossMask ) ) continue;
+
+    for( size_t n=0;n<leafIDs.size();n++ )
+    {
+      S_LMR_EDGE_NEIGHBOR nb;
+      nb.dir       = d;
+      nb.leafID    = leafIDs[n];
+      nb.rankNo    = leafIDmap.find(leafIDs[n])->second;
+      nb.levelDiff = m_octree->getLevel(leafIDs[n]) - level;
+      nb.offset[0] = offsets[3*n  ];
+      nb.offset[1] = offsets[3*n+1];
+      nb.offset[2] = offsets[3*n+2];
+      nb.periodic  = crossMask;
+      m_edgeNeighbor.push_back(nb);
+    }
+  }
+  m_edgeHead[27] = (int)m_edgeNeighbor.size();
+}
 
-  // 周期境界フラグを元に戻しておく
-  rootGrid->clearPeriodicX();
-  rootGrid->clearPeriodicY();
-  rootGrid->clearPeriodicY();
+////////////////////////////////////////////////////////////////////////////////
+// 辺、頂点方向の隣接リーフ情報を取得
+const S_LMR_EDGE_NEIGHBOR*
+cpm_VoxelInfoLMR::GetEdgeNeighborList( int dx, int dy, int dz, int &num ) const
+{
+  num = 0;
+  if( dx<-1 || dx>1 || dy<-1 || dy>1 || dz<-1 || dz>1 )
+  {
+    return NULL;
+  }
+  int d = _LMR_DIR_IDX(dx,dy,dz);
+  num = m_edgeHead[d+1] - m_edgeHead[d];
+  if( num <= 0 )
+  {
+    num = 0;
+    return NULL;
+  }
+  return &m_edgeNeighbor[m_edgeHead[d]];
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -546,6 +1242,30 @@ cpm_VoxelInfoLMR::GetNumLeaf( std::string treeFile )
   return header.numLeaf;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 木情報ファイルからリーフ数を取得する(ランク0で読み込み、ブロードキャスト)
+int
+cpm_VoxelInfoLMR::GetNumLeaf( MPI_Comm comm, std::string treeFile )
+{
+  if( IsCommNull(comm) )
+  {
+    return 0;
+  }
+  int rankNo;
+  MPI_Comm_rank(comm, &rankNo);
+
+  int numLeaf = 0;
+  if( rankNo == 0 )
+  {
+    numLeaf = GetNumLeaf(treeFile);
+  }
+  if( MPI_Bcast(&numLeaf, 1, MPI_INT, 0, comm) != MPI_SUCCESS )
+  {
+    return 0;
+  }
+  return numLeaf;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 自リーフの隣接リーフ番号を取得
 const int*
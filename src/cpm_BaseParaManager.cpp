@@ -22,10 +22,20 @@
  */
 #include "cpm_BaseParaManager.h"
 
+// CPM_PADDING_ON指定時のパディング方式(従来方式)
+CPM_PADDING cpm_BaseParaManager::m_paddingPolicy = CPM_PADDING_ODD;
+
+// パディングサイズ計算用のキャッシュ構成情報
+S_CACHE_GEOMETRY cpm_BaseParaManager::m_cacheGeom;
+bool cpm_BaseParaManager::m_cacheGeomInit = false;
+
+// 試行計測で決定したパディングサイズのマップ
+PaddingTuneMap cpm_BaseParaManager::m_padTuneMap;
+
 ////////////////////////////////////////////////////////////////////////////////
 // コンストラクタ
 cpm_BaseParaManager::cpm_BaseParaManager()
-  : cpm_Base()
+  : cpm_Base(), m_reqList( MPI_REQUEST_NULL )
 {
   // 並列数、ランク番号
   m_nRank  = 1;
@@ -41,6 +51,13 @@ cpm_BaseParaManager::cpm_BaseParaManager()
   // 定義点管理マップのクリア
   m_defPointMap.clear();
 
+  // 登録フィールドの袖通信の統計
+  m_fieldCommCount = 0;
+  m_fieldSkipCount = 0;
+
+  // 隣接ランク以外への粒子移動モード
+  m_bParticleFar = false;
+
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -360,15 +377,81 @@ cpm_BaseParaManager::GetPaddingSize1D( const int size, const int vc )
 #define _ALL_DIM_PAD_
 ////////////////////////////////////////////////////////////////////////////////
 // パディングサイズ取得処理(静的関数)
-// 暫定対応として、1次元目(最内ループ)のみを偶数のときに+1するものとする
 void
-cpm_BaseParaManager::GetPaddingSize( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax )
+cpm_BaseParaManager::GetPaddingSize( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax
+                                   , CPM_PADDING padding, size_t esize )
 {
   if( atype==CPM_ARRAY_V3D || atype==CPM_ARRAY_V3DEX )
   {
     nmax = 3;
   }
 
+  int npad = (atype==CPM_ARRAY_S3D) ? 3 : 4;
+  for( int i=0;i<npad;i++ ) pad_size[i] = 0;
+
+  // パディング方式
+  if( padding == CPM_PADDING_ON )
+  {
+    padding = m_paddingPolicy;
+  }
+  if( padding == CPM_PADDING_OFF )
+  {
+    return;
+  }
+
+  // キャッシュ構成に基づく方式
+  // (S3DはS4D(nmax=1)、V3DはS4D(nmax=3)としてAlloc*と同じ結果にする)
+  if( padding == CPM_PADDING_CACHE || padding == CPM_PADDING_AUTO )
+  {
+    CPM_ARRAY_SHAPE at = (atype==CPM_ARRAY_V3DEX || atype==CPM_ARRAY_S4DEX) ? CPM_ARRAY_S4DEX : CPM_ARRAY_S4D;
+    if( atype==CPM_ARRAY_S3D ) nmax = 1;
+
+    // 決定済みの配列形状は同じ結果を返す
+    // (配列確保時と袖通信時でパディングサイズが変わらないよう、再計算しない)
+    std::vector<int> key(8);
+    key[0] = int(padding);
+    key[1] = int(at);
+    key[2] = size[0];
+    key[3] = size[1];
+    key[4] = size[2];
+    key[5] = vc;
+    key[6] = nmax;
+    key[7] = int(esize);
+    std::vector<int> psz;
+#ifdef _OPENMP
+#pragma omp critical (cpm_padTuneMap)
+#endif
+    {
+      PaddingTuneMap::iterator it = m_padTuneMap.find(key);
+      if( it != m_padTuneMap.end() ) psz = it->second;
+    }
+
+    if( psz.empty() )
+    {
+      psz.resize(4, 0);
+      if( padding == CPM_PADDING_CACHE )
+      {
+        GetPaddingSizeCache( at, size, vc, &psz[0], nmax, esize );
+      }
+      else
+      {
+        GetPaddingSizeAuto( at, size, vc, &psz[0], nmax, esize );
+      }
+
+      // 他スレッドが先に登録したときはその結果を使う
+#ifdef _OPENMP
+#pragma omp critical (cpm_padTuneMap)
+#endif
+      {
+        psz = m_padTuneMap.insert( std::make_pair(key, psz) ).first->second;
+      }
+    }
+    for( int i=0;i<npad;i++ ) pad_size[i] = psz[i];
+    return;
+  }
+
+  // 偶数のときに+1する方式
+  // 暫定対応として、1次元目(最内ループ)のみを偶数のときに+1するものとする
   switch( atype )
   {
   case CPM_ARRAY_S3D:
@@ -404,7 +487,337 @@ cpm_BaseParaManager::GetPaddingSize( CPM_ARRAY_SHAPE atype, const int *size, con
     pad_size[3] = GetPaddingSize1D( size[2], vc );
 #endif
     break;
+  default:
+    break;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// パディング方式の設定(静的関数)
+cpm_ErrorCode
+cpm_BaseParaManager::SetPaddingPolicy( CPM_PADDING policy )
+{
+  if( policy != CPM_PADDING_ODD && policy != CPM_PADDING_CACHE && policy != CPM_PADDING_AUTO )
+  {
+    return CPM_ERROR_INVALID_PADDING;
+  }
+  m_paddingPolicy = policy;
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// パディング方式の取得(静的関数)
+CPM_PADDING
+cpm_BaseParaManager::GetPaddingPolicy()
+{
+  return m_paddingPolicy;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// キャッシュ構成情報の設定(静的関数)
+void
+cpm_BaseParaManager::SetCacheGeometry( const S_CACHE_GEOMETRY &geom )
+{
+  m_cacheGeom     = geom;
+  m_cacheGeomInit = true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// キャッシュ構成情報の取得(静的関数)
+const S_CACHE_GEOMETRY&
+cpm_BaseParaManager::GetCacheGeometry()
+{
+  if( !m_cacheGeomInit )
+  {
+    DetectCacheGeometry( m_cacheGeom );
+    m_cacheGeomInit = true;
+  }
+  return m_cacheGeom;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// キャッシュ構成情報の検出(静的関数)
+bool
+cpm_BaseParaManager::DetectCacheGeometry( S_CACHE_GEOMETRY &geom )
+{
+  bool ret = false;
+#ifndef CPM_WINDOWS
+  for( int idx=0;idx<8;idx++ )
+  {
+    char path[256];
+    char type[32]  = "";
+    int  level     = 0;
+    int  line      = 0;
+    int  ways      = 0;
+    int  size      = 0;
+    char unit      = 'K';
+
+    // index毎の情報を読み込む
+    FILE *fp;
+    sprintf( path, "/sys/devices/system/cpu/cpu0/cache/index%d/type", idx );
+    if( !(fp = fopen(path, "r")) ) break;
+    if( fscanf(fp, "%31s", type) != 1 ) type[0] = '\0';
+    fclose(fp);
+    sprintf( path, "/sys/devices/system/cpu/cpu0/cache/index%d/level", idx );
+    if( (fp = fopen(path, "r")) ) { if( fscanf(fp, "%d", &level) != 1 ) level = 0; fclose(fp); }
+    sprintf( path, "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", idx );
+    if( (fp = fopen(path, "r")) ) { if( fscanf(fp, "%d", &line) != 1 ) line = 0; fclose(fp); }
+    sprintf( path, "/sys/devices/system/cpu/cpu0/cache/index%d/ways_of_associativity", idx );
+    if( (fp = fopen(path, "r")) ) { if( fscanf(fp, "%d", &ways) != 1 ) ways = 0; fclose(fp); }
+    sprintf( path, "/sys/devices/system/cpu/cpu0/cache/index%d/size", idx );
+    if( (fp = fopen(path, "r")) ) { if( fscanf(fp, "%d%c", &size, &unit) < 1 ) size = 0; fclose(fp); }
+    if( unit == 'K' ) size *= 1024;
+    if( unit == 'M' ) size *= 1024*1024;
+
+    // 命令キャッシュは除く
+    if( strcmp(type, "Instruction") == 0 ) continue;
+    if( line <= 0 || ways <= 0 || size <= 0 ) continue;
+
+    if( level == 1 )
+    {
+      geom.m_lineSize = line;
+      geom.m_l1Size   = size;
+      geom.m_l1Assoc  = ways;
+      ret = true;
+    }
+    else if( level == 2 )
+    {
+      geom.m_l2Size  = size;
+      geom.m_l2Assoc = ways;
+    }
+  }
+#endif
+  return ret;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// アドレスオフセット群のキャッシュ競合度の評価(静的関数)
+// 同一セットに対応するオフセットの組の数を重み付けで数える
+long long
+cpm_BaseParaManager::EvalCacheConflict( const long long *offset, int noff )
+{
+  const S_CACHE_GEOMETRY &geom = GetCacheGeometry();
+  long long line  = geom.m_lineSize;
+  long long set1  = geom.L1SetStride();
+  long long set2  = geom.L2SetStride();
+  long long alias = geom.m_aliasSize;
+
+  long long score = 0;
+  for( int i=0;i<noff;i++ ){
+  for( int j=i+1;j<noff;j++ ){
+    long long d = offset[j] - offset[i];
+    if( d < 0 ) d = -d;
+    if( d < line ) continue;
+
+    // L1セット競合
+    if( set1 > line )
+    {
+      long long r = d % set1;
+      if( r < line || set1-r < line ) score += 4;
+    }
+
+    // L2セット競合
+    if( set2 > line )
+    {
+      long long r = d % set2;
+      if( r < line || set2-r < line ) score += 2;
+    }
+
+    // 4KiBエイリアシング
+    if( alias > line )
+    {
+      long long r = d % alias;
+      if( r < line || alias-r < line ) score += 1;
+    }
+  }}
+
+  return score;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// キャッシュ構成に基づくパディングサイズ取得処理(静的関数)
+void
+cpm_BaseParaManager::GetPaddingSizeCache( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax
+                                        , size_t esize )
+{
+  const S_CACHE_GEOMETRY &geom = GetCacheGeometry();
+  bool bEx = (atype == CPM_ARRAY_S4DEX);
+
+  // セルあたりのバイト数(S4DExは成分をまとめて1セルとみなす)
+  long long eb = (long long)esize;
+  if( bEx ) eb *= nmax;
+  if( eb <= 0 ) eb = 1;
+
+  long long nx = size[0] + 2*vc;
+  long long ny = size[1] + 2*vc;
+  long long nz = size[2] + 2*vc;
+
+  // ステンシルの参照幅(1～2)
+  int r = (vc < 1) ? 1 : ((vc > 2) ? 2 : vc);
+  int nr = 2*r+1;
+  long long offset[25];
+
+  // i,jパディングはj,k方向の参照行がキャッシュ上で分散するサイズを選ぶ
+  // (競合度が同じ場合は増加量の少ないもの)
+  int maxPx = int(geom.m_lineSize / eb);
+  if( maxPx < 1 ) maxPx = 1;
+  const int maxPy = 2;
+  int px = 0, py = 0;
+  long long bestScore = -1, bestInc = 0;
+  for( int ipy=0;ipy<=maxPy;ipy++ ){
+  for( int ipx=0;ipx<=maxPx;ipx++ ){
+    long long sj = (nx + ipx) * eb;
+    long long sk = (ny + ipy) * sj;
+    int noff = 0;
+    for( int b=0;b<nr;b++ ){
+    for( int a=0;a<nr;a++ ){
+      offset[noff++] = a*sj + b*sk;
+    }}
+    long long score = EvalCacheConflict( offset, noff );
+    long long inc   = (nx + ipx) * (ny + ipy) - nx * ny;
+    if( bestScore < 0 || score < bestScore || (score == bestScore && inc < bestInc) )
+    {
+      bestScore = score;
+      bestInc   = inc;
+      px = ipx;
+      py = ipy;
+    }
+  }}
+
+  // kパディングはS4Dの成分間の参照が分散するサイズを選ぶ
+  int pz = 0;
+  if( !bEx && nmax > 1 )
+  {
+    long long sk = (nx + px) * (ny + py) * eb;
+    int nc = (nmax > 16) ? 16 : nmax;
+    bestScore = -1;
+    for( int ipz=0;ipz<=2;ipz++ )
+    {
+      long long sn = (nz + ipz) * sk;
+      for( int c=0;c<nc;c++ ) offset[c] = c * sn;
+      long long score = EvalCacheConflict( offset, nc );
+      if( bestScore < 0 || score < bestScore )
+      {
+        bestScore = score;
+        pz = ipz;
+      }
+    }
+  }
+
+  // 成分方向はパディングしない
+  if( bEx )
+  {
+    pad_size[0] = 0;
+    pad_size[1] = px;
+    pad_size[2] = py;
+    pad_size[3] = pz;
   }
+  else
+  {
+    pad_size[0] = px;
+    pad_size[1] = py;
+    pad_size[2] = pz;
+    pad_size[3] = 0;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 試行計測によるパディングサイズ取得処理(静的関数)
+void
+cpm_BaseParaManager::GetPaddingSizeAuto( CPM_ARRAY_SHAPE atype, const int *size, const int vc, int *pad_size, int nmax
+                                       , size_t esize )
+{
+  bool bEx = (atype == CPM_ARRAY_S4DEX);
+
+  // 候補(パディングなし、従来方式、キャッシュ構成に基づく方式、そのi方向違い)
+  std::vector<std::vector<int> > cand;
+  std::vector<int> psz(4, 0);
+  cand.push_back(psz);
+  GetPaddingSize( atype, size, vc, &psz[0], nmax, CPM_PADDING_ODD, esize );
+  cand.push_back(psz);
+  GetPaddingSizeCache( atype, size, vc, &psz[0], nmax, esize );
+  cand.push_back(psz);
+  int ip = bEx ? 1 : 0;
+  int maxPx = int(GetCacheGeometry().m_lineSize / (esize * (bEx ? nmax : 1)));
+  for( int i=0;i<=maxPx;i++ )
+  {
+    std::vector<int> p2 = psz;
+    p2[ip] = i;
+    cand.push_back(p2);
+  }
+
+  // 候補毎に計測
+  double tmin = -1.0;
+  size_t best = 0;
+  for( size_t i=0;i<cand.size();i++ )
+  {
+    if( std::find(cand.begin(), cand.begin()+i, cand[i]) != cand.begin()+i ) continue;
+    const std::vector<int> &p = cand[i];
+    int nx = size[0] + 2*vc + p[ip];
+    int ny = size[1] + 2*vc + p[ip+1];
+    int nz = size[2] + 2*vc;
+    int nb = bEx ? nmax + p[0] : 1;
+    double t;
+    if( esize == sizeof(float) )
+    {
+      t = PaddingProbe<float>( nx, ny, nz, nb );
+    }
+    else
+    {
+      t = PaddingProbe<double>( nx, ny, nz, nb * int((esize + sizeof(double) - 1) / sizeof(double)) );
+    }
+    if( tmin < 0.0 || t < tmin )
+    {
+      tmin = t;
+      best = i;
+    }
+  }
+
+  for( int i=0;i<4;i++ ) pad_size[i] = cand[best][i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// パディングサイズの試行計測(静的関数)
+template<class T>
+double
+cpm_BaseParaManager::PaddingProbe( int nx, int ny, int nz, int nb )
+{
+  // k方向は数面のみとする
+  const int nzp = (nz < 6) ? nz : 6;
+  if( nx < 3 || ny < 3 || nzp < 3 ) return 0.0;
+
+  size_t sj = size_t(nx) * nb;
+  size_t sk = size_t(ny) * sj;
+  size_t nw = sk * nzp;
+  T *a = new T[nw];
+  T *b = new T[nw];
+  for( size_t i=0;i<nw;i++ )
+  {
+    a[i] = T(1);
+    b[i] = T(0);
+  }
+
+  // 7点ステンシルを数回適用した最短時間
+  double tmin = -1.0;
+  for( int it=0;it<5;it++ )
+  {
+    double t0 = GetTime();
+    for( int k=1;k<nzp-1;k++ ){
+    for( int j=1;j<ny-1;j++ ){
+      size_t c0 = k*sk + j*sj;
+      for( int i=1;i<nx-1;i++ ){
+        size_t c = c0 + i*nb;
+        b[c] = a[c-nb] + a[c+nb] + a[c-sj] + a[c+sj] + a[c-sk] + a[c+sk] - T(6)*a[c];
+      }
+    }}
+    double t = GetSpanTime(t0);
+    if( tmin < 0.0 || t < tmin ) tmin = t;
+    std::swap(a, b);
+  }
+
+  delete [] a;
+  delete [] b;
+  return tmin;
 }
 
 #ifdef _DEBUG
@@ -38,7 +38,7 @@ cpm_BaseParaManager::AllocDoubleS4D( int nmax, int vc, bool padding, int *pad_si
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(double) );
   }
   sz2[0] += pad_size[0];
   sz2[1] += pad_size[1];
@@ -63,7 +63,7 @@ cpm_BaseParaManager::AllocFloatS4D( int nmax, int vc, bool padding, int *pad_siz
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(float) );
   }
   sz2[0] += pad_size[0];
   sz2[1] += pad_size[1];
@@ -88,7 +88,7 @@ cpm_BaseParaManager::AllocIntS4D( int nmax, int vc, bool padding, int *pad_size,
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4D, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(int) );
   }
   sz2[0] += pad_size[0];
   sz2[1] += pad_size[1];
@@ -185,7 +185,7 @@ cpm_BaseParaManager::AllocDoubleS4DEx( int nmax, int vc, bool padding, int *pad_
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(double) );
   }
   nmax   += pad_size[0];
   sz2[0] += pad_size[1];
@@ -210,7 +210,7 @@ cpm_BaseParaManager::AllocFloatS4DEx( int nmax, int vc, bool padding, int *pad_s
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(float) );
   }
   nmax   += pad_size[0];
   sz2[0] += pad_size[1];
@@ -235,7 +235,7 @@ cpm_BaseParaManager::AllocIntS4DEx( int nmax, int vc, bool padding, int *pad_siz
   for( int i=0;i<4;i++ ) pad_size[i] = 0;
   if( padding )
   {
-    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax );
+    GetPaddingSize( CPM_ARRAY_S4DEX, sz2, vc, pad_size, nmax, CPM_PADDING_ON, sizeof(int) );
   }
   nmax   += pad_size[0];
   sz2[0] += pad_size[1];
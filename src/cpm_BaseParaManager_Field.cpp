@@ -0,0 +1,208 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_BaseParaManager_Field.cpp
+ * パラレルマネージャ基底クラスのフィールド登録関数ソースファイル
+ * @date   2026/10/19
+ */
+#include "cpm_BaseParaManager.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信の省略判定を行うフィールド(配列)の登録
+cpm_ErrorCode
+cpm_BaseParaManager::RegisterField( const void *array )
+{
+  if( !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( m_fieldMap.find(array) == m_fieldMap.end() )
+  {
+    m_fieldMap.insert( std::make_pair(array, S_FIELD_INFO()) );
+  }
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// フィールドの登録解除
+cpm_ErrorCode
+cpm_BaseParaManager::UnregisterField( const void *array )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return CPM_ERROR_FIELD_NOTREGIST;
+  }
+  m_fieldMap.erase(it);
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// フィールドの更新の通知
+cpm_ErrorCode
+cpm_BaseParaManager::MarkFieldDirty( const void *array )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return CPM_ERROR_FIELD_NOTREGIST;
+  }
+  it->second.m_version++;
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// フィールドのバージョン番号の取得
+long long
+cpm_BaseParaManager::GetFieldVersion( const void *array )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return -1;
+  }
+  return it->second.m_version;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの袖通信の統計の取得
+void
+cpm_BaseParaManager::GetFieldCommStat( long long &numComm, long long &numSkip )
+{
+  numComm = m_fieldCommCount;
+  numSkip = m_fieldSkipCount;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの袖通信の統計のリセット
+void
+cpm_BaseParaManager::ResetFieldCommStat()
+{
+  m_fieldCommCount = 0;
+  m_fieldSkipCount = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの袖通信の開始判定
+bool
+cpm_BaseParaManager::beginFieldComm( const void *array, int nmax, int vc_comm, int procGrpNo )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return false;
+  }
+  S_FIELD_INFO &info = it->second;
+  m_fieldCommCount++;
+
+  // 前回の通信からバージョンが変わっておらず、前回の通信範囲に含まれるときは省略
+  if( info.m_commVersion == info.m_version && info.m_commProcGrp == procGrpNo &&
+      info.m_commN == nmax && vc_comm <= info.m_commVC )
+  {
+    m_fieldSkipCount++;
+    info.m_bSkipped = true;
+    return true;
+  }
+
+  // 正常に完了するまでは通信済みとしない(エラー終了後の再呼び出しで通信を省略しない)
+  info.m_commVersion = -1;
+  info.m_pendVersion = info.m_version;
+  info.m_pendProcGrp = procGrpNo;
+  info.m_pendN       = nmax;
+  info.m_pendVC      = vc_comm;
+  info.m_bSkipped    = false;
+  return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの非同期袖通信の完了判定
+bool
+cpm_BaseParaManager::endFieldComm( const void *array )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return false;
+  }
+  bool bSkipped = it->second.m_bSkipped;
+  it->second.m_bSkipped = false;
+  return bSkipped;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの袖通信の完了の記録
+void
+cpm_BaseParaManager::commitFieldComm( const void *array )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(array);
+  if( it == m_fieldMap.end() )
+  {
+    return;
+  }
+  S_FIELD_INFO &info = it->second;
+  if( info.m_pendVersion < 0 )
+  {
+    return;
+  }
+  info.m_commVersion = info.m_pendVersion;
+  info.m_commProcGrp = info.m_pendProcGrp;
+  info.m_commN       = info.m_pendN;
+  info.m_commVC      = info.m_pendVC;
+  info.m_pendVersion = -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの配列の置き換え
+void
+cpm_BaseParaManager::moveField( const void *oldArray, const void *newArray )
+{
+  FieldInfoMap::iterator it = m_fieldMap.find(oldArray);
+  if( it == m_fieldMap.end() )
+  {
+    return;
+  }
+  S_FIELD_INFO info = it->second;
+  m_fieldMap.erase(it);
+  if( !newArray )
+  {
+    return;
+  }
+  info.m_commVersion = -1;
+  info.m_pendVersion = -1;
+  info.m_bSkipped    = false;
+  m_fieldMap[newArray] = info;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録フィールドの仮想セルの無効化
+void
+cpm_BaseParaManager::invalidateFieldComm( int procGrpNo )
+{
+  for( FieldInfoMap::iterator it=m_fieldMap.begin();it!=m_fieldMap.end();it++ )
+  {
+    S_FIELD_INFO &info = it->second;
+    if( info.m_commProcGrp == procGrpNo )
+    {
+      info.m_commVersion = -1;
+    }
+    if( info.m_pendProcGrp == procGrpNo )
+    {
+      info.m_pendVersion = -1;
+    }
+  }
+}
@@ -224,31 +224,24 @@ cpm_BaseParaManager::Wait( MPI_Request *request )
 cpm_ErrorCode
 cpm_BaseParaManager::Waitall( int count, MPI_Request requests[] )
 {
-  // status
-  int cnt = 0;
-  MPI_Status  *stat = new MPI_Status[count];
-  MPI_Request *req  = new MPI_Request[count];
-  for( int i=0;i<count;i++ )
+  if( count <= 0 )
   {
-    if( requests[i] != MPI_REQUEST_NULL ) req[cnt++] = requests[i];
+    return CPM_SUCCESS;
   }
-  if( cnt == 0 )
+  if( !requests )
   {
-    delete [] stat;
-    delete [] req;
-    return CPM_SUCCESS;
+    return CPM_ERROR_INVALID_PTR;
   }
 
-  // MPI_Waitall
-  if( MPI_Waitall( cnt, req, stat ) != MPI_SUCCESS )
+  // status(作業領域は再利用)
+  if( int(m_waitStat.size()) < count ) m_waitStat.resize(count);
+
+  // MPI_Waitall(MPI_REQUEST_NULLを含んだまま、その場で待つ)
+  if( MPI_Waitall( count, requests, &m_waitStat[0] ) != MPI_SUCCESS )
   {
-    delete [] stat;
-    delete [] req;
     return CPM_ERROR_MPI_WAITALL;
   }
 
-  delete [] stat;
-  delete [] req;
   return CPM_SUCCESS;
 }
 
@@ -421,6 +414,46 @@ cpm_BaseParaManager::Allreduce( MPI_Datatype dtype, void *sendbuf, void *recvbuf
   return CPM_SUCCESS;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Iallreduce(MPI_Datatype指定)
+cpm_ErrorCode
+cpm_BaseParaManager::Iallreduce( MPI_Datatype dtype, void *sendbuf, void *recvbuf, int count, MPI_Op op
+                               , MPI_Request *request, int procGrpNo )
+{
+  if( !sendbuf || !recvbuf || !request )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm(procGrpNo);
+  if( IsCommNull(comm) )
+  {
+    // プロセスグループが存在しない
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+#if defined(DISABLE_MPI) || (MPI_VERSION >= 3)
+  // MPI_Iallreduce
+  if( MPI_Iallreduce( sendbuf, recvbuf, count, dtype, op, comm, request ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLREDUCE;
+  }
+#else
+  // MPI-3未満はAllreduceで代用し、完了済みのリクエスト(MPI_PROC_NULLからの受信)を返す
+  if( MPI_Allreduce( sendbuf, recvbuf, count, dtype, op, comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLREDUCE;
+  }
+  if( MPI_Irecv( NULL, 0, MPI_BYTE, MPI_PROC_NULL, 0, comm, request ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLREDUCE;
+  }
+#endif
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Gather(MPI_Datatype指定)
 cpm_ErrorCode
@@ -566,31 +599,33 @@ cpm_BaseParaManager::cpm_Wait( int reqNo )
 cpm_ErrorCode
 cpm_BaseParaManager::cpm_Waitall( int count, int reqNoList[] )
 {
-  // MPI_Request
-  MPI_Status* stat = new MPI_Status [count];
-  MPI_Request* req = new MPI_Request[count];
-  int cnt = 0;
+  if( count <= 0 || !reqNoList )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+
+  // 登録されていないリクエスト番号があるときはエラー(wait前に判定する)
   for( int i=0;i<count;i++ )
   {
-    MPI_Request *r = m_reqList.Get( reqNoList[i] );
-    if( r )
+    if( !m_reqList.Get( reqNoList[i] ) )
     {
-      r[cnt++] = *req;
+      return CPM_ERROR_INVALID_OBJKEY;
     }
   }
-  if( cnt == 0 )
-  {
-    delete [] stat;
-    delete [] req;
-    return CPM_ERROR_INVALID_OBJKEY;
-  }
 
-  // MPI_Waitall
-  if( MPI_Waitall( cnt, req, stat ) != MPI_SUCCESS )
+  // MPI_Waitall(プール内で連続するリクエストをまとめ、プールの領域に対して直接待つ)
+  if( int(m_waitStat.size()) < count ) m_waitStat.resize(count);
+  int i0 = 0;
+  while( i0 < count )
   {
-    delete [] stat;
-    delete [] req;
-    return CPM_ERROR_MPI_WAITALL;
+    MPI_Request *r0 = m_reqList.Get( reqNoList[i0] );
+    int n = 1;
+    while( i0+n < count && m_reqList.Get( reqNoList[i0+n] ) == r0+n ) n++;
+    if( MPI_Waitall( n, r0, &m_waitStat[0] ) != MPI_SUCCESS )
+    {
+      return CPM_ERROR_MPI_WAITALL;
+    }
+    i0 += n;
   }
 
   // 削除
@@ -614,25 +649,17 @@ cpm_BaseParaManager::cpm_Isend( void *buf, int count, int datatype, int dest, in
     return CPM_ERROR_MPI_INVALID_DATATYPE;
   }
 
-  // MPI_Request
-  MPI_Request *req = m_reqList.Create();
-  if( !req )
-  {
-    return CPM_ERROR_INVALID_PTR;
-  }
-
   // Isend
-  cpm_ErrorCode ret = Isend( dtype, buf, count, dest, req, procGrpNo );
+  MPI_Request req;
+  cpm_ErrorCode ret = Isend( dtype, buf, count, dest, &req, procGrpNo );
   if( ret != MPI_SUCCESS )
   {
-    delete req;
     return ret;
   }
 
   // MPI_Requestを登録
   if( (*reqNo = m_reqList.Add(req) ) < 0 )
   {
-    delete req;
     return CPM_ERROR_REGIST_OBJKEY;
   }
 
@@ -660,13 +687,340 @@ cpm_BaseParaManager::cpm_Irecv( void *buf, int count, int datatype, int source,
   }
 
   // MPI_Requestを登録
-  MPI_Request *r = m_reqList.Create();
-  *r = req;
-  if( (*reqNo = m_reqList.Add(r) ) < 0 )
+  if( (*reqNo = m_reqList.Add(req) ) < 0 )
   {
-    delete r;
     return CPM_ERROR_REGIST_OBJKEY;
   }
 
   return CPM_SUCCESS;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// cpm_Iallreduce
+cpm_ErrorCode
+cpm_BaseParaManager::cpm_Iallreduce( void *sendbuf, void *recvbuf, int count, int datatype, int op
+                                   , int *reqNo, int procGrpNo )
+{
+  if( !reqNo )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // MPI_Datatype
+  MPI_Datatype dtype = cpm_BaseParaManager::GetMPI_Datatype( datatype );
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  // MPI_Op
+  MPI_Op ope = cpm_BaseParaManager::GetMPI_Op( op );
+  if( ope == MPI_OP_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_OPERATOR;
+  }
+
+  // Iallreduce
+  MPI_Request req;
+  cpm_ErrorCode ret = Iallreduce( dtype, sendbuf, recvbuf, count, ope, &req, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // MPI_Requestを登録
+  if( (*reqNo = m_reqList.Add(req) ) < 0 )
+  {
+    return CPM_ERROR_REGIST_OBJKEY;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子データの隣接ランク間の送受信
+cpm_ErrorCode
+cpm_BaseParaManager::exchangeParticles( const std::vector<int> &rankList, const std::vector<int> &scnt
+                                      , const char *sendBuf, size_t esize, std::vector<char> &recvBuf
+                                      , int &nrecv, int procGrpNo )
+{
+  nrecv = 0;
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm(procGrpNo);
+  if( IsCommNull(comm) )
+  {
+    // プロセスグループが存在しない
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  const int nnbr = int(rankList.size());
+  if( nnbr == 0 )
+  {
+    return CPM_SUCCESS;
+  }
+  int tag = 2;
+  std::vector<MPI_Request> req(nnbr*2, MPI_REQUEST_NULL);
+  std::vector<MPI_Status>  stat(nnbr*2);
+
+  // 粒子数の送受信
+  std::vector<int> rcnt(nnbr, 0);
+  std::vector<int> snum(scnt.begin(), scnt.end());
+  for( int n=0;n<nnbr;n++ )
+  {
+    if( MPI_Irecv( &rcnt[n], 1, MPI_INT, rankList[n], tag, comm, &req[n] ) != MPI_SUCCESS )
+    {
+      return CPM_ERROR_MPI_IRECV;
+    }
+  }
+  for( int n=0;n<nnbr;n++ )
+  {
+    if( MPI_Isend( &snum[n], 1, MPI_INT, rankList[n], tag, comm, &req[nnbr+n] ) != MPI_SUCCESS )
+    {
+      return CPM_ERROR_MPI_ISEND;
+    }
+  }
+  if( MPI_Waitall( nnbr*2, &req[0], &stat[0] ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_WAITALL;
+  }
+
+  // 受信バッファ
+  size_t ntotal = 0;
+  for( int n=0;n<nnbr;n++ )
+  {
+    ntotal += size_t(rcnt[n]);
+  }
+  recvBuf.resize(ntotal * esize);
+
+  // 粒子1個の転送用データ型
+  MPI_Datatype dtype = MPI_DATATYPE_NULL;
+  if( MPI_Type_contiguous( int(esize), MPI_BYTE, &dtype ) != MPI_SUCCESS ||
+      MPI_Type_commit( &dtype ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_TYPE_CREATE;
+  }
+
+  // 粒子データの送受信
+  cpm_ErrorCode ret = CPM_SUCCESS;
+  size_t roff = 0;
+  size_t soff = 0;
+  for( int n=0;n<nnbr;n++ )
+  {
+    req[n] = req[nnbr+n] = MPI_REQUEST_NULL;
+    if( rcnt[n] > 0 &&
+        MPI_Irecv( &recvBuf[roff * esize], rcnt[n], dtype, rankList[n], tag, comm, &req[n] ) != MPI_SUCCESS )
+    {
+      ret = CPM_ERROR_MPI_IRECV;
+      break;
+    }
+    roff += size_t(rcnt[n]);
+  }
+  for( int n=0;n<nnbr && ret==CPM_SUCCESS;n++ )
+  {
+    if( scnt[n] > 0 &&
+        MPI_Isend( (void*)(sendBuf + soff * esize), scnt[n], dtype, rankList[n], tag, comm, &req[nnbr+n] ) != MPI_SUCCESS )
+    {
+      ret = CPM_ERROR_MPI_ISEND;
+      break;
+    }
+    soff += size_t(scnt[n]);
+  }
+  if( ret == CPM_SUCCESS && MPI_Waitall( nnbr*2, &req[0], &stat[0] ) != MPI_SUCCESS )
+  {
+    ret = CPM_ERROR_MPI_WAITALL;
+  }
+  MPI_Type_free( &dtype );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  nrecv = int(ntotal);
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 要素単位のAlltoallv
+cpm_ErrorCode
+cpm_BaseParaManager::alltoallvElement( const char *sendBuf, const std::vector<int> &scnt, size_t esize
+                                     , std::vector<char> &recvBuf, std::vector<int> &rcnt, int procGrpNo )
+{
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm(procGrpNo);
+  if( IsCommNull(comm) )
+  {
+    // プロセスグループが存在しない
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  int nrank = GetNumRank(procGrpNo);
+  if( int(scnt.size()) != nrank )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 受信要素数
+  std::vector<int> snum(scnt.begin(), scnt.end());
+  rcnt.assign(nrank, 0);
+  if( MPI_Alltoall( &snum[0], 1, MPI_INT, &rcnt[0], 1, MPI_INT, comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_ALLTOALL;
+  }
+
+  // 変位(要素単位)
+  std::vector<int> sdsp(nrank, 0), rdsp(nrank, 0);
+  size_t nr = 0;
+  for( int r=1;r<nrank;r++ )
+  {
+    sdsp[r] = sdsp[r-1] + snum[r-1];
+    rdsp[r] = rdsp[r-1] + rcnt[r-1];
+  }
+  nr = size_t(rdsp[nrank-1]) + size_t(rcnt[nrank-1]);
+  recvBuf.resize(nr * esize);
+
+  // 1要素の転送用データ型
+  MPI_Datatype dtype = MPI_DATATYPE_NULL;
+  if( MPI_Type_contiguous( int(esize), MPI_BYTE, &dtype ) != MPI_SUCCESS ||
+      MPI_Type_commit( &dtype ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_TYPE_CREATE;
+  }
+
+  // Alltoallv
+  int iret = MPI_Alltoallv( (void*)sendBuf, &snum[0], &sdsp[0], dtype
+                          , recvBuf.empty() ? NULL : &recvBuf[0], &rcnt[0], &rdsp[0], dtype, comm );
+  MPI_Type_free( &dtype );
+  if( iret != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_ALLTOALLV;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 点位置検索の問い合わせの担当ランクへの転送
+cpm_ErrorCode
+cpm_BaseParaManager::RoutePointsToOwner( int num, const double *pos, const S_POINT_LOCATION *loc
+                                       , std::vector<S_POINT_QUERY> &query, int procGrpNo )
+{
+  query.clear();
+  if( num > 0 && (!pos || !loc) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  int nrank  = GetNumRank(procGrpNo);
+  int myrank = GetMyRankID(procGrpNo);
+  if( nrank < 1 || myrank < 0 )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 担当ランク毎の点数
+  std::vector<int> scnt(nrank, 0);
+  for( int n=0;n<num;n++ )
+  {
+    int r = loc[n].rank;
+    if( r >= 0 && r < nrank ) scnt[r]++;
+  }
+
+  // 担当ランク順に詰める(ランク内は点の番号順)
+  std::vector<size_t> soff(nrank+1, 0);
+  for( int r=0;r<nrank;r++ )
+  {
+    soff[r+1] = soff[r] + size_t(scnt[r]);
+  }
+  std::vector<S_POINT_QUERY> sendQuery(soff[nrank]);
+  for( int n=0;n<num;n++ )
+  {
+    int r = loc[n].rank;
+    if( r < 0 || r >= nrank ) continue;
+    S_POINT_QUERY &q = sendQuery[soff[r]++];
+    q.pos[0]   = pos[n*3  ];
+    q.pos[1]   = pos[n*3+1];
+    q.pos[2]   = pos[n*3+2];
+    q.loc      = loc[n];
+    q.srcRank  = myrank;
+    q.srcIndex = n;
+  }
+
+  // 送受信
+  std::vector<char> recvBuf;
+  std::vector<int> rcnt;
+  cpm_ErrorCode ret = alltoallvElement( sendQuery.empty() ? NULL : (const char*)&sendQuery[0], scnt
+                                      , sizeof(S_POINT_QUERY), recvBuf, rcnt, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+  size_t nrecv = recvBuf.size() / sizeof(S_POINT_QUERY);
+  query.resize(nrecv);
+  if( nrecv > 0 )
+  {
+    memcpy( &query[0], &recvBuf[0], recvBuf.size() );
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 問い合わせに対する値の問い合わせ元への返送
+cpm_ErrorCode
+cpm_BaseParaManager::returnPointValues( const std::vector<S_POINT_QUERY> &query, const char *value, size_t vsize
+                                      , char *result, int num, int procGrpNo )
+{
+  int nrank = GetNumRank(procGrpNo);
+  if( nrank < 1 )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 問い合わせ元のランク毎の値の数と、送信バッファ(値、点の番号の組)
+  const size_t esize = vsize + sizeof(int);
+  const size_t nq = query.size();
+  std::vector<int> scnt(nrank, 0);
+  for( size_t q=0;q<nq;q++ )
+  {
+    int r = query[q].srcRank;
+    if( r < 0 || r >= nrank )
+    {
+      return CPM_ERROR_INVALID_PTR;
+    }
+    scnt[r]++;
+  }
+  std::vector<size_t> soff(nrank+1, 0);
+  for( int r=0;r<nrank;r++ )
+  {
+    soff[r+1] = soff[r] + size_t(scnt[r]);
+  }
+  std::vector<char> sendBuf(nq * esize);
+  for( size_t q=0;q<nq;q++ )
+  {
+    char *p = &sendBuf[(soff[query[q].srcRank]++) * esize];
+    memcpy( p, &query[q].srcIndex, sizeof(int) );
+    memcpy( p + sizeof(int), value + q * vsize, vsize );
+  }
+
+  // 送受信
+  std::vector<char> recvBuf;
+  std::vector<int> rcnt;
+  cpm_ErrorCode ret = alltoallvElement( sendBuf.empty() ? NULL : &sendBuf[0], scnt, esize
+                                      , recvBuf, rcnt, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 点の番号の位置に展開
+  size_t nrecv = recvBuf.size() / esize;
+  for( size_t q=0;q<nrecv;q++ )
+  {
+    const char *p = &recvBuf[q * esize];
+    int idx;
+    memcpy( &idx, p, sizeof(int) );
+    if( idx < 0 || idx >= num ) continue;
+    memcpy( result + size_t(idx) * vsize, p + sizeof(int), vsize );
+  }
+
+  return CPM_SUCCESS;
+}
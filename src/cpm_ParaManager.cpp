@@ -81,6 +81,10 @@ cpm_ParaManager::cpm_ParaManager()
 
   // 袖通信バッファ情報のクリア
   m_bndCommInfoMap.clear();
+
+  // 並列ファイル入出力のヒント(MPI実装のデフォルト)
+  m_fieldIOCbNodes = 0;
+  m_fieldIOCbBufferSize = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -109,6 +113,39 @@ cpm_ParaManager::~cpm_ParaManager()
     }
     m_bndCommInfoMap.clear();
   }
+
+  // データ再配置プランの削除、クリア
+  for( size_t i=0;i<m_redistPlanList.size();i++ )
+  {
+    if( m_redistPlanList[i] ) delete m_redistPlanList[i];
+  }
+  m_redistPlanList.clear();
+
+  // マルチグリッドの粗視化レベル情報の削除、クリア
+  for( size_t i=0;i<m_mgLevelList.size();i++ )
+  {
+    if( m_mgLevelList[i] ) delete m_mgLevelList[i];
+  }
+  m_mgLevelList.clear();
+
+  // ペンシル転置プランの削除、クリア(MPI_Finalizeの前に解放する)
+  {
+    std::map<int, S_PENCIL_PLAN*>::iterator it  = m_pencilPlanMap.begin();
+    std::map<int, S_PENCIL_PLAN*>::iterator ite = m_pencilPlanMap.end();
+    for( ; it!=ite; it++ )
+    {
+      S_PENCIL_PLAN *plan = it->second;
+      if( !plan ) continue;
+      std::map<size_t, MPI_Datatype>::iterator itt = plan->m_elemType.begin();
+      for( ; itt!=plan->m_elemType.end(); itt++ )
+      {
+        MPI_Type_free( &itt->second );
+      }
+      if( !IsCommNull(plan->m_comm) ) MPI_Comm_free( &plan->m_comm );
+      delete plan;
+    }
+    m_pencilPlanMap.clear();
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -856,7 +893,7 @@ cpm_ParaManager::GetBndIndexExtGc( int id, int *array, int vc
 
   // パディングサイズ
   int pad_size[3];
-  GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size);
+  GetPaddingSize(CPM_ARRAY_S3D, sz, vc, pad_size, 0, padding, sizeof(int));
 
   // 共有関数
   return GetBndIndexExtGc( id, array
@@ -961,6 +998,88 @@ cpm_ParaManager::Global2LocalIndex( int iG, int jG, int kG, int &iL, int &jL, in
   return true;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 座標の担当ランク、ローカルインデクスの一括検索
+cpm_ErrorCode
+cpm_ParaManager::LocatePoints( int num, const double *pos, S_POINT_LOCATION *loc, int procGrpNo )
+{
+  if( num > 0 && (!pos || !loc) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 領域情報
+  const cpm_VoxelInfoCART *pVoxelInfo = (const cpm_VoxelInfoCART*)FindVoxelInfo( procGrpNo );
+  if( !pVoxelInfo || !pVoxelInfo->m_rankMap )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  const int    *div  = pVoxelInfo->GetDivNum();
+  const int    *gvox = pVoxelInfo->GetGlobalVoxelSize();
+  const double *gorg = pVoxelInfo->GetGlobalOrigin();
+  const double *grgn = pVoxelInfo->GetGlobalRegion();
+  const double *pch  = pVoxelInfo->GetPitch();
+  const int    *rankMap = pVoxelInfo->m_rankMap;
+
+  // 各軸の基準VOXEL数と余り(余りの分は先頭の領域に1つずつ割り当てられている)
+  int nbase[3], amari[3];
+  for( int i=0;i<3;i++ )
+  {
+    nbase[i] = gvox[i] / div[i];
+    amari[i] = gvox[i] % div[i];
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for( int n=0;n<num;n++ )
+  {
+    S_POINT_LOCATION &l = loc[n];
+    int q[3];
+    bool bOut = false;
+    for( int i=0;i<3;i++ )
+    {
+      // 全体のVOXELインデクス(上端は端のセルに含める)
+      double x = pos[n*3+i];
+      if( !(x >= gorg[i] && x <= gorg[i] + grgn[i]) )
+      {
+        bOut = true;
+        break;
+      }
+      int g = std::min( int((x - gorg[i]) / pch[i]), gvox[i] - 1 );
+
+      // 分割位置と領域内のインデクス
+      int nb = amari[i] * (nbase[i] + 1);
+      if( g < nb )
+      {
+        q[i] = g / (nbase[i] + 1);
+        l.index[i] = g - q[i] * (nbase[i] + 1);
+      }
+      else
+      {
+        q[i] = amari[i] + (g - nb) / nbase[i];
+        l.index[i] = g - nb - (q[i] - amari[i]) * nbase[i];
+      }
+    }
+
+    // 担当ランク(不活性領域は計算領域外として扱う)
+    int rank = -1;
+    if( !bOut )
+    {
+      rank = rankMap[_IDX_S3D(q[0],q[1],q[2],div[0],div[1],div[2],0)];
+      if( IsRankNull(rank) ) rank = -1;
+    }
+    l.rank = rank;
+    l.leaf = (rank < 0) ? -1 : 0;
+    if( rank < 0 )
+    {
+      l.index[0] = l.index[1] = l.index[2] = -1;
+    }
+  }
+
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 自ランクの境界が外部境界かどうかを判定
 bool
@@ -987,12 +1106,164 @@ cpm_ParaManager::IsInnerBoundary( cpm_FaceFlag face, int procGrpNo )
   return pVoxelInfo->IsInnerBoundary(face);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// 逆方向袖通信の隣接ランク番号と送信、受信、仮想セルの領域を取得
+cpm_ErrorCode
+cpm_ParaManager::getReverseInfo( const int sz[3], int vc_comm, cpm_DirFlag dir, int periodicFlag
+                               , int &nIDm, int &nIDp, int sbox[2][6], int rbox[2][6], int gbox[2][6]
+                               , int procGrpNo )
+{
+  // 隣接ランク番号(周期境界のときは周期境界の隣接ランク番号で置き換える)
+  const int *nID = GetNeighborRankID(procGrpNo);
+  if( !nID )
+  {
+    return CPM_ERROR_GET_NEIGHBOR_RANK;
+  }
+  const int *pID = GetPeriodicRankID(procGrpNo);
+  if( !pID )
+  {
+    return CPM_ERROR_GET_PERIODIC_RANK;
+  }
+  const int d = int(dir);
+  nIDm = nID[2*d  ];
+  nIDp = nID[2*d+1];
+  if( periodicFlag & (1<<d) )
+  {
+    if( IsRankNull(nIDm) ) nIDm = pID[2*d  ];
+    if( IsRankNull(nIDp) ) nIDp = pID[2*d+1];
+  }
+
+  // 定義点がFDMのときは隣接ランクと共有する境界面も送受信する
+  int is = 0;
+  if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) is = 1;
+
+  // 通信面内の軸は仮想セルを含む全範囲
+  const int m  = sz[d];
+  const int gc = vc_comm;
+  for( int pm=0;pm<2;pm++ )
+  {
+    for( int i=0;i<3;i++ )
+    {
+      sbox[pm][i] = rbox[pm][i] = gbox[pm][i] = -gc;
+      sbox[pm][i+3] = rbox[pm][i+3] = gbox[pm][i+3] = sz[i] + 2*gc;
+    }
+    sbox[pm][d+3] = rbox[pm][d+3] = gc + is;
+    gbox[pm][d+3] = gc;
+  }
+
+  // マイナス側 : 仮想セル(+共有面)を送信、内部セル(+共有面)に受信値を集約
+  sbox[0][d] = -gc;
+  gbox[0][d] = -gc;
+  rbox[0][d] = 0;
+
+  // プラス側
+  sbox[1][d] = m - is;
+  gbox[1][d] = m;
+  rbox[1][d] = m - gc - is;
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 面毎の通信袖数指定の袖通信の隣接ランク番号と送信、受信領域を取得
+cpm_ErrorCode
+cpm_ParaManager::getFaceCommInfo( const int sz[3], int vc, const int vc_comm[6], cpm_DirFlag dir
+                                , int &nIDm, int &nIDp, int sbox[2][6], int rbox[2][6], int procGrpNo )
+{
+  for( int i=0;i<6;i++ )
+  {
+    if( vc_comm[i] < 0 || vc_comm[i] > vc )
+    {
+      return CPM_ERROR_BNDCOMM;
+    }
+  }
+
+  // 隣接ランク番号
+  const int *nID = GetNeighborRankID(procGrpNo);
+  if( !nID )
+  {
+    return CPM_ERROR_GET_NEIGHBOR_RANK;
+  }
+  const int d = int(dir);
+  nIDm = nID[2*d  ];
+  nIDp = nID[2*d+1];
+
+  // 定義点がFDMのときは隣接ランクと共有する境界面を除いて送信する
+  int is = 0;
+  if( GetDefPointType(procGrpNo) == CPM_DEFPOINTTYPE_FDM ) is = 1;
+
+  // 通信面内の軸は面毎の通信袖数を含む範囲
+  for( int pm=0;pm<2;pm++ )
+  {
+    for( int i=0;i<3;i++ )
+    {
+      sbox[pm][i] = rbox[pm][i] = -vc_comm[2*i];
+      sbox[pm][i+3] = rbox[pm][i+3] = sz[i] + vc_comm[2*i] + vc_comm[2*i+1];
+    }
+  }
+
+  // マイナス側 : 隣接ランクのプラス側の仮想セル分を送信、マイナス側の仮想セルに受信
+  const int m  = sz[d];
+  const int gm = vc_comm[2*d  ];
+  const int gp = vc_comm[2*d+1];
+  sbox[0][d] = is;          sbox[0][d+3] = gp;
+  rbox[0][d] = -gm;         rbox[0][d+3] = gm;
+
+  // プラス側
+  sbox[1][d] = m - gm - is; sbox[1][d+3] = gm;
+  rbox[1][d] = m;           rbox[1][d+3] = gp;
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 面毎の通信袖数の全ランクでの一致チェック
+cpm_ErrorCode
+cpm_ParaManager::checkFaceCommWidth( const int vc_comm[6], int procGrpNo )
+{
+  int wmin[6], wmax[6];
+  int w[6];
+  for( int i=0;i<6;i++ )
+  {
+    w[i] = vc_comm[i];
+  }
+  cpm_ErrorCode ret;
+  if( (ret = Allreduce( w, wmin, 6, MPI_MIN, procGrpNo )) != CPM_SUCCESS ) return ret;
+  if( (ret = Allreduce( w, wmax, 6, MPI_MAX, procGrpNo )) != CPM_SUCCESS ) return ret;
+  for( int i=0;i<6;i++ )
+  {
+    if( wmin[i] != wmax[i] )
+    {
+      return CPM_ERROR_BNDCOMM;
+    }
+  }
+  return CPM_SUCCESS;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // 袖通信バッファのセット
 cpm_ErrorCode
 cpm_ParaManager::SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo )
 {
-  if( maxVC==0 || maxN==0 )
+  size_t vc6[6] = {maxVC, maxVC, maxVC, maxVC, maxVC, maxVC};
+  return SetBndCommBuffer( vc6, maxN, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 袖通信バッファのセット(面毎の袖数指定)
+cpm_ErrorCode
+cpm_ParaManager::SetBndCommBuffer( const size_t maxVC[6], size_t maxN, int procGrpNo )
+{
+  if( !maxVC || maxN==0 )
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
+  size_t vcMax = 0;
+  for( int i=0;i<6;i++ )
+  {
+    if( maxVC[i] > vcMax ) vcMax = maxVC[i];
+  }
+  if( vcMax==0 )
   {
     return CPM_ERROR_BNDCOMM;
   }
@@ -1001,10 +1272,19 @@ cpm_ParaManager::SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo )
   const int *sz = GetLocalArraySize(procGrpNo);
   if( !sz ) return CPM_ERROR_BNDCOMM_VOXELSIZE;
 
-  // buffer size
-  size_t nwX = size_t(sz[1]+2*maxVC) * size_t(sz[2]+2*maxVC) * maxVC * maxN;
-  size_t nwY = size_t(sz[2]+2*maxVC) * size_t(sz[0]+2*maxVC) * maxVC * maxN;
-  size_t nwZ = size_t(sz[0]+2*maxVC) * size_t(sz[1]+2*maxVC) * maxVC * maxN;
+  // 袖通信バッファを作り直すため、登録フィールドの仮想セルは最新でない
+  invalidateFieldComm( procGrpNo );
+
+  // buffer size(通信面内の軸は両側の袖数、通信軸は両側の袖数の大きい方)
+  size_t wd[3], wx[3];
+  for( int i=0;i<3;i++ )
+  {
+    wd[i] = size_t(sz[i]) + maxVC[2*i] + maxVC[2*i+1];
+    wx[i] = (maxVC[2*i] > maxVC[2*i+1]) ? maxVC[2*i] : maxVC[2*i+1];
+  }
+  size_t nwX = wd[1] * wd[2] * wx[0] * maxN;
+  size_t nwY = wd[2] * wd[0] * wx[1] * maxN;
+  size_t nwZ = wd[0] * wd[1] * wx[2] * maxN;
 
   // 送受信バッファ情報のインスタンス
   S_BNDCOMM_BUFFER *bufInfo = new S_BNDCOMM_BUFFER();
@@ -1013,7 +1293,11 @@ cpm_ParaManager::SetBndCommBuffer( size_t maxVC, size_t maxN, int procGrpNo )
     return CPM_ERROR_BNDCOMM_ALLOC_BUFFER;
   }
 
-  bufInfo->m_maxVC = maxVC;
+  bufInfo->m_maxVC = vcMax;
+  for( int i=0;i<6;i++ )
+  {
+    bufInfo->m_maxVCFace[i] = maxVC[i];
+  }
   bufInfo->m_maxN  = maxN;
   bufInfo->m_nwX   = nwX;
   bufInfo->m_nwY   = nwY;
@@ -1082,3 +1366,72 @@ cpm_ParaManager::GetBndCommBufferSize( int procGrpNo )
 
   return mem;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// 時間ブロッキング用の袖通信バッファのセット
+cpm_ErrorCode
+cpm_ParaManager::SetTemporalBlockBuffer( int radius, int nsweep, size_t maxN, int procGrpNo )
+{
+  if( radius < 1 || nsweep < 1 )
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
+
+  // 既存のバッファより小さくはしない(面毎の袖数で比較し、既存の面毎の袖数は保持する)
+  size_t vc = size_t(radius) * size_t(nsweep);
+  size_t maxVC[6] = {vc, vc, vc, vc, vc, vc};
+  S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(procGrpNo);
+  if( bufInfo )
+  {
+    bool bFit = (bufInfo->m_maxN >= maxN);
+    for( int i=0;i<6;i++ )
+    {
+      if( bufInfo->m_maxVCFace[i] < vc ) bFit = false;
+      if( bufInfo->m_maxVCFace[i] > maxVC[i] ) maxVC[i] = bufInfo->m_maxVCFace[i];
+    }
+    if( bFit )
+    {
+      return CPM_SUCCESS;
+    }
+    if( bufInfo->m_maxN > maxN ) maxN = bufInfo->m_maxN;
+  }
+
+  return SetBndCommBuffer( maxVC, maxN, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 時間ブロッキングの計算範囲の取得
+cpm_ErrorCode
+cpm_ParaManager::GetTemporalBlockRange( int vc, int radius, int sweep, int sta[3], int end[3]
+                                      , int procGrpNo )
+{
+  if( !sta || !end )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( radius < 1 || sweep < 1 || sweep * radius > vc )
+  {
+    return CPM_ERROR_BNDCOMM;
+  }
+
+  // local voxel size
+  const int *sz = GetLocalArraySize(procGrpNo);
+  if( !sz ) return CPM_ERROR_BNDCOMM_VOXELSIZE;
+
+  // 隣接ランク番号
+  const int *nID = GetNeighborRankID(procGrpNo);
+  if( !nID )
+  {
+    return CPM_ERROR_GET_NEIGHBOR_RANK;
+  }
+
+  // 隣接ランクのある面は残りの有効な仮想セル数だけ広げる
+  const int ext = vc - sweep * radius;
+  for( int i=0;i<3;i++ )
+  {
+    sta[i] = IsRankNull(nID[2*i  ]) ? 0     : -ext;
+    end[i] = IsRankNull(nID[2*i+1]) ? sz[i] : sz[i] + ext;
+  }
+
+  return CPM_SUCCESS;
+}
@@ -21,6 +21,7 @@
  * @date   2012/05/31
  */
 #include "stdlib.h"
+#include "stdio.h"
 #include "cpm_ParaManager.h"
 
 #if !defined(_WIN32) && !defined(WIN32)
@@ -685,3 +686,209 @@ cpm_ParaManager::PeriodicCommS4DEx( MPI_Datatype dtype, void *array, int nmax, i
 
   return CPM_ERROR_MPI_INVALID_DATATYPE;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル入出力のヒント設定
+void
+cpm_ParaManager::SetFieldIOHint( int cb_nodes, int cb_buffer_size )
+{
+  m_fieldIOCbNodes      = cb_nodes;
+  m_fieldIOCbBufferSize = cb_buffer_size;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4D版, MPI_Datatype指定, パディングサイズ指定)
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4D( MPI_Datatype dtype, const char *fileName, void *array
+                              , int imax, int jmax, int kmax, int nmax, int vc
+                              , int pad_size[4], int procGrpNo )
+{
+  return FieldIO( true, dtype, fileName, array, imax, jmax, kmax, nmax, vc, false, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル書き出し(Scalar4DEx版, MPI_Datatype指定, パディングサイズ指定)
+cpm_ErrorCode
+cpm_ParaManager::WriteFieldS4DEx( MPI_Datatype dtype, const char *fileName, void *array
+                                , int nmax, int imax, int jmax, int kmax, int vc
+                                , int pad_size[4], int procGrpNo )
+{
+  return FieldIO( true, dtype, fileName, array, imax, jmax, kmax, nmax, vc, true, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4D版, MPI_Datatype指定, パディングサイズ指定)
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4D( MPI_Datatype dtype, const char *fileName, void *array
+                             , int imax, int jmax, int kmax, int nmax, int vc
+                             , int pad_size[4], int procGrpNo )
+{
+  return FieldIO( false, dtype, fileName, array, imax, jmax, kmax, nmax, vc, false, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル読み込み(Scalar4DEx版, MPI_Datatype指定, パディングサイズ指定)
+cpm_ErrorCode
+cpm_ParaManager::ReadFieldS4DEx( MPI_Datatype dtype, const char *fileName, void *array
+                               , int nmax, int imax, int jmax, int kmax, int vc
+                               , int pad_size[4], int procGrpNo )
+{
+  return FieldIO( false, dtype, fileName, array, imax, jmax, kmax, nmax, vc, true, pad_size, procGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 並列ファイル入出力の実処理
+cpm_ErrorCode
+cpm_ParaManager::FieldIO( bool bWrite, MPI_Datatype dtype, const char *fileName, void *array
+                        , int imax, int jmax, int kmax, int nmax, int vc, bool bEx
+                        , int pad_size[4], int procGrpNo )
+{
+  if( !fileName || !array )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+  if( dtype == MPI_DATATYPE_NULL )
+  {
+    return CPM_ERROR_MPI_INVALID_DATATYPE;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm(procGrpNo);
+  if( IsCommNull(comm) )
+  {
+    // プロセスグループが存在しない
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 全体VOXEL数、自ランクのVOXEL数、始点インデクス
+  const int *gsz  = GetGlobalVoxelSize(procGrpNo);
+  const int *lsz  = GetLocalVoxelSize(procGrpNo);
+  const int *head = GetVoxelHeadIndex(procGrpNo);
+  if( !gsz || !lsz || !head )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  if( imax != lsz[0] || jmax != lsz[1] || kmax != lsz[2] || nmax < 1 || vc < 0 )
+  {
+    return CPM_ERROR_INVALID_VOXELSIZE;
+  }
+
+  // パディングサイズ(S4Dのとき(i,j,k,n)、S4DExのとき(n,i,j,k))
+  int pad[4] = {0, 0, 0, 0};
+  if( pad_size )
+  {
+    for( int i=0;i<4;i++ ) pad[i] = pad_size[i];
+  }
+  int px = bEx ? pad[1] : pad[0];
+  int py = bEx ? pad[2] : pad[1];
+  int pz = bEx ? pad[3] : pad[2];
+  int pn = bEx ? pad[0] : pad[3];
+
+  // 配列側とファイル側のsubarray(Fortran順、先頭が最内側)
+  int asz[4], asub[4], ast[4];
+  int fsz[4], fst[4];
+  int d  = bEx ? 1 : 0;
+  int dn = bEx ? 0 : 3;
+  asz[d  ] = imax+2*vc+px; asub[d  ] = imax; ast[d  ] = vc; fsz[d  ] = gsz[0]; fst[d  ] = head[0];
+  asz[d+1] = jmax+2*vc+py; asub[d+1] = jmax; ast[d+1] = vc; fsz[d+1] = gsz[1]; fst[d+1] = head[1];
+  asz[d+2] = kmax+2*vc+pz; asub[d+2] = kmax; ast[d+2] = vc; fsz[d+2] = gsz[2]; fst[d+2] = head[2];
+  asz[dn ] = nmax+pn;      asub[dn ] = nmax; ast[dn ] = 0;  fsz[dn ] = nmax;   fst[dn ] = 0;
+
+  MPI_Datatype memType  = MPI_DATATYPE_NULL;
+  MPI_Datatype fileType = MPI_DATATYPE_NULL;
+  if( MPI_Type_create_subarray( 4, asz, asub, ast, MPI_ORDER_FORTRAN, dtype, &memType ) != MPI_SUCCESS ||
+      MPI_Type_commit( &memType ) != MPI_SUCCESS ||
+      MPI_Type_create_subarray( 4, fsz, asub, fst, MPI_ORDER_FORTRAN, dtype, &fileType ) != MPI_SUCCESS ||
+      MPI_Type_commit( &fileType ) != MPI_SUCCESS )
+  {
+    if( memType  != MPI_DATATYPE_NULL ) MPI_Type_free( &memType );
+    if( fileType != MPI_DATATYPE_NULL ) MPI_Type_free( &fileType );
+    return CPM_ERROR_MPI_TYPE_CREATE;
+  }
+
+  // 集団バッファリングのヒント
+  MPI_Info info = MPI_INFO_NULL;
+  if( m_fieldIOCbNodes > 0 || m_fieldIOCbBufferSize > 0 )
+  {
+    char val[32];
+    MPI_Info_create( &info );
+    MPI_Info_set( info, (char*)(bWrite ? "romio_cb_write" : "romio_cb_read"), (char*)"enable" );
+    if( m_fieldIOCbNodes > 0 )
+    {
+      sprintf( val, "%d", m_fieldIOCbNodes );
+      MPI_Info_set( info, (char*)"cb_nodes", val );
+    }
+    if( m_fieldIOCbBufferSize > 0 )
+    {
+      sprintf( val, "%d", m_fieldIOCbBufferSize );
+      MPI_Info_set( info, (char*)"cb_buffer_size", val );
+    }
+  }
+
+  // 書き出し時は既存ファイルを削除しておく(古いファイルの末尾が残らないように)
+  if( bWrite )
+  {
+    if( GetMyRankID(procGrpNo) == 0 )
+    {
+      MPI_File_delete( (char*)fileName, MPI_INFO_NULL );
+    }
+    MPI_Barrier( comm );
+  }
+
+  cpm_ErrorCode ret = CPM_SUCCESS;
+  MPI_File fh;
+  int amode = bWrite ? (MPI_MODE_WRONLY | MPI_MODE_CREATE) : MPI_MODE_RDONLY;
+  if( MPI_File_open( comm, (char*)fileName, amode, info, &fh ) != MPI_SUCCESS )
+  {
+    ret = CPM_ERROR_MPI_FILE_OPEN;
+  }
+  else
+  {
+    // 読み込み時はファイルサイズが全体配列と一致するか確認
+    if( !bWrite )
+    {
+      int esize = 0;
+      MPI_Offset fsize = 0;
+      MPI_Type_size( dtype, &esize );
+      MPI_File_get_size( fh, &fsize );
+      MPI_Offset gsize = MPI_Offset(gsz[0]) * MPI_Offset(gsz[1]) * MPI_Offset(gsz[2])
+                       * MPI_Offset(nmax) * MPI_Offset(esize);
+      if( fsize != gsize )
+      {
+        ret = CPM_ERROR_MPI_FILE_SIZE;
+      }
+    }
+
+    // ファイルビューを設定して集団入出力
+    if( ret == CPM_SUCCESS &&
+        MPI_File_set_view( fh, 0, dtype, fileType, (char*)"native", info ) != MPI_SUCCESS )
+    {
+      ret = CPM_ERROR_MPI_FILE_VIEW;
+    }
+    if( ret == CPM_SUCCESS )
+    {
+      MPI_Status status;
+      if( bWrite )
+      {
+        if( MPI_File_write_all( fh, array, 1, memType, &status ) != MPI_SUCCESS )
+        {
+          ret = CPM_ERROR_MPI_FILE_WRITE;
+        }
+      }
+      else
+      {
+        if( MPI_File_read_all( fh, array, 1, memType, &status ) != MPI_SUCCESS )
+        {
+          ret = CPM_ERROR_MPI_FILE_READ;
+        }
+      }
+    }
+    MPI_File_close( &fh );
+  }
+
+  if( info != MPI_INFO_NULL ) MPI_Info_free( &info );
+  MPI_Type_free( &memType );
+  MPI_Type_free( &fileType );
+
+  return ret;
+}
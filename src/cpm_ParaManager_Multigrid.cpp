@@ -0,0 +1,204 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Multigrid.cpp
+ * パラレルマネージャクラスのマルチグリッド関数ソースファイル
+ * @date   2026/10/19
+ */
+#include "stdlib.h"
+#include "cpm_ParaManager.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// マルチグリッドの粗視化レベルの作成
+int
+cpm_ParaManager::CreateCoarseLevel( int fineProcGrpNo, int minLocalVoxel )
+{
+  // 細格子のプロセスグループのランク数
+  int nrank = GetNumRank(fineProcGrpNo);
+  int myrank = GetMyRankID(fineProcGrpNo);
+  if( nrank < 1 || myrank < 0 )
+  {
+    return -1;
+  }
+  if( minLocalVoxel < 1 ) minLocalVoxel = 1;
+
+  // 細格子の領域情報
+  const int *div  = GetDivNum(fineProcGrpNo);
+  const int *pos  = GetDivPos(fineProcGrpNo);
+  const int *head = GetVoxelHeadIndex(fineProcGrpNo);
+  const int *blk  = GetLocalVoxelSize(fineProcGrpNo);
+  const int *gsz  = GetGlobalVoxelSize(fineProcGrpNo);
+  const double *gorg = GetGlobalOrigin(fineProcGrpNo);
+  const double *grgn = GetGlobalRegion(fineProcGrpNo);
+  if( !div || !pos || !head || !blk || !gsz || !gorg || !grgn )
+  {
+    return -1;
+  }
+
+  // 定義点がVOXELで、不活性領域が無く、全体VOXEL数が偶数のときのみ対応
+  // (プロセスグループ内で同じ判定になる)
+  if( GetDefPointType(fineProcGrpNo) != CPM_DEFPOINTTYPE_FVM )
+  {
+    return -1;
+  }
+  if( div[0] * div[1] * div[2] != nrank )
+  {
+    return -1;
+  }
+  for( int i=0;i<3;i++ )
+  {
+    if( gsz[i] < 2 || gsz[i] % 2 != 0 )
+    {
+      return -1;
+    }
+  }
+
+  // 粗格子の全体VOXEL数と分割数(最小VOXEL数を下回る軸は分割数を半分にして集約)
+  int gC[3], divC[3];
+  for( int i=0;i<3;i++ )
+  {
+    gC[i]   = gsz[i] / 2;
+    divC[i] = div[i];
+    while( divC[i] > 1 && gC[i] / divC[i] < minLocalVoxel )
+    {
+      divC[i] = (divC[i] + 1) / 2;
+    }
+  }
+
+  // 細格子の各分割位置のランク番号
+  int myPos[3] = {pos[0], pos[1], pos[2]};
+  std::vector<int> allPos(size_t(nrank) * 3);
+  if( Allgather( myPos, 3, &allPos[0], 3, fineProcGrpNo ) != CPM_SUCCESS )
+  {
+    return -1;
+  }
+  std::vector<int> rankAt(size_t(nrank), -1);
+  for( int r=0;r<nrank;r++ )
+  {
+    const int *p = &allPos[r*3];
+    rankAt[_IDX_S3D(p[0],p[1],p[2],div[0],div[1],div[2],0)] = r;
+  }
+
+  // 粗格子のランクリスト
+  // (粗格子の分割位置順に、対応する位置の細格子のランクを並べる)
+  int nC = divC[0] * divC[1] * divC[2];
+  std::vector<int> proclist(nC);
+  for( int k=0;k<divC[2];k++ ){
+  for( int j=0;j<divC[1];j++ ){
+  for( int i=0;i<divC[0];i++ ){
+    int fi = int( (long long)(i) * div[0] / divC[0] );
+    int fj = int( (long long)(j) * div[1] / divC[1] );
+    int fk = int( (long long)(k) * div[2] / divC[2] );
+    proclist[_IDX_S3D(i,j,k,divC[0],divC[1],divC[2],0)] = rankAt[_IDX_S3D(fi,fj,fk,div[0],div[1],div[2],0)];
+  }}}
+
+  // 粗格子のプロセスグループの作成、領域分割
+  int coarseProcGrpNo = CreateProcessGroup( nC, &proclist[0], fineProcGrpNo );
+  int bad = 0;
+  if( coarseProcGrpNo >= 0 )
+  {
+    double org[3] = {gorg[0], gorg[1], gorg[2]};
+    double rgn[3] = {grgn[0], grgn[1], grgn[2]};
+    size_t maxVC = 1;
+    size_t maxN  = 3;
+    S_BNDCOMM_BUFFER *bufInfo = GetBndCommBuffer(fineProcGrpNo);
+    if( bufInfo )
+    {
+      maxVC = bufInfo->m_maxVC;
+      maxN  = bufInfo->m_maxN;
+    }
+    if( VoxelInit( divC, gC, org, rgn, maxVC, maxN, DIV_COMM_SIZE, coarseProcGrpNo ) != CPM_SUCCESS )
+    {
+      bad = 1;
+    }
+  }
+  int badAll = 0;
+  if( Allreduce( &bad, &badAll, 1, MPI_MAX, fineProcGrpNo ) != CPM_SUCCESS || badAll )
+  {
+    return -1;
+  }
+
+  // 粗格子の自ランクの領域を細格子で見た領域(作業配列)
+  int mine[18];
+  for( int i=0;i<18;i++ ) mine[i] = 0;
+  S_MG_LEVEL *level = new S_MG_LEVEL();
+  level->m_fineProcGrpNo   = fineProcGrpNo;
+  level->m_coarseProcGrpNo = coarseProcGrpNo;
+  for( int i=0;i<3;i++ )
+  {
+    level->m_fineSize[i] = blk[i];
+    mine[i  ] = head[i];
+    mine[i+3] = blk[i];
+    mine[i+6] = gsz[i];
+  }
+  if( coarseProcGrpNo >= 0 )
+  {
+    const int *headC = GetVoxelHeadIndex(coarseProcGrpNo);
+    const int *blkC  = GetLocalVoxelSize(coarseProcGrpNo);
+    for( int i=0;i<3;i++ )
+    {
+      level->m_coarseSize[i] = blkC[i];
+      mine[9+i  ] = headC[i] * 2;
+      mine[9+i+3] = blkC[i] * 2;
+      mine[9+i+6] = gsz[i];
+    }
+  }
+
+  // 制限(細格子->作業配列)、補間(作業配列->細格子)のデータ再配置プラン
+  level->m_restrictPlanNo = createRedistPlan( mine, fineProcGrpNo );
+  for( int i=0;i<9;i++ )
+  {
+    int tmp = mine[i];
+    mine[i] = mine[9+i];
+    mine[9+i] = tmp;
+  }
+  level->m_prolongPlanNo = createRedistPlan( mine, fineProcGrpNo );
+  if( level->m_restrictPlanNo < 0 || level->m_prolongPlanNo < 0 )
+  {
+    delete level;
+    return -1;
+  }
+
+  m_mgLevelList.push_back(level);
+  return int(m_mgLevelList.size()) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粗格子のプロセスグループ番号の取得
+int
+cpm_ParaManager::GetCoarseProcGrp( int levelNo )
+{
+  S_MG_LEVEL *level = FindMGLevel(levelNo);
+  if( !level )
+  {
+    return -1;
+  }
+  return level->m_coarseProcGrpNo;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// マルチグリッドの粗視化レベル情報の検索
+S_MG_LEVEL*
+cpm_ParaManager::FindMGLevel( int levelNo )
+{
+  if( levelNo < 0 || levelNo >= int(m_mgLevelList.size()) )
+  {
+    return NULL;
+  }
+  return m_mgLevelList[levelNo];
+}
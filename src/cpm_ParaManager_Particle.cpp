@@ -0,0 +1,148 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Particle.cpp
+ * パラレルマネージャクラスの粒子移動関数ソースファイル
+ * @date   2026/10/19
+ */
+#include "stdlib.h"
+#include "cpm_ParaManager.h"
+#include "cpm_VoxelInfoCART.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子の移動先ランクの判定
+cpm_ErrorCode
+cpm_ParaManager::FindParticleRank( int num, double *pos, int periodicFlag, int *rank, int procGrpNo )
+{
+  if( num > 0 && (!pos || !rank) )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  // 領域情報
+  const cpm_VoxelInfoCART *pVoxelInfo = (const cpm_VoxelInfoCART*)FindVoxelInfo( procGrpNo );
+  if( !pVoxelInfo || !pVoxelInfo->m_rankMap )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  const double *gorg = pVoxelInfo->GetGlobalOrigin();
+  const double *grgn = pVoxelInfo->GetGlobalRegion();
+
+  // 周期境界の補正(補正後も計算領域外の位置は検索しない)
+  std::vector<char> bOut(num, 0);
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+  for( int n=0;n<num;n++ )
+  {
+    double *x = &pos[n*3];
+    for( int i=0;i<3;i++ )
+    {
+      if( x[i] >= gorg[i] && x[i] < gorg[i] + grgn[i] ) continue;
+      if( periodicFlag & (1<<i) )
+      {
+        if( x[i] < gorg[i] )
+        {
+          // 始点のごく近くでは丸め誤差で終点に一致するので、周期的に同じ位置の始点とする
+          x[i] += grgn[i];
+          if( x[i] >= gorg[i] + grgn[i] ) x[i] = gorg[i];
+        }
+        else
+        {
+          // 終点のごく近くでは丸め誤差で始点を下回るので、始点とする
+          x[i] -= grgn[i];
+          if( x[i] < gorg[i] ) x[i] = gorg[i];
+        }
+      }
+      if( !(x[i] >= gorg[i] && x[i] < gorg[i] + grgn[i]) )
+      {
+        bOut[n] = 1;
+      }
+    }
+  }
+
+  // 担当ランク(隣接領域に限らず、位置を含む領域のランクを算術的に求める)
+  std::vector<S_POINT_LOCATION> loc(num);
+  if( num > 0 )
+  {
+    cpm_ErrorCode ret = LocatePoints( num, pos, &loc[0], procGrpNo );
+    if( ret != CPM_SUCCESS )
+    {
+      return ret;
+    }
+  }
+  for( int n=0;n<num;n++ )
+  {
+    rank[n] = bOut[n] ? -1 : loc[n].rank;
+  }
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 粒子を送受信する隣接ランクリストの取得
+cpm_ErrorCode
+cpm_ParaManager::GetParticleNeighborRank( std::vector<int> &rankList, int periodicFlag, int procGrpNo )
+{
+  rankList.clear();
+
+  // 領域情報
+  const cpm_VoxelInfoCART *pVoxelInfo = (const cpm_VoxelInfoCART*)FindVoxelInfo( procGrpNo );
+  if( !pVoxelInfo || !pVoxelInfo->m_rankMap )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+  const int *div  = pVoxelInfo->GetDivNum();
+  const int *dpos = pVoxelInfo->GetDivPos();
+  const int *rankMap = pVoxelInfo->m_rankMap;
+  int myrank = GetMyRankID(procGrpNo);
+
+  // 26方向の隣接領域
+  for( int dk=-1;dk<=1;dk++ ){
+  for( int dj=-1;dj<=1;dj++ ){
+  for( int di=-1;di<=1;di++ ){
+    int d[3] = {di, dj, dk};
+    int q[3];
+    bool bOut = false;
+    for( int i=0;i<3;i++ )
+    {
+      q[i] = dpos[i] + d[i];
+      if( q[i] < 0 || q[i] >= div[i] )
+      {
+        if( periodicFlag & (1<<i) )
+        {
+          q[i] = (q[i] + div[i]) % div[i];
+        }
+        else
+        {
+          bOut = true;
+        }
+      }
+    }
+    if( bOut ) continue;
+    int r = rankMap[_IDX_S3D(q[0],q[1],q[2],div[0],div[1],div[2],0)];
+    if( IsRankNull(r) || r == myrank ) continue;
+    rankList.push_back(r);
+  }}}
+
+  // 昇順、重複なし
+  std::sort(rankList.begin(), rankList.end());
+  rankList.erase(std::unique(rankList.begin(), rankList.end()), rankList.end());
+
+  return CPM_SUCCESS;
+}
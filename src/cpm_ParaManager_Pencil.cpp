@@ -0,0 +1,264 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Pencil.cpp
+ * パラレルマネージャクラスのペンシル転置関数ソースファイル
+ * @date   2026/10/19
+ */
+#include "stdlib.h"
+#include "cpm_ParaManager.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシルのVOXEL数と始点インデクスの取得
+cpm_ErrorCode
+cpm_ParaManager::GetPencilSize( cpm_DirFlag dir, int size[3], int head[3], int procGrpNo )
+{
+  if( !size || !head )
+  {
+    return CPM_ERROR_INVALID_PTR;
+  }
+
+  S_PENCIL_PLAN *plan = NULL;
+  cpm_ErrorCode ret = GetPencilPlan( dir, plan, procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  for( int i=0;i<3;i++ )
+  {
+    size[i] = plan->m_pencilSize[i];
+    head[i] = plan->m_pencilHead[i];
+  }
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシル転置プランの取得
+cpm_ErrorCode
+cpm_ParaManager::GetPencilPlan( cpm_DirFlag dir, S_PENCIL_PLAN *&plan, int procGrpNo )
+{
+  plan = NULL;
+  if( dir != X_DIR && dir != Y_DIR && dir != Z_DIR )
+  {
+    return CPM_ERROR_PENCIL_INVALID_DIR;
+  }
+
+  // 作成済みのプラン
+  int key = procGrpNo * 3 + int(dir);
+  std::map<int, S_PENCIL_PLAN*>::iterator it = m_pencilPlanMap.find(key);
+  if( it != m_pencilPlanMap.end() )
+  {
+    plan = it->second;
+    return CPM_SUCCESS;
+  }
+
+  // コミュニケータを取得
+  MPI_Comm comm = GetMPI_Comm(procGrpNo);
+  if( IsCommNull(comm) )
+  {
+    // プロセスグループが存在しない
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 領域情報
+  const int *div  = GetDivNum(procGrpNo);
+  const int *pos  = GetDivPos(procGrpNo);
+  const int *head = GetVoxelHeadIndex(procGrpNo);
+  const int *blk  = GetLocalVoxelSize(procGrpNo);
+  const int *gsz  = GetGlobalVoxelSize(procGrpNo);
+  if( !div || !pos || !head || !blk || !gsz )
+  {
+    return CPM_ERROR_NOT_IN_PROCGROUP;
+  }
+
+  // 定義点がVOXELのときのみ対応
+  if( GetDefPointType(procGrpNo) != CPM_DEFPOINTTYPE_FVM )
+  {
+    return CPM_ERROR_PENCIL_DEFPOINT;
+  }
+
+  // 転置軸(a)、ペンシルを分割する軸(s)、もう一方の軸(o)
+  const int a = int(dir);
+  const int s = (a+1) % 3;
+  const int o = (a+2) % 3;
+
+  // 転置軸方向のラインのコミュニケータを作成(ライン内は転置軸方向の分割位置順)
+  MPI_Comm lcomm = MPI_COMM_NULL;
+  int color = pos[s] + div[s] * pos[o];
+  if( MPI_Comm_split( comm, color, pos[a], &lcomm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_COMM_SPLIT;
+  }
+  int nrank = 0;
+  int myPos = -1;
+  MPI_Comm_size( lcomm, &nrank );
+  MPI_Comm_rank( lcomm, &myPos );
+
+  // ラインに不活性な領域があるときはエラー(プロセスグループ内で判定を揃える)
+  int bad = (nrank != div[a] || myPos != pos[a]) ? 1 : 0;
+  int badAll = 0;
+  if( MPI_Allreduce( &bad, &badAll, 1, MPI_INT, MPI_MAX, comm ) != MPI_SUCCESS )
+  {
+    MPI_Comm_free( &lcomm );
+    return CPM_ERROR_MPI_ALLREDUCE;
+  }
+  if( badAll )
+  {
+    MPI_Comm_free( &lcomm );
+    return CPM_ERROR_PENCIL_INACTIVE;
+  }
+
+  // ライン内の各ランクの転置軸方向の始点とサイズ
+  int mine[2] = {head[a], blk[a]};
+  std::vector<int> ax(size_t(nrank) * 2);
+  if( MPI_Allgather( mine, 2, MPI_INT, &ax[0], 2, MPI_INT, lcomm ) != MPI_SUCCESS )
+  {
+    MPI_Comm_free( &lcomm );
+    return CPM_ERROR_MPI_ALLGATHER;
+  }
+
+  // プランの作成
+  plan = new S_PENCIL_PLAN();
+  plan->m_comm  = lcomm;
+  plan->m_nrank = nrank;
+  plan->m_myPos = myPos;
+  for( int i=0;i<3;i++ )
+  {
+    plan->m_blkSize[i] = blk[i];
+  }
+
+  // 分割軸方向をライン内のランク数で分割(q番目の範囲は[q*n/d, (q+1)*n/d))
+  std::vector<int> spHead(nrank+1);
+  for( int q=0;q<=nrank;q++ )
+  {
+    spHead[q] = int( (long long)(q) * (long long)(blk[s]) / (long long)(nrank) );
+  }
+
+  // 自ランクのペンシル
+  plan->m_pencilSize[a] = gsz[a];
+  plan->m_pencilSize[s] = spHead[myPos+1] - spHead[myPos];
+  plan->m_pencilSize[o] = blk[o];
+  plan->m_pencilHead[a] = 0;
+  plan->m_pencilHead[s] = head[s] + spHead[myPos];
+  plan->m_pencilHead[o] = head[o];
+
+  // 各ランクとやりとりする領域
+  plan->m_blkBox.resize(size_t(nrank) * 6);
+  plan->m_pencilBox.resize(size_t(nrank) * 6);
+  for( int q=0;q<nrank;q++ )
+  {
+    // ブロック側 : q番目のランクのペンシルに含まれる範囲
+    int *bb = &plan->m_blkBox[q*6];
+    bb[a] = 0;              bb[a+3] = blk[a];
+    bb[s] = spHead[q];      bb[s+3] = spHead[q+1] - spHead[q];
+    bb[o] = 0;              bb[o+3] = blk[o];
+
+    // ペンシル側 : q番目のランクのブロックの範囲
+    int *pb = &plan->m_pencilBox[q*6];
+    pb[a] = ax[q*2];        pb[a+3] = ax[q*2+1];
+    pb[s] = 0;              pb[s+3] = plan->m_pencilSize[s];
+    pb[o] = 0;              pb[o+3] = blk[o];
+  }
+
+  m_pencilPlanMap.insert(std::make_pair(key, plan));
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシル転置の送受信の準備
+void
+cpm_ParaManager::preparePencilExchange( S_PENCIL_PLAN *plan, bool bToPencil, int nmax, size_t esize )
+{
+  const int nrank = plan->m_nrank;
+  plan->m_scnt.resize(nrank);
+  plan->m_sdsp.resize(nrank);
+  plan->m_rcnt.resize(nrank);
+  plan->m_rdsp.resize(nrank);
+
+  // 要素数と変位(要素単位)
+  const std::vector<int> &sbox = bToPencil ? plan->m_blkBox    : plan->m_pencilBox;
+  const std::vector<int> &rbox = bToPencil ? plan->m_pencilBox : plan->m_blkBox;
+  size_t ns = 0;
+  size_t nr = 0;
+  for( int q=0;q<nrank;q++ )
+  {
+    const int *sb = &sbox[q*6];
+    const int *rb = &rbox[q*6];
+    plan->m_scnt[q] = sb[3] * sb[4] * sb[5] * nmax;
+    plan->m_rcnt[q] = rb[3] * rb[4] * rb[5] * nmax;
+    plan->m_sdsp[q] = int(ns);
+    plan->m_rdsp[q] = int(nr);
+    ns += size_t(plan->m_scnt[q]);
+    nr += size_t(plan->m_rcnt[q]);
+  }
+
+  // バッファ(拡張のみ)
+  if( plan->m_sendBuf.size() < ns * esize ) plan->m_sendBuf.resize(ns * esize);
+  if( plan->m_recvBuf.size() < nr * esize ) plan->m_recvBuf.resize(nr * esize);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ペンシル転置のIalltoallvの発行
+cpm_ErrorCode
+cpm_ParaManager::startPencilExchange( S_PENCIL_PLAN *plan, size_t esize, MPI_Request *req )
+{
+  // 要素サイズの転送用データ型(キャッシュ)
+  MPI_Datatype dtype = MPI_DATATYPE_NULL;
+  std::map<size_t, MPI_Datatype>::iterator it = plan->m_elemType.find(esize);
+  if( it != plan->m_elemType.end() )
+  {
+    dtype = it->second;
+  }
+  else
+  {
+    if( MPI_Type_contiguous( int(esize), MPI_BYTE, &dtype ) != MPI_SUCCESS ||
+        MPI_Type_commit( &dtype ) != MPI_SUCCESS )
+    {
+      return CPM_ERROR_MPI_TYPE_CREATE;
+    }
+    plan->m_elemType.insert(std::make_pair(esize, dtype));
+  }
+
+  void *sbuf = plan->m_sendBuf.empty() ? NULL : &plan->m_sendBuf[0];
+  void *rbuf = plan->m_recvBuf.empty() ? NULL : &plan->m_recvBuf[0];
+
+#if defined(DISABLE_MPI) || (MPI_VERSION >= 3)
+  // MPI_Ialltoallv
+  if( MPI_Ialltoallv( sbuf, &plan->m_scnt[0], &plan->m_sdsp[0], dtype
+                    , rbuf, &plan->m_rcnt[0], &plan->m_rdsp[0], dtype
+                    , plan->m_comm, req ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLTOALLV;
+  }
+#else
+  // MPI-3未満はAlltoallvで代用し、完了済みのリクエスト(MPI_PROC_NULLからの受信)を返す
+  if( MPI_Alltoallv( sbuf, &plan->m_scnt[0], &plan->m_sdsp[0], dtype
+                   , rbuf, &plan->m_rcnt[0], &plan->m_rdsp[0], dtype
+                   , plan->m_comm ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLTOALLV;
+  }
+  if( MPI_Irecv( NULL, 0, MPI_BYTE, MPI_PROC_NULL, 0, plan->m_comm, req ) != MPI_SUCCESS )
+  {
+    return CPM_ERROR_MPI_IALLTOALLV;
+  }
+#endif
+
+  return CPM_SUCCESS;
+}
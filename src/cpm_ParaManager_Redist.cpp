@@ -0,0 +1,168 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ParaManager_Redist.cpp
+ * パラレルマネージャクラスのデータ再配置関数ソースファイル
+ * @date   2026/10/19
+ */
+#include "stdlib.h"
+#include "cpm_ParaManager.h"
+
+// 自ランク情報のword数(再配置元の始点、サイズ、全体サイズ、再配置先の始点、サイズ、全体サイズ)
+#define _REDIST_NW 18
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置プランの作成
+int
+cpm_ParaManager::CreateRedistPlan( int srcProcGrpNo, int dstProcGrpNo, int parentProcGrpNo )
+{
+  // 自ランクの再配置元、再配置先の領域(含まれないときサイズ0)
+  int mine[_REDIST_NW];
+  for( int i=0;i<_REDIST_NW;i++ ) mine[i] = 0;
+  const int grp[2] = {srcProcGrpNo, dstProcGrpNo};
+  for( int s=0;s<2;s++ )
+  {
+    if( grp[s] < 0 || !FindVoxelInfo(grp[s]) ) continue;
+    const int *head = GetArrayHeadIndex(grp[s]);
+    const int *lsz  = GetLocalArraySize(grp[s]);
+    const int *gsz  = GetGlobalArraySize(grp[s]);
+    if( !head || !lsz || !gsz ) continue;
+    for( int i=0;i<3;i++ )
+    {
+      mine[s*9+i  ] = head[i];
+      mine[s*9+i+3] = lsz[i];
+      mine[s*9+i+6] = gsz[i];
+    }
+  }
+
+  return createRedistPlan( mine, parentProcGrpNo );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 自ランクの領域からデータ再配置プランを作成
+int
+cpm_ParaManager::createRedistPlan( const int mine[18], int parentProcGrpNo )
+{
+  // 親プロセスグループのランク数
+  int nrank = GetNumRank(parentProcGrpNo);
+  int myrank = GetMyRankID(parentProcGrpNo);
+  if( nrank < 1 || myrank < 0 )
+  {
+    return -1;
+  }
+
+  // 全ランクの領域を収集
+  std::vector<int> all(size_t(nrank) * _REDIST_NW);
+  if( Allgather( (int*)mine, _REDIST_NW, &all[0], _REDIST_NW, parentProcGrpNo ) != CPM_SUCCESS )
+  {
+    return -1;
+  }
+
+  // 全体サイズが一致するかチェック(全ランクで同じ判定になる)
+  const int *gref = NULL;
+  for( int r=0;r<nrank;r++ )
+  {
+    for( int s=0;s<2;s++ )
+    {
+      const int *g = &all[size_t(r)*_REDIST_NW + s*9 + 6];
+      if( g[0] <= 0 ) continue;
+      if( !gref ) gref = g;
+      if( g[0] != gref[0] || g[1] != gref[1] || g[2] != gref[2] )
+      {
+        return -1;
+      }
+    }
+  }
+
+  // 交差領域の計算
+  S_REDIST_PLAN *plan = new S_REDIST_PLAN();
+  plan->m_parentProcGrpNo = parentProcGrpNo;
+  for( int i=0;i<3;i++ )
+  {
+    plan->m_srcSize[i] = mine[i+3];
+    plan->m_dstSize[i] = mine[9+i+3];
+  }
+  for( int r=0;r<nrank;r++ )
+  {
+    const int *other = &all[size_t(r)*_REDIST_NW];
+    for( int s=0;s<2;s++ )
+    {
+      // s=0:自ランクの再配置元と相手の再配置先(送信)
+      // s=1:自ランクの再配置先と相手の再配置元(受信)
+      const int *my = &mine[s*9];
+      const int *ot = &other[(1-s)*9];
+      int box[6];
+      bool bHit = true;
+      for( int i=0;i<3;i++ )
+      {
+        int st = std::max(my[i], ot[i]);
+        int ed = std::min(my[i]+my[i+3], ot[i]+ot[i+3]);
+        if( ed <= st )
+        {
+          bHit = false;
+          break;
+        }
+        box[i  ] = st - my[i];
+        box[i+3] = ed - st;
+      }
+      if( !bHit ) continue;
+
+      std::vector<int> &rank = (s==0) ? plan->m_sendRank : plan->m_recvRank;
+      std::vector<int> &list = (s==0) ? plan->m_sendBox  : plan->m_recvBox;
+      if( r == myrank )
+      {
+        if( s == 0 ) plan->m_selfSend = int(rank.size());
+        else         plan->m_selfRecv = int(rank.size());
+      }
+      rank.push_back(r);
+      list.insert(list.end(), box, box+6);
+    }
+  }
+
+  m_redistPlanList.push_back(plan);
+  return int(m_redistPlanList.size()) - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置プランの削除
+cpm_ErrorCode
+cpm_ParaManager::DeleteRedistPlan( int planNo )
+{
+  S_REDIST_PLAN *plan = FindRedistPlan(planNo);
+  if( !plan )
+  {
+    return CPM_ERROR_INVALID_OBJKEY;
+  }
+  delete plan;
+  m_redistPlanList[planNo] = NULL;
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// データ再配置プランの検索
+S_REDIST_PLAN*
+cpm_ParaManager::FindRedistPlan( int planNo )
+{
+  if( planNo < 0 || planNo >= int(m_redistPlanList.size()) )
+  {
+    return NULL;
+  }
+  return m_redistPlanList[planNo];
+}
+
+#undef _REDIST_NW
@@ -79,6 +79,7 @@
   #define cpm_Isend_                 cpm_isend_
   #define cpm_Irecv_                 cpm_irecv_
   #define cpm_Allreduce_             cpm_allreduce_
+  #define cpm_Iallreduce_            cpm_iallreduce_
   #define cpm_Gather_                cpm_gather_
   #define cpm_Allgather_             cpm_allgather_
   #define cpm_Gatherv_               cpm_gatherv_
@@ -153,6 +154,7 @@
   #define cpm_Isend_                 CPM_ISEND
   #define cpm_Irecv_                 CPM_IRECV
   #define cpm_Allreduce_             CPM_ALLREDUCE
+  #define cpm_Iallreduce_            CPM_IALLREDUCE
   #define cpm_Gather_                CPM_GATHER
   #define cpm_Allgather_             CPM_ALLGATHER
   #define cpm_Gatherv_               CPM_GATHERV
@@ -1787,6 +1789,41 @@ cpm_Allreduce_( void *sendbuf, void *recvbuf, int *count, int *datatype, int *op
   *ierr = paraMngr->Allreduce( dtype, sendbuf, recvbuf, *count, ope, *procGrpNo );
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/** MPI_IallreduceのFortranインターフェイス
+ *  - MPI_IallreduceのFortranインターフェイス関数
+ *  - 完了はcpm_Wait,cpm_Waitallで待つ
+ *  @param[in]  sendbuf   送信データ
+ *  @param[out] recvbuf   受信データ
+ *  @param[in]  count     送受信データのサイズ
+ *  @param[in]  datatype  送受信データのデータタイプ(cpm_fparam.fiを参照)
+ *  @param[in]  op        オペレータ
+ *  @param[in]  procGrpNo プロセスグループ番号
+ *  @param[out] reqNo     リクエスト番号
+ *  @param[out] ierr      終了コード(0=正常終了、0以外=cpm_ErrorCodeの値)
+ */
+CPM_EXTERN
+void
+cpm_Iallreduce_( void *sendbuf, void *recvbuf, int *count, int *datatype, int *op, int *procGrpNo, int *reqNo, int *ierr )
+{
+  if( !sendbuf || !recvbuf || !count || !datatype || !op || !procGrpNo || !reqNo || !ierr )
+  {
+    if( ierr ) *ierr = CPM_ERROR_INVALID_PTR;
+    return;
+  }
+
+  // インスタンス取得
+  cpm_ParaManager *paraMngr = cpm_ParaManager::get_instance();
+  if( !paraMngr )
+  {
+    *ierr = CPM_ERROR_PM_INSTANCE;
+    return;
+  }
+
+  // cpm_Iallreduce
+  *ierr = paraMngr->cpm_Iallreduce( sendbuf, recvbuf, *count, *datatype, *op, reqNo, *procGrpNo );
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /** MPI_GatherのFortranインターフェイス
  *  - MPI_GatherのFortranインターフェイス関数
@@ -3064,11 +3101,8 @@ cpm_ParaManager::cpm_BndCommS3D_nowait( void *array, int imax, int jmax, int kma
   // MPI_Requestを登録
   for( int i=0;i<12;i++ )
   {
-    MPI_Request *r = m_reqList.Create();
-    *r = req[i];
-    if( (reqNo[i] = m_reqList.Add(r) ) < 0 )
+    if( (reqNo[i] = m_reqList.Add(req[i]) ) < 0 )
     {
-      delete r;
       return CPM_ERROR_REGIST_OBJKEY;
     }
   }
@@ -3106,11 +3140,8 @@ cpm_ParaManager::cpm_BndCommV3D_nowait( void *array, int imax, int jmax, int kma
   // MPI_Requestを登録
   for( int i=0;i<12;i++ )
   {
-    MPI_Request *r = m_reqList.Create();
-    *r = req[i];
-    if( (reqNo[i] = m_reqList.Add(r) ) < 0 )
+    if( (reqNo[i] = m_reqList.Add(req[i]) ) < 0 )
     {
-      delete r;
       return CPM_ERROR_REGIST_OBJKEY;
     }
   }
@@ -3144,11 +3175,8 @@ cpm_ParaManager::cpm_BndCommS4D_nowait( void *array, int imax, int jmax, int kma
   // MPI_Requestを登録
   for( int i=0;i<12;i++ )
   {
-    MPI_Request *r = m_reqList.Create();
-    *r = req[i];
-    if( (reqNo[i] = m_reqList.Add(r) ) < 0 )
+    if( (reqNo[i] = m_reqList.Add(req[i]) ) < 0 )
     {
-      delete r;
       return CPM_ERROR_REGIST_OBJKEY;
     }
   }
@@ -3318,11 +3346,8 @@ cpm_ParaManager::cpm_BndCommV3DEx_nowait( void *array, int imax, int jmax, int k
   // MPI_Requestを登録
   for( int i=0;i<12;i++ )
   {
-    MPI_Request *r = m_reqList.Create();
-    *r = req[i];
-    if( (reqNo[i] = m_reqList.Add(r) ) < 0 )
+    if( (reqNo[i] = m_reqList.Add(req[i]) ) < 0 )
     {
-      delete r;
       return CPM_ERROR_REGIST_OBJKEY;
     }
   }
@@ -3357,11 +3382,8 @@ cpm_ParaManager::cpm_BndCommS4DEx_nowait( void *array, int nmax, int imax, int j
   // MPI_Requestを登録
   for( int i=0;i<12;i++ )
   {
-    MPI_Request *r = m_reqList.Create();
-    *r = req[i];
-    if( (reqNo[i] = m_reqList.Add(r) ) < 0 )
+    if( (reqNo[i] = m_reqList.Add(req[i]) ) < 0 )
     {
-      delete r;
       return CPM_ERROR_REGIST_OBJKEY;
     }
   }
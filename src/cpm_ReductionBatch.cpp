@@ -0,0 +1,206 @@
+/*
+###################################################################################
+#
+# CPMlib - Computational space Partitioning Management library
+#
+# Copyright (c) 2012-2014 Institute of Industrial Science (IIS), The University of Tokyo.
+# All rights reserved.
+#
+# Copyright (c) 2014-2016 Advanced Institute for Computational Science (AICS), RIKEN.
+# All rights reserved.
+#
+# Copyright (c) 2016-2017 Research Institute for Information Technology (RIIT), Kyushu University.
+# All rights reserved.
+#
+###################################################################################
+ */
+
+/**
+ * @file   cpm_ReductionBatch.cpp
+ * 集約リダクションクラスのソースファイル
+ * @date   2026/10/19
+ */
+#include "cpm_ReductionBatch.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// コンストラクタ
+cpm_ReductionBatch::cpm_ReductionBatch( cpm_BaseParaManager *paraMngr, MPI_Op op, int procGrpNo )
+  : cpm_Base()
+{
+  m_paraMngr  = paraMngr;
+  m_op        = op;
+  m_procGrpNo = procGrpNo;
+  m_req       = MPI_REQUEST_NULL;
+  m_active    = false;
+  m_done      = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// デストラクタ
+cpm_ReductionBatch::~cpm_ReductionBatch()
+{
+  if( m_active )
+  {
+    Wait();
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ローカル値の登録
+int
+cpm_ReductionBatch::Add( double val, double *result )
+{
+  return Add( 1, &val, result );
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// ローカル値の登録(配列版)
+int
+cpm_ReductionBatch::Add( int num, const double *val, double *result )
+{
+  if( m_active || num <= 0 || !val )
+  {
+    return -1;
+  }
+
+  // 集約済みの内容はクリア
+  if( m_done )
+  {
+    Clear();
+  }
+
+  int idx = int(m_send.size());
+  for( int i=0;i<num;i++ )
+  {
+    m_send.push_back( val[i] );
+    m_result.push_back( result ? &result[i] : NULL );
+  }
+  return idx;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録した値の集約(同期版)
+cpm_ErrorCode
+cpm_ReductionBatch::Flush()
+{
+  if( !m_paraMngr )
+  {
+    return CPM_ERROR_PM_INSTANCE;
+  }
+  if( m_active )
+  {
+    return Wait();
+  }
+  if( m_send.size() == 0 )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // Allreduce
+  m_recv.resize( m_send.size() );
+  cpm_ErrorCode ret = m_paraMngr->Allreduce( &m_send[0], &m_recv[0], int(m_send.size()), m_op, m_procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 結果の格納
+  Scatter();
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録した値の集約開始(非同期版)
+cpm_ErrorCode
+cpm_ReductionBatch::Start()
+{
+  if( !m_paraMngr )
+  {
+    return CPM_ERROR_PM_INSTANCE;
+  }
+  if( m_active )
+  {
+    return CPM_ERROR_MPI_INVALID_REQUEST;
+  }
+  if( m_send.size() == 0 )
+  {
+    m_done = true;
+    return CPM_SUCCESS;
+  }
+
+  // Iallreduce
+  m_recv.resize( m_send.size() );
+  cpm_ErrorCode ret = m_paraMngr->Iallreduce( &m_send[0], &m_recv[0], int(m_send.size()), m_op
+                                            , &m_req, m_procGrpNo );
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  m_active = true;
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 非同期集約の完了待ち
+cpm_ErrorCode
+cpm_ReductionBatch::Wait()
+{
+  if( !m_active )
+  {
+    return CPM_SUCCESS;
+  }
+
+  // Wait
+  cpm_ErrorCode ret = m_paraMngr->Wait( &m_req );
+  m_active = false;
+  if( ret != CPM_SUCCESS )
+  {
+    return ret;
+  }
+
+  // 結果の格納
+  Scatter();
+
+  return CPM_SUCCESS;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約結果の取得
+double
+cpm_ReductionBatch::Get( int idx ) const
+{
+  if( !m_done || idx < 0 || idx >= int(m_recv.size()) )
+  {
+    return 0.0;
+  }
+  return m_recv[idx];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 登録内容のクリア
+void
+cpm_ReductionBatch::Clear()
+{
+  if( m_active )
+  {
+    return;
+  }
+  m_send.clear();
+  m_recv.clear();
+  m_result.clear();
+  m_done = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// 集約結果の格納
+void
+cpm_ReductionBatch::Scatter()
+{
+  for( size_t i=0;i<m_recv.size();i++ )
+  {
+    if( m_result[i] ) *m_result[i] = m_recv[i];
+  }
+  m_done = true;
+}